@@ -219,6 +219,7 @@ TEST (receive_block, deserialize)
 	ASSERT_EQ (block1.hash (), block1.hash ());
 	block1.hashables.previous = 2;
 	block1.hashables.source = 4;
+	block1.refresh ();
 	std::vector<uint8_t> bytes;
 	{
 		nano::vectorstream stream1 (bytes);
@@ -369,24 +370,34 @@ TEST (state_block, hashing)
 	nano::state_block block (key.pub, 0, key.pub, 0, 0, key.prv, key.pub, 0);
 	auto hash (block.hash ());
 	block.hashables.account.bytes[0] ^= 0x1;
+	block.refresh ();
 	ASSERT_NE (hash, block.hash ());
 	block.hashables.account.bytes[0] ^= 0x1;
+	block.refresh ();
 	ASSERT_EQ (hash, block.hash ());
 	block.hashables.previous.bytes[0] ^= 0x1;
+	block.refresh ();
 	ASSERT_NE (hash, block.hash ());
 	block.hashables.previous.bytes[0] ^= 0x1;
+	block.refresh ();
 	ASSERT_EQ (hash, block.hash ());
 	block.hashables.representative.bytes[0] ^= 0x1;
+	block.refresh ();
 	ASSERT_NE (hash, block.hash ());
 	block.hashables.representative.bytes[0] ^= 0x1;
+	block.refresh ();
 	ASSERT_EQ (hash, block.hash ());
 	block.hashables.balance.bytes[0] ^= 0x1;
+	block.refresh ();
 	ASSERT_NE (hash, block.hash ());
 	block.hashables.balance.bytes[0] ^= 0x1;
+	block.refresh ();
 	ASSERT_EQ (hash, block.hash ());
 	block.hashables.link.bytes[0] ^= 0x1;
+	block.refresh ();
 	ASSERT_NE (hash, block.hash ());
 	block.hashables.link.bytes[0] ^= 0x1;
+	block.refresh ();
 	ASSERT_EQ (hash, block.hash ());
 }
 
@@ -433,6 +444,29 @@ TEST (block_uniquer, cleanup)
 	}
 }
 
+TEST (block_uniquer, cleanup_many)
+{
+	nano::keypair key;
+	nano::block_uniquer uniquer;
+	std::vector<std::shared_ptr<nano::block>> blocks;
+	for (uint64_t i (0); i < 1000; ++i)
+	{
+		blocks.push_back (std::make_shared<nano::state_block> (0, 0, 0, 0, 0, key.prv, key.pub, i));
+		ASSERT_EQ (blocks.back (), uniquer.unique (blocks.back ()));
+	}
+	// Cleanup only removes blocks which are no longer referenced
+	ASSERT_EQ (1000, uniquer.size ());
+	blocks.clear ();
+	auto block1 (std::make_shared<nano::state_block> (0, 0, 0, 0, 0, key.prv, key.pub, 1000));
+	auto iterations (0);
+	while (uniquer.size () > 1)
+	{
+		ASSERT_EQ (block1, uniquer.unique (block1));
+		ASSERT_LT (iterations++, 2000);
+	}
+	ASSERT_EQ (block1, uniquer.unique (std::make_shared<nano::state_block> (*block1)));
+}
+
 TEST (block_builder, from)
 {
 	std::error_code ec;
@@ -682,3 +716,42 @@ TEST (block_builder, receive)
 	             .build (ec);
 	ASSERT_EQ (block->hash ().to_string (), "6C004BF911D9CF2ED75CF6EC45E795122AD5D093FF5A83EDFBA43EC4A3EDC722");
 }
+
+TEST (block, hash_cache)
+{
+	nano::keypair key;
+	nano::state_block block (key.pub, 0, key.pub, 1, 0, key.prv, key.pub, 0);
+	auto hash (block.hash ());
+	nano::state_block copy (block);
+	ASSERT_EQ (hash, copy.hash ());
+	copy.hashables.balance = 2;
+	copy.refresh ();
+	ASSERT_NE (hash, copy.hash ());
+	copy = block;
+	ASSERT_EQ (hash, copy.hash ());
+	auto full_hash (block.full_hash ());
+	block.signature_set (nano::signature (1));
+	ASSERT_EQ (hash, block.hash ());
+	ASSERT_NE (full_hash, block.full_hash ());
+	// Threads race to compute and publish the hash
+	copy.refresh ();
+	std::vector<std::thread> threads;
+	std::atomic<bool> mismatch (false);
+	for (auto i (0); i < 4; ++i)
+	{
+		threads.emplace_back ([&copy, &hash, &mismatch]() {
+			for (auto j (0); j < 1000; ++j)
+			{
+				if (copy.hash () != hash)
+				{
+					mismatch = true;
+				}
+			}
+		});
+	}
+	for (auto & thread : threads)
+	{
+		thread.join ();
+	}
+	ASSERT_FALSE (mismatch);
+}
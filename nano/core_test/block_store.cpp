@@ -132,6 +132,7 @@ TEST (block_store, add_two_items)
 	ASSERT_EQ (nullptr, latest1);
 	nano::open_block block2 (0, 1, 3, nano::keypair ().prv, 0, 0);
 	block2.hashables.account = 3;
+	block2.refresh ();
 	nano::uint256_union hash2 (block2.hash ());
 	block2.signature = nano::sign_message (key1.prv, key1.pub, hash2);
 	auto latest2 (store.block_get (transaction, hash2));
@@ -191,6 +192,29 @@ TEST (block_store, add_pending)
 	ASSERT_TRUE (store.pending_get (transaction, key2, pending2));
 }
 
+TEST (block_store, pending_totals)
+{
+	nano::logger_mt logger;
+	bool init (false);
+	nano::mdb_store store (init, logger, nano::unique_path ());
+	ASSERT_TRUE (!init);
+	auto transaction (store.tx_begin_write ());
+	ASSERT_EQ (nano::pending_total (0, 0), store.pending_total_get (transaction, 1));
+	store.pending_put (transaction, nano::pending_key (1, 2), { 5, 10, nano::epoch::epoch_0 });
+	store.pending_put (transaction, nano::pending_key (1, 3), { 5, 20, nano::epoch::epoch_1 });
+	store.pending_put (transaction, nano::pending_key (2, 4), { 5, 40, nano::epoch::epoch_0 });
+	ASSERT_EQ (nano::pending_total (30, 2), store.pending_total_get (transaction, 1));
+	ASSERT_EQ (nano::pending_total (40, 1), store.pending_total_get (transaction, 2));
+	// Replacing an entry only changes the amount
+	store.pending_put (transaction, nano::pending_key (1, 2), { 5, 15, nano::epoch::epoch_0 });
+	ASSERT_EQ (nano::pending_total (35, 2), store.pending_total_get (transaction, 1));
+	store.pending_del (transaction, nano::pending_key (1, 3));
+	ASSERT_EQ (nano::pending_total (15, 1), store.pending_total_get (transaction, 1));
+	store.pending_del (transaction, nano::pending_key (1, 2));
+	ASSERT_EQ (nano::pending_total (0, 0), store.pending_total_get (transaction, 1));
+	ASSERT_EQ (nano::pending_total (40, 1), store.pending_total_get (transaction, 2));
+}
+
 TEST (block_store, pending_iterator)
 {
 	nano::logger_mt logger;
@@ -526,6 +550,7 @@ TEST (block_store, two_block)
 	ASSERT_TRUE (!init);
 	nano::open_block block1 (0, 1, 1, nano::keypair ().prv, 0, 0);
 	block1.hashables.account = 1;
+	block1.refresh ();
 	std::vector<nano::block_hash> hashes;
 	std::vector<nano::open_block> blocks;
 	hashes.push_back (block1.hash ());
@@ -1587,6 +1612,107 @@ TEST (block_store, upgrade_v13_v14)
 	ASSERT_EQ (error_node_id, MDB_NOTFOUND);
 }
 
+// Populating the delegator index
+TEST (block_store, upgrade_v14_v15)
+{
+	auto path (nano::unique_path ());
+	nano::keypair key1;
+	{
+		nano::logger_mt logger;
+		nano::genesis genesis;
+		auto error (false);
+		nano::mdb_store store (error, logger, path);
+		nano::stat stats;
+		nano::ledger ledger (store, stats);
+		auto transaction (store.tx_begin_write ());
+		store.initialize (transaction, genesis);
+		nano::work_pool pool (std::numeric_limits<unsigned>::max ());
+		nano::change_block change (genesis.hash (), key1.pub, nano::test_genesis_key.prv, nano::test_genesis_key.pub, pool.generate (genesis.hash ()));
+		ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, change).code);
+		store.version_put (transaction, 14);
+		ASSERT_EQ (0, mdb_drop (store.env.tx (transaction), store.delegators, 0));
+		ASSERT_EQ (0, store.delegators_count (transaction, key1.pub));
+	}
+
+	nano::logger_mt logger;
+	auto error (false);
+	nano::mdb_store store (error, logger, path);
+	ASSERT_FALSE (error);
+	auto transaction (store.tx_begin_read ());
+	ASSERT_LT (14, store.version_get (transaction));
+	ASSERT_EQ (1, store.delegators_count (transaction, key1.pub));
+	ASSERT_EQ (0, store.delegators_count (transaction, nano::test_genesis_key.pub));
+	auto i (store.delegators_begin (transaction, key1.pub));
+	ASSERT_NE (store.delegators_end (), i);
+	ASSERT_EQ (nano::test_genesis_key.pub, nano::account (i->second));
+}
+
+// Populating the account height index
+TEST (block_store, upgrade_v15_v16)
+{
+	auto path (nano::unique_path ());
+	nano::genesis genesis;
+	nano::work_pool pool (std::numeric_limits<unsigned>::max ());
+	nano::send_block send (genesis.hash (), nano::test_genesis_key.pub, nano::genesis_amount - 1, nano::test_genesis_key.prv, nano::test_genesis_key.pub, pool.generate (genesis.hash ()));
+	{
+		nano::logger_mt logger;
+		auto error (false);
+		nano::mdb_store store (error, logger, path);
+		nano::stat stats;
+		nano::ledger ledger (store, stats);
+		auto transaction (store.tx_begin_write ());
+		store.initialize (transaction, genesis);
+		ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, send).code);
+		store.version_put (transaction, 15);
+		ASSERT_EQ (0, mdb_drop (store.env.tx (transaction), store.account_heights, 0));
+		ASSERT_TRUE (store.block_at_height (transaction, nano::test_genesis_key.pub, 1).is_zero ());
+	}
+
+	nano::logger_mt logger;
+	auto error (false);
+	nano::mdb_store store (error, logger, path);
+	ASSERT_FALSE (error);
+	auto transaction (store.tx_begin_read ());
+	ASSERT_LT (15, store.version_get (transaction));
+	ASSERT_EQ (genesis.hash (), store.block_at_height (transaction, nano::test_genesis_key.pub, 1));
+	ASSERT_EQ (send.hash (), store.block_at_height (transaction, nano::test_genesis_key.pub, 2));
+	ASSERT_TRUE (store.block_at_height (transaction, nano::test_genesis_key.pub, 3).is_zero ());
+}
+
+// Summing the pending entries of each account
+TEST (block_store, upgrade_v16_v17)
+{
+	auto path (nano::unique_path ());
+	nano::keypair key1;
+	nano::genesis genesis;
+	nano::work_pool pool (std::numeric_limits<unsigned>::max ());
+	nano::send_block send1 (genesis.hash (), key1.pub, nano::genesis_amount - 100, nano::test_genesis_key.prv, nano::test_genesis_key.pub, pool.generate (genesis.hash ()));
+	nano::send_block send2 (send1.hash (), key1.pub, nano::genesis_amount - 300, nano::test_genesis_key.prv, nano::test_genesis_key.pub, pool.generate (send1.hash ()));
+	{
+		nano::logger_mt logger;
+		auto error (false);
+		nano::mdb_store store (error, logger, path);
+		nano::stat stats;
+		nano::ledger ledger (store, stats);
+		auto transaction (store.tx_begin_write ());
+		store.initialize (transaction, genesis);
+		ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, send1).code);
+		ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, send2).code);
+		store.version_put (transaction, 16);
+		ASSERT_EQ (0, mdb_drop (store.env.tx (transaction), store.pending_totals, 0));
+		ASSERT_EQ (0, ledger.account_pending (transaction, key1.pub));
+	}
+
+	nano::logger_mt logger;
+	auto error (false);
+	nano::mdb_store store (error, logger, path);
+	ASSERT_FALSE (error);
+	auto transaction (store.tx_begin_read ());
+	ASSERT_LT (16, store.version_get (transaction));
+	ASSERT_EQ (nano::pending_total (300, 2), store.pending_total_get (transaction, key1.pub));
+	ASSERT_EQ (nano::pending_total (0, 0), store.pending_total_get (transaction, nano::test_genesis_key.pub));
+}
+
 // Test various confirmation height values as well as clearing them
 TEST (block_store, confirmation_height)
 {
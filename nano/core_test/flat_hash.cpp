@@ -0,0 +1,100 @@
+#include <nano/crypto_lib/random_pool.hpp>
+#include <nano/lib/flat_hash.hpp>
+#include <nano/secure/common.hpp>
+
+#include <gtest/gtest.h>
+
+#include <unordered_set>
+
+TEST (flat_hash_set, insert_find_erase)
+{
+	nano::flat_hash_set<nano::block_hash> set;
+	ASSERT_TRUE (set.empty ());
+	ASSERT_EQ (set.end (), set.find (1));
+	ASSERT_TRUE (set.insert (1).second);
+	ASSERT_FALSE (set.insert (1).second);
+	ASSERT_EQ (1, set.size ());
+	ASSERT_NE (set.end (), set.find (1));
+	ASSERT_EQ (nano::block_hash (1), *set.find (1));
+	ASSERT_EQ (0, set.count (2));
+	ASSERT_EQ (1, set.erase (1));
+	ASSERT_EQ (0, set.erase (1));
+	ASSERT_TRUE (set.empty ());
+	// The zero key marks empty slots and is never found
+	ASSERT_EQ (set.end (), set.find (0));
+}
+
+TEST (flat_hash_set, collisions)
+{
+	nano::flat_hash_set<nano::block_hash> set;
+	std::unordered_set<nano::block_hash> reference;
+	// Keys share their first 8 bytes to force long probe sequences which cross the end of the table
+	for (uint64_t i (1); i <= 100; ++i)
+	{
+		nano::block_hash hash (i);
+		hash.qwords[0] = 15;
+		set.insert (hash);
+		reference.insert (hash);
+	}
+	for (uint64_t i (1); i <= 100; i += 3)
+	{
+		nano::block_hash hash (i);
+		hash.qwords[0] = 15;
+		ASSERT_EQ (1, set.erase (hash));
+		reference.erase (hash);
+	}
+	ASSERT_EQ (reference.size (), set.size ());
+	for (auto const & hash : reference)
+	{
+		ASSERT_NE (set.end (), set.find (hash));
+	}
+	size_t iterated (0);
+	for (auto const & hash : set)
+	{
+		ASSERT_EQ (1, reference.count (hash));
+		++iterated;
+	}
+	ASSERT_EQ (reference.size (), iterated);
+}
+
+TEST (flat_hash_set, random)
+{
+	nano::flat_hash_set<nano::block_hash> set;
+	std::unordered_set<nano::block_hash> reference;
+	for (auto i (0); i < 10000; ++i)
+	{
+		nano::block_hash hash;
+		nano::random_pool::generate_block (hash.bytes.data (), hash.bytes.size ());
+		ASSERT_EQ (reference.insert (hash).second, set.insert (hash).second);
+		if (i % 4 == 0)
+		{
+			auto erase (*reference.begin ());
+			reference.erase (erase);
+			ASSERT_EQ (1, set.erase (erase));
+		}
+	}
+	ASSERT_EQ (reference.size (), set.size ());
+	for (auto const & hash : reference)
+	{
+		ASSERT_EQ (1, set.count (hash));
+	}
+	ASSERT_LE (set.size () * 4, set.capacity () * 3);
+	ASSERT_EQ (set.capacity () * sizeof (nano::block_hash), set.memory_usage ());
+	set.clear ();
+	ASSERT_TRUE (set.empty ());
+	ASSERT_EQ (0, set.memory_usage ());
+}
+
+TEST (flat_hash_map, insert_find_erase)
+{
+	nano::flat_hash_map<nano::block_hash, nano::amount> map;
+	ASSERT_TRUE (map.insert (std::make_pair (nano::block_hash (1), nano::amount (10))).second);
+	ASSERT_FALSE (map.insert (std::make_pair (nano::block_hash (1), nano::amount (20))).second);
+	ASSERT_EQ (nano::amount (10), map.find (1)->second);
+	map[2] = 30;
+	ASSERT_EQ (2, map.size ());
+	ASSERT_EQ (nano::amount (30), map.find (2)->second);
+	ASSERT_EQ (1, map.erase (1));
+	ASSERT_EQ (map.end (), map.find (1));
+	ASSERT_EQ (1, map.count (2));
+}
@@ -1,4 +1,5 @@
 #include <nano/core_test/testutil.hpp>
+#include <nano/lib/ipc_binary.hpp>
 #include <nano/lib/ipc_client.hpp>
 #include <nano/node/ipc.hpp>
 #include <nano/node/testing.hpp>
@@ -11,6 +12,7 @@
 #include <chrono>
 #include <memory>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 
 using namespace std::chrono_literals;
@@ -108,3 +110,181 @@ TEST (ipc, config_upgrade_v0_v1)
 	ASSERT_LE (1, local2.get<int> ("version"));
 	ASSERT_FALSE (local2.get<bool> ("allow_unsafe"));
 }
+
+TEST (ipc, config_limits)
+{
+	nano::ipc::ipc_config config1;
+	config1.worker_threads = 3;
+	config1.max_multiplexed_requests = 5;
+	nano::jsonconfig tree;
+	config1.serialize_json (tree);
+	bool upgraded (false);
+	nano::ipc::ipc_config config2;
+	ASSERT_FALSE (config2.deserialize_json (upgraded, tree));
+	ASSERT_EQ (3, config2.worker_threads);
+	ASSERT_EQ (5, config2.max_multiplexed_requests);
+	// A worker pool or request limit of zero would never answer a request
+	nano::jsonconfig tree2;
+	config1.serialize_json (tree2);
+	tree2.put ("worker_threads", 0);
+	nano::ipc::ipc_config config3;
+	ASSERT_TRUE (config3.deserialize_json (upgraded, tree2));
+	nano::jsonconfig tree3;
+	config1.serialize_json (tree3);
+	tree3.put ("max_multiplexed_requests", 0);
+	nano::ipc::ipc_config config4;
+	ASSERT_TRUE (config4.deserialize_json (upgraded, tree3));
+}
+
+TEST (ipc, chunked)
+{
+	nano::system system (24000, 1);
+	system.nodes[0]->config.ipc_config.transport_tcp.enabled = true;
+	system.nodes[0]->config.ipc_config.transport_tcp.port = 24077;
+	nano::node_rpc_config node_rpc_config;
+	nano::ipc::ipc_server ipc (*system.nodes[0], node_rpc_config);
+	nano::ipc::ipc_client client (system.nodes[0]->io_ctx);
+
+	auto req (nano::ipc::prepare_request (nano::ipc::payload_encoding::json_chunked, std::string (R"({"action": "frontiers", "account": ")" + nano::genesis_account.to_account () + R"(", "count": "1"})")));
+	auto res (std::make_shared<std::vector<uint8_t>> ());
+	std::atomic<bool> call_completed{ false };
+	client.async_connect ("::1", 24077, [&client, &req, &res, &call_completed](nano::error err) {
+		client.async_write (req, [&client, &req, &res, &call_completed](nano::error err_a, size_t size_a) {
+			ASSERT_NO_ERROR (static_cast<std::error_code> (err_a));
+			client.async_read (res, sizeof (uint32_t), [&client, &res, &call_completed](nano::error err_read_a, size_t size_read_a) {
+				ASSERT_NO_ERROR (static_cast<std::error_code> (err_read_a));
+				uint32_t header_l = boost::endian::big_to_native (*reinterpret_cast<uint32_t *> (res->data ()));
+				// A small response fits in a single piece
+				ASSERT_EQ (0, header_l & nano::ipc::response_chunk_continued);
+				client.async_read (res, header_l, [&res, &call_completed](nano::error err_read_a, size_t size_read_a) {
+					std::stringstream ss;
+					ss << std::string (res->begin (), res->end ());
+					boost::property_tree::ptree response;
+					boost::property_tree::read_json (ss, response);
+					ASSERT_EQ (nano::genesis ().hash ().to_string (), response.get<std::string> ("frontiers." + nano::genesis_account.to_account ()));
+					call_completed = true;
+				});
+			});
+		});
+	});
+	system.deadline_set (5s);
+	while (!call_completed)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+}
+
+TEST (ipc, multiplexed)
+{
+	nano::system system (24000, 1);
+	system.nodes[0]->config.ipc_config.transport_tcp.enabled = true;
+	system.nodes[0]->config.ipc_config.transport_tcp.port = 24077;
+	nano::node_rpc_config node_rpc_config;
+	nano::ipc::ipc_server ipc (*system.nodes[0], node_rpc_config);
+	nano::ipc::ipc_client client (system.nodes[0]->io_ctx);
+
+	// Both requests are written before either response is read
+	auto req (nano::ipc::prepare_request (nano::ipc::payload_encoding::json_multiplexed, std::string (R"({"action": "block_count"})"), 7));
+	auto req2 (nano::ipc::prepare_request (nano::ipc::payload_encoding::json_multiplexed, std::string (R"({"action": "account_balance", "account": ")" + nano::genesis_account.to_account () + R"("})"), 3));
+	req->insert (req->end (), req2->begin (), req2->end ());
+	auto res (std::make_shared<std::vector<uint8_t>> ());
+	std::unordered_map<uint32_t, boost::property_tree::ptree> responses;
+	std::atomic<bool> call_completed{ false };
+	std::function<void()> read_response;
+	read_response = [&client, &res, &responses, &read_response, &call_completed]() {
+		client.async_read (res, 2 * sizeof (uint32_t), [&client, &res, &responses, &read_response, &call_completed](nano::error err_read_a, size_t size_read_a) {
+			ASSERT_NO_ERROR (static_cast<std::error_code> (err_read_a));
+			auto words (reinterpret_cast<uint32_t *> (res->data ()));
+			uint32_t id_l = boost::endian::big_to_native (words[0]);
+			uint32_t header_l = boost::endian::big_to_native (words[1]);
+			ASSERT_EQ (0, header_l & nano::ipc::response_chunk_continued);
+			client.async_read (res, header_l, [&res, &responses, &read_response, &call_completed, id_l](nano::error err_read_a, size_t size_read_a) {
+				std::stringstream ss;
+				ss << std::string (res->begin (), res->end ());
+				boost::property_tree::read_json (ss, responses[id_l]);
+				if (responses.size () < 2)
+				{
+					read_response ();
+				}
+				else
+				{
+					call_completed = true;
+				}
+			});
+		});
+	};
+	client.async_connect ("::1", 24077, [&client, &req, &read_response](nano::error err) {
+		client.async_write (req, [&req, &read_response](nano::error err_a, size_t size_a) {
+			ASSERT_NO_ERROR (static_cast<std::error_code> (err_a));
+			ASSERT_EQ (size_a, req->size ());
+			read_response ();
+		});
+	});
+	system.deadline_set (5s);
+	while (!call_completed)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	// Responses may arrive in either order, the id tells them apart
+	ASSERT_EQ (1, responses[7].get<int> ("count"));
+	ASSERT_EQ (nano::genesis_amount.convert_to<std::string> (), responses[3].get<std::string> ("balance"));
+}
+
+TEST (ipc, binary)
+{
+	nano::system system (24000, 1);
+	system.nodes[0]->config.ipc_config.transport_tcp.enabled = true;
+	system.nodes[0]->config.ipc_config.transport_tcp.port = 24077;
+	nano::node_rpc_config node_rpc_config;
+	nano::ipc::ipc_server ipc (*system.nodes[0], node_rpc_config);
+	nano::ipc::ipc_client client (system.nodes[0]->io_ctx);
+
+	nano::genesis genesis;
+	nano::ipc::binary::blocks_info_request request;
+	request.hashes.push_back (genesis.hash ());
+	request.hashes.push_back (nano::block_hash (1));
+	std::vector<uint8_t> payload;
+	{
+		nano::vectorstream stream (payload);
+		nano::write (stream, nano::ipc::binary::action::blocks_info);
+		request.serialize (stream);
+	}
+	auto req (nano::ipc::prepare_request (nano::ipc::payload_encoding::binary, std::string (payload.begin (), payload.end ())));
+	auto res (std::make_shared<std::vector<uint8_t>> ());
+	std::atomic<bool> call_completed{ false };
+	client.async_connect ("::1", 24077, [&client, &req, &res, &call_completed](nano::error err) {
+		client.async_write (req, [&client, &res, &call_completed](nano::error err_a, size_t size_a) {
+			ASSERT_NO_ERROR (static_cast<std::error_code> (err_a));
+			client.async_read (res, sizeof (uint32_t), [&client, &res, &call_completed](nano::error err_read_a, size_t size_read_a) {
+				ASSERT_NO_ERROR (static_cast<std::error_code> (err_read_a));
+				uint32_t payload_size_l = boost::endian::big_to_native (*reinterpret_cast<uint32_t *> (res->data ()));
+				client.async_read (res, payload_size_l, [&call_completed](nano::error err_read_a, size_t size_read_a) {
+					ASSERT_NO_ERROR (static_cast<std::error_code> (err_read_a));
+					call_completed = true;
+				});
+			});
+		});
+	});
+	system.deadline_set (5s);
+	while (!call_completed)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	nano::bufferstream stream (res->data (), res->size ());
+	nano::ipc::binary::status status (nano::ipc::binary::status::error);
+	ASSERT_FALSE (nano::try_read (stream, status));
+	ASSERT_EQ (nano::ipc::binary::status::ok, status);
+	nano::ipc::binary::blocks_info_response response;
+	ASSERT_FALSE (response.deserialize (stream));
+	ASSERT_EQ (2, response.blocks.size ());
+	auto & entry (response.blocks[0]);
+	ASSERT_TRUE (entry.found);
+	ASSERT_EQ (genesis.hash (), entry.hash);
+	ASSERT_EQ (nano::genesis_account, entry.account);
+	ASSERT_EQ (nano::genesis_amount, entry.balance.number ());
+	ASSERT_EQ (1, entry.height);
+	ASSERT_TRUE (entry.confirmed);
+	ASSERT_EQ (*genesis.open, *entry.block);
+	ASSERT_FALSE (response.blocks[1].found);
+	ASSERT_EQ (nano::block_hash (1), response.blocks[1].hash);
+}
@@ -0,0 +1,124 @@
+#include <nano/lib/json_reader.hpp>
+#include <nano/lib/perfect_hash.hpp>
+
+#include <gtest/gtest.h>
+
+#include <boost/property_tree/json_parser.hpp>
+
+#include <sstream>
+
+namespace
+{
+bool read_json (std::string const & text_a, boost::property_tree::ptree & tree_a)
+{
+	auto error (false);
+	try
+	{
+		std::stringstream stream (text_a);
+		boost::property_tree::read_json (stream, tree_a);
+	}
+	catch (std::runtime_error const &)
+	{
+		error = true;
+	}
+	return error;
+}
+
+bool json_reader (std::string const & text_a, boost::property_tree::ptree & tree_a)
+{
+	auto error (false);
+	try
+	{
+		nano::json_reader (text_a).read (tree_a);
+	}
+	catch (boost::property_tree::json_parser::json_parser_error const &)
+	{
+		error = true;
+	}
+	return error;
+}
+}
+
+TEST (json_reader, matches_read_json)
+{
+	std::vector<std::string> texts{
+		"{\"action\": \"account_info\", \"account\": \"nano_1111\", \"pending\": \"true\"}",
+		" { \"a\" : [ 1, -2.5e+3, true, false, null, \"\" ], \"b\": {}, \"c\": [], \"a\": \"duplicate\" } \n",
+		"{\"escapes\": \"\\\"\\\\\\/\\b\\f\\n\\r\\t\\u0041\\u00e9\\u20ac\\ud83d\\ude00\"}",
+		"{\"utf8\": \"caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80\"}",
+		"[{\"nested\": [[\"deep\"]]}, 0, 10, -0.0, 1E5]",
+		"\xef\xbb\xbf{\"bom\": \"1\"}",
+		"\"root string\"",
+		"12"
+	};
+	for (auto const & text : texts)
+	{
+		boost::property_tree::ptree expected;
+		boost::property_tree::ptree actual;
+		ASSERT_FALSE (read_json (text, expected)) << text;
+		ASSERT_FALSE (json_reader (text, actual)) << text;
+		ASSERT_EQ (expected, actual) << text;
+	}
+}
+
+TEST (json_reader, errors)
+{
+	std::vector<std::string> texts{
+		"",
+		"{",
+		"{\"a\": 1,}",
+		"{\"a\" 1}",
+		"{a: 1}",
+		"[1 2]",
+		"{\"a\": 01}",
+		"{\"a\": -}",
+		"{\"a\": 1.}",
+		"{\"a\": 1e}",
+		"{\"a\": tru}",
+		"{\"a\": \"unterminated}",
+		"{\"a\": \"control\x01\"}",
+		"{\"a\": \"\\x\"}",
+		"{\"a\": \"\\u12\"}",
+		"{\"a\": \"\\udc00\"}",
+		"{\"a\": \"\\ud800\"}",
+		"{\"a\": \"\x80\"}",
+		"{\"a\": \"\xc3\"}",
+		"{\"a\": \"\xf8\x80\x80\x80\x80\"}",
+		"{} {}",
+		"\xef{\"a\": \"1\"}",
+		"\xef\xbb{\"a\": \"1\"}",
+		"\xef\xbb\xbe{\"a\": \"1\"}"
+	};
+	for (auto const & text : texts)
+	{
+		boost::property_tree::ptree tree;
+		ASSERT_TRUE (read_json (text, tree)) << text;
+		ASSERT_TRUE (json_reader (text, tree)) << text;
+	}
+}
+
+TEST (perfect_hash, find)
+{
+	std::vector<std::string> keys;
+	for (auto i (0); i < 200; ++i)
+	{
+		keys.push_back ("action_" + std::to_string (i));
+	}
+	nano::perfect_hash hash (keys);
+	ASSERT_EQ (keys.size (), hash.size ());
+	for (size_t i (0), n (keys.size ()); i < n; ++i)
+	{
+		ASSERT_EQ (i, hash.find (keys[i]));
+	}
+	ASSERT_EQ (nano::perfect_hash::not_found, hash.find (""));
+	ASSERT_EQ (nano::perfect_hash::not_found, hash.find ("action_"));
+	ASSERT_EQ (nano::perfect_hash::not_found, hash.find ("action_200"));
+	ASSERT_EQ (nano::perfect_hash::not_found, hash.find ("action_10 "));
+}
+
+TEST (perfect_hash, empty)
+{
+	nano::perfect_hash hash (std::vector<std::string>{});
+	ASSERT_EQ (0, hash.size ());
+	ASSERT_EQ (nano::perfect_hash::not_found, hash.find ("account_info"));
+}
@@ -0,0 +1,110 @@
+#include <nano/lib/json_writer.hpp>
+
+#include <gtest/gtest.h>
+
+#include <boost/property_tree/json_parser.hpp>
+
+#include <sstream>
+
+namespace
+{
+std::string write_json (boost::property_tree::ptree const & tree_a)
+{
+	std::stringstream stream;
+	boost::property_tree::write_json (stream, tree_a);
+	return stream.str ();
+}
+}
+
+TEST (json_writer, matches_write_json)
+{
+	std::string output;
+	nano::json_writer writer ([&output](std::string const & chunk_a, bool last_a) {
+		output.append (chunk_a);
+	});
+	boost::property_tree::ptree tree;
+	writer.begin_object ();
+	writer.put ("account", "nano_1111");
+	tree.put ("account", "nano_1111");
+	writer.begin_array ("history");
+	boost::property_tree::ptree history;
+	for (auto i (0); i < 3; ++i)
+	{
+		boost::property_tree::ptree entry;
+		entry.put ("type", "send");
+		entry.put ("height", std::to_string (i));
+		writer.push_back_child (entry);
+		history.push_back (std::make_pair ("", entry));
+	}
+	writer.begin_object ();
+	writer.put ("nested", "1");
+	writer.end ();
+	boost::property_tree::ptree nested;
+	nested.put ("nested", "1");
+	history.push_back (std::make_pair ("", nested));
+	writer.push_back ("plain");
+	history.push_back (std::make_pair ("", boost::property_tree::ptree ("plain")));
+	writer.end ();
+	tree.add_child ("history", history);
+	// Empty objects and arrays are written as empty values, like ptree does
+	writer.begin_object ("blocks");
+	writer.end ();
+	tree.add_child ("blocks", boost::property_tree::ptree ());
+	writer.begin_array ("empty");
+	writer.end ();
+	tree.add_child ("empty", boost::property_tree::ptree ());
+	writer.begin_object ("outer");
+	writer.begin_object ("inner");
+	writer.put ("key", "value");
+	writer.end ();
+	writer.begin_object ("unused");
+	writer.end ();
+	writer.end ();
+	tree.put ("outer.inner.key", "value");
+	tree.put ("outer.unused", "");
+	writer.put ("escaped", "\"a/b\\c\"\b\f\n\r\t\x01\x1f\x7f\xe2\x82\xac");
+	tree.put ("escaped", "\"a/b\\c\"\b\f\n\r\t\x01\x1f\x7f\xe2\x82\xac");
+	writer.finish ();
+	ASSERT_EQ (write_json (tree), output);
+}
+
+TEST (json_writer, empty)
+{
+	std::string output;
+	nano::json_writer writer ([&output](std::string const & chunk_a, bool last_a) {
+		output.append (chunk_a);
+	});
+	writer.begin_object ();
+	writer.finish ();
+	ASSERT_EQ (write_json (boost::property_tree::ptree ()), output);
+}
+
+TEST (json_writer, chunks)
+{
+	std::string output;
+	size_t chunks (0);
+	auto last (false);
+	nano::json_writer writer ([&](std::string const & chunk_a, bool last_a) {
+		ASSERT_FALSE (last);
+		ASSERT_TRUE (last_a || chunk_a.size () >= 100);
+		output.append (chunk_a);
+		last = last_a;
+		++chunks;
+	},
+	100);
+	boost::property_tree::ptree tree;
+	boost::property_tree::ptree accounts;
+	writer.begin_object ();
+	writer.begin_object ("accounts");
+	for (auto i (0); i < 1000; ++i)
+	{
+		writer.put (std::to_string (i), std::to_string (i * i));
+		accounts.put (std::to_string (i), std::to_string (i * i));
+	}
+	writer.end ();
+	tree.add_child ("accounts", accounts);
+	writer.finish ();
+	ASSERT_TRUE (last);
+	ASSERT_LT (100, chunks);
+	ASSERT_EQ (write_json (tree), output);
+}
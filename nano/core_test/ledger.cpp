@@ -320,6 +320,96 @@ TEST (ledger, rollback_representation)
 	ASSERT_EQ (0, ledger.weight (transaction, key3.pub));
 }
 
+TEST (ledger, delegators)
+{
+	nano::logger_mt logger;
+	bool init (false);
+	nano::mdb_store store (init, logger, nano::unique_path ());
+	ASSERT_TRUE (!init);
+	nano::stat stats;
+	nano::ledger ledger (store, stats);
+	nano::genesis genesis;
+	auto transaction (store.tx_begin_write ());
+	store.initialize (transaction, genesis);
+	nano::work_pool pool (std::numeric_limits<unsigned>::max ());
+	ASSERT_EQ (1, store.delegators_count (transaction, nano::test_genesis_key.pub));
+	nano::keypair key1;
+	nano::change_block change1 (genesis.hash (), key1.pub, nano::test_genesis_key.prv, nano::test_genesis_key.pub, pool.generate (genesis.hash ()));
+	ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, change1).code);
+	ASSERT_EQ (0, store.delegators_count (transaction, nano::test_genesis_key.pub));
+	ASSERT_EQ (1, store.delegators_count (transaction, key1.pub));
+	nano::keypair key2;
+	nano::send_block send1 (change1.hash (), key2.pub, 50, nano::test_genesis_key.prv, nano::test_genesis_key.pub, pool.generate (change1.hash ()));
+	ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, send1).code);
+	nano::open_block open (send1.hash (), key1.pub, key2.pub, key2.prv, key2.pub, pool.generate (key2.pub));
+	ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, open).code);
+	ASSERT_EQ (2, store.delegators_count (transaction, key1.pub));
+	std::vector<nano::account> delegators;
+	for (auto i (store.delegators_begin (transaction, key1.pub)), n (store.delegators_end ()); i != n && i->first == key1.pub; ++i)
+	{
+		delegators.push_back (i->second);
+	}
+	ASSERT_EQ (2, delegators.size ());
+	ASSERT_LT (delegators[0], delegators[1]);
+	ASSERT_NE (delegators.end (), std::find (delegators.begin (), delegators.end (), key2.pub));
+	ASSERT_NE (delegators.end (), std::find (delegators.begin (), delegators.end (), nano::test_genesis_key.pub));
+	nano::state_block state1 (key2.pub, open.hash (), nano::test_genesis_key.pub, nano::genesis_amount - 50, 0, key2.prv, key2.pub, pool.generate (open.hash ()));
+	ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, state1).code);
+	ASSERT_EQ (1, store.delegators_count (transaction, key1.pub));
+	ASSERT_EQ (1, store.delegators_count (transaction, nano::test_genesis_key.pub));
+	ASSERT_FALSE (ledger.rollback (transaction, state1.hash ()));
+	ASSERT_EQ (2, store.delegators_count (transaction, key1.pub));
+	ASSERT_EQ (0, store.delegators_count (transaction, nano::test_genesis_key.pub));
+	ASSERT_FALSE (ledger.rollback (transaction, open.hash ()));
+	ASSERT_EQ (1, store.delegators_count (transaction, key1.pub));
+	ASSERT_FALSE (ledger.rollback (transaction, change1.hash ()));
+	ASSERT_EQ (0, store.delegators_count (transaction, key1.pub));
+	ASSERT_EQ (1, store.delegators_count (transaction, nano::test_genesis_key.pub));
+}
+
+TEST (ledger, account_heights)
+{
+	nano::logger_mt logger;
+	bool init (false);
+	nano::mdb_store store (init, logger, nano::unique_path ());
+	ASSERT_TRUE (!init);
+	nano::stat stats;
+	nano::ledger ledger (store, stats);
+	nano::genesis genesis;
+	auto transaction (store.tx_begin_write ());
+	store.initialize (transaction, genesis);
+	nano::work_pool pool (std::numeric_limits<unsigned>::max ());
+	ASSERT_EQ (genesis.hash (), store.block_at_height (transaction, nano::test_genesis_key.pub, 1));
+	nano::keypair key1;
+	nano::change_block change1 (genesis.hash (), key1.pub, nano::test_genesis_key.prv, nano::test_genesis_key.pub, pool.generate (genesis.hash ()));
+	ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, change1).code);
+	nano::send_block send1 (change1.hash (), key1.pub, 50, nano::test_genesis_key.prv, nano::test_genesis_key.pub, pool.generate (change1.hash ()));
+	ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, send1).code);
+	nano::state_block open (key1.pub, 0, key1.pub, nano::genesis_amount - 50, send1.hash (), key1.prv, key1.pub, pool.generate (key1.pub));
+	ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, open).code);
+	ASSERT_EQ (3, store.block_account_height (transaction, send1.hash ()));
+	ASSERT_EQ (1, store.block_account_height (transaction, open.hash ()));
+	ASSERT_EQ (change1.hash (), store.block_at_height (transaction, nano::test_genesis_key.pub, 2));
+	ASSERT_EQ (send1.hash (), store.block_at_height (transaction, nano::test_genesis_key.pub, 3));
+	ASSERT_TRUE (store.block_at_height (transaction, nano::test_genesis_key.pub, 4).is_zero ());
+	ASSERT_EQ (open.hash (), store.block_at_height (transaction, key1.pub, 1));
+	std::vector<nano::block_hash> chain;
+	for (auto i (store.account_heights_begin (transaction, nano::account_height_key (nano::test_genesis_key.pub, 2))), n (store.account_heights_end ()); i != n && i->first.account () == nano::test_genesis_key.pub; ++i)
+	{
+		chain.push_back (i->second);
+	}
+	ASSERT_EQ ((std::vector<nano::block_hash>{ change1.hash (), send1.hash () }), chain);
+	ASSERT_EQ (genesis.hash (), ledger.block_at_distance (transaction, nano::test_genesis_key.pub, send1.hash (), 2, false));
+	ASSERT_TRUE (ledger.block_at_distance (transaction, nano::test_genesis_key.pub, send1.hash (), 3, false).is_zero ());
+	ASSERT_EQ (send1.hash (), ledger.block_at_distance (transaction, nano::test_genesis_key.pub, genesis.hash (), 2, true));
+	ASSERT_TRUE (ledger.block_at_distance (transaction, nano::test_genesis_key.pub, genesis.hash (), 3, true).is_zero ());
+	ASSERT_FALSE (ledger.rollback (transaction, change1.hash ()));
+	ASSERT_TRUE (store.block_at_height (transaction, nano::test_genesis_key.pub, 2).is_zero ());
+	ASSERT_TRUE (store.block_at_height (transaction, nano::test_genesis_key.pub, 3).is_zero ());
+	ASSERT_TRUE (store.block_at_height (transaction, key1.pub, 1).is_zero ());
+	ASSERT_EQ (genesis.hash (), store.block_at_height (transaction, nano::test_genesis_key.pub, 1));
+}
+
 TEST (ledger, receive_rollback)
 {
 	nano::logger_mt logger;
@@ -15,7 +15,9 @@ public:
 	bulk_pull_count (0),
 	bulk_pull_account_count (0),
 	bulk_push_count (0),
-	frontier_req_count (0)
+	frontier_req_count (0),
+	node_id_handshake_count (0),
+	ledger_snapshot_req_count (0)
 	{
 	}
 	void keepalive (nano::keepalive const &) override
@@ -54,6 +56,10 @@ public:
 	{
 		++node_id_handshake_count;
 	}
+	void ledger_snapshot_req (nano::ledger_snapshot_req const &) override
+	{
+		++ledger_snapshot_req_count;
+	}
 	uint64_t keepalive_count;
 	uint64_t publish_count;
 	uint64_t confirm_req_count;
@@ -63,6 +69,7 @@ public:
 	uint64_t bulk_push_count;
 	uint64_t frontier_req_count;
 	uint64_t node_id_handshake_count;
+	uint64_t ledger_snapshot_req_count;
 };
 }
 
@@ -522,6 +522,7 @@ TEST (bulk_pull, end_not_owned)
 	open.hashables.account = key2.pub;
 	open.hashables.representative = key2.pub;
 	open.hashables.source = latest;
+	open.refresh ();
 	open.signature = nano::sign_message (key2.prv, key2.pub, open.hash ());
 	system.nodes[0]->work_generate_blocking (open);
 	ASSERT_EQ (nano::process_result::progress, system.nodes[0]->process (open).code);
@@ -957,6 +958,132 @@ TEST (bootstrap_processor, wallet_lazy_pending)
 	node1->stop ();
 }
 
+TEST (bootstrap_processor, ledger_snapshot)
+{
+	nano::system system;
+	nano::node_config node_config (24000, system.logging);
+	node_config.ledger_snapshot_server = true;
+	auto node0 (system.add_node (node_config));
+	nano::genesis genesis;
+	nano::keypair key1;
+	nano::keypair key2;
+	nano::send_block send1 (genesis.hash (), key1.pub, nano::genesis_amount - 100, nano::test_genesis_key.prv, nano::test_genesis_key.pub, system.work.generate (genesis.hash ()));
+	nano::open_block open1 (send1.hash (), key1.pub, key1.pub, key1.prv, key1.pub, system.work.generate (key1.pub));
+	nano::state_block send2 (nano::test_genesis_key.pub, send1.hash (), nano::test_genesis_key.pub, nano::genesis_amount - 150, key2.pub, nano::test_genesis_key.prv, nano::test_genesis_key.pub, system.work.generate (send1.hash ()));
+	nano::state_block open2 (key2.pub, 0, key2.pub, 50, send2.hash (), key2.prv, key2.pub, system.work.generate (key2.pub));
+	nano::state_block send3 (nano::test_genesis_key.pub, send2.hash (), nano::test_genesis_key.pub, nano::genesis_amount - 175, key1.pub, nano::test_genesis_key.prv, nano::test_genesis_key.pub, system.work.generate (send2.hash ()));
+	{
+		auto transaction (node0->store.tx_begin_write ());
+		for (nano::block const * block : std::initializer_list<nano::block const *>{ &send1, &open1, &send2, &open2, &send3 })
+		{
+			ASSERT_EQ (nano::process_result::progress, node0->ledger.process (transaction, *block).code);
+		}
+		// Cement up to send2 and open1, leaving open2 and send3 out of the snapshot
+		nano::account_info info;
+		ASSERT_FALSE (node0->store.account_get (transaction, nano::test_genesis_key.pub, info));
+		info.confirmation_height = 3;
+		node0->store.account_put (transaction, nano::test_genesis_key.pub, info);
+		ASSERT_FALSE (node0->store.account_get (transaction, key1.pub, info));
+		info.confirmation_height = 1;
+		node0->store.account_put (transaction, key1.pub, info);
+	}
+	nano::node_init init1;
+	auto node1 (std::make_shared<nano::node> (init1, system.io_ctx, 24001, nano::unique_path (), system.alarm, system.logging, system.work));
+	node1->bootstrap_initiator.bootstrap_snapshot (node0->network.endpoint (), { send2.hash () });
+	system.deadline_set (10s);
+	while (node1->bootstrap_initiator.in_progress ())
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	auto transaction (node1->store.tx_begin_read ());
+	ASSERT_TRUE (node1->store.block_exists (transaction, open1.hash ()));
+	ASSERT_TRUE (node1->store.block_exists (transaction, send2.hash ()));
+	ASSERT_FALSE (node1->store.block_exists (transaction, open2.hash ()));
+	ASSERT_FALSE (node1->store.block_exists (transaction, send3.hash ()));
+	ASSERT_TRUE (node1->store.block_successor (transaction, send2.hash ()).is_zero ());
+	nano::account_info info;
+	ASSERT_FALSE (node1->store.account_get (transaction, nano::test_genesis_key.pub, info));
+	ASSERT_EQ (send2.hash (), info.head);
+	ASSERT_EQ (3, info.block_count);
+	ASSERT_EQ (3, info.confirmation_height);
+	ASSERT_EQ (nano::genesis_amount - 150, info.balance.number ());
+	ASSERT_TRUE (node1->store.account_get (transaction, key2.pub, info));
+	nano::pending_info pending;
+	ASSERT_FALSE (node1->store.pending_get (transaction, nano::pending_key (key2.pub, send2.hash ()), pending));
+	ASSERT_EQ (50, pending.amount.number ());
+	ASSERT_FALSE (node1->store.pending_exists (transaction, nano::pending_key (key1.pub, send3.hash ())));
+	ASSERT_EQ (nano::genesis_amount - 150, node1->store.representation_get (transaction, nano::test_genesis_key.pub));
+	ASSERT_EQ (100, node1->store.representation_get (transaction, key1.pub));
+	ASSERT_EQ (0, node1->stats.count (nano::stat::type::bootstrap, nano::stat::detail::ledger_snapshot_failure, nano::stat::dir::in));
+	node1->stop ();
+}
+
+TEST (bootstrap_processor, ledger_snapshot_unknown_anchor)
+{
+	nano::system system;
+	nano::node_config node_config (24000, system.logging);
+	node_config.ledger_snapshot_server = true;
+	auto node0 (system.add_node (node_config));
+	nano::genesis genesis;
+	nano::keypair key1;
+	nano::send_block send1 (genesis.hash (), key1.pub, nano::genesis_amount - 100, nano::test_genesis_key.prv, nano::test_genesis_key.pub, system.work.generate (genesis.hash ()));
+	{
+		auto transaction (node0->store.tx_begin_write ());
+		ASSERT_EQ (nano::process_result::progress, node0->ledger.process (transaction, send1).code);
+		nano::account_info info;
+		ASSERT_FALSE (node0->store.account_get (transaction, nano::test_genesis_key.pub, info));
+		info.confirmation_height = 2;
+		node0->store.account_put (transaction, nano::test_genesis_key.pub, info);
+	}
+	nano::node_init init1;
+	auto node1 (std::make_shared<nano::node> (init1, system.io_ctx, 24001, nano::unique_path (), system.alarm, system.logging, system.work));
+	node1->bootstrap_initiator.bootstrap_snapshot (node0->network.endpoint (), { nano::block_hash (1) });
+	system.deadline_set (10s);
+	while (node1->bootstrap_initiator.in_progress ())
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	// The anchor isn't part of the snapshot so the ledger is restored to just the genesis block
+	ASSERT_EQ (1, node1->stats.count (nano::stat::type::bootstrap, nano::stat::detail::ledger_snapshot_failure, nano::stat::dir::in));
+	auto transaction (node1->store.tx_begin_read ());
+	ASSERT_EQ (1, node1->store.block_count (transaction).sum ());
+	ASSERT_FALSE (node1->store.block_exists (transaction, send1.hash ()));
+	ASSERT_EQ (genesis.hash (), node1->latest (nano::test_genesis_key.pub));
+	node1->stop ();
+}
+
+TEST (bootstrap_processor, ledger_snapshot_disabled)
+{
+	nano::system system (24000, 1);
+	auto node0 (system.nodes[0]);
+	ASSERT_FALSE (node0->config.ledger_snapshot_server);
+	nano::genesis genesis;
+	nano::keypair key1;
+	nano::send_block send1 (genesis.hash (), key1.pub, nano::genesis_amount - 100, nano::test_genesis_key.prv, nano::test_genesis_key.pub, system.work.generate (genesis.hash ()));
+	{
+		auto transaction (node0->store.tx_begin_write ());
+		ASSERT_EQ (nano::process_result::progress, node0->ledger.process (transaction, send1).code);
+		nano::account_info info;
+		ASSERT_FALSE (node0->store.account_get (transaction, nano::test_genesis_key.pub, info));
+		info.confirmation_height = 2;
+		node0->store.account_put (transaction, nano::test_genesis_key.pub, info);
+	}
+	nano::node_init init1;
+	auto node1 (std::make_shared<nano::node> (init1, system.io_ctx, 24001, nano::unique_path (), system.alarm, system.logging, system.work));
+	node1->bootstrap_initiator.bootstrap_snapshot (node0->network.endpoint (), {});
+	system.deadline_set (10s);
+	while (node1->bootstrap_initiator.in_progress ())
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	// Serving snapshots is opt in, the request is dropped and nothing is imported
+	ASSERT_EQ (1, node1->stats.count (nano::stat::type::bootstrap, nano::stat::detail::ledger_snapshot_failure, nano::stat::dir::in));
+	ASSERT_FALSE (node0->bootstrap.ledger_snapshot_serving);
+	auto transaction (node1->store.tx_begin_read ());
+	ASSERT_EQ (1, node1->store.block_count (transaction).sum ());
+	node1->stop ();
+}
+
 TEST (frontier_req_response, DISABLED_destruction)
 {
 	{
@@ -1027,6 +1154,36 @@ TEST (frontier_req, count)
 	ASSERT_EQ (send1.hash (), request->frontier);
 }
 
+TEST (frontier_req, renew_transaction)
+{
+	nano::system system (24000, 1);
+	auto & node1 (*system.nodes[0]);
+	nano::genesis genesis;
+	// Public key FB93... after genesis in accounts table
+	nano::keypair key1 ("ED5AE0A6505B14B67435C29FD9FEEBC26F597D147BC92F6D795FFAD7AFD3D967");
+	nano::state_block send1 (nano::test_genesis_key.pub, genesis.hash (), nano::test_genesis_key.pub, nano::genesis_amount - nano::Gxrb_ratio, key1.pub, nano::test_genesis_key.prv, nano::test_genesis_key.pub, 0);
+	node1.work_generate_blocking (send1);
+	ASSERT_EQ (nano::process_result::progress, node1.process (send1).code);
+	auto connection (std::make_shared<nano::bootstrap_server> (nullptr, system.nodes[0]));
+	std::unique_ptr<nano::frontier_req> req (new nano::frontier_req);
+	req->start.clear ();
+	req->age = std::numeric_limits<decltype (req->age)>::max ();
+	req->count = std::numeric_limits<decltype (req->count)>::max ();
+	connection->requests.push (std::unique_ptr<nano::message>{});
+	auto request (std::make_shared<nano::frontier_req_server> (connection, std::move (req)));
+	ASSERT_EQ (nano::test_genesis_key.pub, request->current);
+	// Opened after the first frontier was read, only visible once the transaction is renewed
+	nano::state_block receive1 (key1.pub, 0, nano::test_genesis_key.pub, nano::Gxrb_ratio, send1.hash (), key1.prv, key1.pub, 0);
+	node1.work_generate_blocking (receive1);
+	ASSERT_EQ (nano::process_result::progress, node1.process (receive1).code);
+	request->transaction_start = std::chrono::steady_clock::time_point ();
+	request->next ();
+	ASSERT_EQ (key1.pub, request->current);
+	ASSERT_EQ (receive1.hash (), request->frontier);
+	request->next ();
+	ASSERT_TRUE (request->current.is_zero ());
+}
+
 TEST (frontier_req, time_bound)
 {
 	nano::system system (24000, 1);
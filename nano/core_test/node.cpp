@@ -723,6 +723,10 @@ TEST (node_config, v16_v17_upgrade)
 	ASSERT_FALSE (tree.get_optional_child ("active_elections_size"));
 	ASSERT_FALSE (tree.get_optional_child ("bandwidth_limit"));
 	ASSERT_FALSE (tree.get_optional_child ("conf_height_processor_batch_min_time"));
+	ASSERT_FALSE (tree.get_optional_child ("wallet_key_cache"));
+	ASSERT_FALSE (tree.get_optional_child ("wallet_action_threads"));
+	ASSERT_FALSE (tree.get_optional_child ("ledger_snapshot_server"));
+	ASSERT_FALSE (tree.get_optional_child ("bootstrap_work_validation_threads"));
 
 	config.deserialize_json (upgraded, tree);
 	// The config options should be added after the upgrade
@@ -739,6 +743,10 @@ TEST (node_config, v16_v17_upgrade)
 	ASSERT_TRUE (!!tree.get_optional_child ("active_elections_size"));
 	ASSERT_TRUE (!!tree.get_optional_child ("bandwidth_limit"));
 	ASSERT_TRUE (!!tree.get_optional_child ("conf_height_processor_batch_min_time"));
+	ASSERT_TRUE (!!tree.get_optional_child ("wallet_key_cache"));
+	ASSERT_TRUE (!!tree.get_optional_child ("wallet_action_threads"));
+	ASSERT_TRUE (!!tree.get_optional_child ("ledger_snapshot_server"));
+	ASSERT_TRUE (!!tree.get_optional_child ("bootstrap_work_validation_threads"));
 
 	ASSERT_TRUE (upgraded);
 	auto version (tree.get<std::string> ("version"));
@@ -779,6 +787,10 @@ TEST (node_config, v17_values)
 		tree.put ("active_elections_size", 50000);
 		tree.put ("bandwidth_limit", 5242880);
 		tree.put ("conf_height_processor_batch_min_time", 0);
+		tree.put ("wallet_key_cache", false);
+		tree.put ("wallet_action_threads", 4);
+		tree.put ("ledger_snapshot_server", false);
+		tree.put ("bootstrap_work_validation_threads", 4);
 	}
 
 	config.deserialize_json (upgraded, tree);
@@ -797,6 +809,10 @@ TEST (node_config, v17_values)
 	ASSERT_EQ (config.active_elections_size, 50000);
 	ASSERT_EQ (config.bandwidth_limit, 5242880);
 	ASSERT_EQ (config.conf_height_processor_batch_min_time.count (), 0);
+	ASSERT_FALSE (config.wallet_key_cache);
+	ASSERT_EQ (config.wallet_action_threads, 4);
+	ASSERT_FALSE (config.ledger_snapshot_server);
+	ASSERT_EQ (config.bootstrap_work_validation_threads, 4);
 
 	// Check config is correct with other values
 	tree.put ("tcp_io_timeout", std::numeric_limits<unsigned long>::max () - 100);
@@ -819,6 +835,10 @@ TEST (node_config, v17_values)
 	tree.put ("active_elections_size", std::numeric_limits<unsigned long long>::max ());
 	tree.put ("bandwidth_limit", std::numeric_limits<size_t>::max ());
 	tree.put ("conf_height_processor_batch_min_time", 500);
+	tree.put ("wallet_key_cache", true);
+	tree.put ("wallet_action_threads", 1);
+	tree.put ("ledger_snapshot_server", true);
+	tree.put ("bootstrap_work_validation_threads", 1);
 
 	upgraded = false;
 	config.deserialize_json (upgraded, tree);
@@ -840,6 +860,10 @@ TEST (node_config, v17_values)
 	ASSERT_EQ (config.active_elections_size, std::numeric_limits<unsigned long long>::max ());
 	ASSERT_EQ (config.bandwidth_limit, std::numeric_limits<size_t>::max ());
 	ASSERT_EQ (config.conf_height_processor_batch_min_time.count (), 500);
+	ASSERT_TRUE (config.wallet_key_cache);
+	ASSERT_EQ (config.wallet_action_threads, 1);
+	ASSERT_TRUE (config.ledger_snapshot_server);
+	ASSERT_EQ (config.bootstrap_work_validation_threads, 1);
 }
 
 // Regression test to ensure that deserializing includes changes node via get_required_child
@@ -2697,6 +2721,40 @@ TEST (node, block_processor_signatures)
 	ASSERT_FALSE (node1.store.block_exists (transaction, receive3->hash ()));
 }
 
+/*
+ * Legacy blocks are batch verified against the account of their previous block, from the ledger or from earlier blocks of the same batch
+ */
+TEST (node, block_processor_signatures_legacy)
+{
+	nano::system system (24000, 1);
+	auto & node (*system.nodes[0]);
+	nano::genesis genesis;
+	nano::keypair key1;
+	auto send1 (std::make_shared<nano::send_block> (genesis.hash (), key1.pub, nano::genesis_amount - nano::Gxrb_ratio, nano::test_genesis_key.prv, nano::test_genesis_key.pub, system.work.generate (genesis.hash ())));
+	auto send2 (std::make_shared<nano::send_block> (send1->hash (), key1.pub, nano::genesis_amount - 2 * nano::Gxrb_ratio, nano::test_genesis_key.prv, nano::test_genesis_key.pub, system.work.generate (send1->hash ())));
+	auto open1 (std::make_shared<nano::open_block> (send1->hash (), key1.pub, key1.pub, key1.prv, key1.pub, system.work.generate (key1.pub)));
+	auto receive1 (std::make_shared<nano::receive_block> (open1->hash (), send2->hash (), key1.prv, key1.pub, system.work.generate (open1->hash ())));
+	// Invalid signature, the account comes from receive1 in the same batch
+	auto change1 (std::make_shared<nano::change_block> (receive1->hash (), key1.pub, key1.prv, key1.pub, system.work.generate (receive1->hash ())));
+	change1->signature.bytes[32] ^= 0x1;
+	// Signed by the wrong account
+	auto change2 (std::make_shared<nano::change_block> (receive1->hash (), nano::test_genesis_key.pub, nano::test_genesis_key.prv, nano::test_genesis_key.pub, system.work.generate (receive1->hash ())));
+	node.process_active (send1);
+	node.process_active (send2);
+	node.process_active (open1);
+	node.process_active (receive1);
+	node.process_active (change1);
+	node.process_active (change2);
+	node.block_processor.flush ();
+	auto transaction (node.store.tx_begin_read ());
+	ASSERT_TRUE (node.store.block_exists (transaction, send1->hash ()));
+	ASSERT_TRUE (node.store.block_exists (transaction, send2->hash ()));
+	ASSERT_TRUE (node.store.block_exists (transaction, open1->hash ()));
+	ASSERT_TRUE (node.store.block_exists (transaction, receive1->hash ()));
+	ASSERT_FALSE (node.store.block_exists (transaction, change1->hash ()));
+	ASSERT_FALSE (node.store.block_exists (transaction, change2->hash ()));
+}
+
 /*
  *  State blocks go through a different signature path, ensure invalidly signed state blocks are rejected
  */
@@ -146,3 +146,71 @@ TEST (signature_checker, one)
 	block.signature.bytes[31] ^= 0x1;
 	verify_block (block, 1);
 }
+
+TEST (signature_checker, concurrent_priorities)
+{
+	nano::signature_checker checker (3);
+	nano::keypair key;
+	nano::state_block block (key.pub, 0, key.pub, 0, 0, key.prv, key.pub, 0);
+	auto hash (block.hash ());
+	nano::signature invalid (block.signature);
+	invalid.bytes[31] ^= 0x1;
+	auto check_func = [&checker, &key, &hash, &block, &invalid](nano::signature_check_priority priority_a, size_t seed_a) {
+		for (size_t i (0); i < 50; ++i)
+		{
+			// Mix sets smaller than a chunk, which get verified together, with sets split over several threads
+			size_t size (1 + (seed_a + i * 131) % (i % 5 == 0 ? 2000 : 40));
+			std::vector<unsigned char const *> messages (size, hash.bytes.data ());
+			std::vector<size_t> lengths (size, sizeof (hash));
+			std::vector<unsigned char const *> pub_keys (size, key.pub.bytes.data ());
+			std::vector<unsigned char const *> signatures (size, block.signature.bytes.data ());
+			std::vector<int> verifications (size, -1);
+			for (size_t j (i % 7); j < size; j += 7)
+			{
+				signatures[j] = invalid.bytes.data ();
+			}
+			nano::signature_check_set check (size, messages.data (), lengths.data (), pub_keys.data (), signatures.data (), verifications.data ());
+			checker.verify (check, priority_a);
+			for (size_t j (0); j < size; ++j)
+			{
+				ASSERT_EQ (signatures[j] == invalid.bytes.data () ? 0 : 1, verifications[j]);
+			}
+		}
+	};
+	std::thread thread1 (check_func, nano::signature_check_priority::high, 1);
+	std::thread thread2 (check_func, nano::signature_check_priority::normal, 2);
+	std::thread thread3 (check_func, nano::signature_check_priority::normal, 3);
+	thread1.join ();
+	thread2.join ();
+	thread3.join ();
+	checker.flush ();
+}
+
+TEST (signature_checker, collected)
+{
+	nano::signature_checker checker (2);
+	nano::keypair key;
+	nano::state_block block (key.pub, 0, key.pub, 0, 0, key.prv, key.pub, 0);
+	auto hash (block.hash ());
+	nano::signature invalid (block.signature);
+	invalid.bytes[31] ^= 0x1;
+	// Single signatures from several threads, some of them not waiting, are verified together and each caller gets its own result
+	auto check_func = [&checker, &key, &hash, &block, &invalid](size_t seed_a) {
+		for (size_t i (0); i < 200; ++i)
+		{
+			auto valid ((seed_a + i) % 3 != 0);
+			auto wait ((seed_a + i) % 5 != 0);
+			ASSERT_EQ (!valid, checker.validate_message (key.pub, hash.bytes.data (), hash.bytes.size (), valid ? block.signature : invalid, wait));
+		}
+	};
+	std::vector<std::thread> threads;
+	for (size_t i (0); i < 4; ++i)
+	{
+		threads.emplace_back (check_func, i);
+	}
+	for (auto & thread : threads)
+	{
+		thread.join ();
+	}
+	checker.flush ();
+}
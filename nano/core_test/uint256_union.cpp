@@ -444,6 +444,61 @@ TEST (uint256_union, bounds)
 	ASSERT_TRUE (key.decode_account (bad2));
 }
 
+TEST (uint256_union, account_buffer)
+{
+	for (auto i (0); i != 100; ++i)
+	{
+		nano::keypair key;
+		std::array<char, nano::uint256_union::account_encoded_size> buffer;
+		key.pub.encode_account (buffer.data ());
+		ASSERT_EQ (key.pub.to_account (), std::string (buffer.data (), buffer.size ()));
+		nano::uint256_union output;
+		ASSERT_FALSE (output.decode_account (buffer.data (), buffer.size ()));
+		ASSERT_EQ (key.pub, output);
+		// Any changed digit fails the checksum
+		buffer[10 + i % 50] = buffer[10 + i % 50] == '1' ? '3' : '1';
+		ASSERT_TRUE (output.decode_account (buffer.data (), buffer.size ()));
+	}
+	nano::uint256_union output;
+	ASSERT_TRUE (output.decode_account ("nano_5111111111111111111111111111111111111111111111111111hifc8npp"));
+	ASSERT_TRUE (output.decode_account ("nano_1111111111111111111111111111111111111111111111111111hifc8np", 64));
+}
+
+TEST (uint256_union, hex_buffer)
+{
+	nano::keypair key;
+	std::array<char, 64> buffer;
+	key.pub.encode_hex (buffer.data ());
+	ASSERT_EQ (key.pub.to_string (), std::string (buffer.data (), buffer.size ()));
+	nano::uint256_union output;
+	ASSERT_FALSE (output.decode_hex (buffer.data (), buffer.size ()));
+	ASSERT_EQ (key.pub, output);
+	std::string lower (key.pub.to_string ());
+	std::transform (lower.begin (), lower.end (), lower.begin (), ::tolower);
+	ASSERT_FALSE (output.decode_hex (lower));
+	ASSERT_EQ (key.pub, output);
+	ASSERT_FALSE (output.decode_hex ("0x1f"));
+	ASSERT_EQ (nano::uint256_union (0x1f), output);
+	ASSERT_TRUE (output.decode_hex ("-1"));
+	ASSERT_TRUE (output.decode_hex (" 1"));
+	ASSERT_TRUE (output.decode_hex ("1g"));
+	nano::uint512_union signature;
+	ASSERT_FALSE (signature.decode_hex (std::string (128, 'f')));
+	ASSERT_EQ (std::string (128, 'F'), signature.to_string ());
+	ASSERT_TRUE (signature.decode_hex (std::string (129, 'f')));
+	nano::uint128_union amount;
+	ASSERT_FALSE (amount.decode_hex ("10"));
+	ASSERT_EQ (16, amount.number ());
+	ASSERT_TRUE (amount.decode_hex (std::string (33, '1')));
+	// No digits is an error for every width, with or without the prefix
+	ASSERT_TRUE (output.decode_hex (""));
+	ASSERT_TRUE (output.decode_hex ("0x"));
+	ASSERT_TRUE (signature.decode_hex (""));
+	ASSERT_TRUE (signature.decode_hex ("0x"));
+	ASSERT_TRUE (amount.decode_hex (""));
+	ASSERT_TRUE (amount.decode_hex ("0x"));
+}
+
 TEST (uint256_union, operator_less_than)
 {
 	test_union_operator_less_than<nano::uint256_union, nano::uint256_t> ();
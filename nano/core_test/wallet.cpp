@@ -1075,3 +1075,244 @@ TEST (wallet, update_work_action)
 	}
 	ASSERT_GT (updated_difficulty, difficulty1);
 }
+
+TEST (wallet, key_cache)
+{
+	nano::system system;
+	nano::node_config node_config (24000, system.logging);
+	node_config.wallet_key_cache = true;
+	auto & node = *system.add_node (node_config);
+	auto wallet (system.wallet (0));
+	ASSERT_NE (nullptr, wallet->store.key_cache);
+	auto transaction (node.wallets.tx_begin_write ());
+	nano::keypair key1;
+	wallet->store.insert_adhoc (transaction, key1.prv);
+	auto key2 (wallet->store.deterministic_insert (transaction));
+	nano::raw_key prv;
+	ASSERT_FALSE (wallet->store.fetch (transaction, key1.pub, prv));
+	ASSERT_EQ (key1.prv, prv);
+	ASSERT_FALSE (wallet->store.fetch (transaction, key2, prv));
+	ASSERT_EQ (key2, nano::pub_key (prv.data));
+	ASSERT_EQ (2, wallet->store.key_cache->size ());
+	// Served from the cache
+	ASSERT_FALSE (wallet->store.fetch (transaction, key1.pub, prv));
+	ASSERT_EQ (key1.prv, prv);
+	wallet->store.erase (transaction, key2);
+	ASSERT_EQ (1, wallet->store.key_cache->size ());
+	ASSERT_TRUE (wallet->store.fetch (transaction, key2, prv));
+	wallet->store.lock ();
+	ASSERT_EQ (0, wallet->store.key_cache->size ());
+	ASSERT_FALSE (wallet->store.valid_password (transaction));
+	ASSERT_TRUE (wallet->store.fetch (transaction, key1.pub, prv));
+	ASSERT_FALSE (wallet->enter_password (transaction, ""));
+	ASSERT_FALSE (wallet->store.fetch (transaction, key1.pub, prv));
+	ASSERT_EQ (key1.prv, prv);
+	ASSERT_EQ (1, wallet->store.key_cache->size ());
+	// A wrong password locks the wallet and clears the cache
+	ASSERT_TRUE (wallet->enter_password (transaction, "1"));
+	ASSERT_EQ (0, wallet->store.key_cache->size ());
+	ASSERT_TRUE (wallet->store.fetch (transaction, key1.pub, prv));
+}
+
+TEST (wallet_key_cache, put_erase)
+{
+	nano::wallet_key_cache cache;
+	nano::keypair key1;
+	nano::raw_key prv;
+	// Keys decrypted before a clear are discarded
+	auto generation (cache.generation ());
+	cache.clear ();
+	cache.put (key1.pub, key1.prv, generation);
+	ASSERT_EQ (0, cache.size ());
+	ASSERT_TRUE (cache.get (key1.pub, prv));
+	cache.put (key1.pub, key1.prv, cache.generation ());
+	ASSERT_FALSE (cache.get (key1.pub, prv));
+	ASSERT_EQ (key1.prv, prv);
+	// Growing the locked storage keeps the cached keys
+	std::vector<nano::keypair> keys (300);
+	for (auto & key : keys)
+	{
+		cache.put (key.pub, key.prv, cache.generation ());
+	}
+	ASSERT_EQ (keys.size () + 1, cache.size ());
+	for (auto i (0); i < keys.size (); i += 2)
+	{
+		cache.erase (keys[i].pub);
+	}
+	ASSERT_EQ (keys.size () / 2 + 1, cache.size ());
+	for (auto i (0); i < keys.size (); ++i)
+	{
+		ASSERT_EQ (i % 2 == 0, cache.get (keys[i].pub, prv));
+		if (i % 2 != 0)
+		{
+			ASSERT_EQ (keys[i].prv, prv);
+		}
+	}
+	cache.clear ();
+	ASSERT_EQ (0, cache.size ());
+	ASSERT_TRUE (cache.get (key1.pub, prv));
+}
+
+TEST (wallet_key_cache, erase_put_race)
+{
+	nano::wallet_key_cache cache;
+	nano::keypair key1;
+	nano::keypair key2;
+	nano::raw_key prv;
+	cache.put (key2.pub, key2.prv, cache.generation ());
+	// key1 is decrypted, then removed from the wallet before the decrypted key is put
+	auto generation (cache.generation ());
+	cache.erase (key1.pub);
+	cache.put (key1.pub, key1.prv, generation);
+	ASSERT_TRUE (cache.get (key1.pub, prv));
+	ASSERT_EQ (1, cache.size ());
+	// Erasing a cached key discards a concurrent put of it as well
+	generation = cache.generation ();
+	cache.erase (key2.pub);
+	cache.put (key2.pub, key2.prv, generation);
+	ASSERT_TRUE (cache.get (key2.pub, prv));
+	ASSERT_EQ (0, cache.size ());
+	// Keys decrypted after the erase are cached
+	cache.put (key1.pub, key1.prv, cache.generation ());
+	ASSERT_FALSE (cache.get (key1.pub, prv));
+	ASSERT_EQ (key1.prv, prv);
+}
+
+TEST (wallet_action_queue, ordering)
+{
+	nano::system system (24000, 1);
+	auto wallet1 (system.wallet (0));
+	nano::wallet_action_queue queue;
+	nano::keypair key1;
+	nano::keypair key2;
+	std::vector<int> order;
+	auto action = [&order](int value_a) {
+		return [&order, value_a](nano::wallet &) { order.push_back (value_a); };
+	};
+	queue.push (1, key1.pub, wallet1, action (1));
+	queue.push (3, key1.pub, wallet1, action (2));
+	queue.push (2, key2.pub, wallet1, action (3));
+	ASSERT_EQ (3, queue.size ());
+	nano::account account;
+	std::shared_ptr<nano::wallet> wallet;
+	nano::wallet_action_queue::action_type current;
+	// Highest priority first
+	ASSERT_FALSE (queue.pop (account, wallet, current));
+	ASSERT_EQ (key1.pub, account);
+	current (*wallet);
+	// key1 is running so only key2 can run next
+	ASSERT_FALSE (queue.pop (account, wallet, current));
+	ASSERT_EQ (key2.pub, account);
+	current (*wallet);
+	ASSERT_TRUE (queue.pop (account, wallet, current));
+	queue.done (key2.pub);
+	ASSERT_TRUE (queue.pop (account, wallet, current));
+	queue.done (key1.pub);
+	ASSERT_FALSE (queue.pop (account, wallet, current));
+	ASSERT_EQ (key1.pub, account);
+	current (*wallet);
+	queue.done (key1.pub);
+	ASSERT_TRUE (queue.empty ());
+	ASSERT_TRUE (queue.pop (account, wallet, current));
+	ASSERT_EQ (std::vector<int> ({ 2, 3, 1 }), order);
+	// A queued action with a higher priority moves its idle account ahead
+	queue.push (1, key1.pub, wallet1, action (4));
+	queue.push (2, key2.pub, wallet1, action (5));
+	queue.push (3, key1.pub, wallet1, action (6));
+	ASSERT_FALSE (queue.pop (account, wallet, current));
+	ASSERT_EQ (key1.pub, account);
+	current (*wallet);
+	ASSERT_EQ (6, order.back ());
+	// Clearing while an action runs
+	queue.clear ();
+	queue.done (key1.pub);
+	ASSERT_TRUE (queue.empty ());
+	ASSERT_TRUE (queue.pop (account, wallet, current));
+}
+
+TEST (wallet, action_concurrency)
+{
+	nano::system system (24000, 1);
+	auto & node (*system.nodes[0]);
+	auto wallet (system.wallet (0));
+	nano::keypair key1;
+	nano::keypair key2;
+	std::promise<void> other;
+	auto other_future (other.get_future ());
+	std::atomic<bool> done (false);
+	std::atomic<int> running (0);
+	std::atomic<bool> overlapped (false);
+	std::mutex order_mutex;
+	std::vector<int> order;
+	// The first action waits for an action of another account, which has to run on a different thread
+	node.wallets.queue_wallet_action (nano::wallets::high_priority, wallet, [&other_future, &done](nano::wallet &) {
+		other_future.wait ();
+		done = true;
+	},
+	key1.pub);
+	node.wallets.queue_wallet_action (nano::wallets::high_priority, wallet, [&other](nano::wallet &) {
+		other.set_value ();
+	},
+	key2.pub);
+	// Actions of one account never overlap and run in queued order
+	for (auto i (0); i < 3; ++i)
+	{
+		node.wallets.queue_wallet_action (nano::wallets::high_priority, wallet, [&, i](nano::wallet &) {
+			overlapped = overlapped || ++running > 1;
+			std::this_thread::sleep_for (std::chrono::milliseconds (10));
+			{
+				std::lock_guard<std::mutex> lock (order_mutex);
+				order.push_back (i);
+			}
+			--running;
+		},
+		key1.pub);
+	}
+	auto finished = [&]() {
+		std::lock_guard<std::mutex> lock (order_mutex);
+		return done && order.size () == 3;
+	};
+	system.deadline_set (10s);
+	while (!finished ())
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	ASSERT_FALSE (overlapped);
+	ASSERT_EQ (std::vector<int> ({ 0, 1, 2 }), order);
+}
+
+TEST (wallet, work_precache)
+{
+	nano::system system (24000, 1);
+	auto & node (*system.nodes[0]);
+	auto wallet (system.wallet (0));
+	wallet->insert_adhoc (nano::test_genesis_key.prv);
+	ASSERT_EQ (1, node.wallets.precache.size ());
+	auto cached_for = [&](nano::block_hash const & root_a) {
+		auto transaction (node.wallets.tx_begin_read ());
+		uint64_t work (0);
+		return !wallet->store.work_get (transaction, nano::test_genesis_key.pub, work) && nano::work_value (root_a, work) >= node.active.active_difficulty ();
+	};
+	nano::genesis genesis;
+	system.deadline_set (10s);
+	while (!cached_for (genesis.hash ()))
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	nano::keypair key;
+	auto block (wallet->send_action (nano::test_genesis_key.pub, key.pub, nano::Gxrb_ratio));
+	ASSERT_NE (nullptr, block);
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::work_cache, nano::stat::detail::hit));
+	ASSERT_EQ (0, node.stats.count (nano::stat::type::work_cache, nano::stat::detail::miss));
+	// The new frontier gets work in the background
+	system.deadline_set (10s);
+	while (!cached_for (block->hash ()))
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	ASSERT_LE (2, node.stats.count (nano::stat::type::work_cache, nano::stat::detail::refresh));
+	// Work provided by the caller isn't counted
+	auto block2 (wallet->send_action (nano::test_genesis_key.pub, key.pub, nano::Gxrb_ratio, system.work.generate (block->hash ())));
+	ASSERT_NE (nullptr, block2);
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::work_cache, nano::stat::detail::hit));
+}
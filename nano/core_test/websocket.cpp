@@ -2,6 +2,7 @@
 #include <nano/boost/beast.hpp>
 #include <nano/core_test/testutil.hpp>
 #include <nano/crypto_lib/random_pool.hpp>
+#include <nano/lib/jsonconfig.hpp>
 #include <nano/node/testing.hpp>
 #include <nano/node/websocket.hpp>
 
@@ -76,6 +77,33 @@ boost::optional<std::string> websocket_test_call (std::string host, std::string
 	}
 	return ret;
 }
+
+/**
+ * A client which subscribes to confirmations and then holds the connection open without reading anything further
+ * until \p finished_a is set. Sets ack_ready once the subscription has been acknowledged.
+ */
+std::thread slow_confirmation_subscriber (std::atomic<bool> & finished_a)
+{
+	ack_ready = false;
+	return std::thread ([&finished_a]() {
+		boost::asio::io_context ioc;
+		boost::asio::ip::tcp::resolver resolver{ ioc };
+		boost::beast::websocket::stream<boost::asio::ip::tcp::socket> ws (ioc);
+		auto const results = resolver.resolve ("::1", "24078");
+		boost::asio::connect (ws.next_layer (), results.begin (), results.end ());
+		ws.handshake ("::1", "/");
+		ws.text (true);
+		std::string message (R"json({"action": "subscribe", "topic": "confirmation", "ack": true})json");
+		ws.write (boost::asio::buffer (message));
+		boost::beast::flat_buffer buffer;
+		ws.read (buffer);
+		ack_ready = true;
+		while (!finished_a)
+		{
+			std::this_thread::sleep_for (10ms);
+		}
+	});
+}
 }
 
 /** Tests clients subscribing multiple times or unsubscribing without a subscription */
@@ -536,6 +564,106 @@ TEST (websocket, confirmation_options)
 	node1->stop ();
 }
 
+/** Subscribes to confirmations of the destination account of a send, which the listener finds through its account index, also after the accounts changed */
+TEST (websocket, confirmation_accounts)
+{
+	nano::system system (24000, 1);
+	nano::node_init init1;
+	nano::node_config config;
+	nano::node_flags node_flags;
+	config.websocket_config.enabled = true;
+	config.websocket_config.port = 24078;
+
+	auto node1 (std::make_shared<nano::node> (init1, system.io_ctx, nano::unique_path (), system.alarm, config, system.work, node_flags));
+	nano::uint256_union wallet;
+	nano::random_pool::generate_block (wallet.bytes.data (), wallet.bytes.size ());
+	node1->wallets.create (wallet);
+	node1->start ();
+	system.nodes.push_back (node1);
+
+	nano::keypair key1;
+	nano::keypair key2;
+	nano::keypair key3;
+	ack_ready = false;
+	std::atomic<bool> client_thread_finished{ false };
+	std::thread client_thread ([&client_thread_finished, &key1, &key2, &key3]() {
+		boost::asio::io_context ioc;
+		boost::asio::ip::tcp::resolver resolver{ ioc };
+		boost::beast::websocket::stream<boost::asio::ip::tcp::socket> ws (ioc);
+		auto const results = resolver.resolve ("::1", "24078");
+		boost::asio::connect (ws.next_layer (), results.begin (), results.end ());
+		ws.handshake ("::1", "/");
+		ws.text (true);
+		auto request ([&ws](std::string const & message_a) {
+			ws.write (boost::asio::buffer (message_a));
+			boost::beast::flat_buffer buffer;
+			ws.read (buffer);
+		});
+		auto subscribe ([](nano::keypair const & key_a) {
+			return std::string (R"json({"action": "subscribe", "topic": "confirmation", "ack": true, "options": {"accounts": [")json") + key_a.pub.to_account () + R"json("]}})json";
+		});
+		// The index follows the session's subscription through an unsubscribe and an update with different accounts
+		request (subscribe (key1));
+		request (R"json({"action": "unsubscribe", "topic": "confirmation", "ack": true})json");
+		request (subscribe (key2));
+		request (subscribe (key3));
+		ack_ready = true;
+
+		boost::optional<std::string> response;
+		boost::beast::flat_buffer buffer;
+		ws.async_read (buffer, [&response, &buffer](boost::beast::error_code const & ec, std::size_t const n) {
+			if (!ec)
+			{
+				std::ostringstream res;
+				res << beast_buffers (buffer.data ());
+				response = res.str ();
+			}
+		});
+		ioc.run_one_for (5s);
+		ASSERT_TRUE (response);
+		boost::property_tree::ptree event;
+		std::stringstream stream;
+		stream << response.get ();
+		boost::property_tree::read_json (stream, event);
+		ASSERT_EQ (event.get<std::string> ("topic"), "confirmation");
+		// Sends to the accounts of the earlier subscriptions are confirmed first but filtered out
+		ASSERT_EQ (key3.pub.to_account (), event.get<std::string> ("message.block.link_as_account"));
+		client_thread_finished = true;
+	});
+
+	// Wait for the subscriptions to be acknowledged
+	system.deadline_set (5s);
+	while (!ack_ready)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	ack_ready = false;
+
+	// Quick-confirm state blocks sending to each of the accounts subscribed to in turn
+	system.wallet (1)->insert_adhoc (nano::test_genesis_key.prv);
+	auto balance = nano::genesis_amount - (node1->config.online_weight_minimum.number () + 1);
+	for (auto key : { &key1, &key2, &key3 })
+	{
+		nano::block_hash previous (node1->latest (nano::test_genesis_key.pub));
+		auto send (std::make_shared<nano::state_block> (nano::test_genesis_key.pub, previous, nano::test_genesis_key.pub, balance, key->pub, nano::test_genesis_key.prv, nano::test_genesis_key.pub, system.work.generate (previous)));
+		node1->process_active (send);
+		system.deadline_set (5s);
+		while (node1->latest (nano::test_genesis_key.pub) != send->hash ())
+		{
+			ASSERT_NO_ERROR (system.poll ());
+		}
+		balance -= 1;
+	}
+
+	system.deadline_set (5s);
+	while (!client_thread_finished)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	client_thread.join ();
+	node1->stop ();
+}
+
 /** Subscribes to votes, sends a block and awaits websocket notification of a vote arrival */
 TEST (websocket, vote)
 {
@@ -701,3 +829,114 @@ TEST (websocket, vote_options)
 	client_thread_2.join ();
 	node1->stop ();
 }
+
+/** Tests that messages for a session with max_queued_messages waiting are dropped */
+TEST (websocket, confirmation_message_drop)
+{
+	nano::system system (24000, 1);
+	nano::node_init init1;
+	nano::node_config config;
+	nano::node_flags node_flags;
+	config.websocket_config.enabled = true;
+	config.websocket_config.port = 24078;
+	config.websocket_config.max_queued_messages = 1;
+
+	auto node1 (std::make_shared<nano::node> (init1, system.io_ctx, nano::unique_path (), system.alarm, config, system.work, node_flags));
+	node1->start ();
+	system.nodes.push_back (node1);
+
+	std::atomic<bool> client_finished{ false };
+	auto client_thread (slow_confirmation_subscriber (client_finished));
+	system.deadline_set (5s);
+	while (!ack_ready)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	ASSERT_EQ (1, node1->websocket_server->subscriber_count (nano::websocket::topic::confirmation));
+
+	// The writes are queued on the session's strand ahead of the first write's completion, so at most one fits the queue
+	nano::genesis genesis;
+	uint64_t burst (10);
+	for (auto i (0u); i < burst; ++i)
+	{
+		node1->websocket_server->broadcast_confirmation (genesis.open, nano::test_genesis_key.pub, nano::genesis_amount, "send", nano::election_status_type::active_confirmed_quorum);
+	}
+	system.deadline_set (5s);
+	while (node1->stats.count (nano::stat::type::websocket, nano::stat::detail::message_drop, nano::stat::dir::out) < burst - 1)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	// Every message is dropped if the write of the acknowledgement had not completed yet
+	ASSERT_GE (burst, node1->stats.count (nano::stat::type::websocket, nano::stat::detail::message_drop, nano::stat::dir::out));
+	ASSERT_EQ (0, node1->stats.count (nano::stat::type::websocket, nano::stat::detail::slow_consumer_disconnect));
+	// Dropping messages keeps the session
+	ASSERT_EQ (1, node1->websocket_server->subscriber_count (nano::websocket::topic::confirmation));
+
+	client_finished = true;
+	client_thread.join ();
+	node1->stop ();
+}
+
+/** Tests that a session with max_queued_messages waiting is disconnected if disconnect_slow_consumers is set */
+TEST (websocket, confirmation_slow_consumer_disconnect)
+{
+	nano::system system (24000, 1);
+	nano::node_init init1;
+	nano::node_config config;
+	nano::node_flags node_flags;
+	config.websocket_config.enabled = true;
+	config.websocket_config.port = 24078;
+	config.websocket_config.max_queued_messages = 1;
+	config.websocket_config.disconnect_slow_consumers = true;
+
+	auto node1 (std::make_shared<nano::node> (init1, system.io_ctx, nano::unique_path (), system.alarm, config, system.work, node_flags));
+	node1->start ();
+	system.nodes.push_back (node1);
+
+	std::atomic<bool> client_finished{ false };
+	auto client_thread (slow_confirmation_subscriber (client_finished));
+	system.deadline_set (5s);
+	while (!ack_ready)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	ASSERT_EQ (1, node1->websocket_server->subscriber_count (nano::websocket::topic::confirmation));
+
+	nano::genesis genesis;
+	for (auto i (0); i < 10; ++i)
+	{
+		node1->websocket_server->broadcast_confirmation (genesis.open, nano::test_genesis_key.pub, nano::genesis_amount, "send", nano::election_status_type::active_confirmed_quorum);
+	}
+	// The session ends once its socket has been closed, which removes its subscription
+	system.deadline_set (5s);
+	while (node1->websocket_server->subscriber_count (nano::websocket::topic::confirmation) != 0)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	ASSERT_EQ (1, node1->stats.count (nano::stat::type::websocket, nano::stat::detail::slow_consumer_disconnect));
+	ASSERT_EQ (0, node1->stats.count (nano::stat::type::websocket, nano::stat::detail::message_drop, nano::stat::dir::out));
+
+	client_finished = true;
+	client_thread.join ();
+	node1->stop ();
+}
+
+TEST (websocket, config_serialization)
+{
+	nano::websocket::config config1;
+	config1.enabled = true;
+	config1.port = 24079;
+	config1.max_queued_messages = 7;
+	config1.disconnect_slow_consumers = true;
+	nano::jsonconfig tree;
+	ASSERT_FALSE (config1.serialize_json (tree));
+	ASSERT_EQ (7, tree.get<size_t> ("max_queued_messages"));
+	ASSERT_TRUE (tree.get<bool> ("disconnect_slow_consumers"));
+	nano::websocket::config config2;
+	ASSERT_FALSE (config2.deserialize_json (tree));
+	ASSERT_EQ (config1.enabled, config2.enabled);
+	ASSERT_EQ (config1.address, config2.address);
+	ASSERT_EQ (config1.port, config2.port);
+	ASSERT_EQ (config1.max_queued_messages, config2.max_queued_messages);
+	ASSERT_EQ (config1.disconnect_slow_consumers, config2.disconnect_slow_consumers);
+}
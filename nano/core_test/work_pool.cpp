@@ -1,11 +1,14 @@
 #include <nano/crypto_lib/random_pool.hpp>
 #include <nano/lib/jsonconfig.hpp>
 #include <nano/lib/timer.hpp>
+#include <nano/lib/work_kernel.hpp>
 #include <nano/node/node.hpp>
 #include <nano/node/wallet.hpp>
 
 #include <gtest/gtest.h>
 
+#include <future>
+
 TEST (work, one)
 {
 	nano::network_constants network_constants;
@@ -30,6 +33,87 @@ TEST (work, validate)
 	ASSERT_LT (network_constants.publish_threshold, difficulty);
 }
 
+TEST (work, value_batch)
+{
+	std::vector<nano::block_hash> roots;
+	std::vector<uint64_t> works;
+	for (uint64_t i (0); i < 9; ++i)
+	{
+		roots.push_back (nano::block_hash (i * 31 + 1));
+		works.push_back (i * 0x0123456789abcdefULL);
+	}
+	std::vector<uint64_t> values (roots.size ());
+	nano::work_value_batch (roots.data (), works.data (), values.data (), roots.size ());
+	for (size_t i (0); i < roots.size (); ++i)
+	{
+		ASSERT_EQ (nano::work_value (roots[i], works[i]), values[i]);
+	}
+}
+
+TEST (work, kernels)
+{
+	auto const & kernels (nano::work_kernels ());
+	ASSERT_FALSE (kernels.empty ());
+	ASSERT_EQ (1, kernels.front ().lanes);
+	for (auto const & kernel : kernels)
+	{
+		ASSERT_LE (kernel.lanes, nano::work_kernel::max_lanes);
+		for (uint64_t round (0); round < 16; ++round)
+		{
+			std::array<nano::block_hash, nano::work_kernel::max_lanes> roots;
+			std::array<uint64_t, nano::work_kernel::max_lanes> works;
+			std::array<uint64_t, nano::work_kernel::max_lanes> values;
+			for (size_t lane (0); lane < kernel.lanes; ++lane)
+			{
+				nano::random_pool::generate_block (roots[lane].bytes.data (), roots[lane].bytes.size ());
+				works[lane] = round * 0x9e3779b97f4a7c15ULL + lane;
+			}
+			kernel.function (roots.data (), works.data (), values.data ());
+			for (size_t lane (0); lane < kernel.lanes; ++lane)
+			{
+				ASSERT_EQ (nano::work_value (roots[lane], works[lane]), values[lane]) << kernel.name;
+			}
+		}
+	}
+	ASSERT_NE (kernels.end (), std::find_if (kernels.begin (), kernels.end (), [](nano::work_kernel const & kernel_a) { return kernel_a.function == nano::work_kernel_best ().function; }));
+}
+
+TEST (work, priority)
+{
+	nano::network_constants network_constants;
+	nano::work_pool pool (std::numeric_limits<unsigned>::max ());
+	std::promise<boost::optional<uint64_t>> low;
+	// Practically unreachable, the low priority item must not hold back the one queued after it
+	// clang-format off
+	pool.generate (nano::uint256_union (1), [&low](boost::optional<uint64_t> const & work_a) {
+		low.set_value (work_a);
+	},
+	std::numeric_limits<uint64_t>::max (), nano::work_priority::low);
+	// clang-format on
+	auto work (pool.generate (nano::uint256_union (2), network_constants.publish_threshold));
+	ASSERT_FALSE (nano::work_validate (nano::uint256_union (2), work));
+	pool.cancel (nano::uint256_union (1));
+	ASSERT_FALSE (low.get_future ().get ());
+}
+
+TEST (work, difficulty_order)
+{
+	nano::network_constants network_constants;
+	nano::work_pool pool (std::numeric_limits<unsigned>::max ());
+	std::promise<boost::optional<uint64_t>> hard;
+	// clang-format off
+	pool.generate (nano::uint256_union (1), [&hard](boost::optional<uint64_t> const & work_a) {
+		hard.set_value (work_a);
+	},
+	std::numeric_limits<uint64_t>::max ());
+	// clang-format on
+	auto work (pool.generate (nano::uint256_union (2), network_constants.publish_threshold));
+	ASSERT_FALSE (nano::work_validate (nano::uint256_union (2), work));
+	ASSERT_NE (0, pool.expected_duration (std::numeric_limits<uint64_t>::max ()).count ());
+	pool.cancel (nano::uint256_union (1));
+	ASSERT_FALSE (hard.get_future ().get ());
+}
+
 TEST (work, cancel)
 {
 	nano::work_pool pool (std::numeric_limits<unsigned>::max ());
@@ -53,6 +53,8 @@ public:
 			static_cast<BUILDER *> (this)->validate ();
 		}
 		assert (!ec);
+		// Fields may have been set after the hash was computed for signing
+		block->refresh ();
 		return std::move (block);
 	}
 
@@ -64,6 +66,7 @@ public:
 			static_cast<BUILDER *> (this)->validate ();
 		}
 		ec = this->ec;
+		block->refresh ();
 		return std::move (block);
 	}
 
@@ -78,6 +81,7 @@ public:
 	/** Sign the block using the \p private_key and \p public_key */
 	inline abstract_builder & sign (nano::raw_key const & private_key, nano::public_key const & public_key)
 	{
+		block->refresh ();
 		block->signature = nano::sign_message (private_key, public_key, block->hash ());
 		build_state |= build_flags::signature_present;
 		return *this;
@@ -74,7 +74,70 @@ size_t nano::block::size (nano::block_type type_a)
 	return result;
 }
 
+nano::block_hash_cache::block_hash_cache (nano::block_hash_cache const & other_a)
+{
+	auto cached (other_a.get ());
+	if (cached)
+	{
+		set (*cached);
+	}
+}
+
+nano::block_hash_cache & nano::block_hash_cache::operator= (nano::block_hash_cache const & other_a)
+{
+	clear ();
+	auto cached (other_a.get ());
+	if (cached)
+	{
+		set (*cached);
+	}
+	return *this;
+}
+
+boost::optional<nano::block_hash> nano::block_hash_cache::get () const
+{
+	boost::optional<nano::block_hash> result;
+	if (status.load (std::memory_order_acquire) == state::ready)
+	{
+		result = value;
+	}
+	return result;
+}
+
+void nano::block_hash_cache::set (nano::block_hash const & hash_a) const
+{
+	auto expected (state::empty);
+	if (status.compare_exchange_strong (expected, state::writing, std::memory_order_acquire))
+	{
+		value = hash_a;
+		status.store (state::ready, std::memory_order_release);
+	}
+}
+
+void nano::block_hash_cache::clear ()
+{
+	status.store (state::empty, std::memory_order_release);
+}
+
 nano::block_hash nano::block::hash () const
+{
+	nano::block_hash result;
+	auto cached (cached_hash.get ());
+	if (cached)
+	{
+		result = *cached;
+		// Hashables must not change without a refresh () once the hash is cached
+		assert (result == generate_hash ());
+	}
+	else
+	{
+		result = generate_hash ();
+		cached_hash.set (result);
+	}
+	return result;
+}
+
+nano::block_hash nano::block::generate_hash () const
 {
 	nano::uint256_union result;
 	blake2b_state hash_l;
@@ -86,12 +149,18 @@ nano::block_hash nano::block::hash () const
 	return result;
 }
 
+void nano::block::refresh ()
+{
+	cached_hash.clear ();
+}
+
 nano::block_hash nano::block::full_hash () const
 {
 	nano::block_hash result;
+	auto hash_l (hash ());
 	blake2b_state state;
 	blake2b_init (&state, sizeof (result.bytes));
-	blake2b_update (&state, hash ().bytes.data (), sizeof (hash ()));
+	blake2b_update (&state, hash_l.bytes.data (), sizeof (hash_l));
 	auto signature (block_signature ());
 	blake2b_update (&state, signature.bytes.data (), sizeof (signature));
 	auto work (block_work ());
@@ -224,6 +293,7 @@ bool nano::send_block::deserialize (nano::stream & stream_a)
 		error = true;
 	}
 
+	refresh ();
 	return error;
 }
 
@@ -285,6 +355,7 @@ bool nano::send_block::deserialize_json (boost::property_tree::ptree const & tre
 	{
 		error = true;
 	}
+	refresh ();
 	return error;
 }
 
@@ -544,6 +615,7 @@ bool nano::open_block::deserialize (nano::stream & stream_a)
 		error = true;
 	}
 
+	refresh ();
 	return error;
 }
 
@@ -601,6 +673,7 @@ bool nano::open_block::deserialize_json (boost::property_tree::ptree const & tre
 	{
 		error = true;
 	}
+	refresh ();
 	return error;
 }
 
@@ -786,6 +859,7 @@ bool nano::change_block::deserialize (nano::stream & stream_a)
 		error = true;
 	}
 
+	refresh ();
 	return error;
 }
 
@@ -837,6 +911,7 @@ bool nano::change_block::deserialize_json (boost::property_tree::ptree const & t
 	{
 		error = true;
 	}
+	refresh ();
 	return error;
 }
 
@@ -1074,6 +1149,7 @@ bool nano::state_block::deserialize (nano::stream & stream_a)
 		error = true;
 	}
 
+	refresh ();
 	return error;
 }
 
@@ -1144,6 +1220,7 @@ bool nano::state_block::deserialize_json (boost::property_tree::ptree const & tr
 	{
 		error = true;
 	}
+	refresh ();
 	return error;
 }
 
@@ -1346,6 +1423,7 @@ bool nano::receive_block::deserialize (nano::stream & stream_a)
 		error = true;
 	}
 
+	refresh ();
 	return error;
 }
 
@@ -1401,6 +1479,7 @@ bool nano::receive_block::deserialize_json (boost::property_tree::ptree const &
 	{
 		error = true;
 	}
+	refresh ();
 	return error;
 }
 
@@ -1566,45 +1645,13 @@ std::shared_ptr<nano::block> nano::block_uniquer::unique (std::shared_ptr<nano::
 	auto result (block_a);
 	if (result != nullptr)
 	{
-		nano::uint256_union key (block_a->full_hash ());
-		std::lock_guard<std::mutex> lock (mutex);
-		auto & existing (blocks[key]);
-		if (auto block_l = existing.lock ())
-		{
-			result = block_l;
-		}
-		else
-		{
-			existing = block_a;
-		}
-		release_assert (std::numeric_limits<CryptoPP::word32>::max () > blocks.size ());
-		for (auto i (0); i < cleanup_count && !blocks.empty (); ++i)
-		{
-			auto random_offset (nano::random_pool::generate_word32 (0, static_cast<CryptoPP::word32> (blocks.size () - 1)));
-			auto existing (std::next (blocks.begin (), random_offset));
-			if (existing == blocks.end ())
-			{
-				existing = blocks.begin ();
-			}
-			if (existing != blocks.end ())
-			{
-				if (auto block_l = existing->second.lock ())
-				{
-					// Still live
-				}
-				else
-				{
-					blocks.erase (existing);
-				}
-			}
-		}
+		result = blocks.unique (block_a->full_hash (), block_a);
 	}
 	return result;
 }
 
 size_t nano::block_uniquer::size ()
 {
-	std::lock_guard<std::mutex> lock (mutex);
 	return blocks.size ();
 }
 
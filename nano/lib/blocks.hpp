@@ -3,10 +3,13 @@
 #include <nano/crypto/blake2/blake2.h>
 #include <nano/lib/errors.hpp>
 #include <nano/lib/numbers.hpp>
+#include <nano/lib/uniquer.hpp>
 #include <nano/lib/utility.hpp>
 
+#include <boost/optional.hpp>
 #include <boost/property_tree/json_parser.hpp>
 
+#include <atomic>
 #include <cassert>
 #include <streambuf>
 #include <unordered_map>
@@ -53,13 +56,39 @@ enum class block_type : uint8_t
 	change = 5,
 	state = 6
 };
+/**
+ * Memoized block hash which can be read from several threads at once.
+ * The first thread to compute the hash publishes it, threads racing with it compute their own copy.
+ */
+class block_hash_cache final
+{
+public:
+	block_hash_cache () = default;
+	block_hash_cache (nano::block_hash_cache const &);
+	nano::block_hash_cache & operator= (nano::block_hash_cache const &);
+	boost::optional<nano::block_hash> get () const;
+	void set (nano::block_hash const &) const;
+	void clear ();
+
+private:
+	enum class state : uint8_t
+	{
+		empty,
+		writing,
+		ready
+	};
+	mutable std::atomic<nano::block_hash_cache::state> status{ nano::block_hash_cache::state::empty };
+	mutable nano::block_hash value;
+};
 class block
 {
 public:
-	// Return a digest of the hashables in this block.
+	// Return a digest of the hashables in this block, computed once and then cached.
 	nano::block_hash hash () const;
 	// Return a digest of hashables and non-hashables in this block.
 	nano::block_hash full_hash () const;
+	// Drop the cached hash, required after modifying hashables directly.
+	void refresh ();
 	std::string to_json () const;
 	virtual void hash (blake2b_state &) const = 0;
 	virtual uint64_t block_work () const = 0;
@@ -87,6 +116,10 @@ public:
 	virtual ~block () = default;
 	virtual bool valid_predecessor (nano::block const &) const = 0;
 	static size_t size (nano::block_type);
+
+private:
+	nano::block_hash generate_hash () const;
+	nano::block_hash_cache cached_hash;
 };
 class send_hashables
 {
@@ -343,15 +376,13 @@ public:
 class block_uniquer
 {
 public:
-	using value_type = std::pair<const nano::uint256_union, std::weak_ptr<nano::block>>;
+	using value_type = nano::sharded_uniquer<nano::block>::value_type;
 
 	std::shared_ptr<nano::block> unique (std::shared_ptr<nano::block>);
 	size_t size ();
 
 private:
-	std::mutex mutex;
-	std::unordered_map<std::remove_const_t<value_type::first_type>, value_type::second_type> blocks;
-	static unsigned constexpr cleanup_count = 2;
+	nano::sharded_uniquer<nano::block> blocks;
 };
 
 std::unique_ptr<seq_con_info_component> collect_seq_con_info (block_uniquer & block_uniquer, const std::string & name);
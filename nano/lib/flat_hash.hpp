@@ -0,0 +1,305 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace nano
+{
+namespace detail
+{
+	template <typename Key>
+	class flat_hash_identity_key final
+	{
+	public:
+		Key const & operator() (Key const & slot_a) const
+		{
+			return slot_a;
+		}
+	};
+	template <typename Key, typename Value>
+	class flat_hash_pair_key final
+	{
+	public:
+		Key const & operator() (std::pair<Key, Value> const & slot_a) const
+		{
+			return slot_a.first;
+		}
+	};
+
+	/**
+	 * Open addressing hash table for 256-bit keys which are already uniformly distributed, such as block hashes and accounts.
+	 * Slots are stored inline in a single power-of-two sized vector and probed linearly, using the first 8 bytes of the key as the hash.
+	 * The all-zero key marks an empty slot and therefore cannot be stored. Erasure shifts following entries back instead of leaving tombstones.
+	 */
+	template <typename Key, typename Slot, typename KeyOf>
+	class flat_hash_table
+	{
+	public:
+		class const_iterator final
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = Slot;
+			using difference_type = std::ptrdiff_t;
+			using pointer = Slot const *;
+			using reference = Slot const &;
+			const_iterator () = default;
+			const_iterator (Slot const * current_a, Slot const * end_a) :
+			current (current_a),
+			end (end_a)
+			{
+				skip_empty ();
+			}
+			reference operator* () const
+			{
+				return *current;
+			}
+			pointer operator-> () const
+			{
+				return current;
+			}
+			const_iterator & operator++ ()
+			{
+				++current;
+				skip_empty ();
+				return *this;
+			}
+			const_iterator operator++ (int)
+			{
+				auto result (*this);
+				++(*this);
+				return result;
+			}
+			bool operator== (const_iterator const & other_a) const
+			{
+				return current == other_a.current;
+			}
+			bool operator!= (const_iterator const & other_a) const
+			{
+				return current != other_a.current;
+			}
+
+		private:
+			void skip_empty ()
+			{
+				while (current != end && KeyOf () (*current).is_zero ())
+				{
+					++current;
+				}
+			}
+			Slot const * current{ nullptr };
+			Slot const * end{ nullptr };
+		};
+		using key_type = Key;
+		using value_type = Slot;
+		using iterator = const_iterator;
+
+		const_iterator begin () const
+		{
+			return const_iterator (slots.data (), slots.data () + slots.size ());
+		}
+		const_iterator end () const
+		{
+			return const_iterator (slots.data () + slots.size (), slots.data () + slots.size ());
+		}
+		size_t size () const
+		{
+			return entries;
+		}
+		bool empty () const
+		{
+			return entries == 0;
+		}
+		/** Number of allocated slots, occupied or not */
+		size_t capacity () const
+		{
+			return slots.size ();
+		}
+		/** Bytes owned by the table, which is all that is allocated for it */
+		size_t memory_usage () const
+		{
+			return slots.capacity () * sizeof (Slot);
+		}
+		/** Removes all entries and releases the slot storage */
+		void clear ()
+		{
+			std::vector<Slot> ().swap (slots);
+			entries = 0;
+		}
+		void reserve (size_t count_a)
+		{
+			auto required (minimum_capacity);
+			while (required * max_load_numerator < count_a * max_load_denominator)
+			{
+				required *= 2;
+			}
+			if (required > slots.size ())
+			{
+				rehash (required);
+			}
+		}
+		const_iterator find (Key const & key_a) const
+		{
+			auto index (find_index (key_a));
+			return index != not_found ? const_iterator (slots.data () + index, slots.data () + slots.size ()) : end ();
+		}
+		size_t count_key (Key const & key_a) const
+		{
+			return find_index (key_a) != not_found ? 1 : 0;
+		}
+		size_t erase (Key const & key_a)
+		{
+			auto index (find_index (key_a));
+			auto result (index != not_found ? 1 : 0);
+			if (result)
+			{
+				erase_index (index);
+			}
+			return result;
+		}
+		static size_t constexpr minimum_capacity = 16;
+		static size_t constexpr max_load_numerator = 3;
+		static size_t constexpr max_load_denominator = 4;
+
+	protected:
+		/** Returns the slot holding key_a, claiming an empty one if the key is not present. The second member is true if the slot was claimed */
+		std::pair<Slot *, bool> emplace_slot (Key const & key_a)
+		{
+			assert (!key_a.is_zero ());
+			if ((entries + 1) * max_load_denominator > slots.size () * max_load_numerator)
+			{
+				auto capacity (slots.size () * 2);
+				rehash (capacity != 0 ? capacity : minimum_capacity);
+			}
+			auto mask (slots.size () - 1);
+			auto index (key_a.qwords[0] & mask);
+			while (!KeyOf () (slots[index]).is_zero () && !(KeyOf () (slots[index]) == key_a))
+			{
+				index = (index + 1) & mask;
+			}
+			auto inserted (KeyOf () (slots[index]).is_zero ());
+			if (inserted)
+			{
+				++entries;
+			}
+			return std::make_pair (&slots[index], inserted);
+		}
+		const_iterator iterator_at (Slot const * slot_a) const
+		{
+			return const_iterator (slot_a, slots.data () + slots.size ());
+		}
+
+	private:
+		static size_t constexpr not_found = static_cast<size_t> (-1);
+		size_t find_index (Key const & key_a) const
+		{
+			auto result (not_found);
+			if (!slots.empty () && !key_a.is_zero ())
+			{
+				auto mask (slots.size () - 1);
+				for (auto index (key_a.qwords[0] & mask); result == not_found && !KeyOf () (slots[index]).is_zero (); index = (index + 1) & mask)
+				{
+					if (KeyOf () (slots[index]) == key_a)
+					{
+						result = index;
+					}
+				}
+			}
+			return result;
+		}
+		void erase_index (size_t index_a)
+		{
+			auto mask (slots.size () - 1);
+			auto hole (index_a);
+			for (auto index ((index_a + 1) & mask); !KeyOf () (slots[index]).is_zero (); index = (index + 1) & mask)
+			{
+				// An entry can fill the hole unless its preferred slot lies cyclically between the hole and its current position
+				auto preferred (KeyOf () (slots[index]).qwords[0] & mask);
+				if (((index - preferred) & mask) >= ((index - hole) & mask))
+				{
+					slots[hole] = slots[index];
+					hole = index;
+				}
+			}
+			slots[hole] = Slot{};
+			--entries;
+		}
+		void rehash (size_t capacity_a)
+		{
+			assert ((capacity_a & (capacity_a - 1)) == 0);
+			std::vector<Slot> old (capacity_a, Slot{});
+			old.swap (slots);
+			auto mask (slots.size () - 1);
+			for (auto const & slot : old)
+			{
+				if (!KeyOf () (slot).is_zero ())
+				{
+					auto index (KeyOf () (slot).qwords[0] & mask);
+					while (!KeyOf () (slots[index]).is_zero ())
+					{
+						index = (index + 1) & mask;
+					}
+					slots[index] = slot;
+				}
+			}
+		}
+		std::vector<Slot> slots;
+		size_t entries{ 0 };
+	};
+}
+
+/** Memory compact replacement for std::unordered_set when storing block hashes or accounts, see nano::detail::flat_hash_table */
+template <typename Key>
+class flat_hash_set final : public nano::detail::flat_hash_table<Key, Key, nano::detail::flat_hash_identity_key<Key>>
+{
+public:
+	using const_iterator = typename nano::detail::flat_hash_table<Key, Key, nano::detail::flat_hash_identity_key<Key>>::const_iterator;
+	std::pair<const_iterator, bool> insert (Key const & key_a)
+	{
+		auto slot (this->emplace_slot (key_a));
+		if (slot.second)
+		{
+			*slot.first = key_a;
+		}
+		return std::make_pair (this->iterator_at (slot.first), slot.second);
+	}
+	size_t count (Key const & key_a) const
+	{
+		return this->count_key (key_a);
+	}
+};
+
+/** Memory compact replacement for std::unordered_map keyed by block hashes or accounts, see nano::detail::flat_hash_table */
+template <typename Key, typename Value>
+class flat_hash_map final : public nano::detail::flat_hash_table<Key, std::pair<Key, Value>, nano::detail::flat_hash_pair_key<Key, Value>>
+{
+public:
+	using const_iterator = typename nano::detail::flat_hash_table<Key, std::pair<Key, Value>, nano::detail::flat_hash_pair_key<Key, Value>>::const_iterator;
+	using mapped_type = Value;
+	std::pair<const_iterator, bool> insert (std::pair<Key, Value> const & value_a)
+	{
+		auto slot (this->emplace_slot (value_a.first));
+		if (slot.second)
+		{
+			*slot.first = value_a;
+		}
+		return std::make_pair (this->iterator_at (slot.first), slot.second);
+	}
+	Value & operator[] (Key const & key_a)
+	{
+		auto slot (this->emplace_slot (key_a));
+		if (slot.second)
+		{
+			slot.first->first = key_a;
+		}
+		return slot.first->second;
+	}
+	size_t count (Key const & key_a) const
+	{
+		return this->count_key (key_a);
+	}
+};
+}
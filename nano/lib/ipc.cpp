@@ -1,21 +1,28 @@
 #include <nano/lib/ipc.hpp>
 
 nano::ipc::socket_base::socket_base (boost::asio::io_context & io_ctx_a) :
-io_timer (io_ctx_a)
+socket_base (io_ctx_a, boost::asio::strand<boost::asio::io_context::executor_type> (io_ctx_a.get_executor ()))
 {
 }
 
-void nano::ipc::socket_base::timer_start (std::chrono::seconds timeout_a)
+nano::ipc::socket_base::socket_base (boost::asio::io_context & io_ctx_a, boost::asio::strand<boost::asio::io_context::executor_type> const & strand_a) :
+strand (strand_a),
+read_timer (io_ctx_a),
+write_timer (io_ctx_a)
+{
+}
+
+void nano::ipc::socket_base::timer_start (boost::asio::deadline_timer & timer_a, std::chrono::seconds timeout_a)
 {
 	if (timeout_a < std::chrono::seconds::max ())
 	{
-		io_timer.expires_from_now (boost::posix_time::seconds (static_cast<long> (timeout_a.count ())));
-		io_timer.async_wait ([this](const boost::system::error_code & ec) {
+		timer_a.expires_from_now (boost::posix_time::seconds (static_cast<long> (timeout_a.count ())));
+		timer_a.async_wait (boost::asio::bind_executor (strand, [this](const boost::system::error_code & ec) {
 			if (!ec)
 			{
 				this->timer_expired ();
 			}
-		});
+		}));
 	}
 }
 
@@ -24,10 +31,10 @@ void nano::ipc::socket_base::timer_expired ()
 	close ();
 }
 
-void nano::ipc::socket_base::timer_cancel ()
+void nano::ipc::socket_base::timer_cancel (boost::asio::deadline_timer & timer_a)
 {
 	boost::system::error_code ec;
-	io_timer.cancel (ec);
+	timer_a.cancel (ec);
 	assert (!ec);
 }
 
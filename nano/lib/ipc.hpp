@@ -28,27 +28,36 @@ namespace ipc
 		reserved_2 = 3,
 	};
 
-	/** Abstract base type for sockets, implementing timer logic and a close operation */
+	/**
+	 * Abstract base type for sockets, implementing timer logic and a close operation. A read and a write may be
+	 * in progress at the same time, each has its own timer. Operations and timers of a socket run on its strand.
+	 */
 	class socket_base
 	{
 	public:
 		socket_base (boost::asio::io_context & io_ctx_a);
+		socket_base (boost::asio::io_context & io_ctx_a, boost::asio::strand<boost::asio::io_context::executor_type> const & strand_a);
 		virtual ~socket_base () = default;
 
 		/** Close socket */
 		virtual void close () = 0;
 
 		/**
-		 * Start IO timer.
+		 * Start the read or write timer, on the strand.
 		 * @param timeout_a Seconds to wait. To wait indefinitely, use std::chrono::seconds::max ()
 		 */
-		void timer_start (std::chrono::seconds timeout_a);
+		void timer_start (boost::asio::deadline_timer & timer_a, std::chrono::seconds timeout_a);
 		void timer_expired ();
-		void timer_cancel ();
+		void timer_cancel (boost::asio::deadline_timer & timer_a);
 
-	private:
-		/** IO operation timer */
-		boost::asio::deadline_timer io_timer;
+		/** Serializes the operations, timers and completion handlers of the socket */
+		boost::asio::strand<boost::asio::io_context::executor_type> strand;
+
+		/** Timer of the read in progress */
+		boost::asio::deadline_timer read_timer;
+
+		/** Timer of the write in progress, also used while connecting */
+		boost::asio::deadline_timer write_timer;
 	};
 
 	/**
@@ -62,9 +71,35 @@ namespace ipc
 		 */
 		json_legacy = 0x1,
 		/** Request/response is same as json_legacy and exposes unsafe RPC's */
-		json_unsafe = 0x2
+		json_unsafe = 0x2,
+		/**
+		 * Request is the same as json_legacy. The response is one or more 32-bit BE headers each followed by payload bytes,
+		 * the low 31 bits of a header are the payload length and response_chunk_continued is set while further payloads follow.
+		 * A response sent in one piece is therefore framed exactly like json_legacy.
+		 */
+		json_chunked = 0x3,
+		/** Request/response is same as json_chunked and exposes unsafe RPC's */
+		json_chunked_unsafe = 0x4,
+		/**
+		 * Request is preamble followed by a 32-bit BE request id, 32-bit BE payload length and payload bytes.
+		 * The node reads the next request without waiting for the response, so any number of requests can be in flight on a connection.
+		 * Each response payload is preceded by the 32-bit BE id of its request and a header as in json_chunked. Responses arrive in
+		 * the order they complete. The node sends each response whole, responses to be streamed are requested with json_chunked
+		 * over a connection of their own, so that a slow reader of one response does not hold back the others.
+		 */
+		json_multiplexed = 0x5,
+		/** Request/response is same as json_multiplexed and exposes unsafe RPC's */
+		json_multiplexed_unsafe = 0x6,
+		/**
+		 * Request/response is same as json_legacy, but the payloads follow the binary schema in nano/lib/ipc_binary.hpp.
+		 * Only read-only actions are available.
+		 */
+		binary = 0x7
 	};
 
+	/** Header flag of a json_chunked or json_multiplexed response payload which is followed by further payloads */
+	uint32_t constexpr response_chunk_continued = 0x80000000;
+
 	/** IPC transport interface */
 	class transport
 	{
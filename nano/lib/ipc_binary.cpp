@@ -0,0 +1,302 @@
+#include <nano/lib/ipc_binary.hpp>
+
+#include <boost/endian/conversion.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+void write_u64 (nano::stream & stream_a, uint64_t value_a)
+{
+	nano::write (stream_a, boost::endian::native_to_big (value_a));
+}
+
+void read_u64 (nano::stream & stream_a, uint64_t & value_a)
+{
+	nano::read (stream_a, value_a);
+	boost::endian::big_to_native_inplace (value_a);
+}
+
+void write_bool (nano::stream & stream_a, bool value_a)
+{
+	nano::write (stream_a, static_cast<uint8_t> (value_a ? 1 : 0));
+}
+
+void read_bool (nano::stream & stream_a, bool & value_a)
+{
+	uint8_t byte;
+	nano::read (stream_a, byte);
+	value_a = byte != 0;
+}
+
+void write_count (nano::stream & stream_a, size_t count_a)
+{
+	nano::write (stream_a, boost::endian::native_to_big (static_cast<uint32_t> (count_a)));
+}
+
+uint32_t read_count (nano::stream & stream_a)
+{
+	uint32_t result;
+	nano::read (stream_a, result);
+	return boost::endian::big_to_native (result);
+}
+
+std::shared_ptr<nano::block> read_block (nano::stream & stream_a)
+{
+	auto result (nano::deserialize_block (stream_a));
+	if (result == nullptr)
+	{
+		throw std::runtime_error ("Failed to read block");
+	}
+	return result;
+}
+}
+
+void nano::ipc::binary::account_info_request::serialize (nano::stream & stream_a) const
+{
+	nano::write (stream_a, account.bytes);
+}
+
+bool nano::ipc::binary::account_info_request::deserialize (nano::stream & stream_a)
+{
+	return nano::try_read (stream_a, account.bytes);
+}
+
+void nano::ipc::binary::account_info_response::serialize (nano::stream & stream_a) const
+{
+	nano::write (stream_a, frontier.bytes);
+	nano::write (stream_a, open_block.bytes);
+	nano::write (stream_a, representative_block.bytes);
+	nano::write (stream_a, representative.bytes);
+	nano::write (stream_a, balance.bytes);
+	write_u64 (stream_a, modified);
+	write_u64 (stream_a, block_count);
+	write_u64 (stream_a, confirmation_height);
+}
+
+bool nano::ipc::binary::account_info_response::deserialize (nano::stream & stream_a)
+{
+	bool result (false);
+	try
+	{
+		nano::read (stream_a, frontier.bytes);
+		nano::read (stream_a, open_block.bytes);
+		nano::read (stream_a, representative_block.bytes);
+		nano::read (stream_a, representative.bytes);
+		nano::read (stream_a, balance.bytes);
+		read_u64 (stream_a, modified);
+		read_u64 (stream_a, block_count);
+		read_u64 (stream_a, confirmation_height);
+	}
+	catch (std::runtime_error &)
+	{
+		result = true;
+	}
+	return result;
+}
+
+void nano::ipc::binary::account_history_request::serialize (nano::stream & stream_a) const
+{
+	nano::write (stream_a, account.bytes);
+	nano::write (stream_a, head.bytes);
+	write_u64 (stream_a, count);
+	write_u64 (stream_a, offset);
+	write_bool (stream_a, reverse);
+}
+
+bool nano::ipc::binary::account_history_request::deserialize (nano::stream & stream_a)
+{
+	bool result (false);
+	try
+	{
+		nano::read (stream_a, account.bytes);
+		nano::read (stream_a, head.bytes);
+		read_u64 (stream_a, count);
+		read_u64 (stream_a, offset);
+		read_bool (stream_a, reverse);
+	}
+	catch (std::runtime_error &)
+	{
+		result = true;
+	}
+	return result;
+}
+
+void nano::ipc::binary::account_history_entry::serialize (nano::stream & stream_a) const
+{
+	nano::write (stream_a, hash.bytes);
+	write_u64 (stream_a, height);
+	write_u64 (stream_a, local_timestamp);
+	nano::write (stream_a, amount.bytes);
+	nano::write (stream_a, counterparty.bytes);
+	nano::serialize_block (stream_a, *block);
+}
+
+bool nano::ipc::binary::account_history_entry::deserialize (nano::stream & stream_a)
+{
+	bool result (false);
+	try
+	{
+		nano::read (stream_a, hash.bytes);
+		read_u64 (stream_a, height);
+		read_u64 (stream_a, local_timestamp);
+		nano::read (stream_a, amount.bytes);
+		nano::read (stream_a, counterparty.bytes);
+		block = read_block (stream_a);
+	}
+	catch (std::runtime_error &)
+	{
+		result = true;
+	}
+	return result;
+}
+
+void nano::ipc::binary::account_history_response::serialize (nano::stream & stream_a) const
+{
+	nano::write (stream_a, account.bytes);
+	write_count (stream_a, history.size ());
+	for (auto const & entry : history)
+	{
+		entry.serialize (stream_a);
+	}
+	nano::write (stream_a, next.bytes);
+}
+
+bool nano::ipc::binary::account_history_response::deserialize (nano::stream & stream_a)
+{
+	bool result (false);
+	try
+	{
+		nano::read (stream_a, account.bytes);
+		history.clear ();
+		for (auto i (read_count (stream_a)); i > 0 && !result; --i)
+		{
+			history.emplace_back ();
+			result = history.back ().deserialize (stream_a);
+		}
+		nano::read (stream_a, next.bytes);
+	}
+	catch (std::runtime_error &)
+	{
+		result = true;
+	}
+	return result;
+}
+
+void nano::ipc::binary::blocks_info_request::serialize (nano::stream & stream_a) const
+{
+	write_count (stream_a, hashes.size ());
+	for (auto const & hash : hashes)
+	{
+		nano::write (stream_a, hash.bytes);
+	}
+}
+
+bool nano::ipc::binary::blocks_info_request::deserialize (nano::stream & stream_a)
+{
+	bool result (false);
+	try
+	{
+		hashes.clear ();
+		for (auto i (read_count (stream_a)); i > 0; --i)
+		{
+			hashes.emplace_back ();
+			nano::read (stream_a, hashes.back ().bytes);
+		}
+	}
+	catch (std::runtime_error &)
+	{
+		result = true;
+	}
+	return result;
+}
+
+void nano::ipc::binary::blocks_info_entry::serialize (nano::stream & stream_a) const
+{
+	nano::write (stream_a, hash.bytes);
+	write_bool (stream_a, found);
+	if (found)
+	{
+		nano::write (stream_a, account.bytes);
+		nano::write (stream_a, amount.bytes);
+		nano::write (stream_a, balance.bytes);
+		write_u64 (stream_a, height);
+		write_u64 (stream_a, local_timestamp);
+		write_bool (stream_a, confirmed);
+		nano::serialize_block (stream_a, *block);
+	}
+}
+
+bool nano::ipc::binary::blocks_info_entry::deserialize (nano::stream & stream_a)
+{
+	bool result (false);
+	try
+	{
+		nano::read (stream_a, hash.bytes);
+		read_bool (stream_a, found);
+		if (found)
+		{
+			nano::read (stream_a, account.bytes);
+			nano::read (stream_a, amount.bytes);
+			nano::read (stream_a, balance.bytes);
+			read_u64 (stream_a, height);
+			read_u64 (stream_a, local_timestamp);
+			read_bool (stream_a, confirmed);
+			block = read_block (stream_a);
+		}
+	}
+	catch (std::runtime_error &)
+	{
+		result = true;
+	}
+	return result;
+}
+
+void nano::ipc::binary::blocks_info_response::serialize (nano::stream & stream_a) const
+{
+	write_count (stream_a, blocks.size ());
+	for (auto const & entry : blocks)
+	{
+		entry.serialize (stream_a);
+	}
+}
+
+bool nano::ipc::binary::blocks_info_response::deserialize (nano::stream & stream_a)
+{
+	bool result (false);
+	try
+	{
+		blocks.clear ();
+		for (auto i (read_count (stream_a)); i > 0 && !result; --i)
+		{
+			blocks.emplace_back ();
+			result = blocks.back ().deserialize (stream_a);
+		}
+	}
+	catch (std::runtime_error &)
+	{
+		result = true;
+	}
+	return result;
+}
+
+void nano::ipc::binary::serialize_error (nano::stream & stream_a, std::string const & message_a)
+{
+	auto size (static_cast<uint16_t> (std::min<size_t> (message_a.size (), std::numeric_limits<uint16_t>::max ())));
+	nano::write (stream_a, boost::endian::native_to_big (size));
+	stream_a.sputn (reinterpret_cast<uint8_t const *> (message_a.data ()), size);
+}
+
+bool nano::ipc::binary::deserialize_error (nano::stream & stream_a, std::string & message_a)
+{
+	uint16_t size;
+	auto result (nano::try_read (stream_a, size));
+	if (!result)
+	{
+		boost::endian::big_to_native_inplace (size);
+		message_a.resize (size);
+		result = stream_a.sgetn (reinterpret_cast<uint8_t *> (&message_a[0]), size) != size;
+	}
+	return result;
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <nano/lib/blocks.hpp>
+#include <nano/lib/numbers.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace nano
+{
+namespace ipc
+{
+	/**
+	 * Schema of payload_encoding::binary. A request payload is an action byte followed by the request of that action,
+	 * a response payload is a status byte followed by the response or, on error, the error message.
+	 * Hashes and accounts are 32 raw bytes, amounts 16 raw bytes, integers and lengths are BE and blocks use the
+	 * wire serialization, a type byte followed by the block.
+	 */
+	namespace binary
+	{
+		enum class action : uint8_t
+		{
+			invalid = 0,
+			account_info = 1,
+			account_history = 2,
+			blocks_info = 3
+		};
+
+		enum class status : uint8_t
+		{
+			ok = 0,
+			/** Followed by a 16-bit BE length and the message */
+			error = 1
+		};
+
+		class account_info_request final
+		{
+		public:
+			void serialize (nano::stream &) const;
+			bool deserialize (nano::stream &);
+			nano::account account{ 0 };
+		};
+
+		class account_info_response final
+		{
+		public:
+			void serialize (nano::stream &) const;
+			bool deserialize (nano::stream &);
+			nano::block_hash frontier{ 0 };
+			nano::block_hash open_block{ 0 };
+			nano::block_hash representative_block{ 0 };
+			nano::account representative{ 0 };
+			nano::amount balance{ 0 };
+			/** Seconds since posix epoch */
+			uint64_t modified{ 0 };
+			uint64_t block_count{ 0 };
+			uint64_t confirmation_height{ 0 };
+		};
+
+		class account_history_request final
+		{
+		public:
+			void serialize (nano::stream &) const;
+			bool deserialize (nano::stream &);
+			nano::account account{ 0 };
+			/** Block to start from instead of the frontier, or the open block if reverse. Zero to use the account */
+			nano::block_hash head{ 0 };
+			uint64_t count{ 0 };
+			uint64_t offset{ 0 };
+			bool reverse{ false };
+		};
+
+		class account_history_entry final
+		{
+		public:
+			void serialize (nano::stream &) const;
+			bool deserialize (nano::stream &);
+			nano::block_hash hash{ 0 };
+			uint64_t height{ 0 };
+			uint64_t local_timestamp{ 0 };
+			/** Amount sent or received by the block, zero for changes */
+			nano::amount amount{ 0 };
+			/** Destination of a send or the source account of a receive, zero otherwise */
+			nano::account counterparty{ 0 };
+			std::shared_ptr<nano::block> block;
+		};
+
+		class account_history_response final
+		{
+		public:
+			void serialize (nano::stream &) const;
+			bool deserialize (nano::stream &);
+			nano::account account{ 0 };
+			std::vector<nano::ipc::binary::account_history_entry> history;
+			/** Where the next page starts, zero if the end of the chain was reached */
+			nano::block_hash next{ 0 };
+		};
+
+		class blocks_info_request final
+		{
+		public:
+			void serialize (nano::stream &) const;
+			bool deserialize (nano::stream &);
+			std::vector<nano::block_hash> hashes;
+		};
+
+		/** Only the hash and a cleared found flag are sent for a block not in the ledger */
+		class blocks_info_entry final
+		{
+		public:
+			void serialize (nano::stream &) const;
+			bool deserialize (nano::stream &);
+			nano::block_hash hash{ 0 };
+			bool found{ false };
+			nano::account account{ 0 };
+			nano::amount amount{ 0 };
+			nano::amount balance{ 0 };
+			uint64_t height{ 0 };
+			uint64_t local_timestamp{ 0 };
+			bool confirmed{ false };
+			std::shared_ptr<nano::block> block;
+		};
+
+		class blocks_info_response final
+		{
+		public:
+			void serialize (nano::stream &) const;
+			bool deserialize (nano::stream &);
+			std::vector<nano::ipc::binary::blocks_info_entry> blocks;
+		};
+
+		void serialize_error (nano::stream &, std::string const &);
+		bool deserialize_error (nano::stream &, std::string &);
+	}
+}
+}
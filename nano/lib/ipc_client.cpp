@@ -26,16 +26,16 @@ template <typename SOCKET_TYPE, typename ENDPOINT_TYPE>
 class socket_client : public nano::ipc::socket_base, public channel
 {
 public:
-	socket_client (boost::asio::io_context & io_ctx_a, ENDPOINT_TYPE endpoint_a) :
-	socket_base (io_ctx_a), endpoint (endpoint_a), socket (io_ctx_a), resolver (io_ctx_a), strand (io_ctx_a.get_executor ())
+	socket_client (boost::asio::io_context & io_ctx_a, boost::asio::strand<boost::asio::io_context::executor_type> const & strand_a, ENDPOINT_TYPE endpoint_a) :
+	socket_base (io_ctx_a, strand_a), endpoint (endpoint_a), socket (io_ctx_a), resolver (io_ctx_a)
 	{
 	}
 
 	void async_resolve (std::string const & host_a, uint16_t port_a, std::function<void(boost::system::error_code const &, boost::asio::ip::tcp::endpoint)> callback_a)
 	{
-		this->timer_start (io_timeout);
-		resolver.async_resolve (boost::asio::ip::tcp::resolver::query (host_a, std::to_string (port_a)), [this, callback_a](boost::system::error_code const & ec, boost::asio::ip::tcp::resolver::iterator endpoint_iterator_a) {
-			this->timer_cancel ();
+		this->timer_start (this->write_timer, io_timeout);
+		resolver.async_resolve (boost::asio::ip::tcp::resolver::query (host_a, std::to_string (port_a)), boost::asio::bind_executor (this->strand, [this, callback_a](boost::system::error_code const & ec, boost::asio::ip::tcp::resolver::iterator endpoint_iterator_a) {
+			this->timer_cancel (this->write_timer);
 			boost::asio::ip::tcp::resolver::iterator end;
 			if (!ec && endpoint_iterator_a != end)
 			{
@@ -46,33 +46,33 @@ public:
 			{
 				callback_a (ec, *end);
 			}
-		});
+		}));
 	}
 
 	void async_connect (std::function<void(boost::system::error_code const &)> callback_a)
 	{
-		this->timer_start (io_timeout);
-		socket.async_connect (endpoint, boost::asio::bind_executor (strand, [this, callback_a](boost::system::error_code const & ec) {
-			this->timer_cancel ();
+		this->timer_start (this->write_timer, io_timeout);
+		socket.async_connect (endpoint, boost::asio::bind_executor (this->strand, [this, callback_a](boost::system::error_code const & ec) {
+			this->timer_cancel (this->write_timer);
 			callback_a (ec);
 		}));
 	}
 
 	void async_read (std::shared_ptr<std::vector<uint8_t>> buffer_a, size_t size_a, std::function<void(boost::system::error_code const &, size_t)> callback_a) override
 	{
-		this->timer_start (io_timeout);
+		this->timer_start (this->read_timer, io_timeout);
 		buffer_a->resize (size_a);
 		boost::asio::async_read (socket, boost::asio::buffer (buffer_a->data (), size_a), boost::asio::bind_executor (this->strand, [this, callback_a](boost::system::error_code const & ec, size_t size_a) {
-			this->timer_cancel ();
+			this->timer_cancel (this->read_timer);
 			callback_a (ec, size_a);
 		}));
 	}
 
 	void async_write (std::shared_ptr<std::vector<uint8_t>> buffer_a, std::function<void(boost::system::error_code const &, size_t)> callback_a) override
 	{
-		this->timer_start (io_timeout);
+		this->timer_start (this->write_timer, io_timeout);
 		boost::asio::async_write (socket, boost::asio::buffer (buffer_a->data (), buffer_a->size ()), boost::asio::bind_executor (this->strand, [this, callback_a, buffer_a](boost::system::error_code const & ec, size_t size_a) {
-			this->timer_cancel ();
+			this->timer_cancel (this->write_timer);
 			callback_a (ec, size_a);
 		}));
 	}
@@ -80,8 +80,10 @@ public:
 	/** Shut down and close socket */
 	void close () override
 	{
-		socket.shutdown (boost::asio::ip::tcp::socket::shutdown_both);
-		socket.close ();
+		// The socket may already be broken, which is why it is being closed
+		boost::system::error_code ec;
+		socket.shutdown (boost::asio::ip::tcp::socket::shutdown_both, ec);
+		socket.close (ec);
 	}
 
 private:
@@ -89,7 +91,6 @@ private:
 	SOCKET_TYPE socket;
 	boost::asio::ip::tcp::resolver resolver;
 	std::chrono::seconds io_timeout{ 60 };
-	boost::asio::strand<boost::asio::io_context::executor_type> strand;
 };
 
 /**
@@ -99,14 +100,14 @@ private:
 class client_impl : public nano::ipc::ipc_client_impl
 {
 public:
-	client_impl (boost::asio::io_context & io_ctx_a) :
-	io_ctx (io_ctx_a)
+	client_impl (boost::asio::io_context & io_ctx_a, boost::asio::strand<boost::asio::io_context::executor_type> const & strand_a) :
+	io_ctx (io_ctx_a), strand (strand_a)
 	{
 	}
 
 	void connect (std::string const & host_a, uint16_t port_a, std::function<void(nano::error)> callback_a)
 	{
-		tcp_client = std::make_shared<socket_client<socket_type, boost::asio::ip::tcp::endpoint>> (io_ctx, boost::asio::ip::tcp::endpoint (boost::asio::ip::tcp::v6 (), port_a));
+		tcp_client = std::make_shared<socket_client<socket_type, boost::asio::ip::tcp::endpoint>> (io_ctx, strand, boost::asio::ip::tcp::endpoint (boost::asio::ip::tcp::v6 (), port_a));
 
 		tcp_client->async_resolve (host_a, port_a, [this, callback_a](boost::system::error_code const & ec_resolve_a, boost::asio::ip::tcp::endpoint endpoint_a) {
 			if (!ec_resolve_a)
@@ -126,13 +127,27 @@ public:
 	{
 		nano::error err;
 #if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
-		domain_client = std::make_shared<socket_client<boost::asio::local::stream_protocol::socket, boost::asio::local::stream_protocol::endpoint>> (io_ctx, boost::asio::local::stream_protocol::endpoint (path_a));
+		domain_client = std::make_shared<socket_client<boost::asio::local::stream_protocol::socket, boost::asio::local::stream_protocol::endpoint>> (io_ctx, strand, boost::asio::local::stream_protocol::endpoint (path_a));
 #else
 		err = nano::error ("Domain sockets are not supported by this platform");
 #endif
 		return err;
 	}
 
+	void close ()
+	{
+		if (tcp_client)
+		{
+			tcp_client->close ();
+		}
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+		if (domain_client)
+		{
+			domain_client->close ();
+		}
+#endif
+	}
+
 	channel & get_channel ()
 	{
 #if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
@@ -144,6 +159,7 @@ public:
 
 private:
 	boost::asio::io_context & io_ctx;
+	boost::asio::strand<boost::asio::io_context::executor_type> strand;
 	std::shared_ptr<socket_client<socket_type, boost::asio::ip::tcp::endpoint>> tcp_client;
 #if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
 	std::shared_ptr<socket_client<boost::asio::local::stream_protocol::socket, boost::asio::local::stream_protocol::endpoint>> domain_client;
@@ -152,19 +168,25 @@ private:
 }
 
 nano::ipc::ipc_client::ipc_client (boost::asio::io_context & io_ctx_a) :
-io_ctx (io_ctx_a)
+ipc_client (io_ctx_a, boost::asio::strand<boost::asio::io_context::executor_type> (io_ctx_a.get_executor ()))
+{
+}
+
+nano::ipc::ipc_client::ipc_client (boost::asio::io_context & io_ctx_a, boost::asio::strand<boost::asio::io_context::executor_type> const & strand_a) :
+io_ctx (io_ctx_a),
+strand (strand_a)
 {
 }
 
 nano::error nano::ipc::ipc_client::connect (std::string const & path_a)
 {
-	impl = std::make_unique<client_impl> (io_ctx);
+	impl = std::make_unique<client_impl> (io_ctx, strand);
 	return boost::polymorphic_downcast<client_impl *> (impl.get ())->connect (path_a);
 }
 
 void nano::ipc::ipc_client::async_connect (std::string const & host_a, uint16_t port_a, std::function<void(nano::error)> callback_a)
 {
-	impl = std::make_unique<client_impl> (io_ctx);
+	impl = std::make_unique<client_impl> (io_ctx, strand);
 	auto client (boost::polymorphic_downcast<client_impl *> (impl.get ()));
 	client->connect (host_a, port_a, callback_a);
 }
@@ -194,16 +216,31 @@ void nano::ipc::ipc_client::async_read (std::shared_ptr<std::vector<uint8_t>> bu
 	});
 }
 
-std::shared_ptr<std::vector<uint8_t>> nano::ipc::prepare_request (nano::ipc::payload_encoding encoding_a, std::string const & payload_a)
+void nano::ipc::ipc_client::close ()
+{
+	if (impl)
+	{
+		boost::polymorphic_downcast<client_impl *> (impl.get ())->close ();
+	}
+}
+
+std::shared_ptr<std::vector<uint8_t>> nano::ipc::prepare_request (nano::ipc::payload_encoding encoding_a, std::string const & payload_a, uint32_t request_id_a)
 {
 	auto buffer_l (std::make_shared<std::vector<uint8_t>> ());
-	if (encoding_a == nano::ipc::payload_encoding::json_legacy)
+	if (encoding_a >= nano::ipc::payload_encoding::json_legacy && encoding_a <= nano::ipc::payload_encoding::binary)
 	{
 		buffer_l->push_back ('N');
 		buffer_l->push_back (static_cast<uint8_t> (encoding_a));
 		buffer_l->push_back (0);
 		buffer_l->push_back (0);
 
+		if (encoding_a == nano::ipc::payload_encoding::json_multiplexed || encoding_a == nano::ipc::payload_encoding::json_multiplexed_unsafe)
+		{
+			uint32_t id_be = boost::endian::native_to_big (request_id_a);
+			char * id_chars = reinterpret_cast<char *> (&id_be);
+			buffer_l->insert (buffer_l->end (), id_chars, id_chars + sizeof (uint32_t));
+		}
+
 		auto payload_length = static_cast<uint32_t> (payload_a.size ());
 		uint32_t be = boost::endian::native_to_big (payload_length);
 		char * chars = reinterpret_cast<char *> (&be);
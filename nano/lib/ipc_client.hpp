@@ -25,6 +25,8 @@ namespace ipc
 	{
 	public:
 		ipc_client (boost::asio::io_context & io_ctx_a);
+		/** Client whose completion handlers and timers run on \p strand_a, operations must be started on it too */
+		ipc_client (boost::asio::io_context & io_ctx_a, boost::asio::strand<boost::asio::io_context::executor_type> const & strand_a);
 		ipc_client (ipc_client && ipc_client) = default;
 		virtual ~ipc_client () = default;
 
@@ -43,8 +45,12 @@ namespace ipc
 		/** Read \p size_a bytes asynchronously */
 		void async_read (std::shared_ptr<std::vector<uint8_t>> buffer_a, size_t size_a, std::function<void(nano::error, size_t)> callback_a);
 
+		/** Closes the socket, outstanding operations complete with an error */
+		void close ();
+
 	private:
 		boost::asio::io_context & io_ctx;
+		boost::asio::strand<boost::asio::io_context::executor_type> strand;
 
 		// PIMPL pattern to hide implementation details
 		std::unique_ptr<ipc_client_impl> impl;
@@ -55,8 +61,8 @@ namespace ipc
 
 	/**
   	 * Returns a buffer with an IPC preamble for the given \p encoding_a followed by the payload. Depending on encoding,
-	 * the buffer may contain a payload length or end sentinel.
+	 * the buffer may contain a payload length or end sentinel. \p request_id_a is only sent by the multiplexed encodings.
 	 */
-	std::shared_ptr<std::vector<uint8_t>> prepare_request (nano::ipc::payload_encoding encoding_a, std::string const & payload_a);
+	std::shared_ptr<std::vector<uint8_t>> prepare_request (nano::ipc::payload_encoding encoding_a, std::string const & payload_a, uint32_t request_id_a = 0);
 }
 }
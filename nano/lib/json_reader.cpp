@@ -0,0 +1,366 @@
+#include <nano/lib/json_reader.hpp>
+
+#include <boost/property_tree/json_parser/error.hpp>
+
+#include <cstring>
+
+nano::json_reader::json_reader (std::string const & text_a) :
+cur (text_a.data ()),
+end (text_a.data () + text_a.size ()),
+line (1)
+{
+}
+
+void nano::json_reader::read (boost::property_tree::ptree & tree_a)
+{
+	// Skip a UTF-8 byte order mark, a partial one is left for value () to reject
+	if (end - cur >= 3 && std::memcmp (cur, "\xef\xbb\xbf", 3) == 0)
+	{
+		cur += 3;
+	}
+	boost::property_tree::ptree result;
+	value (result);
+	skip_ws ();
+	if (cur != end)
+	{
+		error ("garbage after data");
+	}
+	tree_a.swap (result);
+}
+
+void nano::json_reader::value (boost::property_tree::ptree & tree_a)
+{
+	skip_ws ();
+	if (cur == end)
+	{
+		error ("expected value");
+	}
+	switch (*cur)
+	{
+		case '{':
+			++cur;
+			object (tree_a);
+			break;
+		case '[':
+			++cur;
+			array (tree_a);
+			break;
+		case '"':
+			++cur;
+			string (tree_a.data ());
+			break;
+		case 't':
+			literal ("true", tree_a);
+			break;
+		case 'f':
+			literal ("false", tree_a);
+			break;
+		case 'n':
+			literal ("null", tree_a);
+			break;
+		default:
+			if (*cur == '-' || (*cur >= '0' && *cur <= '9'))
+			{
+				number (tree_a.data ());
+			}
+			else
+			{
+				error ("expected value");
+			}
+			break;
+	}
+}
+
+void nano::json_reader::object (boost::property_tree::ptree & tree_a)
+{
+	skip_ws ();
+	if (!have ('}'))
+	{
+		std::string key;
+		do
+		{
+			skip_ws ();
+			if (!have ('"'))
+			{
+				error ("expected key string");
+			}
+			key.clear ();
+			string (key);
+			skip_ws ();
+			expect (':', "expected ':'");
+			tree_a.push_back (std::make_pair (key, boost::property_tree::ptree ()));
+			value (tree_a.back ().second);
+			skip_ws ();
+		} while (have (','));
+		expect ('}', "expected '}' or ','");
+	}
+}
+
+void nano::json_reader::array (boost::property_tree::ptree & tree_a)
+{
+	skip_ws ();
+	if (!have (']'))
+	{
+		do
+		{
+			tree_a.push_back (std::make_pair (std::string (), boost::property_tree::ptree ()));
+			value (tree_a.back ().second);
+			skip_ws ();
+		} while (have (','));
+		expect (']', "expected ']' or ','");
+	}
+}
+
+/** Reads the remainder of a string whose opening quote has been consumed, checking UTF-8 sequences the way read_json does */
+void nano::json_reader::string (std::string & out_a)
+{
+	auto run (cur);
+	while (true)
+	{
+		if (cur == end)
+		{
+			error ("unterminated string");
+		}
+		auto c (static_cast<unsigned char> (*cur));
+		if (c == '"')
+		{
+			out_a.append (run, cur);
+			++cur;
+			break;
+		}
+		else if (c == '\\')
+		{
+			out_a.append (run, cur);
+			++cur;
+			escape (out_a);
+			run = cur;
+		}
+		else if (c < 0x80)
+		{
+			if (c < 0x20)
+			{
+				error ("invalid code sequence");
+			}
+			++cur;
+		}
+		else
+		{
+			// Lead bytes 0xc0 - 0xf7 are followed by 1 - 3 continuation bytes, anything else is rejected
+			int trailing (c >= 0xf8 ? -1 : c >= 0xf0 ? 3 : c >= 0xe0 ? 2 : c >= 0xc0 ? 1 : -1);
+			if (trailing == -1)
+			{
+				error ("invalid code sequence");
+			}
+			++cur;
+			for (auto i (0); i < trailing; ++i)
+			{
+				if (cur == end || (static_cast<unsigned char> (*cur) & 0xc0) != 0x80)
+				{
+					error ("invalid code sequence");
+				}
+				++cur;
+			}
+		}
+	}
+}
+
+void nano::json_reader::number (std::string & out_a)
+{
+	auto begin (cur);
+	have ('-');
+	if (!have ('0'))
+	{
+		if (cur == end || *cur < '1' || *cur > '9')
+		{
+			error ("expected digits after -");
+		}
+		while (cur != end && *cur >= '0' && *cur <= '9')
+		{
+			++cur;
+		}
+	}
+	if (have ('.'))
+	{
+		if (cur == end || *cur < '0' || *cur > '9')
+		{
+			error ("need at least one digit after '.'");
+		}
+		while (cur != end && *cur >= '0' && *cur <= '9')
+		{
+			++cur;
+		}
+	}
+	if (have ('e') || have ('E'))
+	{
+		if (!have ('+'))
+		{
+			have ('-');
+		}
+		if (cur == end || *cur < '0' || *cur > '9')
+		{
+			error ("need at least one digit in exponent");
+		}
+		while (cur != end && *cur >= '0' && *cur <= '9')
+		{
+			++cur;
+		}
+	}
+	out_a.assign (begin, cur);
+}
+
+void nano::json_reader::literal (char const * text_a, boost::property_tree::ptree & tree_a)
+{
+	auto size (std::strlen (text_a));
+	if (static_cast<size_t> (end - cur) < size || std::memcmp (cur, text_a, size) != 0)
+	{
+		error ("expected literal");
+	}
+	cur += size;
+	tree_a.data () = text_a;
+}
+
+void nano::json_reader::escape (std::string & out_a)
+{
+	if (cur == end)
+	{
+		error ("invalid escape sequence");
+	}
+	switch (*cur++)
+	{
+		case '"':
+			out_a.push_back ('"');
+			break;
+		case '\\':
+			out_a.push_back ('\\');
+			break;
+		case '/':
+			out_a.push_back ('/');
+			break;
+		case 'b':
+			out_a.push_back ('\b');
+			break;
+		case 'f':
+			out_a.push_back ('\f');
+			break;
+		case 'n':
+			out_a.push_back ('\n');
+			break;
+		case 'r':
+			out_a.push_back ('\r');
+			break;
+		case 't':
+			out_a.push_back ('\t');
+			break;
+		case 'u':
+		{
+			auto codepoint (hex_quad ());
+			if ((codepoint & 0xfc00) == 0xdc00)
+			{
+				error ("invalid codepoint, stray low surrogate");
+			}
+			if ((codepoint & 0xfc00) == 0xd800)
+			{
+				expect ('\\', "invalid codepoint, stray high surrogate");
+				expect ('u', "expected codepoint reference after high surrogate");
+				auto low (hex_quad ());
+				if ((low & 0xfc00) != 0xdc00)
+				{
+					error ("expected low surrogate after high surrogate");
+				}
+				codepoint = 0x10000 + (((codepoint & 0x3ff) << 10) | (low & 0x3ff));
+			}
+			if (codepoint <= 0x7f)
+			{
+				out_a.push_back (static_cast<char> (codepoint));
+			}
+			else if (codepoint <= 0x7ff)
+			{
+				out_a.push_back (static_cast<char> (0xc0 | (codepoint >> 6)));
+				out_a.push_back (static_cast<char> (0x80 | (codepoint & 0x3f)));
+			}
+			else if (codepoint <= 0xffff)
+			{
+				out_a.push_back (static_cast<char> (0xe0 | (codepoint >> 12)));
+				out_a.push_back (static_cast<char> (0x80 | ((codepoint >> 6) & 0x3f)));
+				out_a.push_back (static_cast<char> (0x80 | (codepoint & 0x3f)));
+			}
+			else
+			{
+				out_a.push_back (static_cast<char> (0xf0 | (codepoint >> 18)));
+				out_a.push_back (static_cast<char> (0x80 | ((codepoint >> 12) & 0x3f)));
+				out_a.push_back (static_cast<char> (0x80 | ((codepoint >> 6) & 0x3f)));
+				out_a.push_back (static_cast<char> (0x80 | (codepoint & 0x3f)));
+			}
+			break;
+		}
+		default:
+			error ("invalid escape sequence");
+	}
+}
+
+unsigned nano::json_reader::hex_quad ()
+{
+	unsigned result (0);
+	for (auto i (0); i < 4; ++i)
+	{
+		if (cur == end)
+		{
+			error ("invalid escape sequence");
+		}
+		auto c (*cur++);
+		unsigned digit;
+		if (c >= '0' && c <= '9')
+		{
+			digit = c - '0';
+		}
+		else if (c >= 'A' && c <= 'F')
+		{
+			digit = c - 'A' + 10;
+		}
+		else if (c >= 'a' && c <= 'f')
+		{
+			digit = c - 'a' + 10;
+		}
+		else
+		{
+			error ("invalid escape sequence");
+		}
+		result = result * 16 + digit;
+	}
+	return result;
+}
+
+void nano::json_reader::skip_ws ()
+{
+	while (cur != end && (*cur == ' ' || *cur == '\t' || *cur == '\n' || *cur == '\r'))
+	{
+		if (*cur == '\n')
+		{
+			++line;
+		}
+		++cur;
+	}
+}
+
+bool nano::json_reader::have (char c_a)
+{
+	auto result (cur != end && *cur == c_a);
+	if (result)
+	{
+		++cur;
+	}
+	return result;
+}
+
+void nano::json_reader::expect (char c_a, char const * message_a)
+{
+	if (!have (c_a))
+	{
+		error (message_a);
+	}
+}
+
+void nano::json_reader::error (char const * message_a)
+{
+	throw boost::property_tree::json_parser::json_parser_error (message_a, "", line);
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <boost/property_tree/ptree.hpp>
+
+#include <string>
+
+namespace nano
+{
+/**
+ * JSON parser producing the same tree and accepting the same input as boost::property_tree::read_json.
+ * The text is scanned in place instead of through a stream, runs of unescaped characters are copied into the tree in one piece.
+ */
+class json_reader final
+{
+public:
+	json_reader (std::string const &);
+	/** Throws boost::property_tree::json_parser_error if the text is not valid JSON */
+	void read (boost::property_tree::ptree &);
+
+private:
+	void value (boost::property_tree::ptree &);
+	void object (boost::property_tree::ptree &);
+	void array (boost::property_tree::ptree &);
+	void string (std::string &);
+	void number (std::string &);
+	void literal (char const *, boost::property_tree::ptree &);
+	void escape (std::string &);
+	unsigned hex_quad ();
+	void skip_ws ();
+	bool have (char);
+	void expect (char, char const *);
+	[[noreturn]] void error (char const *);
+	char const * cur;
+	char const * end;
+	int line;
+};
+}
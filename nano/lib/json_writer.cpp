@@ -0,0 +1,231 @@
+#include <nano/lib/json_writer.hpp>
+
+#include <cassert>
+
+nano::json_writer::json_writer (std::function<void(std::string const &, bool)> const & sink_a, size_t chunk_size_a) :
+chunk_size (chunk_size_a),
+sink (sink_a)
+{
+	buffer.reserve (chunk_size);
+}
+
+void nano::json_writer::begin_object ()
+{
+	if (frames.empty ())
+	{
+		frames.push_back ({ "", false, true, 0 });
+		buffer.push_back ('{');
+	}
+	else
+	{
+		assert (frames.back ().array);
+		frames.push_back ({ "", false, false, 0 });
+	}
+}
+
+void nano::json_writer::begin_object (std::string const & key_a)
+{
+	assert (!frames.empty () && !frames.back ().array);
+	frames.push_back ({ key_a, false, false, 0 });
+}
+
+void nano::json_writer::begin_array (std::string const & key_a)
+{
+	assert (!frames.empty () && !frames.back ().array);
+	frames.push_back ({ key_a, true, false, 0 });
+}
+
+void nano::json_writer::end ()
+{
+	// The root object is closed by finish
+	assert (frames.size () > 1);
+	if (frames.back ().opened)
+	{
+		buffer.push_back ('\n');
+		indent (frames.size () - 1);
+		buffer.push_back (frames.back ().array ? ']' : '}');
+		frames.pop_back ();
+	}
+	else
+	{
+		// Nothing was written into it, ptree renders this as an empty value
+		auto key (std::move (frames.back ().key));
+		frames.pop_back ();
+		member (frames.size () - 1, key);
+		buffer.append ("\"\"");
+	}
+	flush ();
+}
+
+void nano::json_writer::put (std::string const & key_a, std::string const & value_a)
+{
+	assert (!frames.back ().array);
+	member (frames.size () - 1, key_a);
+	buffer.push_back ('"');
+	escape (value_a);
+	buffer.push_back ('"');
+	flush ();
+}
+
+void nano::json_writer::push_back (std::string const & value_a)
+{
+	assert (frames.back ().array);
+	member (frames.size () - 1, "");
+	buffer.push_back ('"');
+	escape (value_a);
+	buffer.push_back ('"');
+	flush ();
+}
+
+void nano::json_writer::put_child (std::string const & key_a, boost::property_tree::ptree const & tree_a)
+{
+	assert (!frames.back ().array);
+	member (frames.size () - 1, key_a);
+	tree (tree_a, frames.size ());
+	flush ();
+}
+
+void nano::json_writer::push_back_child (boost::property_tree::ptree const & tree_a)
+{
+	assert (frames.back ().array);
+	member (frames.size () - 1, "");
+	tree (tree_a, frames.size ());
+	flush ();
+}
+
+void nano::json_writer::finish ()
+{
+	assert (frames.size () == 1);
+	buffer.append ("\n}\n");
+	frames.clear ();
+	sink (buffer, true);
+	buffer.clear ();
+}
+
+/** Starts a member of frame \p index_a, first opening the frames which were deferred until they had a member */
+void nano::json_writer::member (size_t index_a, std::string const & key_a)
+{
+	open (index_a);
+	auto & frame (frames[index_a]);
+	if (frame.members++ > 0)
+	{
+		buffer.push_back (',');
+	}
+	buffer.push_back ('\n');
+	indent (index_a + 1);
+	if (!frame.array)
+	{
+		buffer.push_back ('"');
+		escape (key_a);
+		buffer.append ("\": ");
+	}
+}
+
+void nano::json_writer::open (size_t index_a)
+{
+	if (!frames[index_a].opened)
+	{
+		assert (index_a > 0);
+		member (index_a - 1, frames[index_a].key);
+		buffer.push_back (frames[index_a].array ? '[' : '{');
+		frames[index_a].opened = true;
+	}
+}
+
+void nano::json_writer::indent (size_t level_a)
+{
+	buffer.append (4 * level_a, ' ');
+}
+
+void nano::json_writer::escape (std::string const & text_a)
+{
+	// Same rules as write_json, everything from 0x20 upwards is verbatim apart from quote, solidus and backslash
+	static char const * hex_digits ("0123456789ABCDEF");
+	for (auto i : text_a)
+	{
+		auto c (static_cast<unsigned char> (i));
+		switch (c)
+		{
+			case '\b':
+				buffer.append ("\\b");
+				break;
+			case '\f':
+				buffer.append ("\\f");
+				break;
+			case '\n':
+				buffer.append ("\\n");
+				break;
+			case '\r':
+				buffer.append ("\\r");
+				break;
+			case '\t':
+				buffer.append ("\\t");
+				break;
+			case '/':
+				buffer.append ("\\/");
+				break;
+			case '"':
+				buffer.append ("\\\"");
+				break;
+			case '\\':
+				buffer.append ("\\\\");
+				break;
+			default:
+				if (c >= 0x20)
+				{
+					buffer.push_back (i);
+				}
+				else
+				{
+					buffer.append ("\\u00");
+					buffer.push_back (hex_digits[c >> 4]);
+					buffer.push_back (hex_digits[c & 0xf]);
+				}
+				break;
+		}
+	}
+}
+
+/** Mirrors write_json's layout of a subtree at nesting \p level_a */
+void nano::json_writer::tree (boost::property_tree::ptree const & tree_a, size_t level_a)
+{
+	if (tree_a.empty ())
+	{
+		buffer.push_back ('"');
+		escape (tree_a.data ());
+		buffer.push_back ('"');
+	}
+	else
+	{
+		auto array (tree_a.count ("") == tree_a.size ());
+		buffer.push_back (array ? '[' : '{');
+		for (auto i (tree_a.begin ()), n (tree_a.end ()); i != n; ++i)
+		{
+			if (i != tree_a.begin ())
+			{
+				buffer.push_back (',');
+			}
+			buffer.push_back ('\n');
+			indent (level_a + 1);
+			if (!array)
+			{
+				buffer.push_back ('"');
+				escape (i->first);
+				buffer.append ("\": ");
+			}
+			tree (i->second, level_a + 1);
+		}
+		buffer.push_back ('\n');
+		indent (level_a);
+		buffer.push_back (array ? ']' : '}');
+	}
+}
+
+void nano::json_writer::flush ()
+{
+	if (buffer.size () >= chunk_size)
+	{
+		sink (buffer, false);
+		buffer.clear ();
+	}
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <boost/property_tree/ptree.hpp>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace nano
+{
+/**
+ * Streaming JSON emitter producing the same text as boost::property_tree::write_json, so responses can be
+ * written without first building a ptree. The ptree conventions are kept: every value is a string and an
+ * object or array without members is written as "".
+ * Output is passed to the sink whenever chunk_size bytes are buffered, the final piece is flagged.
+ */
+class json_writer final
+{
+public:
+	json_writer (std::function<void(std::string const &, bool)> const &, size_t = 64 * 1024);
+	/** Opens the root object or an object element of the enclosing array */
+	void begin_object ();
+	/** Opens an object member of the enclosing object */
+	void begin_object (std::string const &);
+	/** Opens an array member of the enclosing object */
+	void begin_array (std::string const &);
+	/** Closes the innermost object or array */
+	void end ();
+	/** Writes a string member of the enclosing object */
+	void put (std::string const &, std::string const &);
+	/** Writes a string element of the enclosing array */
+	void push_back (std::string const &);
+	/** Writes \p tree_a as a member of the enclosing object, laid out as write_json would */
+	void put_child (std::string const &, boost::property_tree::ptree const &);
+	/** Writes \p tree_a as an element of the enclosing array */
+	void push_back_child (boost::property_tree::ptree const &);
+	/** Closes the root object and hands the remaining output to the sink as the final piece */
+	void finish ();
+	size_t const chunk_size;
+
+private:
+	class frame final
+	{
+	public:
+		std::string key;
+		bool array;
+		bool opened;
+		size_t members;
+	};
+	void member (size_t, std::string const &);
+	void open (size_t);
+	void indent (size_t);
+	void escape (std::string const &);
+	void tree (boost::property_tree::ptree const &, size_t);
+	void flush ();
+	std::function<void(std::string const &, bool)> sink;
+	std::vector<frame> frames;
+	std::string buffer;
+};
+}
@@ -11,6 +11,11 @@ namespace nano
 bool get_use_memory_pools ();
 void set_use_memory_pools (bool use_memory_pools);
 
+/** Allocates whole zeroed pages which the platform is asked to keep out of swap, for holding secrets. Returns nullptr if no memory could be mapped */
+void * locked_allocate (size_t size);
+/** Zeroes and unmaps memory returned by locked_allocate of the same size */
+void locked_free (void * memory, size_t size);
+
 /** This makes some heuristic assumptions about the implementation defined shared_ptr internals.
     Should only be used in the memory pool purge functions at exit, which doesn't matter much if
     it is incorrect (other than reports from heap memory analysers) */
@@ -18,46 +18,133 @@ uint8_t base58_decode (char value)
 	return static_cast<uint8_t> (base58_reverse[value - 0x30] - 0x30);
 }
 char const * account_lookup ("13456789abcdefghijkmnopqrstuwxyz");
-char const * account_reverse ("~0~1234567~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~89:;<=>?@AB~CDEFGHIJK~LMNO~~~~~");
-char account_encode (uint8_t value)
+/** Maps characters to their account digit value, 0xff for characters outside the alphabet */
+std::array<uint8_t, 256> const & account_reverse ()
 {
-	assert (value < 32);
-	auto result (account_lookup[value]);
+	static std::array<uint8_t, 256> const result ([]() {
+		std::array<uint8_t, 256> table;
+		table.fill (0xff);
+		for (uint8_t i (0); i < 32; ++i)
+		{
+			table[static_cast<uint8_t> (account_lookup[i])] = i;
+		}
+		return table;
+	}());
 	return result;
 }
-uint8_t account_decode (char value)
+char const * hex_lookup ("0123456789ABCDEF");
+/** Maps characters to their hex digit value, 0xff for non hex characters */
+std::array<uint8_t, 256> const & hex_reverse ()
 {
-	assert (value >= '0');
-	assert (value <= '~');
-	auto result (account_reverse[value - 0x30]);
-	if (result != '~')
+	static std::array<uint8_t, 256> const result ([]() {
+		std::array<uint8_t, 256> table;
+		table.fill (0xff);
+		for (uint8_t i (0); i < 16; ++i)
+		{
+			table['0' + i] = i;
+		}
+		for (uint8_t i (0); i < 6; ++i)
+		{
+			table['a' + i] = 10 + i;
+			table['A' + i] = 10 + i;
+		}
+		return table;
+	}());
+	return result;
+}
+/** Writes size_a big endian bytes as 2 * size_a uppercase hex characters */
+void encode_hex_bytes (uint8_t const * bytes_a, size_t size_a, char * destination_a)
+{
+	for (size_t i (0); i < size_a; ++i)
+	{
+		destination_a[2 * i] = hex_lookup[bytes_a[i] >> 4];
+		destination_a[2 * i + 1] = hex_lookup[bytes_a[i] & 0xf];
+	}
+}
+/**
+ * Decodes up to 2 * size_a hex characters into size_a big endian bytes, shorter input is zero extended.
+ * A leading "0x" is skipped as the stream based parser this replaced accepted it.
+ */
+bool decode_hex_bytes (char const * source_a, size_t length_a, uint8_t * bytes_a, size_t size_a)
+{
+	auto error (length_a > 2 * size_a);
+	if (!error)
 	{
-		result -= 0x30;
+		if (length_a >= 2 && source_a[0] == '0' && source_a[1] == 'x')
+		{
+			source_a += 2;
+			length_a -= 2;
+		}
+		// At least one digit is required, with or without the prefix
+		error = length_a == 0;
+	}
+	if (!error)
+	{
+		auto const & table (hex_reverse ());
+		std::array<uint8_t, 64> result;
+		assert (size_a <= result.size ());
+		std::fill (result.begin (), result.begin () + size_a, 0);
+		// Digits fill the value from its least significant end
+		for (size_t i (0); !error && i < length_a; ++i)
+		{
+			auto value (table[static_cast<uint8_t> (source_a[length_a - 1 - i])]);
+			error = value == 0xff;
+			result[size_a - 1 - i / 2] |= (i % 2 == 0) ? value : value << 4;
+		}
+		if (!error)
+		{
+			std::copy (result.begin (), result.begin () + size_a, bytes_a);
+		}
 	}
+	return error;
+}
+uint64_t account_checksum (nano::uint256_union const & account_a)
+{
+	uint64_t result (0);
+	blake2b_state hash;
+	blake2b_init (&hash, 5);
+	blake2b_update (&hash, account_a.bytes.data (), account_a.bytes.size ());
+	blake2b_final (&hash, reinterpret_cast<uint8_t *> (&result), 5);
 	return result;
 }
 }
 
+constexpr size_t nano::uint256_union::account_encoded_size;
+
 void nano::uint256_union::encode_account (std::string & destination_a) const
 {
 	assert (destination_a.empty ());
-	destination_a.reserve (65);
-	uint64_t check (0);
-	blake2b_state hash;
-	blake2b_init (&hash, 5);
-	blake2b_update (&hash, bytes.data (), bytes.size ());
-	blake2b_final (&hash, reinterpret_cast<uint8_t *> (&check), 5);
-	nano::uint512_t number_l (number ());
-	number_l <<= 40;
-	number_l |= nano::uint512_t (check);
-	for (auto i (0); i < 60; ++i)
+	destination_a.resize (account_encoded_size);
+	encode_account (&destination_a[0]);
+}
+
+void nano::uint256_union::encode_account (char * destination_a) const
+{
+	// The 256 bit key followed by its 40 bit checksum, right aligned in 320 bits so each 40 bit group encodes to 8 characters
+	std::array<uint8_t, 40> buffer;
+	std::fill (buffer.begin (), buffer.begin () + 3, 0);
+	std::copy (bytes.begin (), bytes.end (), buffer.begin () + 3);
+	auto check (account_checksum (*this));
+	for (auto i (0); i < 5; ++i)
+	{
+		buffer[35 + i] = static_cast<uint8_t> (check >> (8 * (4 - i)));
+	}
+	std::array<char, 64> digits;
+	for (auto group (0); group < 8; ++group)
 	{
-		uint8_t r (number_l & static_cast<uint8_t> (0x1f));
-		number_l >>= 5;
-		destination_a.push_back (account_encode (r));
+		uint64_t value (0);
+		for (auto i (0); i < 5; ++i)
+		{
+			value = (value << 8) | buffer[group * 5 + i];
+		}
+		for (auto i (0); i < 8; ++i)
+		{
+			digits[group * 8 + i] = account_lookup[(value >> (35 - 5 * i)) & 0x1f];
+		}
 	}
-	destination_a.append ("_onan"); // nano_
-	std::reverse (destination_a.begin (), destination_a.end ());
+	std::copy_n ("nano_", 5, destination_a);
+	// The first 4 digits only cover padding
+	std::copy (digits.begin () + 4, digits.end (), destination_a + 5);
 }
 
 std::string nano::uint256_union::to_account () const
@@ -69,45 +156,51 @@ std::string nano::uint256_union::to_account () const
 
 bool nano::uint256_union::decode_account (std::string const & source_a)
 {
-	auto error (source_a.size () < 5);
+	return decode_account (source_a.data (), source_a.size ());
+}
+
+bool nano::uint256_union::decode_account (char const * source_a, size_t size_a)
+{
+	auto error (size_a < 5);
 	if (!error)
 	{
 		auto xrb_prefix (source_a[0] == 'x' && source_a[1] == 'r' && source_a[2] == 'b' && (source_a[3] == '_' || source_a[3] == '-'));
 		auto nano_prefix (source_a[0] == 'n' && source_a[1] == 'a' && source_a[2] == 'n' && source_a[3] == 'o' && (source_a[4] == '_' || source_a[4] == '-'));
-		error = (xrb_prefix && source_a.size () != 64) || (nano_prefix && source_a.size () != 65);
+		error = (xrb_prefix && size_a != 64) || (nano_prefix && size_a != 65);
 		if (!error)
 		{
 			if (xrb_prefix || nano_prefix)
 			{
-				auto i (source_a.begin () + (xrb_prefix ? 4 : 5));
-				if (*i == '1' || *i == '3')
+				auto digits (source_a + (xrb_prefix ? 4 : 5));
+				if (digits[0] == '1' || digits[0] == '3')
 				{
-					nano::uint512_t number_l;
-					for (auto j (source_a.end ()); !error && i != j; ++i)
+					auto const & table (account_reverse ());
+					std::array<uint8_t, 40> buffer;
+					for (auto group (0); !error && group < 8; ++group)
 					{
-						uint8_t character (*i);
-						error = character < 0x30 || character >= 0x80;
-						if (!error)
+						uint64_t value (0);
+						for (auto i (0); i < 8; ++i)
 						{
-							uint8_t byte (account_decode (character));
-							error = byte == '~';
-							if (!error)
-							{
-								number_l <<= 5;
-								number_l += byte;
-							}
+							// Four zero digits of padding precede the 60 encoded ones
+							auto index (group * 8 + i - 4);
+							uint8_t digit (index < 0 ? 0 : table[static_cast<uint8_t> (digits[index])]);
+							error |= digit == 0xff;
+							value = (value << 5) | (digit & 0x1f);
+						}
+						for (auto i (0); i < 5; ++i)
+						{
+							buffer[group * 5 + i] = static_cast<uint8_t> (value >> (8 * (4 - i)));
 						}
 					}
 					if (!error)
 					{
-						*this = (number_l >> 40).convert_to<nano::uint256_t> ();
-						uint64_t check (number_l & static_cast<uint64_t> (0xffffffffff));
-						uint64_t validation (0);
-						blake2b_state hash;
-						blake2b_init (&hash, 5);
-						blake2b_update (&hash, bytes.data (), bytes.size ());
-						blake2b_final (&hash, reinterpret_cast<uint8_t *> (&validation), 5);
-						error = check != validation;
+						std::copy (buffer.begin () + 3, buffer.begin () + 35, bytes.begin ());
+						uint64_t check (0);
+						for (auto i (0); i < 5; ++i)
+						{
+							check = (check << 8) | buffer[35 + i];
+						}
+						error = check != account_checksum (*this);
 					}
 				}
 				else
@@ -203,39 +296,23 @@ nano::uint256_t nano::uint256_union::number () const
 void nano::uint256_union::encode_hex (std::string & text) const
 {
 	assert (text.empty ());
-	std::stringstream stream;
-	stream << std::hex << std::noshowbase << std::setw (64) << std::setfill ('0');
-	stream << number ();
-	text = stream.str ();
+	text.resize (2 * bytes.size ());
+	encode_hex (&text[0]);
+}
+
+void nano::uint256_union::encode_hex (char * destination_a) const
+{
+	encode_hex_bytes (bytes.data (), bytes.size (), destination_a);
 }
 
 bool nano::uint256_union::decode_hex (std::string const & text)
 {
-	auto error (false);
-	if (!text.empty () && text.size () <= 64)
-	{
-		std::stringstream stream (text);
-		stream << std::hex << std::noshowbase;
-		nano::uint256_t number_l;
-		try
-		{
-			stream >> number_l;
-			*this = number_l;
-			if (!stream.eof ())
-			{
-				error = true;
-			}
-		}
-		catch (std::runtime_error &)
-		{
-			error = true;
-		}
-	}
-	else
-	{
-		error = true;
-	}
-	return error;
+	return decode_hex (text.data (), text.size ());
+}
+
+bool nano::uint256_union::decode_hex (char const * source_a, size_t size_a)
+{
+	return decode_hex_bytes (source_a, size_a, bytes.data (), bytes.size ());
 }
 
 void nano::uint256_union::encode_dec (std::string & text) const
@@ -320,35 +397,13 @@ nano::uint512_t nano::uint512_union::number () const
 void nano::uint512_union::encode_hex (std::string & text) const
 {
 	assert (text.empty ());
-	std::stringstream stream;
-	stream << std::hex << std::noshowbase << std::setw (128) << std::setfill ('0');
-	stream << number ();
-	text = stream.str ();
+	text.resize (2 * bytes.size ());
+	encode_hex_bytes (bytes.data (), bytes.size (), &text[0]);
 }
 
 bool nano::uint512_union::decode_hex (std::string const & text)
 {
-	auto error (text.size () > 128);
-	if (!error)
-	{
-		std::stringstream stream (text);
-		stream << std::hex << std::noshowbase;
-		nano::uint512_t number_l;
-		try
-		{
-			stream >> number_l;
-			*this = number_l;
-			if (!stream.eof ())
-			{
-				error = true;
-			}
-		}
-		catch (std::runtime_error &)
-		{
-			error = true;
-		}
-	}
-	return error;
+	return decode_hex_bytes (text.data (), text.size (), bytes.data (), bytes.size ());
 }
 
 bool nano::uint512_union::operator!= (nano::uint512_union const & other_a) const
@@ -477,35 +532,13 @@ nano::uint128_t nano::uint128_union::number () const
 void nano::uint128_union::encode_hex (std::string & text) const
 {
 	assert (text.empty ());
-	std::stringstream stream;
-	stream << std::hex << std::noshowbase << std::setw (32) << std::setfill ('0');
-	stream << number ();
-	text = stream.str ();
+	text.resize (2 * bytes.size ());
+	encode_hex_bytes (bytes.data (), bytes.size (), &text[0]);
 }
 
 bool nano::uint128_union::decode_hex (std::string const & text)
 {
-	auto error (text.size () > 32);
-	if (!error)
-	{
-		std::stringstream stream (text);
-		stream << std::hex << std::noshowbase;
-		nano::uint128_t number_l;
-		try
-		{
-			stream >> number_l;
-			*this = number_l;
-			if (!stream.eof ())
-			{
-				error = true;
-			}
-		}
-		catch (std::runtime_error &)
-		{
-			error = true;
-		}
-	}
-	return error;
+	return decode_hex_bytes (text.data (), text.size (), bytes.data (), bytes.size ());
 }
 
 void nano::uint128_union::encode_dec (std::string & text) const
@@ -68,12 +68,20 @@ union uint256_union final
 	bool operator!= (nano::uint256_union const &) const;
 	bool operator< (nano::uint256_union const &) const;
 	void encode_hex (std::string &) const;
+	/** Writes 64 hex characters without a terminator */
+	void encode_hex (char *) const;
 	bool decode_hex (std::string const &);
+	bool decode_hex (char const *, size_t);
 	void encode_dec (std::string &) const;
 	bool decode_dec (std::string const &);
 	void encode_account (std::string &) const;
+	/** Writes account_encoded_size characters without a terminator */
+	void encode_account (char *) const;
 	std::string to_account () const;
 	bool decode_account (std::string const &);
+	bool decode_account (char const *, size_t);
+	/** Length of the "nano_" prefixed account encoding */
+	static size_t constexpr account_encoded_size = 65;
 	std::array<uint8_t, 32> bytes;
 	std::array<char, 32> chars;
 	std::array<uint32_t, 8> dwords;
@@ -0,0 +1,129 @@
+#include <nano/lib/perfect_hash.hpp>
+#include <nano/lib/utility.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_set>
+
+size_t constexpr nano::perfect_hash::not_found;
+
+namespace
+{
+size_t power_of_two_at_least (size_t value_a)
+{
+	size_t result (1);
+	while (result < value_a)
+	{
+		result <<= 1;
+	}
+	return result;
+}
+}
+
+nano::perfect_hash::perfect_hash (std::vector<std::string> const & keys_a) :
+keys (keys_a),
+// Averaging two keys per bucket in a table at most half full keeps the displacement search short
+displacements (power_of_two_at_least (keys_a.size () / 2), 0),
+slots (power_of_two_at_least (keys_a.size () * 2), not_found)
+{
+	release_assert (std::unordered_set<std::string> (keys.begin (), keys.end ()).size () == keys.size ());
+	std::vector<std::vector<size_t>> buckets (displacements.size ());
+	for (size_t i (0), n (keys.size ()); i < n; ++i)
+	{
+		buckets[bucket (hash (keys[i]))].push_back (i);
+	}
+	std::vector<size_t> order (buckets.size ());
+	for (size_t i (0), n (order.size ()); i < n; ++i)
+	{
+		order[i] = i;
+	}
+	// Place the most crowded buckets first, while the table still has room
+	std::stable_sort (order.begin (), order.end (), [&buckets](size_t const & lhs, size_t const & rhs) {
+		return buckets[lhs].size () > buckets[rhs].size ();
+	});
+	std::vector<size_t> candidate;
+	for (auto index : order)
+	{
+		auto const & members (buckets[index]);
+		auto placed (members.empty ());
+		for (uint32_t displacement (0); !placed; ++displacement)
+		{
+			release_assert (displacement < std::numeric_limits<uint32_t>::max ());
+			candidate.clear ();
+			placed = true;
+			for (auto member : members)
+			{
+				auto slot_l (slot (hash (keys[member]), displacement));
+				if (slots[slot_l] != not_found || std::find (candidate.begin (), candidate.end (), slot_l) != candidate.end ())
+				{
+					placed = false;
+					break;
+				}
+				candidate.push_back (slot_l);
+			}
+			if (placed)
+			{
+				displacements[index] = displacement;
+				for (size_t i (0), n (members.size ()); i < n; ++i)
+				{
+					slots[candidate[i]] = members[i];
+				}
+			}
+		}
+	}
+}
+
+size_t nano::perfect_hash::find (std::string const & key_a) const
+{
+	auto hash_l (hash (key_a));
+	auto result (slots[slot (hash_l, displacements[bucket (hash_l)])]);
+	if (result != not_found && keys[result] != key_a)
+	{
+		result = not_found;
+	}
+	return result;
+}
+
+size_t nano::perfect_hash::size () const
+{
+	return keys.size ();
+}
+
+/** Consumes the key eight bytes at a time, finishing with the splitmix64 finalizer so the high and low bits are both usable */
+uint64_t nano::perfect_hash::hash (std::string const & key_a)
+{
+	auto data (key_a.data ());
+	auto remaining (key_a.size ());
+	uint64_t result (0xcbf29ce484222325ULL ^ remaining);
+	while (remaining >= sizeof (uint64_t))
+	{
+		uint64_t word;
+		std::memcpy (&word, data, sizeof (word));
+		result = (result ^ word) * 0x100000001b3ULL;
+		result ^= result >> 29;
+		data += sizeof (word);
+		remaining -= sizeof (word);
+	}
+	uint64_t tail (0);
+	for (size_t i (0); i < remaining; ++i)
+	{
+		tail |= static_cast<uint64_t> (static_cast<unsigned char> (data[i])) << (8 * i);
+	}
+	result = (result ^ tail) * 0xbf58476d1ce4e5b9ULL;
+	result ^= result >> 31;
+	result *= 0x94d049bb133111ebULL;
+	result ^= result >> 29;
+	return result;
+}
+
+size_t nano::perfect_hash::bucket (uint64_t hash_a) const
+{
+	return (hash_a >> 32) & (displacements.size () - 1);
+}
+
+/** Each displacement scrambles the hash differently, giving the keys of a bucket a fresh set of slots to try */
+size_t nano::perfect_hash::slot (uint64_t hash_a, uint32_t displacement_a) const
+{
+	auto result ((hash_a ^ (displacement_a * 0x9e3779b97f4a7c15ULL)) * 0xd6e8feb86659fd93ULL);
+	return (result >> 32) & (slots.size () - 1);
+}
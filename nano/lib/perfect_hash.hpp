@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace nano
+{
+/**
+ * Perfect hash over a fixed set of strings, for dispatching on names known at startup.
+ * Keys are hashed once, the high bits select a bucket whose displacement was chosen on construction so that
+ * no two keys share a slot. A lookup therefore costs one hash and at most one string comparison.
+ */
+class perfect_hash final
+{
+public:
+	perfect_hash (std::vector<std::string> const &);
+	/** Returns the position of \p key_a in the vector passed on construction or not_found */
+	size_t find (std::string const &) const;
+	size_t size () const;
+	static size_t constexpr not_found = std::numeric_limits<size_t>::max ();
+
+private:
+	static uint64_t hash (std::string const &);
+	size_t bucket (uint64_t) const;
+	size_t slot (uint64_t, uint32_t) const;
+	std::vector<std::string> keys;
+	std::vector<uint32_t> displacements;
+	std::vector<size_t> slots;
+};
+}
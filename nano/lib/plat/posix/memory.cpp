@@ -0,0 +1,36 @@
+#include <nano/lib/memory.hpp>
+
+#include <sys/mman.h>
+
+void * nano::locked_allocate (size_t size)
+{
+	auto result (mmap (nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+	if (result != MAP_FAILED)
+	{
+		// Locking fails when RLIMIT_MEMLOCK is exhausted, the memory is still usable and is zeroed when freed
+		mlock (result, size);
+#ifdef MADV_DONTDUMP
+		madvise (result, size, MADV_DONTDUMP);
+#endif
+	}
+	else
+	{
+		result = nullptr;
+	}
+	return result;
+}
+
+void nano::locked_free (void * memory, size_t size)
+{
+	if (memory != nullptr)
+	{
+		// Writes through a volatile pointer are not elided as dead stores
+		auto bytes (static_cast<volatile uint8_t *> (memory));
+		for (size_t i (0); i < size; ++i)
+		{
+			bytes[i] = 0;
+		}
+		munlock (memory, size);
+		munmap (memory, size);
+	}
+}
@@ -0,0 +1,24 @@
+#include <nano/lib/memory.hpp>
+
+#include <windows.h>
+
+void * nano::locked_allocate (size_t size)
+{
+	auto result (VirtualAlloc (nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+	if (result != nullptr)
+	{
+		// Locking fails when the working set quota is exhausted, the memory is still usable and is zeroed when freed
+		VirtualLock (result, size);
+	}
+	return result;
+}
+
+void nano::locked_free (void * memory, size_t size)
+{
+	if (memory != nullptr)
+	{
+		SecureZeroMemory (memory, size);
+		VirtualUnlock (memory, size);
+		VirtualFree (memory, 0, MEM_RELEASE);
+	}
+}
@@ -7,11 +7,18 @@ namespace nano
 {
 class rpc;
 
+/**
+ * Receives a response in one or more pieces, the last one is flagged. After any other piece the producer waits until the
+ * resume function is called, with true once the consumer can take the next piece or false if it no longer wants it.
+ */
+using rpc_response_chunk = std::function<void(std::string const &, bool, std::function<void(bool)> const &)>;
+
 class rpc_handler_interface
 {
 public:
 	virtual ~rpc_handler_interface () = default;
-	virtual void process_request (std::string const & action, std::string const & body, std::function<void(std::string const &)> response) = 0;
+	/** The response body is passed to \p response in one or more pieces, the last one is flagged */
+	virtual void process_request (std::string const & action, std::string const & body, nano::rpc_response_chunk response) = 0;
 	virtual void stop () = 0;
 	virtual void rpc_instance (nano::rpc & rpc) = 0;
 };
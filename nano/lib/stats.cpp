@@ -385,6 +385,15 @@ std::string nano::stat::type_to_string (uint32_t key)
 			break;
 		case nano::stat::type::drop:
 			res = "drop";
+			break;
+		case nano::stat::type::work_cache:
+			res = "work_cache";
+			break;
+		case nano::stat::type::websocket:
+			res = "websocket";
+			break;
+		case nano::stat::type::rpc_cache:
+			res = "rpc_cache";
 	}
 	return res;
 }
@@ -470,6 +479,9 @@ std::string nano::stat::detail_to_string (uint32_t key)
 		case nano::stat::detail::initiate_wallet_lazy:
 			res = "initiate_wallet_lazy";
 			break;
+		case nano::stat::detail::initiate_snapshot:
+			res = "initiate_snapshot";
+			break;
 		case nano::stat::detail::insufficient_work:
 			res = "insufficient_work";
 			break;
@@ -479,6 +491,12 @@ std::string nano::stat::detail_to_string (uint32_t key)
 		case nano::stat::detail::keepalive:
 			res = "keepalive";
 			break;
+		case nano::stat::detail::ledger_snapshot:
+			res = "ledger_snapshot";
+			break;
+		case nano::stat::detail::ledger_snapshot_failure:
+			res = "ledger_snapshot_failure";
+			break;
 		case nano::stat::detail::open:
 			res = "open";
 			break;
@@ -565,6 +583,21 @@ std::string nano::stat::detail_to_string (uint32_t key)
 			break;
 		case nano::stat::detail::blocks_confirmed:
 			res = "blocks_confirmed";
+			break;
+		case nano::stat::detail::hit:
+			res = "hit";
+			break;
+		case nano::stat::detail::miss:
+			res = "miss";
+			break;
+		case nano::stat::detail::refresh:
+			res = "refresh";
+			break;
+		case nano::stat::detail::message_drop:
+			res = "message_drop";
+			break;
+		case nano::stat::detail::slow_consumer_disconnect:
+			res = "slow_consumer_disconnect";
 	}
 	return res;
 }
@@ -234,7 +234,10 @@ public:
 		udp,
 		observer,
 		confirmation_height,
-		drop
+		drop,
+		work_cache,
+		websocket,
+		rpc_cache
 	};
 
 	/** Optional detail type */
@@ -274,6 +277,7 @@ public:
 		initiate,
 		initiate_lazy,
 		initiate_wallet_lazy,
+		initiate_snapshot,
 
 		// bootstrap specific
 		bulk_pull,
@@ -285,6 +289,8 @@ public:
 		bulk_pull_request_failure,
 		bulk_push,
 		frontier_req,
+		ledger_snapshot,
+		ledger_snapshot_failure,
 		error_socket_close,
 
 		// vote specific
@@ -320,7 +326,16 @@ public:
 
 		// confirmation height
 		blocks_confirmed,
-		invalid_block
+		invalid_block,
+
+		// work cache, rpc cache
+		hit,
+		miss,
+		refresh,
+
+		// websocket
+		message_drop,
+		slow_consumer_disconnect
 	};
 
 	/** Direction of the stat. If the direction is irrelevant, use in */
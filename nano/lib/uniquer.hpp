@@ -0,0 +1,110 @@
+#pragma once
+
+#include <nano/lib/flat_hash.hpp>
+#include <nano/lib/numbers.hpp>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace nano
+{
+/**
+ * Maps digests to weakly held objects so equal objects deserialized separately share a single instance.
+ * Entries are spread over shards by key, each shard with its own mutex. A shard stores its entries densely in a vector indexed by a flat hash map,
+ * expired entries are found with a clock sweep and swap-removed in constant time. Each insertion sweeps a few entries of the shards in turn.
+ */
+template <typename T>
+class sharded_uniquer final
+{
+public:
+	using value_type = std::pair<nano::uint256_union, std::weak_ptr<T>>;
+	std::shared_ptr<T> unique (nano::uint256_union const & key_a, std::shared_ptr<T> const & value_a)
+	{
+		auto result (value_a);
+		// The zero key marks empty slots of the index, such values are returned as is
+		if (!key_a.is_zero ())
+		{
+			auto & shard (shards[key_a.qwords[3] & (shard_count - 1)]);
+			{
+				std::lock_guard<std::mutex> lock (shard.mutex);
+				auto existing (shard.index.find (key_a));
+				if (existing != shard.index.end ())
+				{
+					auto & entry (shard.entries[existing->second]);
+					if (auto value_l = entry.second.lock ())
+					{
+						result = value_l;
+					}
+					else
+					{
+						entry.second = value_a;
+					}
+				}
+				else
+				{
+					shard.index[key_a] = shard.entries.size ();
+					shard.entries.emplace_back (key_a, value_a);
+				}
+			}
+			cleanup ();
+		}
+		return result;
+	}
+	size_t size ()
+	{
+		size_t result (0);
+		for (auto & shard : shards)
+		{
+			std::lock_guard<std::mutex> lock (shard.mutex);
+			result += shard.entries.size ();
+		}
+		return result;
+	}
+	static size_t constexpr shard_count = 16;
+	static unsigned constexpr cleanup_count = 2;
+
+private:
+	class shard final
+	{
+	public:
+		std::mutex mutex;
+		std::vector<value_type> entries;
+		nano::flat_hash_map<nano::uint256_union, size_t> index;
+		/** Position of the clock sweep in entries */
+		size_t hand{ 0 };
+	};
+	void cleanup ()
+	{
+		auto & shard (shards[next_cleanup.fetch_add (1) % shard_count]);
+		std::lock_guard<std::mutex> lock (shard.mutex);
+		for (auto i (0u); i < cleanup_count && !shard.entries.empty (); ++i)
+		{
+			if (shard.hand >= shard.entries.size ())
+			{
+				shard.hand = 0;
+			}
+			auto & entry (shard.entries[shard.hand]);
+			if (entry.second.expired ())
+			{
+				shard.index.erase (entry.first);
+				if (shard.hand + 1 != shard.entries.size ())
+				{
+					// Move the last entry into the hole, it is examined by the next step
+					entry = std::move (shard.entries.back ());
+					shard.index[entry.first] = shard.hand;
+				}
+				shard.entries.pop_back ();
+			}
+			else
+			{
+				++shard.hand;
+			}
+		}
+	}
+	std::array<shard, shard_count> shards;
+	std::atomic<size_t> next_cleanup{ 0 };
+};
+}
@@ -134,6 +134,12 @@ namespace thread_role
 			case nano::thread_role::name::confirmation_height_processing:
 				thread_role_name_string = "Conf height";
 				break;
+			case nano::thread_role::name::bootstrap_work_validation:
+				thread_role_name_string = "Bootstrap work";
+				break;
+			case nano::thread_role::name::work_precache:
+				thread_role_name_string = "Work precache";
+				break;
 		}
 
 		/*
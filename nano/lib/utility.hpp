@@ -110,7 +110,9 @@ namespace thread_role
 		rpc_request_processor,
 		rpc_process_container,
 		work_watcher,
-		confirmation_height_processing
+		confirmation_height_processing,
+		bootstrap_work_validation,
+		work_precache
 	};
 	/*
 	 * Get/Set the identifier for the current thread
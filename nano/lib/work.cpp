@@ -1,8 +1,11 @@
 #include <nano/crypto_lib/random_pool.hpp>
 #include <nano/lib/blocks.hpp>
 #include <nano/lib/work.hpp>
+#include <nano/lib/work_kernel.hpp>
 #include <nano/node/xorshift.hpp>
 
+#include <array>
+#include <cmath>
 #include <future>
 
 bool nano::work_validate (nano::block_hash const & root_a, uint64_t work_a, uint64_t * difficulty_a)
@@ -32,6 +35,21 @@ uint64_t nano::work_value (nano::block_hash const & root_a, uint64_t work_a)
 	return result;
 }
 
+void nano::work_value_batch (nano::block_hash const * roots_a, uint64_t const * works_a, uint64_t * values_a, size_t count_a)
+{
+	auto const & kernel (nano::work_kernel_best ());
+	size_t i (0);
+	for (; i + kernel.lanes <= count_a; i += kernel.lanes)
+	{
+		kernel.function (roots_a + i, works_a + i, values_a + i);
+	}
+	auto const & portable (nano::work_kernels ().front ());
+	for (; i < count_a; ++i)
+	{
+		portable.function (roots_a + i, works_a + i, values_a + i);
+	}
+}
+
 nano::work_pool::work_pool (unsigned max_threads_a, std::chrono::nanoseconds pow_rate_limiter_a, std::function<boost::optional<uint64_t> (nano::uint256_union const &, uint64_t)> opencl_a) :
 ticket (0),
 done (false),
@@ -42,6 +60,7 @@ opencl (opencl_a)
 	boost::thread::attributes attrs;
 	nano::thread_attributes::set (attrs);
 	auto count (network_constants.is_test_network () ? 1 : std::min (max_threads_a, std::max (1u, boost::thread::hardware_concurrency ())));
+	thread_count = count;
 	for (auto i (0u); i < count; ++i)
 	{
 		auto thread (boost::thread (attrs, [this, i]() {
@@ -67,10 +86,12 @@ void nano::work_pool::loop (uint64_t thread)
 	// Quick RNG for work attempts.
 	xorshift1024star rng;
 	nano::random_pool::generate_block (reinterpret_cast<uint8_t *> (rng.s.data ()), rng.s.size () * sizeof (decltype (rng.s)::value_type));
+	auto const & kernel (nano::work_kernel_best ());
+	std::array<nano::block_hash, nano::work_kernel::max_lanes> roots;
+	std::array<uint64_t, nano::work_kernel::max_lanes> works;
+	std::array<uint64_t, nano::work_kernel::max_lanes> values;
 	uint64_t work;
 	uint64_t output;
-	blake2b_state hash;
-	blake2b_init (&hash, sizeof (output));
 	std::unique_lock<std::mutex> lock (mutex);
 	auto pow_sleep = pow_rate_limiter;
 	while (!done || !pending.empty ())
@@ -83,11 +104,14 @@ void nano::work_pool::loop (uint64_t thread)
 		}
 		if (!empty)
 		{
-			auto current_l (pending.front ());
+			auto current_l (schedule (thread));
 			int ticket_l (ticket);
 			lock.unlock ();
+			std::fill (roots.begin (), roots.begin () + kernel.lanes, current_l.item);
 			output = 0;
-			// ticket != ticket_l indicates a different thread found a solution and we should stop
+			uint64_t hashes (0);
+			auto begin (std::chrono::steady_clock::now ());
+			// ticket != ticket_l indicates the pending set changed and this thread should pick its item again
 			while (ticket == ticket_l && output < current_l.difficulty)
 			{
 				// Don't query main memory every iteration in order to reduce memory bus traffic
@@ -96,13 +120,20 @@ void nano::work_pool::loop (uint64_t thread)
 				unsigned iteration (256);
 				while (iteration && output < current_l.difficulty)
 				{
-					work = rng.next ();
-					blake2b_update (&hash, reinterpret_cast<uint8_t *> (&work), sizeof (work));
-					blake2b_update (&hash, current_l.item.bytes.data (), current_l.item.bytes.size ());
-					blake2b_final (&hash, reinterpret_cast<uint8_t *> (&output), sizeof (output));
-					blake2b_init (&hash, sizeof (output));
-					iteration -= 1;
+					// Each kernel call evaluates one nonce per lane
+					for (size_t lane (0); lane < kernel.lanes; ++lane)
+					{
+						works[lane] = rng.next ();
+					}
+					kernel.function (roots.data (), works.data (), values.data ());
+					for (size_t lane (0); lane < kernel.lanes && output < current_l.difficulty; ++lane)
+					{
+						work = works[lane];
+						output = values[lane];
+					}
+					iteration -= kernel.lanes;
 				}
+				hashes += 256 - iteration;
 
 				// Add a rate limiter (if specified) to the pow calculation to save some CPUs which don't want to operate at full throttle
 				if (pow_sleep != std::chrono::nanoseconds (0))
@@ -110,22 +141,29 @@ void nano::work_pool::loop (uint64_t thread)
 					std::this_thread::sleep_for (pow_sleep);
 				}
 			}
+			auto elapsed (std::chrono::steady_clock::now () - begin);
 			lock.lock ();
-			if (ticket == ticket_l)
+			hash_count += hashes;
+			hash_time += elapsed;
+			if (output >= current_l.difficulty)
 			{
-				// If the ticket matches what we started with, we're the ones that found the solution
-				assert (output >= current_l.difficulty);
-				assert (current_l.difficulty == 0 || work_value (current_l.item, work) == output);
-				// Signal other threads to stop their work next time they check ticket
-				++ticket;
-				pending.pop_front ();
-				lock.unlock ();
-				current_l.callback (work);
-				lock.lock ();
-			}
-			else
-			{
-				// A different thread found a solution
+				auto & by_sequence (pending.get<sequence_tag> ());
+				auto existing (by_sequence.find (current_l.sequence));
+				if (existing != by_sequence.end ())
+				{
+					// The item is still pending so we're the ones that found the solution
+					assert (current_l.difficulty == 0 || work_value (current_l.item, work) == output);
+					by_sequence.erase (existing);
+					// Signal other threads to stop their work next time they check ticket
+					++ticket;
+					lock.unlock ();
+					current_l.callback (work);
+					lock.lock ();
+				}
+				else
+				{
+					// A different thread found a solution or the item was cancelled
+				}
 			}
 		}
 		else
@@ -136,29 +174,34 @@ void nano::work_pool::loop (uint64_t thread)
 	}
 }
 
+nano::work_item const & nano::work_pool::schedule (uint64_t thread_a)
+{
+	assert (!pending.empty ());
+	// Threads are spread over the cheapest items of the highest pending priority, one item per thread at most
+	auto & ordered (pending.get<schedule_tag> ());
+	auto begin (ordered.begin ());
+	size_t active (0);
+	for (auto i (begin); i != ordered.end () && i->priority == begin->priority && active < thread_count; ++i)
+	{
+		++active;
+	}
+	return *std::next (begin, thread_a % active);
+}
+
 void nano::work_pool::cancel (nano::uint256_union const & root_a)
 {
 	std::lock_guard<std::mutex> lock (mutex);
-	if (!pending.empty ())
+	auto & by_root (pending.get<root_tag> ());
+	auto range (by_root.equal_range (root_a));
+	if (range.first != range.second)
 	{
-		if (pending.front ().item == root_a)
+		for (auto i (range.first); i != range.second; ++i)
 		{
-			++ticket;
+			i->callback (boost::none);
 		}
+		by_root.erase (range.first, range.second);
+		++ticket;
 	}
-	pending.remove_if ([&root_a](decltype (pending)::value_type const & item_a) {
-		bool result;
-		if (item_a.item == root_a)
-		{
-			item_a.callback (boost::none);
-			result = true;
-		}
-		else
-		{
-			result = false;
-		}
-		return result;
-	});
 }
 
 void nano::work_pool::stop ()
@@ -175,7 +218,7 @@ void nano::work_pool::generate (nano::uint256_union const & hash_a, std::functio
 	generate (hash_a, callback_a, network_constants.publish_threshold);
 }
 
-void nano::work_pool::generate (nano::uint256_union const & hash_a, std::function<void(boost::optional<uint64_t> const &)> callback_a, uint64_t difficulty_a)
+void nano::work_pool::generate (nano::uint256_union const & hash_a, std::function<void(boost::optional<uint64_t> const &)> callback_a, uint64_t difficulty_a, nano::work_priority priority_a)
 {
 	assert (!hash_a.is_zero ());
 	boost::optional<uint64_t> result;
@@ -187,7 +230,9 @@ void nano::work_pool::generate (nano::uint256_union const & hash_a, std::functio
 	{
 		{
 			std::lock_guard<std::mutex> lock (mutex);
-			pending.push_back ({ hash_a, callback_a, difficulty_a });
+			pending.insert ({ hash_a, callback_a, difficulty_a, priority_a, next_sequence++ });
+			// Threads reschedule in case the new item precedes the ones being worked on
+			++ticket;
 		}
 		producer_condition.notify_all ();
 	}
@@ -202,7 +247,7 @@ uint64_t nano::work_pool::generate (nano::uint256_union const & hash_a)
 	return generate (hash_a, network_constants.publish_threshold);
 }
 
-uint64_t nano::work_pool::generate (nano::uint256_union const & hash_a, uint64_t difficulty_a)
+uint64_t nano::work_pool::generate (nano::uint256_union const & hash_a, uint64_t difficulty_a, nano::work_priority priority_a)
 {
 	std::promise<boost::optional<uint64_t>> work;
 	std::future<boost::optional<uint64_t>> future = work.get_future ();
@@ -210,12 +255,26 @@ uint64_t nano::work_pool::generate (nano::uint256_union const & hash_a, uint64_t
 	generate (hash_a, [&work](boost::optional<uint64_t> work_a) {
 		work.set_value (work_a);
 	},
-	difficulty_a);
+	difficulty_a, priority_a);
 	// clang-format on
 	auto result (future.get ());
 	return result.value ();
 }
 
+std::chrono::milliseconds nano::work_pool::expected_duration (uint64_t difficulty_a)
+{
+	std::chrono::milliseconds result (0);
+	std::lock_guard<std::mutex> lock (mutex);
+	if (hash_count != 0 && thread_count != 0)
+	{
+		// Each hash reaches the difficulty with probability (2^64 - difficulty) / 2^64
+		auto expected_hashes (difficulty_a == 0 ? 1.0 : std::ldexp (1.0, 64) / static_cast<double> (std::numeric_limits<uint64_t>::max () - difficulty_a + 1));
+		auto seconds_per_hash (std::chrono::duration<double> (hash_time).count () / hash_count);
+		result = std::chrono::duration_cast<std::chrono::milliseconds> (std::chrono::duration<double> (expected_hashes * seconds_per_hash / thread_count));
+	}
+	return result;
+}
+
 namespace nano
 {
 std::unique_ptr<seq_con_info_component> collect_seq_con_info (work_pool & work_pool, const std::string & name)
@@ -4,6 +4,11 @@
 #include <nano/lib/numbers.hpp>
 #include <nano/lib/utility.hpp>
 
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/mem_fun.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index_container.hpp>
 #include <boost/optional.hpp>
 #include <boost/thread/thread.hpp>
 
@@ -11,6 +16,7 @@
 #include <condition_variable>
 #include <memory>
 #include <thread>
+#include <tuple>
 
 namespace nano
 {
@@ -18,13 +24,32 @@ class block;
 bool work_validate (nano::block_hash const &, uint64_t, uint64_t * = nullptr);
 bool work_validate (nano::block const &, uint64_t * = nullptr);
 uint64_t work_value (nano::block_hash const &, uint64_t);
+/** Computes work_value for count_a root and work pairs into values_a, batching callers can validate many blocks in one call */
+void work_value_batch (nano::block_hash const *, uint64_t const *, uint64_t *, size_t);
 class opencl_work;
+/** Order in which queued work is generated, items of a higher priority are scheduled first */
+enum class work_priority : uint8_t
+{
+	/** Blocks created by wallet actions */
+	high,
+	/** Default, including RPC work_generate */
+	normal,
+	/** Work watcher regeneration of unconfirmed blocks and precaching of wallet frontiers */
+	low
+};
 class work_item final
 {
 public:
 	nano::uint256_union item;
 	std::function<void(boost::optional<uint64_t> const &)> callback;
 	uint64_t difficulty;
+	nano::work_priority priority;
+	/** Insertion order, unique within a work_pool */
+	uint64_t sequence;
+	std::tuple<nano::work_priority, uint64_t, uint64_t> schedule_key () const
+	{
+		return std::make_tuple (priority, difficulty, sequence);
+	}
 };
 class work_pool final
 {
@@ -35,19 +60,45 @@ public:
 	void stop ();
 	void cancel (nano::uint256_union const &);
 	void generate (nano::uint256_union const &, std::function<void(boost::optional<uint64_t> const &)>);
-	void generate (nano::uint256_union const &, std::function<void(boost::optional<uint64_t> const &)>, uint64_t);
+	void generate (nano::uint256_union const &, std::function<void(boost::optional<uint64_t> const &)>, uint64_t, nano::work_priority = nano::work_priority::normal);
 	uint64_t generate (nano::uint256_union const &);
-	uint64_t generate (nano::uint256_union const &, uint64_t);
+	uint64_t generate (nano::uint256_union const &, uint64_t, nano::work_priority = nano::work_priority::normal);
+	/** Time all threads are expected to take to reach difficulty_a, based on the hash rate measured so far. Zero until a measurement exists */
+	std::chrono::milliseconds expected_duration (uint64_t difficulty_a);
 	nano::network_constants network_constants;
+	/** Incremented whenever the pending set changes, threads working on a stale ticket pick their item again */
 	std::atomic<int> ticket;
 	bool done;
 	std::vector<boost::thread> threads;
-	std::list<nano::work_item> pending;
+	size_t thread_count{ 0 };
+	class schedule_tag
+	{
+	};
+	class sequence_tag
+	{
+	};
+	class root_tag
+	{
+	};
+	boost::multi_index_container<
+	nano::work_item,
+	boost::multi_index::indexed_by<
+	boost::multi_index::ordered_unique<boost::multi_index::tag<schedule_tag>, boost::multi_index::const_mem_fun<nano::work_item, std::tuple<nano::work_priority, uint64_t, uint64_t>, &nano::work_item::schedule_key>>,
+	boost::multi_index::hashed_unique<boost::multi_index::tag<sequence_tag>, boost::multi_index::member<nano::work_item, uint64_t, &nano::work_item::sequence>>,
+	boost::multi_index::hashed_non_unique<boost::multi_index::tag<root_tag>, boost::multi_index::member<nano::work_item, nano::uint256_union, &nano::work_item::item>, std::hash<nano::uint256_union>>>>
+	pending;
+	uint64_t next_sequence{ 0 };
+	/** Hashes computed and thread time spent computing them, for expected_duration */
+	uint64_t hash_count{ 0 };
+	std::chrono::nanoseconds hash_time{ 0 };
 	std::mutex mutex;
 	std::condition_variable producer_condition;
 	std::chrono::nanoseconds pow_rate_limiter;
 	std::function<boost::optional<uint64_t> (nano::uint256_union const &, uint64_t)> opencl;
 	nano::observer_set<bool> work_observers;
+
+private:
+	nano::work_item const & schedule (uint64_t);
 };
 
 std::unique_ptr<seq_con_info_component> collect_seq_con_info (work_pool & work_pool, const std::string & name);
@@ -0,0 +1,212 @@
+#include <nano/lib/work_kernel.hpp>
+
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define NANO_WORK_KERNEL_X86
+#include <immintrin.h>
+#endif
+
+namespace
+{
+uint64_t constexpr blake2b_iv[8] = {
+	0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+	0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+};
+
+uint8_t constexpr blake2b_sigma[12][16] = {
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	{ 14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3 },
+	{ 11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4 },
+	{ 7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8 },
+	{ 9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13 },
+	{ 2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9 },
+	{ 12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11 },
+	{ 13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10 },
+	{ 6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5 },
+	{ 10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	{ 14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3 }
+};
+
+// First state word after applying the parameter block of an unkeyed 8 byte digest with fanout and depth 1
+uint64_t constexpr work_h0 = blake2b_iv[0] ^ 0x01010008ULL;
+// Nonce and root, the only block which is also the final one
+uint64_t constexpr work_input_size = 40;
+
+/*
+ * Message words 5 to 15 are always zero, indexing them with constants lets the compiler drop those additions.
+ * G and the rounds are macros so they expand inside functions compiled for a specific instruction set.
+ */
+#define NANO_WORK_ROUND(G, r)                                                       \
+	G (v[0], v[4], v[8], v[12], m[blake2b_sigma[r][0]], m[blake2b_sigma[r][1]]);   \
+	G (v[1], v[5], v[9], v[13], m[blake2b_sigma[r][2]], m[blake2b_sigma[r][3]]);   \
+	G (v[2], v[6], v[10], v[14], m[blake2b_sigma[r][4]], m[blake2b_sigma[r][5]]);  \
+	G (v[3], v[7], v[11], v[15], m[blake2b_sigma[r][6]], m[blake2b_sigma[r][7]]);  \
+	G (v[0], v[5], v[10], v[15], m[blake2b_sigma[r][8]], m[blake2b_sigma[r][9]]);  \
+	G (v[1], v[6], v[11], v[12], m[blake2b_sigma[r][10]], m[blake2b_sigma[r][11]]); \
+	G (v[2], v[7], v[8], v[13], m[blake2b_sigma[r][12]], m[blake2b_sigma[r][13]]);  \
+	G (v[3], v[4], v[9], v[14], m[blake2b_sigma[r][14]], m[blake2b_sigma[r][15]]);
+
+#define NANO_WORK_ROUNDS(G)  \
+	NANO_WORK_ROUND (G, 0)  \
+	NANO_WORK_ROUND (G, 1)  \
+	NANO_WORK_ROUND (G, 2)  \
+	NANO_WORK_ROUND (G, 3)  \
+	NANO_WORK_ROUND (G, 4)  \
+	NANO_WORK_ROUND (G, 5)  \
+	NANO_WORK_ROUND (G, 6)  \
+	NANO_WORK_ROUND (G, 7)  \
+	NANO_WORK_ROUND (G, 8)  \
+	NANO_WORK_ROUND (G, 9)  \
+	NANO_WORK_ROUND (G, 10) \
+	NANO_WORK_ROUND (G, 11)
+
+inline uint64_t rotr64 (uint64_t word_a, unsigned bits_a)
+{
+	return (word_a >> bits_a) | (word_a << (64 - bits_a));
+}
+
+inline uint64_t load64_le (uint8_t const * bytes_a)
+{
+	uint64_t result (0);
+	for (auto i (0); i < 8; ++i)
+	{
+		result |= static_cast<uint64_t> (bytes_a[i]) << (8 * i);
+	}
+	return result;
+}
+
+#define NANO_WORK_G_PORTABLE(a, b, c, d, x, y) \
+	do                                         \
+	{                                          \
+		a = a + b + x;                         \
+		d = rotr64 (d ^ a, 32);                \
+		c = c + d;                             \
+		b = rotr64 (b ^ c, 24);                \
+		a = a + b + y;                         \
+		d = rotr64 (d ^ a, 16);                \
+		c = c + d;                             \
+		b = rotr64 (b ^ c, 63);                \
+	} while (0)
+
+void work_kernel_portable (nano::block_hash const * roots_a, uint64_t const * works_a, uint64_t * values_a)
+{
+	// The nonce is hashed in memory order, as nano::work_value does
+	uint8_t work_bytes[8];
+	std::memcpy (work_bytes, works_a, sizeof (work_bytes));
+	uint64_t const m[16] = { load64_le (work_bytes), load64_le (roots_a->bytes.data ()), load64_le (roots_a->bytes.data () + 8), load64_le (roots_a->bytes.data () + 16), load64_le (roots_a->bytes.data () + 24), 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+	uint64_t v[16] = { work_h0, blake2b_iv[1], blake2b_iv[2], blake2b_iv[3], blake2b_iv[4], blake2b_iv[5], blake2b_iv[6], blake2b_iv[7],
+		blake2b_iv[0], blake2b_iv[1], blake2b_iv[2], blake2b_iv[3], blake2b_iv[4] ^ work_input_size, blake2b_iv[5], ~blake2b_iv[6], blake2b_iv[7] };
+	NANO_WORK_ROUNDS (NANO_WORK_G_PORTABLE)
+	auto digest (work_h0 ^ v[0] ^ v[8]);
+	// The digest bytes are little endian, reinterpret them the way nano::work_value does
+	uint8_t digest_bytes[8];
+	for (auto i (0); i < 8; ++i)
+	{
+		digest_bytes[i] = static_cast<uint8_t> (digest >> (8 * i));
+	}
+	std::memcpy (values_a, digest_bytes, sizeof (digest_bytes));
+}
+
+#ifdef NANO_WORK_KERNEL_X86
+#define NANO_WORK_G_AVX2(a, b, c, d, x, y)                                                          \
+	do                                                                                              \
+	{                                                                                               \
+		a = _mm256_add_epi64 (_mm256_add_epi64 (a, b), x);                                          \
+		d = _mm256_shuffle_epi32 (_mm256_xor_si256 (d, a), _MM_SHUFFLE (2, 3, 0, 1));               \
+		c = _mm256_add_epi64 (c, d);                                                                \
+		b = _mm256_shuffle_epi8 (_mm256_xor_si256 (b, c), rotate24);                                \
+		a = _mm256_add_epi64 (_mm256_add_epi64 (a, b), y);                                          \
+		d = _mm256_shuffle_epi8 (_mm256_xor_si256 (d, a), rotate16);                                \
+		c = _mm256_add_epi64 (c, d);                                                                \
+		b = _mm256_xor_si256 (b, c);                                                                \
+		b = _mm256_or_si256 (_mm256_srli_epi64 (b, 63), _mm256_add_epi64 (b, b));                   \
+	} while (0)
+
+__attribute__ ((target ("avx2"))) void work_kernel_avx2 (nano::block_hash const * roots_a, uint64_t const * works_a, uint64_t * values_a)
+{
+	auto const rotate24 (_mm256_setr_epi8 (3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10, 3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10));
+	auto const rotate16 (_mm256_setr_epi8 (2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9, 2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9));
+	auto const zero (_mm256_setzero_si256 ());
+	__m256i const m[16] = {
+		_mm256_loadu_si256 (reinterpret_cast<__m256i const *> (works_a)),
+		_mm256_set_epi64x (roots_a[3].qwords[0], roots_a[2].qwords[0], roots_a[1].qwords[0], roots_a[0].qwords[0]),
+		_mm256_set_epi64x (roots_a[3].qwords[1], roots_a[2].qwords[1], roots_a[1].qwords[1], roots_a[0].qwords[1]),
+		_mm256_set_epi64x (roots_a[3].qwords[2], roots_a[2].qwords[2], roots_a[1].qwords[2], roots_a[0].qwords[2]),
+		_mm256_set_epi64x (roots_a[3].qwords[3], roots_a[2].qwords[3], roots_a[1].qwords[3], roots_a[0].qwords[3]),
+		zero, zero, zero, zero, zero, zero, zero, zero, zero, zero, zero
+	};
+	__m256i v[16] = {
+		_mm256_set1_epi64x (work_h0), _mm256_set1_epi64x (blake2b_iv[1]), _mm256_set1_epi64x (blake2b_iv[2]), _mm256_set1_epi64x (blake2b_iv[3]),
+		_mm256_set1_epi64x (blake2b_iv[4]), _mm256_set1_epi64x (blake2b_iv[5]), _mm256_set1_epi64x (blake2b_iv[6]), _mm256_set1_epi64x (blake2b_iv[7]),
+		_mm256_set1_epi64x (blake2b_iv[0]), _mm256_set1_epi64x (blake2b_iv[1]), _mm256_set1_epi64x (blake2b_iv[2]), _mm256_set1_epi64x (blake2b_iv[3]),
+		_mm256_set1_epi64x (blake2b_iv[4] ^ work_input_size), _mm256_set1_epi64x (blake2b_iv[5]), _mm256_set1_epi64x (~blake2b_iv[6]), _mm256_set1_epi64x (blake2b_iv[7])
+	};
+	NANO_WORK_ROUNDS (NANO_WORK_G_AVX2)
+	auto digest (_mm256_xor_si256 (_mm256_set1_epi64x (work_h0), _mm256_xor_si256 (v[0], v[8])));
+	_mm256_storeu_si256 (reinterpret_cast<__m256i *> (values_a), digest);
+}
+
+#define NANO_WORK_G_AVX512(a, b, c, d, x, y)                 \
+	do                                                       \
+	{                                                        \
+		a = _mm512_add_epi64 (_mm512_add_epi64 (a, b), x);   \
+		d = _mm512_ror_epi64 (_mm512_xor_si512 (d, a), 32);  \
+		c = _mm512_add_epi64 (c, d);                         \
+		b = _mm512_ror_epi64 (_mm512_xor_si512 (b, c), 24);  \
+		a = _mm512_add_epi64 (_mm512_add_epi64 (a, b), y);   \
+		d = _mm512_ror_epi64 (_mm512_xor_si512 (d, a), 16);  \
+		c = _mm512_add_epi64 (c, d);                         \
+		b = _mm512_ror_epi64 (_mm512_xor_si512 (b, c), 63);  \
+	} while (0)
+
+__attribute__ ((target ("avx512f"))) void work_kernel_avx512 (nano::block_hash const * roots_a, uint64_t const * works_a, uint64_t * values_a)
+{
+	auto const zero (_mm512_setzero_si512 ());
+	__m512i m[16] = { _mm512_loadu_si512 (works_a), zero, zero, zero, zero, zero, zero, zero, zero, zero, zero, zero, zero, zero, zero, zero };
+	for (auto i (0); i < 4; ++i)
+	{
+		m[1 + i] = _mm512_set_epi64 (roots_a[7].qwords[i], roots_a[6].qwords[i], roots_a[5].qwords[i], roots_a[4].qwords[i], roots_a[3].qwords[i], roots_a[2].qwords[i], roots_a[1].qwords[i], roots_a[0].qwords[i]);
+	}
+	__m512i v[16] = {
+		_mm512_set1_epi64 (work_h0), _mm512_set1_epi64 (blake2b_iv[1]), _mm512_set1_epi64 (blake2b_iv[2]), _mm512_set1_epi64 (blake2b_iv[3]),
+		_mm512_set1_epi64 (blake2b_iv[4]), _mm512_set1_epi64 (blake2b_iv[5]), _mm512_set1_epi64 (blake2b_iv[6]), _mm512_set1_epi64 (blake2b_iv[7]),
+		_mm512_set1_epi64 (blake2b_iv[0]), _mm512_set1_epi64 (blake2b_iv[1]), _mm512_set1_epi64 (blake2b_iv[2]), _mm512_set1_epi64 (blake2b_iv[3]),
+		_mm512_set1_epi64 (blake2b_iv[4] ^ work_input_size), _mm512_set1_epi64 (blake2b_iv[5]), _mm512_set1_epi64 (~blake2b_iv[6]), _mm512_set1_epi64 (blake2b_iv[7])
+	};
+	NANO_WORK_ROUNDS (NANO_WORK_G_AVX512)
+	auto digest (_mm512_xor_si512 (_mm512_set1_epi64 (work_h0), _mm512_xor_si512 (v[0], v[8])));
+	_mm512_storeu_si512 (values_a, digest);
+}
+#endif
+
+std::vector<nano::work_kernel> detect_work_kernels ()
+{
+	std::vector<nano::work_kernel> result;
+	result.push_back (nano::work_kernel{ "portable", 1, work_kernel_portable });
+#ifdef NANO_WORK_KERNEL_X86
+	__builtin_cpu_init ();
+	if (__builtin_cpu_supports ("avx2"))
+	{
+		result.push_back (nano::work_kernel{ "avx2", 4, work_kernel_avx2 });
+	}
+	if (__builtin_cpu_supports ("avx512f"))
+	{
+		result.push_back (nano::work_kernel{ "avx512", 8, work_kernel_avx512 });
+	}
+#endif
+	return result;
+}
+}
+
+std::vector<nano::work_kernel> const & nano::work_kernels ()
+{
+	static std::vector<nano::work_kernel> const kernels (detect_work_kernels ());
+	return kernels;
+}
+
+nano::work_kernel const & nano::work_kernel_best ()
+{
+	return nano::work_kernels ().back ();
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <nano/lib/numbers.hpp>
+
+#include <vector>
+
+namespace nano
+{
+/**
+ * Proof of work hashing specialised for its fixed input, an 8 byte nonce followed by a 32 byte root, hashed with Blake2b into 8 bytes.
+ * The input fits a single compression block so a kernel runs one compression per nonce with no state re-initialisation.
+ * Vectorized kernels evaluate one nonce per SIMD lane.
+ */
+class work_kernel final
+{
+public:
+	/** Computes the work value of works_a[i] against roots_a[i] for each of the `lanes` entries */
+	using function_type = void (*) (nano::block_hash const * roots_a, uint64_t const * works_a, uint64_t * values_a);
+	char const * name;
+	size_t lanes;
+	function_type function;
+	static size_t constexpr max_lanes = 8;
+};
+/** Kernels supported by the running CPU, the portable kernel first */
+std::vector<nano::work_kernel> const & work_kernels ();
+/** The kernel with the most lanes supported by the running CPU, detected once */
+nano::work_kernel const & work_kernel_best ();
+}
@@ -9,8 +9,11 @@
 #include <boost/dll/runtime_symbol_info.hpp>
 #include <boost/program_options.hpp>
 
+#include <algorithm>
 #include <csignal>
+#include <future>
 #include <iomanip>
+#include <mutex>
 #include <random>
 
 /* Boost v1.70 introduced breaking changes; the conditional compilation allows 1.6x to be supported as well. */
@@ -244,6 +247,112 @@ private:
 	tcp::resolver::results_type const & results;
 };
 
+/** Issues account_info requests one after another until the shared budget is spent, recording the latency of each */
+class benchmark_session final : public std::enable_shared_from_this<benchmark_session>
+{
+public:
+	benchmark_session (boost::asio::io_context & ioc, std::atomic<int> & requests_remaining, std::string const & account, tcp::resolver::results_type const & results, std::function<void(std::chrono::microseconds)> completed) :
+	socket (ioc),
+	strand (socket.get_executor ()),
+	requests_remaining (requests_remaining),
+	account (account),
+	results (results),
+	completed (completed)
+	{
+	}
+
+	void run ()
+	{
+		if (requests_remaining-- <= 0)
+		{
+			return;
+		}
+		auto this_l (shared_from_this ());
+		start = std::chrono::steady_clock::now ();
+		boost::asio::async_connect (socket, results.cbegin (), results.cend (), boost::asio::bind_executor (strand, [this_l](boost::system::error_code const & ec, boost::asio::ip::tcp::resolver::iterator) {
+			if (ec)
+			{
+				return fail (ec, "connect");
+			}
+
+			boost::property_tree::ptree request;
+			request.put ("action", "account_info");
+			request.put ("account", this_l->account);
+			std::stringstream ostream;
+			boost::property_tree::write_json (ostream, request);
+
+			this_l->req = {};
+			this_l->req.method (http::verb::post);
+			this_l->req.version (11);
+			this_l->req.target ("/");
+			this_l->req.body () = ostream.str ();
+			this_l->req.prepare_payload ();
+
+			http::async_write (this_l->socket, this_l->req, boost::asio::bind_executor (this_l->strand, [this_l](boost::system::error_code ec, std::size_t) {
+				if (ec)
+				{
+					return fail (ec, "write");
+				}
+
+				this_l->res = {};
+				http::async_read (this_l->socket, this_l->buffer, this_l->res, boost::asio::bind_executor (this_l->strand, [this_l](boost::system::error_code ec, std::size_t) {
+					if (ec)
+					{
+						return fail (ec, "read");
+					}
+
+					this_l->completed (std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::steady_clock::now () - this_l->start));
+					this_l->socket.shutdown (tcp::socket::shutdown_both, ec);
+					this_l->socket.close (ec);
+					this_l->run ();
+				}));
+			}));
+		}));
+	}
+
+private:
+	socket_type socket;
+	boost::asio::strand<boost::asio::io_context::executor_type> strand;
+	boost::beast::flat_buffer buffer;
+	http::request<http::string_body> req;
+	http::response<http::string_body> res;
+	std::atomic<int> & requests_remaining;
+	std::string account;
+	tcp::resolver::results_type const & results;
+	std::function<void(std::chrono::microseconds)> completed;
+	std::chrono::steady_clock::time_point start;
+};
+
+/** Measures RPC throughput and latency at increasing numbers of requests in flight */
+void rpc_benchmark (boost::asio::io_context & ioc, tcp::resolver::results_type const & results, std::string const & account, int request_count)
+{
+	for (auto concurrency : { 1, 4, 16, 64, 256 })
+	{
+		std::atomic<int> requests_remaining{ request_count };
+		std::mutex mutex;
+		std::vector<std::chrono::microseconds> latencies;
+		latencies.reserve (request_count);
+		std::promise<void> done;
+		auto completed = [&mutex, &latencies, &done, request_count](std::chrono::microseconds latency_a) {
+			std::lock_guard<std::mutex> lock (mutex);
+			latencies.push_back (latency_a);
+			if (latencies.size () == static_cast<size_t> (request_count))
+			{
+				done.set_value ();
+			}
+		};
+		auto start (std::chrono::steady_clock::now ());
+		for (auto i = 0; i < concurrency; ++i)
+		{
+			std::make_shared<benchmark_session> (ioc, requests_remaining, account, results, completed)->run ();
+		}
+		done.get_future ().wait ();
+		auto elapsed (std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::steady_clock::now () - start));
+		std::sort (latencies.begin (), latencies.end ());
+		std::cout << "RPC benchmark, " << concurrency << " in flight: " << static_cast<uint64_t> (request_count * 1e6 / std::max<int64_t> (1, elapsed.count ())) << " req/s, p50 " << latencies[latencies.size () / 2].count () << "us, p99 " << latencies[latencies.size () * 99 / 100].count () << "us" << std::endl;
+	}
+}
+
 boost::property_tree::ptree rpc_request (boost::property_tree::ptree const & request, boost::asio::io_context & ioc, tcp::resolver::results_type const & results)
 {
 	tcp::socket socket{ ioc };
@@ -367,7 +476,8 @@ int main (int argc, char * const * argv)
 		("simultaneous_process_calls", boost::program_options::value<int> ()->default_value (20), "Number of simultaneous rpc sends to do")
 		("destination_count", boost::program_options::value<int> ()->default_value (2), "How many destination accounts to choose between")
 		("node_path", boost::program_options::value<std::string> (), "The path to the nano_node to test")
-		("rpc_path", boost::program_options::value<std::string> (), "The path to do nano_rpc to test");
+		("rpc_path", boost::program_options::value<std::string> (), "The path to do nano_rpc to test")
+		("rpc_benchmark_count", boost::program_options::value<int> ()->default_value (0), "How many account_info requests to time against the primary node at each concurrency level once the nodes have caught up, 0 to skip");
 	// clang-format on
 
 	boost::program_options::variables_map vm;
@@ -386,6 +496,7 @@ int main (int argc, char * const * argv)
 	auto destination_count = vm.find ("destination_count")->second.as<int> ();
 	auto send_count = vm.find ("send_count")->second.as<int> ();
 	auto simultaneous_process_calls = vm.find ("simultaneous_process_calls")->second.as<int> ();
+	auto rpc_benchmark_count = vm.find ("rpc_benchmark_count")->second.as<int> ();
 
 	boost::system::error_code err;
 	auto running_executable_filepath = boost::dll::program_location (err);
@@ -507,7 +618,7 @@ int main (int argc, char * const * argv)
 
 	std::cout << "\rPrimary node processing transactions: 00%";
 
-	std::thread t ([send_count, &destination_accounts, &ioc, &primary_node_results, &wallet, &resolver, &node_count]() {
+	std::thread t ([send_count, rpc_benchmark_count, &destination_accounts, &ioc, &primary_node_results, &wallet, &resolver, &node_count]() {
 		std::random_device rd;
 		std::mt19937 mt (rd ());
 		std::uniform_int_distribution<size_t> dist (0, destination_accounts.size () - 1);
@@ -581,6 +692,11 @@ int main (int argc, char * const * argv)
 			stop_rpc (ioc, results);
 		}
 
+		if (rpc_benchmark_count > 0)
+		{
+			rpc_benchmark (ioc, primary_node_results, nano::genesis_account.to_account (), rpc_benchmark_count);
+		}
+
 		// Stop main node
 		stop_rpc (ioc, primary_node_results);
 	});
@@ -1,5 +1,6 @@
 #include <nano/crypto_lib/random_pool.hpp>
 #include <nano/lib/utility.hpp>
+#include <nano/lib/work_kernel.hpp>
 #include <nano/nano_node/daemon.hpp>
 #include <nano/node/cli.hpp>
 #include <nano/node/ipc.hpp>
@@ -347,6 +348,32 @@ int main (int argc, char * const * argv)
 				pow_rate_limiter = std::chrono::nanoseconds (boost::lexical_cast<uint64_t> (pow_sleep_interval_it->second.as<std::string> ()));
 			}
 
+			std::cerr << "Profiling work kernels\n";
+			for (auto const & kernel : nano::work_kernels ())
+			{
+				std::array<nano::block_hash, nano::work_kernel::max_lanes> roots;
+				std::array<uint64_t, nano::work_kernel::max_lanes> works;
+				std::array<uint64_t, nano::work_kernel::max_lanes> values;
+				nano::random_pool::generate_block (roots[0].bytes.data (), roots[0].bytes.size ());
+				roots.fill (roots[0]);
+				nano::random_pool::generate_block (reinterpret_cast<uint8_t *> (works.data ()), works.size () * sizeof (uint64_t));
+				uint64_t hashes (0);
+				auto begin (std::chrono::steady_clock::now ());
+				auto end (begin);
+				while (end - begin < std::chrono::seconds (2))
+				{
+					for (auto i (0); i < 4096; ++i)
+					{
+						kernel.function (roots.data (), works.data (), values.data ());
+						works[0] += values[0] | 1;
+					}
+					hashes += 4096 * kernel.lanes;
+					end = std::chrono::steady_clock::now ();
+				}
+				auto us (std::chrono::duration_cast<std::chrono::microseconds> (end - begin).count ());
+				std::cerr << boost::str (boost::format ("Kernel %1% (%2% lanes): %3% hashes/s per thread\n") % kernel.name % kernel.lanes % (hashes * 1000000 / us));
+			}
+			std::cerr << boost::str (boost::format ("Work generation uses the %1% kernel\n") % nano::work_kernel_best ().name);
 			nano::work_pool work (std::numeric_limits<unsigned>::max (), pow_rate_limiter);
 			nano::change_block block (0, 0, nano::keypair ().prv, 0, 0);
 			std::cerr << "Starting generation profiling\n";
@@ -45,7 +45,7 @@ void nano::block_processor::flush ()
 bool nano::block_processor::full ()
 {
 	std::unique_lock<std::mutex> lock (mutex);
-	return (blocks.size () + state_blocks.size ()) > node.flags.block_processor_full_size;
+	return (blocks.size () + unverified_blocks.size ()) > node.flags.block_processor_full_size;
 }
 
 void nano::block_processor::add (std::shared_ptr<nano::block> block_a, uint64_t origination)
@@ -63,9 +63,9 @@ void nano::block_processor::add (nano::unchecked_info const & info_a)
 			std::lock_guard<std::mutex> lock (mutex);
 			if (blocks_hashes.find (hash) == blocks_hashes.end () && rolled_back.get<1> ().find (hash) == rolled_back.get<1> ().end ())
 			{
-				if (info_a.verified == nano::signature_verification::unknown && (info_a.block->type () == nano::block_type::state || info_a.block->type () == nano::block_type::open || !info_a.account.is_zero ()))
+				if (info_a.verified == nano::signature_verification::unknown)
 				{
-					state_blocks.push_back (info_a);
+					unverified_blocks.push_back (info_a);
 				}
 				else
 				{
@@ -128,22 +128,53 @@ bool nano::block_processor::should_log (bool first_time)
 bool nano::block_processor::have_blocks ()
 {
 	assert (!mutex.try_lock ());
-	return !blocks.empty () || !forced.empty () || !state_blocks.empty ();
+	return !blocks.empty () || !forced.empty () || !unverified_blocks.empty ();
 }
 
-void nano::block_processor::verify_state_blocks (nano::transaction const & transaction_a, std::unique_lock<std::mutex> & lock_a, size_t max_count)
+void nano::block_processor::verify_blocks (nano::transaction const & transaction_a, std::unique_lock<std::mutex> & lock_a, size_t max_count)
 {
 	assert (!mutex.try_lock ());
 	nano::timer<std::chrono::milliseconds> timer_l (nano::timer_state::started);
 	std::deque<nano::unchecked_info> items;
-	for (auto i (0); i < max_count && !state_blocks.empty (); i++)
+	std::vector<nano::account> accounts;
+	// Accounts of legacy blocks in this batch, later blocks of the same chain resolve their account from them
+	std::unordered_map<nano::block_hash, nano::account> batch_accounts;
+	for (auto i (0); i < max_count && !unverified_blocks.empty (); i++)
 	{
-		auto & item (state_blocks.front ());
-		if (!node.ledger.store.block_exists (transaction_a, item.block->type (), item.block->hash ()))
+		auto & item (unverified_blocks.front ());
+		auto hash (item.block->hash ());
+		if (!node.ledger.store.block_exists (transaction_a, item.block->type (), hash))
 		{
-			items.push_back (std::move (item));
+			nano::account account (item.block->account ());
+			if (!item.block->link ().is_zero () && node.ledger.is_epoch_link (item.block->link ()))
+			{
+				account = node.ledger.epoch_signer;
+			}
+			else if (!item.account.is_zero ())
+			{
+				account = item.account;
+			}
+			else if (account.is_zero ())
+			{
+				// Send, receive and change blocks belong to the account of their previous block
+				account = legacy_account (transaction_a, *item.block, batch_accounts);
+			}
+			if (!account.is_zero ())
+			{
+				if (item.block->type () != nano::block_type::state)
+				{
+					batch_accounts[hash] = account;
+				}
+				accounts.push_back (account);
+				items.push_back (std::move (item));
+			}
+			else
+			{
+				// The previous block is unknown, the ledger checks the signature once the block is no longer a gap
+				blocks.push_back (std::move (item));
+			}
 		}
-		state_blocks.pop_front ();
+		unverified_blocks.pop_front ();
 	}
 	lock_a.unlock ();
 	if (!items.empty ())
@@ -155,8 +186,6 @@ void nano::block_processor::verify_state_blocks (nano::transaction const & trans
 		messages.reserve (size);
 		std::vector<size_t> lengths;
 		lengths.reserve (size);
-		std::vector<nano::account> accounts;
-		accounts.reserve (size);
 		std::vector<unsigned char const *> pub_keys;
 		pub_keys.reserve (size);
 		std::vector<nano::uint512_union> blocks_signatures;
@@ -171,17 +200,7 @@ void nano::block_processor::verify_state_blocks (nano::transaction const & trans
 			hashes.push_back (item.block->hash ());
 			messages.push_back (hashes.back ().bytes.data ());
 			lengths.push_back (sizeof (decltype (hashes)::value_type));
-			nano::account account (item.block->account ());
-			if (!item.block->link ().is_zero () && node.ledger.is_epoch_link (item.block->link ()))
-			{
-				account = node.ledger.epoch_signer;
-			}
-			else if (!item.account.is_zero ())
-			{
-				account = item.account;
-			}
-			accounts.push_back (account);
-			pub_keys.push_back (accounts.back ().bytes.data ());
+			pub_keys.push_back (accounts[i].bytes.data ());
 			blocks_signatures.push_back (item.block->block_signature ());
 			signatures.push_back (blocks_signatures.back ().bytes.data ());
 		}
@@ -217,7 +236,7 @@ void nano::block_processor::verify_state_blocks (nano::transaction const & trans
 		}
 		if (node.config.logging.timing_logging ())
 		{
-			node.logger.try_log (boost::str (boost::format ("Batch verified %1% state blocks in %2% %3%") % size % timer_l.stop ().count () % timer_l.unit ()));
+			node.logger.try_log (boost::str (boost::format ("Batch verified %1% blocks in %2% %3%") % size % timer_l.stop ().count () % timer_l.unit ()));
 		}
 	}
 	else
@@ -226,19 +245,40 @@ void nano::block_processor::verify_state_blocks (nano::transaction const & trans
 	}
 }
 
+nano::account nano::block_processor::legacy_account (nano::transaction const & transaction_a, nano::block const & block_a, std::unordered_map<nano::block_hash, nano::account> const & batch_accounts_a)
+{
+	nano::account result (0);
+	auto previous (block_a.previous ());
+	auto existing (batch_accounts_a.find (previous));
+	if (existing != batch_accounts_a.end ())
+	{
+		result = existing->second;
+	}
+	else
+	{
+		nano::block_sideband sideband;
+		auto previous_block (node.store.block_get (transaction_a, previous, &sideband));
+		if (previous_block != nullptr)
+		{
+			result = previous_block->account ().is_zero () ? sideband.account : previous_block->account ();
+		}
+	}
+	return result;
+}
+
 void nano::block_processor::process_batch (std::unique_lock<std::mutex> & lock_a)
 {
 	nano::timer<std::chrono::milliseconds> timer_l;
 	lock_a.lock ();
 	timer_l.start ();
-	// Limit state blocks verification time
+	// Limit signature verification time
 	size_t max_verification_batch (node.flags.block_processor_verification_size != 0 ? node.flags.block_processor_verification_size : 2048 * (node.config.signature_checker_threads + 1));
-	if (!state_blocks.empty ())
+	if (!unverified_blocks.empty ())
 	{
 		auto transaction (node.store.tx_begin_read ());
-		while (!state_blocks.empty () && timer_l.before_deadline (std::chrono::seconds (2)))
+		while (!unverified_blocks.empty () && timer_l.before_deadline (std::chrono::seconds (2)))
 		{
-			verify_state_blocks (transaction, lock_a, max_verification_batch);
+			verify_blocks (transaction, lock_a, max_verification_batch);
 		}
 	}
 	lock_a.unlock ();
@@ -261,7 +301,7 @@ void nano::block_processor::process_batch (std::unique_lock<std::mutex> & lock_a
 		}
 		else
 		{
-			if (((blocks.size () + state_blocks.size () + forced.size ()) > 64 && should_log (false)))
+			if (((blocks.size () + unverified_blocks.size () + forced.size ()) > 64 && should_log (false)))
 			{
 				log_this_record = true;
 			}
@@ -270,7 +310,7 @@ void nano::block_processor::process_batch (std::unique_lock<std::mutex> & lock_a
 		if (log_this_record)
 		{
 			first_time = false;
-			node.logger.always_log (boost::str (boost::format ("%1% blocks (+ %2% state blocks) (+ %3% forced) in processing queue") % blocks.size () % state_blocks.size () % forced.size ()));
+			node.logger.always_log (boost::str (boost::format ("%1% blocks (+ %2% unverified) (+ %3% forced) in processing queue") % blocks.size () % unverified_blocks.size () % forced.size ()));
 		}
 		nano::unchecked_info info;
 		bool force (false);
@@ -332,11 +372,11 @@ void nano::block_processor::process_batch (std::unique_lock<std::mutex> & lock_a
 		auto process_result (process_one (transaction, info));
 		(void)process_result;
 		lock_a.lock ();
-		/* Verify more state blocks if blocks deque is empty
+		/* Verify more blocks if blocks deque is empty
 		 Because verification is long process, avoid large deque verification inside of write transaction */
-		if (blocks.empty () && !state_blocks.empty ())
+		if (blocks.empty () && !unverified_blocks.empty ())
 		{
-			verify_state_blocks (transaction, lock_a, 256 * (node.config.signature_checker_threads + 1));
+			verify_blocks (transaction, lock_a, 256 * (node.config.signature_checker_threads + 1));
 		}
 	}
 	lock_a.unlock ();
@@ -12,6 +12,7 @@
 
 #include <chrono>
 #include <memory>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace nano
@@ -52,13 +53,15 @@ public:
 
 private:
 	void queue_unchecked (nano::transaction const &, nano::block_hash const &);
-	void verify_state_blocks (nano::transaction const & transaction_a, std::unique_lock<std::mutex> &, size_t = std::numeric_limits<size_t>::max ());
+	void verify_blocks (nano::transaction const & transaction_a, std::unique_lock<std::mutex> &, size_t = std::numeric_limits<size_t>::max ());
+	nano::account legacy_account (nano::transaction const &, nano::block const &, std::unordered_map<nano::block_hash, nano::account> const &);
 	void process_batch (std::unique_lock<std::mutex> &);
 	void process_live (nano::block_hash const &, std::shared_ptr<nano::block>);
 	bool stopped;
 	bool active;
 	std::chrono::steady_clock::time_point next_log;
-	std::deque<nano::unchecked_info> state_blocks;
+	/** Blocks waiting for batch signature verification */
+	std::deque<nano::unchecked_info> unverified_blocks;
 	std::deque<nano::unchecked_info> blocks;
 	std::unordered_set<nano::block_hash> blocks_hashes;
 	std::deque<std::shared_ptr<nano::block>> forced;
@@ -8,6 +8,7 @@
 #include <boost/log/trivial.hpp>
 
 #include <algorithm>
+#include <fstream>
 
 constexpr double bootstrap_connection_scale_target_blocks = 50000.0;
 constexpr double bootstrap_connection_warmup_time_sec = 5.0;
@@ -18,6 +19,9 @@ constexpr unsigned bootstrap_frontier_retry_limit = 16;
 constexpr double bootstrap_minimum_termination_time_sec = 30.0;
 constexpr unsigned bootstrap_max_new_connections = 10;
 constexpr unsigned bulk_push_cost_limit = 200;
+constexpr size_t bulk_pull_work_validation_batch = 64;
+constexpr std::chrono::milliseconds bootstrap_read_transaction_max_age (500);
+constexpr size_t frontier_req_batch = 128;
 
 size_t constexpr nano::frontier_req_client::size_frontier;
 
@@ -370,6 +374,7 @@ void nano::bulk_pull_client::receive_block ()
 				this_l->connection->node->logger.try_log (boost::str (boost::format ("Error receiving block type: %1%") % ec.message ()));
 			}
 			this_l->connection->node->stats.inc (nano::stat::type::bootstrap, nano::stat::detail::bulk_pull_receive_block_failure, nano::stat::dir::in);
+			this_l->validate_blocks (nullptr);
 		}
 	});
 }
@@ -417,11 +422,13 @@ void nano::bulk_pull_client::received_type ()
 		}
 		case nano::block_type::not_a_block:
 		{
-			// Avoid re-using slow peers, or peers that sent the wrong blocks.
-			if (!connection->pending_stop && expected == pull.end)
-			{
-				connection->attempt->pool_connection (connection);
-			}
+			validate_blocks ([this_l]() {
+				// Avoid re-using slow peers, or peers that sent the wrong blocks.
+				if (!this_l->connection->pending_stop && this_l->expected == this_l->pull.end)
+				{
+					this_l->connection->attempt->pool_connection (this_l->connection);
+				}
+			});
 			break;
 		}
 		default:
@@ -430,6 +437,7 @@ void nano::bulk_pull_client::received_type ()
 			{
 				connection->node->logger.try_log (boost::str (boost::format ("Unknown type received as block type: %1%") % static_cast<int> (type)));
 			}
+			validate_blocks (nullptr);
 			break;
 		}
 	}
@@ -441,55 +449,19 @@ void nano::bulk_pull_client::received_block (boost::system::error_code const & e
 	{
 		nano::bufferstream stream (connection->receive_buffer->data (), size_a);
 		std::shared_ptr<nano::block> block (nano::deserialize_block (stream, type_a));
-		if (block != nullptr && !nano::work_validate (*block))
+		if (block != nullptr)
 		{
-			auto hash (block->hash ());
-			if (connection->node->config.logging.bulk_pull_logging ())
-			{
-				std::string block_l;
-				block->serialize_json (block_l);
-				connection->node->logger.try_log (boost::str (boost::format ("Pulled block %1% %2%") % hash.to_string () % block_l));
-			}
-			// Is block expected?
-			bool block_expected (false);
-			if (hash == expected)
+			blocks.push_back (block);
+			if (blocks.size () < bulk_pull_work_validation_batch)
 			{
-				expected = block->previous ();
-				block_expected = true;
+				receive_block ();
 			}
 			else
 			{
-				unexpected_count++;
-			}
-			if (total_blocks == 0 && block_expected)
-			{
-				known_account = block->account ();
-			}
-			if (connection->block_count++ == 0)
-			{
-				connection->start_time = std::chrono::steady_clock::now ();
-			}
-			connection->attempt->total_blocks++;
-			total_blocks++;
-			bool stop_pull (connection->attempt->process_block (block, known_account, total_blocks, block_expected));
-			if (!stop_pull && !connection->hard_stop.load ())
-			{
-				/* Process block in lazy pull if not stopped
-				Stop usual pull request with unexpected block & more than 16k blocks processed
-				to prevent spam */
-				if (connection->attempt->mode != nano::bootstrap_mode::legacy || unexpected_count < 16384)
-				{
-					receive_block ();
-				}
-			}
-			else if (stop_pull && block_expected)
-			{
-				expected = pull.end;
-				connection->attempt->pool_connection (connection);
-			}
-			if (stop_pull)
-			{
-				connection->attempt->lazy_stopped++;
+				auto this_l (shared_from_this ());
+				validate_blocks ([this_l]() {
+					this_l->receive_block ();
+				});
 			}
 		}
 		else
@@ -499,6 +471,7 @@ void nano::bulk_pull_client::received_block (boost::system::error_code const & e
 				connection->node->logger.try_log ("Error deserializing block received from pull request");
 			}
 			connection->node->stats.inc (nano::stat::type::bootstrap, nano::stat::detail::bulk_pull_deserialize_receive_block, nano::stat::dir::in);
+			validate_blocks (nullptr);
 		}
 	}
 	else
@@ -508,11 +481,120 @@ void nano::bulk_pull_client::received_block (boost::system::error_code const & e
 			connection->node->logger.try_log (boost::str (boost::format ("Error bulk receiving block: %1%") % ec.message ()));
 		}
 		connection->node->stats.inc (nano::stat::type::bootstrap, nano::stat::detail::bulk_pull_receive_block_failure, nano::stat::dir::in);
+		validate_blocks (nullptr);
 	}
 }
 
+void nano::bulk_pull_client::validate_blocks (std::function<void()> const & next_a)
+{
+	if (!blocks.empty ())
+	{
+		// Reading is paused until the batch is processed, next_a resumes it unless the pull has to stop
+		auto this_l (shared_from_this ());
+		connection->node->bootstrap_initiator.validate_work ([this_l, next_a]() {
+			if (this_l->process_blocks () && next_a != nullptr)
+			{
+				next_a ();
+			}
+		});
+	}
+	else if (next_a != nullptr)
+	{
+		next_a ();
+	}
+}
+
+bool nano::bulk_pull_client::process_blocks ()
+{
+	auto count (blocks.size ());
+	std::vector<nano::block_hash> roots;
+	std::vector<uint64_t> works;
+	roots.reserve (count);
+	works.reserve (count);
+	for (auto const & block : blocks)
+	{
+		roots.push_back (block->root ());
+		works.push_back (block->block_work ());
+	}
+	std::vector<uint64_t> values (count);
+	nano::work_value_batch (roots.data (), works.data (), values.data (), count);
+	auto threshold (connection->node->network_params.network.publish_threshold);
+	bool receive_more (true);
+	for (size_t i (0); i < count && receive_more; ++i)
+	{
+		if (values[i] >= threshold)
+		{
+			receive_more = process_block (blocks[i]);
+		}
+		else
+		{
+			if (connection->node->config.logging.bulk_pull_logging ())
+			{
+				connection->node->logger.try_log (boost::str (boost::format ("Insufficient work for block %1% received from pull request") % blocks[i]->hash ().to_string ()));
+			}
+			connection->node->stats.inc (nano::stat::type::bootstrap, nano::stat::detail::insufficient_work, nano::stat::dir::in);
+			receive_more = false;
+		}
+	}
+	blocks.clear ();
+	return receive_more;
+}
+
+bool nano::bulk_pull_client::process_block (std::shared_ptr<nano::block> block_a)
+{
+	auto hash (block_a->hash ());
+	if (connection->node->config.logging.bulk_pull_logging ())
+	{
+		std::string block_l;
+		block_a->serialize_json (block_l);
+		connection->node->logger.try_log (boost::str (boost::format ("Pulled block %1% %2%") % hash.to_string () % block_l));
+	}
+	// Is block expected?
+	bool block_expected (false);
+	if (hash == expected)
+	{
+		expected = block_a->previous ();
+		block_expected = true;
+	}
+	else
+	{
+		unexpected_count++;
+	}
+	if (total_blocks == 0 && block_expected)
+	{
+		known_account = block_a->account ();
+	}
+	if (connection->block_count++ == 0)
+	{
+		connection->start_time = std::chrono::steady_clock::now ();
+	}
+	connection->attempt->total_blocks++;
+	total_blocks++;
+	bool receive_more (false);
+	bool stop_pull (connection->attempt->process_block (block_a, known_account, total_blocks, block_expected));
+	if (!stop_pull && !connection->hard_stop.load ())
+	{
+		/* Process block in lazy pull if not stopped
+		Stop usual pull request with unexpected block & more than 16k blocks processed
+		to prevent spam */
+		receive_more = connection->attempt->mode != nano::bootstrap_mode::legacy || unexpected_count < 16384;
+	}
+	else if (stop_pull && block_expected)
+	{
+		expected = pull.end;
+		connection->attempt->pool_connection (connection);
+	}
+	if (stop_pull)
+	{
+		connection->attempt->lazy_stopped++;
+	}
+	return receive_more;
+}
+
 nano::bulk_push_client::bulk_push_client (std::shared_ptr<nano::bootstrap_client> const & connection_a) :
-connection (connection_a)
+connection (connection_a),
+transaction (connection_a->node->store.tx_begin_read ()),
+transaction_start (std::chrono::steady_clock::now ())
 {
 }
 
@@ -526,10 +608,9 @@ void nano::bulk_push_client::start ()
 	auto this_l (shared_from_this ());
 	connection->channel->send (
 	message, [this_l](boost::system::error_code const & ec, size_t size_a) {
-		auto transaction (this_l->connection->node->store.tx_begin_read ());
 		if (!ec)
 		{
-			this_l->push (transaction);
+			this_l->push ();
 		}
 		else
 		{
@@ -542,8 +623,15 @@ void nano::bulk_push_client::start ()
 	false); // is bootstrap traffic is_dropable false
 }
 
-void nano::bulk_push_client::push (nano::transaction const & transaction_a)
+void nano::bulk_push_client::push ()
 {
+	auto now (std::chrono::steady_clock::now ());
+	if (now - transaction_start > bootstrap_read_transaction_max_age)
+	{
+		// Don't pin an old snapshot while pushing to a slow peer
+		transaction.refresh ();
+		transaction_start = now;
+	}
 	std::shared_ptr<nano::block> block;
 	bool finished (false);
 	while (block == nullptr && !finished)
@@ -563,7 +651,7 @@ void nano::bulk_push_client::push (nano::transaction const & transaction_a)
 		}
 		if (!finished)
 		{
-			block = connection->node->store.block_get (transaction_a, current_target.first);
+			block = connection->node->store.block_get (transaction, current_target.first);
 			if (block == nullptr)
 			{
 				current_target.first = nano::block_hash (0);
@@ -615,8 +703,7 @@ void nano::bulk_push_client::push_block (nano::block const & block_a)
 	connection->channel->send_buffer (buffer, nano::stat::detail::all, [this_l](boost::system::error_code const & ec, size_t size_a) {
 		if (!ec)
 		{
-			auto transaction (this_l->connection->node->store.tx_begin_read ());
-			this_l->push (transaction);
+			this_l->push ();
 		}
 		else
 		{
@@ -749,6 +836,336 @@ void nano::bulk_pull_account_client::receive_pending ()
 	});
 }
 
+nano::ledger_snapshot_client::ledger_snapshot_client (std::shared_ptr<nano::bootstrap_client> const & connection_a, std::unordered_set<nano::block_hash> const & anchors_a) :
+connection (connection_a),
+chunk (std::make_shared<std::vector<uint8_t>> ()),
+anchors (anchors_a)
+{
+	// The genesis block is implicitly trusted
+	nano::genesis genesis;
+	anchors.insert (genesis.hash ());
+}
+
+bool nano::ledger_snapshot_client::run ()
+{
+	auto & node (*connection->node);
+	auto error (false);
+	{
+		auto transaction (node.store.tx_begin_read ());
+		error = node.store.block_count (transaction).sum () != 1;
+	}
+	if (!error)
+	{
+		// The snapshot is downloaded before taking the write lock so the transfer doesn't hold up other ledger writers
+		auto path (node.application_path / "ledger_snapshot.tmp");
+		std::fstream file (path.string (), std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+		error = !file || download (file);
+		if (!error)
+		{
+			file.seekg (0);
+			auto scoped_write_guard = node.write_database_queue.wait (nano::writer::ledger_snapshot);
+			auto transaction (node.store.tx_begin_write ());
+			// Blocks may have been processed during the download
+			if (node.store.block_count (transaction).sum () == 1)
+			{
+				node.store.ledger_clear (transaction);
+				while (!error && !finished)
+				{
+					error = read_chunk (file) || process_chunk (transaction);
+				}
+				error = error || supply != node.network_params.ledger.genesis_amount || !anchors.empty ();
+				if (error)
+				{
+					// Write transactions cannot be aborted, restore the genesis only ledger instead
+					node.store.ledger_clear (transaction);
+					nano::genesis genesis;
+					node.store.initialize (transaction, genesis);
+				}
+			}
+			else
+			{
+				error = true;
+			}
+		}
+		file.close ();
+		boost::system::error_code ec;
+		boost::filesystem::remove (path, ec);
+		if (error)
+		{
+			node.stats.inc (nano::stat::type::bootstrap, nano::stat::detail::ledger_snapshot_failure, nano::stat::dir::in);
+		}
+		node.logger.try_log (boost::str (boost::format ("Ledger snapshot %1% with %2% blocks, %3% accounts and %4% pending entries") % (error ? "failed" : "imported") % block_count % account_count % pending_count));
+	}
+	else
+	{
+		node.logger.try_log ("Ledger snapshots can only be imported into a ledger containing just the genesis block");
+	}
+	return error;
+}
+
+bool nano::ledger_snapshot_client::download (std::ostream & stream_a)
+{
+	auto future (request ());
+	auto error (connection->attempt->consume_future (future));
+	auto done (false);
+	while (!error && !done)
+	{
+		future = receive_chunk ();
+		error = connection->attempt->consume_future (future);
+		if (!error)
+		{
+			// Chunks are stored with their length, the empty chunk ending the stream is kept as well
+			done = chunk->empty ();
+			uint32_t size (chunk->size ());
+			stream_a.write (reinterpret_cast<char const *> (&size), sizeof (size));
+			stream_a.write (reinterpret_cast<char const *> (chunk->data ()), chunk->size ());
+			error = !stream_a;
+		}
+	}
+	stream_a.flush ();
+	return error || !stream_a;
+}
+
+bool nano::ledger_snapshot_client::read_chunk (std::istream & stream_a)
+{
+	uint32_t size (0);
+	stream_a.read (reinterpret_cast<char *> (&size), sizeof (size));
+	auto error (!stream_a || size == 0 || size > nano::ledger_snapshot_client::chunk_size_max);
+	if (!error)
+	{
+		chunk->resize (size);
+		stream_a.read (reinterpret_cast<char *> (chunk->data ()), size);
+		error = !stream_a;
+	}
+	return error;
+}
+
+std::future<bool> nano::ledger_snapshot_client::request ()
+{
+	auto promise (std::make_shared<std::promise<bool>> ());
+	auto result (promise->get_future ());
+	nano::ledger_snapshot_req message;
+	auto this_l (shared_from_this ());
+	connection->channel->send (
+	message, [this_l, promise](boost::system::error_code const & ec, size_t size_a) {
+		if (ec && this_l->connection->node->config.logging.bulk_pull_logging ())
+		{
+			this_l->connection->node->logger.try_log (boost::str (boost::format ("Unable to send ledger_snapshot_req request: %1%") % ec.message ()));
+		}
+		promise->set_value (!!ec);
+	},
+	false); // is bootstrap traffic is_dropable false
+	return result;
+}
+
+std::future<bool> nano::ledger_snapshot_client::receive_chunk ()
+{
+	// If the socket is closed the callbacks are dropped along with the promise, which fails the future
+	auto promise (std::make_shared<std::promise<bool>> ());
+	auto result (promise->get_future ());
+	auto this_l (shared_from_this ());
+	connection->channel->socket->async_read (connection->receive_buffer, sizeof (uint32_t), [this_l, promise](boost::system::error_code const & ec, size_t size_a) {
+		auto error (ec || size_a != sizeof (uint32_t));
+		if (!error)
+		{
+			uint32_t size;
+			nano::bufferstream stream (this_l->connection->receive_buffer->data (), size_a);
+			nano::read (stream, size);
+			boost::endian::big_to_native_inplace (size);
+			error = size > nano::ledger_snapshot_client::chunk_size_max;
+			if (!error && size == 0)
+			{
+				// An empty chunk ends the stream
+				this_l->chunk->clear ();
+				promise->set_value (false);
+			}
+			else if (!error)
+			{
+				this_l->chunk->resize (size);
+				this_l->connection->channel->socket->async_read (this_l->chunk, size, [this_l, promise, size](boost::system::error_code const & ec, size_t size_a) {
+					promise->set_value (ec || size_a != size);
+				});
+			}
+		}
+		if (error)
+		{
+			if (this_l->connection->node->config.logging.bulk_pull_logging ())
+			{
+				this_l->connection->node->logger.try_log (boost::str (boost::format ("Error receiving ledger snapshot chunk: %1%") % ec.message ()));
+			}
+			promise->set_value (true);
+		}
+	});
+	return result;
+}
+
+bool nano::ledger_snapshot_client::process_chunk (nano::transaction const & transaction_a)
+{
+	nano::bufferstream stream (chunk->data (), chunk->size ());
+	auto error (false);
+	nano::ledger_snapshot_entry type;
+	while (!error && !finished && !nano::try_read (stream, type))
+	{
+		switch (type)
+		{
+			case nano::ledger_snapshot_entry::block:
+				error = process_block (transaction_a, stream);
+				break;
+			case nano::ledger_snapshot_entry::account:
+				error = process_account (transaction_a, stream);
+				break;
+			case nano::ledger_snapshot_entry::pending:
+				error = process_pending (transaction_a, stream);
+				break;
+			case nano::ledger_snapshot_entry::representation:
+				error = process_representation (transaction_a, stream);
+				break;
+			case nano::ledger_snapshot_entry::end:
+				error = process_end (stream);
+				break;
+			default:
+				error = true;
+				break;
+		}
+	}
+	return error;
+}
+
+bool nano::ledger_snapshot_client::process_block (nano::transaction const & transaction_a, nano::stream & stream_a)
+{
+	nano::block_type type;
+	nano::epoch epoch;
+	auto error (nano::try_read (stream_a, type) || nano::try_read (stream_a, epoch));
+	if (!error)
+	{
+		auto block (nano::deserialize_block (stream_a, type));
+		nano::block_sideband sideband;
+		sideband.type = type;
+		error = block == nullptr || sideband.deserialize (stream_a);
+		if (!error)
+		{
+			auto hash (block->hash ());
+			if (chain_height == 0)
+			{
+				// Every chain starts with the open block of its account
+				chain_account = block->account ();
+				chain_open = hash;
+				error = !block->previous ().is_zero () || chain_account.is_zero ();
+			}
+			else
+			{
+				error = block->previous () != chain_head || chain_successor != hash;
+			}
+			error = error || sideband.height != chain_height + 1;
+			error = error || (type == nano::block_type::state ? (epoch != nano::epoch::epoch_0 && epoch != nano::epoch::epoch_1) || block->account () != chain_account : epoch != nano::epoch::epoch_0);
+			error = error || (type != nano::block_type::state && type != nano::block_type::open && sideband.account != chain_account);
+			if (!error)
+			{
+				connection->node->store.block_import (transaction_a, hash, *block, sideband, epoch);
+				anchors.erase (hash);
+				++chain_height;
+				chain_head = hash;
+				chain_successor = sideband.successor;
+				chain_head_block = block;
+				chain_head_sideband = sideband;
+				chain_head_epoch = epoch;
+				++block_count;
+			}
+		}
+	}
+	return error;
+}
+
+bool nano::ledger_snapshot_client::process_account (nano::transaction const & transaction_a, nano::stream & stream_a)
+{
+	auto & store (connection->node->store);
+	nano::account account;
+	nano::account_info info;
+	auto error (nano::try_read (stream_a, account.bytes) || info.deserialize (stream_a) || nano::try_read (stream_a, info.epoch));
+	error = error || chain_height == 0 || account != chain_account || (account_count != 0 && !(previous_account < account));
+	error = error || info.open_block != chain_open || info.head != chain_head || !chain_successor.is_zero () || info.epoch != chain_head_epoch;
+	error = error || info.block_count != chain_height || info.confirmation_height != chain_height || info.balance.number () != store.block_balance_calculated (chain_head_block, chain_head_sideband);
+	if (!error)
+	{
+		nano::representative_visitor visitor (transaction_a, store);
+		visitor.compute (info.head);
+		error = visitor.result != info.rep_block;
+	}
+	if (!error)
+	{
+		auto representative (store.block_get (transaction_a, info.rep_block)->representative ());
+		weights[representative] += info.balance.number ();
+		supply += info.balance.number ();
+		store.account_append (transaction_a, account, info);
+		store.delegator_put (transaction_a, representative, account);
+		if (chain_head_block->type () != nano::block_type::state)
+		{
+			store.frontier_put (transaction_a, info.head, account);
+		}
+		previous_account = account;
+		++account_count;
+		chain_height = 0;
+	}
+	return error;
+}
+
+bool nano::ledger_snapshot_client::process_pending (nano::transaction const & transaction_a, nano::stream & stream_a)
+{
+	auto & node (*connection->node);
+	nano::pending_key key;
+	nano::pending_info pending;
+	auto error (key.deserialize (stream_a) || pending.deserialize (stream_a) || nano::try_read (stream_a, pending.epoch));
+	error = error || chain_height != 0 || (pending_count != 0 && !(previous_pending < key));
+	if (!error)
+	{
+		// The send has to be part of the snapshot, the supply check rejects sends which were also received
+		auto send (node.store.block_get (transaction_a, key.hash));
+		error = send == nullptr || node.ledger.block_destination (transaction_a, *send) != key.account || node.ledger.account (transaction_a, key.hash) != pending.source || node.ledger.amount (transaction_a, key.hash) != pending.amount.number ();
+		error = error || pending.epoch != (send->type () == nano::block_type::state ? node.store.block_version (transaction_a, key.hash) : nano::epoch::epoch_0);
+	}
+	if (!error)
+	{
+		supply += pending.amount.number ();
+		node.store.pending_append (transaction_a, key, pending);
+		previous_pending = key;
+		++pending_count;
+	}
+	return error;
+}
+
+bool nano::ledger_snapshot_client::process_representation (nano::transaction const & transaction_a, nano::stream & stream_a)
+{
+	nano::account representative;
+	nano::amount weight;
+	auto error (nano::try_read (stream_a, representative.bytes) || nano::try_read (stream_a, weight.bytes));
+	error = error || chain_height != 0 || (representation_count != 0 && !(previous_representative < representative));
+	if (!error)
+	{
+		// Weights have to match the ones calculated from the received accounts
+		auto existing (weights.find (representative));
+		error = existing == weights.end () || existing->second != weight.number ();
+		if (!error)
+		{
+			weights.erase (existing);
+			connection->node->store.representation_append (transaction_a, representative, weight.number ());
+			previous_representative = representative;
+			++representation_count;
+		}
+	}
+	return error;
+}
+
+bool nano::ledger_snapshot_client::process_end (nano::stream & stream_a)
+{
+	uint64_t blocks;
+	uint64_t accounts;
+	uint64_t pending;
+	auto error (nano::try_read (stream_a, blocks) || nano::try_read (stream_a, accounts) || nano::try_read (stream_a, pending));
+	error = error || chain_height != 0 || !weights.empty () || blocks != block_count || accounts != account_count || pending != pending_count;
+	finished = true;
+	return error;
+}
+
 nano::pull_info::pull_info (nano::account const & account_a, nano::block_hash const & head_a, nano::block_hash const & end_a, count_t count_a) :
 account (account_a),
 head (head_a),
@@ -1216,6 +1633,11 @@ void nano::bootstrap_attempt::stop ()
 		{
 		}
 	}
+	if (auto i = snapshot.lock ())
+	{
+		// Aborts the outstanding chunk read, failing the import
+		i->connection->channel->socket->close ();
+	}
 }
 
 void nano::bootstrap_attempt::add_pull (nano::pull_info const & pull_a)
@@ -1271,7 +1693,7 @@ void nano::bootstrap_attempt::lazy_start (nano::block_hash const & hash_a)
 	std::unique_lock<std::mutex> lock (lazy_mutex);
 	// Add start blocks, limit 1024 (32k with disabled legacy bootstrap)
 	size_t max_keys (node->flags.disable_legacy_bootstrap ? 32 * 1024 : 1024);
-	if (lazy_keys.size () < max_keys && lazy_keys.find (hash_a) == lazy_keys.end () && lazy_blocks.find (hash_a) == lazy_blocks.end ())
+	if (!hash_a.is_zero () && lazy_keys.size () < max_keys && lazy_keys.find (hash_a) == lazy_keys.end () && lazy_blocks.find (hash_a) == lazy_blocks.end ())
 	{
 		lazy_keys.insert (hash_a);
 		lazy_pulls.push_back (hash_a);
@@ -1310,19 +1732,24 @@ bool nano::bootstrap_attempt::lazy_finished ()
 	bool result (true);
 	auto transaction (node->store.tx_begin_read ());
 	std::unique_lock<std::mutex> lock (lazy_mutex);
-	for (auto it (lazy_keys.begin ()), end (lazy_keys.end ()); it != end && !stopped;)
+	std::vector<nano::block_hash> processed;
+	for (auto it (lazy_keys.begin ()), end (lazy_keys.end ()); it != end && !stopped; ++it)
 	{
 		if (node->store.block_exists (transaction, *it))
 		{
-			it = lazy_keys.erase (it);
+			processed.push_back (*it);
 		}
 		else
 		{
 			result = false;
 			break;
-			// No need to increment `it` as we break above.
 		}
 	}
+	// Erasing shifts entries within the table, so processed keys are removed after iterating
+	for (auto const & hash : processed)
+	{
+		lazy_keys.erase (hash);
+	}
 	// Finish lazy bootstrap without lazy pulls (in combination with still_pulling ())
 	if (!result && lazy_pulls.empty ())
 	{
@@ -1478,17 +1905,17 @@ bool nano::bootstrap_attempt::process_block (std::shared_ptr<nano::block> block_
 								auto previous_balance (lazy_balances.find (previous));
 								if (previous_balance != lazy_balances.end ())
 								{
-									if (previous_balance->second <= balance)
+									if (previous_balance->second.number () <= balance)
 									{
 										lazy_add (link);
 									}
-									lazy_balances.erase (previous_balance);
+									lazy_balances.erase (previous);
 								}
 							}
 							// Insert in unknown state blocks if previous wasn't already processed
 							else
 							{
-								lazy_state_unknown.insert (std::make_pair (previous, std::make_pair (link, balance)));
+								lazy_state_unknown.insert (std::make_pair (previous, std::make_pair (link, nano::amount (balance))));
 							}
 						}
 					}
@@ -1497,7 +1924,7 @@ bool nano::bootstrap_attempt::process_block (std::shared_ptr<nano::block> block_
 				// Adding lazy balances
 				if (total_blocks == 0)
 				{
-					lazy_balances.insert (std::make_pair (hash, balance));
+					lazy_balances.insert (std::make_pair (hash, nano::amount (balance)));
 				}
 				// Removing lazy balances
 				if (!block_a->previous ().is_zero () && lazy_balances.find (block_a->previous ()) != lazy_balances.end ())
@@ -1526,7 +1953,7 @@ bool nano::bootstrap_attempt::process_block (std::shared_ptr<nano::block> block_
 				if (block_a->type () == nano::block_type::state)
 				{
 					std::shared_ptr<nano::state_block> block_l (std::static_pointer_cast<nano::state_block> (block_a));
-					if (block_l->hashables.balance.number () <= next_block.second)
+					if (block_l->hashables.balance.number () <= next_block.second.number ())
 					{
 						lazy_add (next_block.first);
 					}
@@ -1535,7 +1962,7 @@ bool nano::bootstrap_attempt::process_block (std::shared_ptr<nano::block> block_
 				else if (block_a->type () == nano::block_type::send)
 				{
 					std::shared_ptr<nano::send_block> block_l (std::static_pointer_cast<nano::send_block> (block_a));
-					if (block_l->hashables.balance.number () <= next_block.second)
+					if (block_l->hashables.balance.number () <= next_block.second.number ())
 					{
 						lazy_add (next_block.first);
 					}
@@ -1649,6 +2076,32 @@ void nano::bootstrap_attempt::wallet_run ()
 	idle.clear ();
 }
 
+void nano::bootstrap_attempt::snapshot_run ()
+{
+	std::unique_lock<std::mutex> lock (mutex);
+	// Only the requested peer is used, wait for it to connect or for the connection attempt to fail
+	while (!stopped && idle.empty () && connections > 0)
+	{
+		condition.wait_for (lock, std::chrono::seconds (1));
+	}
+	auto connection_l (!stopped && !idle.empty () ? connection (lock) : nullptr);
+	if (connection_l != nullptr)
+	{
+		auto client (std::make_shared<nano::ledger_snapshot_client> (connection_l, snapshot_anchors));
+		snapshot = client;
+		lock.unlock ();
+		client->run ();
+		lock.lock ();
+	}
+	else
+	{
+		node->logger.try_log ("Unable to connect to ledger snapshot peer");
+	}
+	stopped = true;
+	condition.notify_all ();
+	idle.clear ();
+}
+
 nano::bootstrap_initiator::bootstrap_initiator (nano::node & node_a) :
 node (node_a),
 stopped (false),
@@ -1657,6 +2110,13 @@ thread ([this]() {
 	run_bootstrap ();
 })
 {
+	for (auto i (0u), n (std::max (1u, node.config.bootstrap_work_validation_threads)); i < n; ++i)
+	{
+		work_validation_threads.push_back (boost::thread ([this]() {
+			nano::thread_role::set (nano::thread_role::name::bootstrap_work_validation);
+			run_work_validation ();
+		}));
+	}
 }
 
 nano::bootstrap_initiator::~bootstrap_initiator ()
@@ -1732,6 +2192,24 @@ void nano::bootstrap_initiator::bootstrap_wallet (std::deque<nano::account> & ac
 	condition.notify_all ();
 }
 
+void nano::bootstrap_initiator::bootstrap_snapshot (nano::endpoint const & endpoint_a, std::vector<nano::block_hash> const & anchors_a)
+{
+	std::unique_lock<std::mutex> lock (mutex);
+	if (!stopped)
+	{
+		while (attempt != nullptr)
+		{
+			attempt->stop ();
+			condition.wait (lock);
+		}
+		node.stats.inc (nano::stat::type::bootstrap, nano::stat::detail::initiate_snapshot, nano::stat::dir::out);
+		attempt = std::make_shared<nano::bootstrap_attempt> (node.shared (), nano::bootstrap_mode::snapshot);
+		attempt->snapshot_anchors.insert (anchors_a.begin (), anchors_a.end ());
+		attempt->add_connection (endpoint_a);
+		condition.notify_all ();
+	}
+}
+
 void nano::bootstrap_initiator::run_bootstrap ()
 {
 	std::unique_lock<std::mutex> lock (mutex);
@@ -1748,6 +2226,10 @@ void nano::bootstrap_initiator::run_bootstrap ()
 			{
 				attempt->lazy_run ();
 			}
+			else if (attempt->mode == nano::bootstrap_mode::snapshot)
+			{
+				attempt->snapshot_run ();
+			}
 			else
 			{
 				attempt->wallet_run ();
@@ -1780,6 +2262,42 @@ std::shared_ptr<nano::bootstrap_attempt> nano::bootstrap_initiator::current_atte
 	return attempt;
 }
 
+void nano::bootstrap_initiator::validate_work (std::function<void()> const & action_a)
+{
+	{
+		std::lock_guard<std::mutex> guard (work_validation_mutex);
+		if (!stopped)
+		{
+			work_validation.push_back (action_a);
+		}
+	}
+	work_validation_condition.notify_all ();
+}
+
+void nano::bootstrap_initiator::run_work_validation ()
+{
+	std::unique_lock<std::mutex> lock (work_validation_mutex);
+	while (!stopped)
+	{
+		if (!work_validation.empty ())
+		{
+			auto action (std::move (work_validation.front ()));
+			work_validation.pop_front ();
+			lock.unlock ();
+			action ();
+			lock.lock ();
+		}
+		else
+		{
+			work_validation_condition.wait (lock);
+		}
+	}
+	// Queued actions hold pull clients, release them outside the lock so unfinished pulls get requeued
+	std::deque<std::function<void()>> discarded;
+	discarded.swap (work_validation);
+	lock.unlock ();
+}
+
 void nano::bootstrap_initiator::stop ()
 {
 	if (!stopped.exchange (true))
@@ -1797,6 +2315,17 @@ void nano::bootstrap_initiator::stop ()
 		{
 			thread.join ();
 		}
+		{
+			std::lock_guard<std::mutex> guard (work_validation_mutex);
+		}
+		work_validation_condition.notify_all ();
+		for (auto & work_validation_thread : work_validation_threads)
+		{
+			if (work_validation_thread.joinable ())
+			{
+				work_validation_thread.join ();
+			}
+		}
 	}
 }
 
@@ -1829,6 +2358,31 @@ std::unique_ptr<seq_con_info_component> collect_seq_con_info (bootstrap_initiato
 	auto composite = std::make_unique<seq_con_info_composite> (name);
 	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "observers", count, sizeof_element }));
 	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "pulls_cache", cache_count, sizeof_cache_element }));
+	size_t work_validation_count = 0;
+	{
+		std::lock_guard<std::mutex> guard (bootstrap_initiator.work_validation_mutex);
+		work_validation_count = bootstrap_initiator.work_validation.size ();
+	}
+	auto sizeof_work_validation_element = sizeof (decltype (bootstrap_initiator.work_validation)::value_type);
+	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "work_validation", work_validation_count, sizeof_work_validation_element }));
+	auto attempt (bootstrap_initiator.current_attempt ());
+	if (attempt != nullptr)
+	{
+		composite->add_component (collect_seq_con_info (*attempt, "attempt"));
+	}
+	return composite;
+}
+
+std::unique_ptr<seq_con_info_component> collect_seq_con_info (bootstrap_attempt & bootstrap_attempt, const std::string & name)
+{
+	auto composite = std::make_unique<seq_con_info_composite> (name);
+	std::lock_guard<std::mutex> guard (bootstrap_attempt.lazy_mutex);
+	// Flat tables are reported by allocated slots so that the totals reflect their real memory usage
+	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "lazy_blocks", bootstrap_attempt.lazy_blocks.capacity (), sizeof (decltype (bootstrap_attempt.lazy_blocks)::value_type) }));
+	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "lazy_state_unknown", bootstrap_attempt.lazy_state_unknown.capacity (), sizeof (decltype (bootstrap_attempt.lazy_state_unknown)::value_type) }));
+	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "lazy_balances", bootstrap_attempt.lazy_balances.capacity (), sizeof (decltype (bootstrap_attempt.lazy_balances)::value_type) }));
+	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "lazy_keys", bootstrap_attempt.lazy_keys.capacity (), sizeof (decltype (bootstrap_attempt.lazy_keys)::value_type) }));
+	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "lazy_pulls", bootstrap_attempt.lazy_pulls.size (), sizeof (decltype (bootstrap_attempt.lazy_pulls)::value_type) }));
 	return composite;
 }
 }
@@ -2023,6 +2577,16 @@ void nano::bootstrap_server::receive_header_action (boost::system::error_code co
 					}
 					break;
 				}
+				case nano::message_type::ledger_snapshot_req:
+				{
+					node->stats.inc (nano::stat::type::bootstrap, nano::stat::detail::ledger_snapshot, nano::stat::dir::in);
+					// Serving the whole cemented ledger is expensive, only nodes opting in answer these requests
+					if (node->config.ledger_snapshot_server && is_bootstrap_connection ())
+					{
+						add_request (std::unique_ptr<nano::message> (new nano::ledger_snapshot_req (header)));
+					}
+					break;
+				}
 				case nano::message_type::keepalive:
 				{
 					auto this_l (shared_from_this ());
@@ -2407,6 +2971,22 @@ public:
 		auto response (std::make_shared<nano::frontier_req_server> (connection, std::unique_ptr<nano::frontier_req> (static_cast<nano::frontier_req *> (connection->requests.front ().release ()))));
 		response->send_next ();
 	}
+	void ledger_snapshot_req (nano::ledger_snapshot_req const &) override
+	{
+		if (!connection->node->bootstrap.ledger_snapshot_serving.exchange (true))
+		{
+			auto response (std::make_shared<nano::ledger_snapshot_server> (connection));
+			response->start ();
+		}
+		else
+		{
+			if (connection->node->config.logging.bulk_pull_logging ())
+			{
+				connection->node->logger.try_log (boost::str (boost::format ("Refusing ledger snapshot request from %1%, another snapshot is being served") % connection->remote_endpoint));
+			}
+			connection->stop ();
+		}
+	}
 	void node_id_handshake (nano::node_id_handshake const & message_a) override
 	{
 		if (connection->node->config.logging.network_node_id_handshake_logging ())
@@ -3166,13 +3746,309 @@ void nano::bulk_push_server::received_block (boost::system::error_code const & e
 	}
 }
 
+nano::ledger_snapshot_server::ledger_snapshot_server (std::shared_ptr<nano::bootstrap_server> const & connection_a) :
+connection (connection_a),
+transaction (connection_a->node->store.tx_begin_read ()),
+send_buffer (std::make_shared<std::vector<uint8_t>> ())
+{
+}
+
+nano::ledger_snapshot_server::~ledger_snapshot_server ()
+{
+	connection->node->bootstrap.ledger_snapshot_serving = false;
+}
+
+void nano::ledger_snapshot_server::start ()
+{
+	// Reading every confirmation height can take a while on large ledgers, keep it off the thread handling the connection
+	auto this_l (shared_from_this ());
+	connection->node->background ([this_l]() {
+		auto & store (this_l->connection->node->store);
+		for (auto i (store.latest_begin (this_l->transaction)), n (store.latest_end ()); i != n; ++i)
+		{
+			if (i->second.confirmation_height != 0)
+			{
+				this_l->heights.emplace_back (i->first, i->second.confirmation_height);
+			}
+		}
+		this_l->send_next ();
+	});
+}
+
+void nano::ledger_snapshot_server::send_next ()
+{
+	send_buffer->clear ();
+	{
+		nano::vectorstream stream (*send_buffer);
+		// Placeholder for the chunk length
+		nano::write (stream, uint32_t (0));
+		while (send_buffer->size () < chunk_size && phase != nano::ledger_snapshot_phase::finished)
+		{
+			next (stream);
+			stream.pubsync ();
+		}
+	}
+	auto size (boost::endian::native_to_big (static_cast<uint32_t> (send_buffer->size () - sizeof (uint32_t))));
+	std::memcpy (send_buffer->data (), &size, sizeof (size));
+	if (phase == nano::ledger_snapshot_phase::finished)
+	{
+		// An empty chunk ends the stream
+		nano::vectorstream stream (*send_buffer);
+		nano::write (stream, uint32_t (0));
+	}
+	// Nothing read so far is kept across chunks, so the transaction doesn't need to be held while the peer is reading
+	transaction.reset ();
+	auto this_l (shared_from_this ());
+	connection->socket->async_write (send_buffer, [this_l](boost::system::error_code const & ec, size_t size_a) {
+		this_l->sent_action (ec, size_a);
+	});
+}
+
+void nano::ledger_snapshot_server::sent_action (boost::system::error_code const & ec, size_t size_a)
+{
+	if (!ec)
+	{
+		if (phase != nano::ledger_snapshot_phase::finished)
+		{
+			transaction.renew ();
+			send_next ();
+		}
+		else
+		{
+			if (connection->node->config.logging.bulk_pull_logging ())
+			{
+				connection->node->logger.try_log (boost::str (boost::format ("Ledger snapshot sent with %1% blocks, %2% accounts and %3% pending entries") % block_count % account_count % pending_count));
+			}
+			connection->finish_request ();
+		}
+	}
+	else
+	{
+		if (connection->node->config.logging.bulk_pull_logging ())
+		{
+			connection->node->logger.try_log (boost::str (boost::format ("Unable to send ledger snapshot chunk: %1%") % ec.message ()));
+		}
+	}
+}
+
+void nano::ledger_snapshot_server::next (nano::stream & stream_a)
+{
+	switch (phase)
+	{
+		case nano::ledger_snapshot_phase::accounts:
+			next_account (stream_a);
+			break;
+		case nano::ledger_snapshot_phase::pending:
+			next_pending (stream_a);
+			break;
+		case nano::ledger_snapshot_phase::representation:
+			next_representation (stream_a);
+			break;
+		case nano::ledger_snapshot_phase::end:
+			nano::write (stream_a, nano::ledger_snapshot_entry::end);
+			nano::write (stream_a, block_count);
+			nano::write (stream_a, account_count);
+			nano::write (stream_a, pending_count);
+			phase = nano::ledger_snapshot_phase::finished;
+			break;
+		case nano::ledger_snapshot_phase::finished:
+			assert (false);
+			break;
+	}
+}
+
+void nano::ledger_snapshot_server::next_account (nano::stream & stream_a)
+{
+	auto & store (connection->node->store);
+	if (chain_remaining == 0)
+	{
+		if (current_account < heights.size ())
+		{
+			chain_account = heights[current_account].first;
+			chain_remaining = heights[current_account].second;
+			chain_info = cemented_info (chain_account, chain_remaining);
+			chain_next = chain_info.open_block;
+		}
+		else
+		{
+			phase = nano::ledger_snapshot_phase::pending;
+		}
+	}
+	else
+	{
+		nano::block_sideband sideband;
+		auto block (store.block_get (transaction, chain_next, &sideband));
+		assert (block != nullptr);
+		auto epoch (block->type () == nano::block_type::state ? store.block_version (transaction, chain_next) : nano::epoch::epoch_0);
+		chain_next = sideband.successor;
+		if (--chain_remaining == 0)
+		{
+			// Uncemented successors are not part of the snapshot
+			sideband.successor.clear ();
+		}
+		nano::write (stream_a, nano::ledger_snapshot_entry::block);
+		nano::write (stream_a, block->type ());
+		nano::write (stream_a, epoch);
+		block->serialize (stream_a);
+		sideband.serialize (stream_a);
+		++block_count;
+		if (chain_remaining == 0)
+		{
+			nano::write (stream_a, nano::ledger_snapshot_entry::account);
+			nano::write (stream_a, chain_account.bytes);
+			chain_info.serialize (stream_a);
+			nano::write (stream_a, chain_info.epoch);
+			++account_count;
+			weights[store.block_get (transaction, chain_info.rep_block)->representative ()] += chain_info.balance.number ();
+			++current_account;
+		}
+	}
+}
+
+void nano::ledger_snapshot_server::next_pending (nano::stream & stream_a)
+{
+	auto & store (connection->node->store);
+	if (pending.empty ())
+	{
+		// Move on to the next account which either has pending entries or a chain which might have received a send of the snapshot
+		boost::optional<nano::account> destination;
+		if (!pending_finished)
+		{
+			auto existing_pending (store.pending_begin (transaction, nano::pending_key (pending_start, 0)));
+			if (existing_pending != store.pending_end ())
+			{
+				destination = existing_pending->first.account;
+			}
+			auto existing_account (store.latest_begin (transaction, pending_start));
+			if (existing_account != store.latest_end () && (!destination || existing_account->first < *destination))
+			{
+				destination = existing_account->first;
+			}
+		}
+		if (destination)
+		{
+			collect_pending (*destination);
+			pending_finished = destination->number () == std::numeric_limits<nano::uint256_t>::max ();
+			pending_start = destination->number () + 1;
+		}
+		else
+		{
+			phase = nano::ledger_snapshot_phase::representation;
+		}
+	}
+	else
+	{
+		auto entry (pending.begin ());
+		nano::write (stream_a, nano::ledger_snapshot_entry::pending);
+		entry->first.serialize (stream_a);
+		entry->second.serialize (stream_a);
+		nano::write (stream_a, entry->second.epoch);
+		pending.erase (entry);
+		++pending_count;
+	}
+}
+
+void nano::ledger_snapshot_server::next_representation (nano::stream & stream_a)
+{
+	if (!weights.empty ())
+	{
+		nano::write (stream_a, nano::ledger_snapshot_entry::representation);
+		nano::write (stream_a, weights.begin ()->first.bytes);
+		nano::write (stream_a, nano::amount (weights.begin ()->second).bytes);
+		weights.erase (weights.begin ());
+	}
+	else
+	{
+		phase = nano::ledger_snapshot_phase::end;
+	}
+}
+
+uint64_t nano::ledger_snapshot_server::cemented_height (nano::account const & account_a) const
+{
+	auto existing (std::lower_bound (heights.begin (), heights.end (), std::make_pair (account_a, uint64_t (0))));
+	return existing != heights.end () && existing->first == account_a ? existing->second : 0;
+}
+
+bool nano::ledger_snapshot_server::cemented (nano::block_hash const & hash_a)
+{
+	auto & node (*connection->node);
+	auto height (node.store.block_account_height (transaction, hash_a));
+	return height != 0 && height <= cemented_height (node.ledger.account (transaction, hash_a));
+}
+
+nano::account_info nano::ledger_snapshot_server::cemented_info (nano::account const & account_a, uint64_t height_a)
+{
+	auto & store (connection->node->store);
+	nano::account_info result;
+	auto error (store.account_get (transaction, account_a, result));
+	assert (!error);
+	auto hash (store.block_at_height (transaction, account_a, height_a));
+	nano::block_sideband sideband;
+	auto block (store.block_get (transaction, hash, &sideband));
+	assert (block != nullptr);
+	nano::representative_visitor visitor (transaction, store);
+	visitor.compute (hash);
+	result.head = hash;
+	result.rep_block = visitor.result;
+	result.balance = store.block_balance_calculated (block, sideband);
+	result.modified = sideband.timestamp;
+	result.block_count = height_a;
+	result.confirmation_height = height_a;
+	result.epoch = block->type () == nano::block_type::state ? store.block_version (transaction, hash) : nano::epoch::epoch_0;
+	return result;
+}
+
+void nano::ledger_snapshot_server::collect_pending (nano::account const & destination_a)
+{
+	auto & node (*connection->node);
+	// Sends of the snapshot to this account which are still in the pending table
+	for (auto i (node.store.pending_begin (transaction, nano::pending_key (destination_a, 0))), n (node.store.pending_end ()); i != n && i->first.account == destination_a; ++i)
+	{
+		if (cemented (i->first.hash))
+		{
+			pending.emplace (i->first, i->second);
+		}
+	}
+	// Sends of the snapshot received by blocks past the cemented height are pending as of the snapshot as well
+	nano::block_hash hash (0);
+	auto height (cemented_height (destination_a));
+	if (height != 0)
+	{
+		hash = node.store.block_successor (transaction, node.store.block_at_height (transaction, destination_a, height));
+	}
+	else
+	{
+		nano::account_info info;
+		if (!node.store.account_get (transaction, destination_a, info))
+		{
+			hash = info.open_block;
+		}
+	}
+	while (!hash.is_zero ())
+	{
+		nano::block_sideband sideband;
+		auto block (node.store.block_get (transaction, hash, &sideband));
+		assert (block != nullptr);
+		auto source (node.ledger.block_source (transaction, *block));
+		if (!source.is_zero () && !node.ledger.is_epoch_link (source) && cemented (source))
+		{
+			auto epoch (node.store.block_get (transaction, source)->type () == nano::block_type::state ? node.store.block_version (transaction, source) : nano::epoch::epoch_0);
+			pending.emplace (nano::pending_key (destination_a, source), nano::pending_info (node.ledger.account (transaction, source), node.ledger.amount (transaction, source), epoch));
+		}
+		hash = sideband.successor;
+	}
+}
+
 nano::frontier_req_server::frontier_req_server (std::shared_ptr<nano::bootstrap_server> const & connection_a, std::unique_ptr<nano::frontier_req> request_a) :
 connection (connection_a),
 current (request_a->start.number () - 1),
 frontier (0),
 request (std::move (request_a)),
 send_buffer (std::make_shared<std::vector<uint8_t>> ()),
-count (0)
+count (0),
+transaction (connection_a->node->store.tx_begin_read ()),
+transaction_start (std::chrono::steady_clock::now ()),
+iterator (connection_a->node->store.latest_begin (transaction, current.number () + 1))
 {
 	next ();
 }
@@ -3184,15 +4060,20 @@ void nano::frontier_req_server::send_next ()
 		{
 			send_buffer->clear ();
 			nano::vectorstream stream (*send_buffer);
-			write (stream, current.bytes);
-			write (stream, frontier.bytes);
+			// Frontiers are written in batches, the cursor only has to be repositioned once per write
+			for (size_t i (0); i < frontier_req_batch && !current.is_zero () && count < request->count; ++i)
+			{
+				write (stream, current.bytes);
+				write (stream, frontier.bytes);
+				if (connection->node->config.logging.bulk_pull_logging ())
+				{
+					connection->node->logger.try_log (boost::str (boost::format ("Sending frontier for %1% %2%") % current.to_account () % frontier.to_string ()));
+				}
+				++count;
+				next ();
+			}
 		}
 		auto this_l (shared_from_this ());
-		if (connection->node->config.logging.bulk_pull_logging ())
-		{
-			connection->node->logger.try_log (boost::str (boost::format ("Sending frontier for %1% %2%") % current.to_account () % frontier.to_string ()));
-		}
-		next ();
 		connection->socket->async_write (send_buffer, [this_l](boost::system::error_code const & ec, size_t size_a) {
 			this_l->sent_action (ec, size_a);
 		});
@@ -3241,7 +4122,6 @@ void nano::frontier_req_server::sent_action (boost::system::error_code const & e
 {
 	if (!ec)
 	{
-		count++;
 		send_next ();
 	}
 	else
@@ -3255,34 +4135,30 @@ void nano::frontier_req_server::sent_action (boost::system::error_code const & e
 
 void nano::frontier_req_server::next ()
 {
-	// Filling accounts deque to prevent often read transactions
-	if (accounts.empty ())
+	auto & store (connection->node->store);
+	auto now (std::chrono::steady_clock::now ());
+	if (now - transaction_start > bootstrap_read_transaction_max_age)
 	{
-		auto now (nano::seconds_since_epoch ());
-		bool skip_old (request->age != std::numeric_limits<decltype (request->age)>::max ());
-		size_t max_size (128);
-		auto transaction (connection->node->store.tx_begin_read ());
-		for (auto i (connection->node->store.latest_begin (transaction, current.number () + 1)), n (connection->node->store.latest_end ()); i != n && accounts.size () != max_size; ++i)
-		{
-			nano::account_info const & info (i->second);
-			if (!skip_old || (now - info.modified) <= request->age)
-			{
-				nano::account const & account (i->first);
-				accounts.emplace_back (account, info.head);
-			}
-		}
-		/* If loop breaks before max_size, then latest_end () is reached
-		Add empty record to finish frontier_req_server */
-		if (accounts.size () != max_size)
+		// Don't pin an old snapshot while sending to a slow peer, resume after the last account sent
+		iterator = store.latest_end ();
+		transaction.refresh ();
+		transaction_start = now;
+		iterator = store.latest_begin (transaction, current.number () + 1);
+	}
+	auto seconds (nano::seconds_since_epoch ());
+	bool skip_old (request->age != std::numeric_limits<decltype (request->age)>::max ());
+	current.clear ();
+	frontier.clear ();
+	// Reaching latest_end () leaves current zeroed, which finishes frontier_req_server
+	for (auto n (store.latest_end ()); iterator != n && current.is_zero (); ++iterator)
+	{
+		nano::account_info const & info (iterator->second);
+		if (!skip_old || (seconds - info.modified) <= request->age)
 		{
-			accounts.emplace_back (nano::account (0), nano::block_hash (0));
+			current = iterator->first;
+			frontier = info.head;
 		}
 	}
-	// Retrieving accounts from deque
-	auto const & account_pair (accounts.front ());
-	current = account_pair.first;
-	frontier = account_pair.second;
-	accounts.pop_front ();
 }
 
 void nano::pulls_cache::add (nano::pull_info const & pull_a)
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <nano/lib/flat_hash.hpp>
 #include <nano/node/common.hpp>
 #include <nano/node/socket.hpp>
 #include <nano/secure/blockstore.hpp>
@@ -15,6 +16,7 @@
 
 #include <atomic>
 #include <future>
+#include <map>
 #include <queue>
 #include <stack>
 #include <unordered_set>
@@ -54,11 +56,13 @@ enum class bootstrap_mode
 {
 	legacy,
 	lazy,
-	wallet_lazy
+	wallet_lazy,
+	snapshot
 };
 class frontier_req_client;
 class bulk_push_client;
 class bulk_pull_account_client;
+class ledger_snapshot_client;
 class bootstrap_attempt final : public std::enable_shared_from_this<bootstrap_attempt>
 {
 public:
@@ -93,6 +97,7 @@ public:
 	void wallet_run ();
 	void wallet_start (std::deque<nano::account> &);
 	bool wallet_finished ();
+	void snapshot_run ();
 	std::chrono::steady_clock::time_point next_log;
 	std::deque<std::weak_ptr<nano::bootstrap_client>> clients;
 	std::weak_ptr<nano::bootstrap_client> connection_frontier_request;
@@ -112,17 +117,21 @@ public:
 	std::mutex mutex;
 	std::condition_variable condition;
 	// Lazy bootstrap
-	std::unordered_set<nano::block_hash> lazy_blocks;
-	std::unordered_map<nano::block_hash, std::pair<nano::block_hash, nano::uint128_t>> lazy_state_unknown;
-	std::unordered_map<nano::block_hash, nano::uint128_t> lazy_balances;
-	std::unordered_set<nano::block_hash> lazy_keys;
+	nano::flat_hash_set<nano::block_hash> lazy_blocks;
+	nano::flat_hash_map<nano::block_hash, std::pair<nano::block_hash, nano::amount>> lazy_state_unknown;
+	nano::flat_hash_map<nano::block_hash, nano::amount> lazy_balances;
+	nano::flat_hash_set<nano::block_hash> lazy_keys;
 	std::deque<nano::block_hash> lazy_pulls;
 	std::atomic<uint64_t> lazy_stopped;
 	uint64_t lazy_max_stopped = 256;
 	std::mutex lazy_mutex;
 	// Wallet lazy bootstrap
 	std::deque<nano::account> wallet_accounts;
+	// Ledger snapshot bootstrap
+	std::weak_ptr<nano::ledger_snapshot_client> snapshot;
+	std::unordered_set<nano::block_hash> snapshot_anchors;
 };
+std::unique_ptr<seq_con_info_component> collect_seq_con_info (bootstrap_attempt & bootstrap_attempt, const std::string & name);
 class frontier_req_client final : public std::enable_shared_from_this<nano::frontier_req_client>
 {
 public:
@@ -155,6 +164,9 @@ public:
 	void receive_block ();
 	void received_type ();
 	void received_block (boost::system::error_code const &, size_t, nano::block_type);
+	void validate_blocks (std::function<void()> const &);
+	bool process_blocks ();
+	bool process_block (std::shared_ptr<nano::block>);
 	nano::block_hash first ();
 	std::shared_ptr<nano::bootstrap_client> connection;
 	nano::block_hash expected;
@@ -162,6 +174,8 @@ public:
 	nano::pull_info pull;
 	uint64_t total_blocks;
 	uint64_t unexpected_count;
+	/** Received blocks waiting for their work to be validated as one batch */
+	std::vector<std::shared_ptr<nano::block>> blocks;
 };
 class bootstrap_client final : public std::enable_shared_from_this<bootstrap_client>
 {
@@ -187,12 +201,15 @@ public:
 	explicit bulk_push_client (std::shared_ptr<nano::bootstrap_client> const &);
 	~bulk_push_client ();
 	void start ();
-	void push (nano::transaction const &);
+	void push ();
 	void push_block (nano::block const &);
 	void send_finished ();
 	std::shared_ptr<nano::bootstrap_client> connection;
 	std::promise<bool> promise;
 	std::pair<nano::block_hash, nano::block_hash> current_target;
+	/** Read transaction shared by all pushed blocks, refreshed once it gets older than bootstrap_read_transaction_max_age */
+	nano::read_transaction transaction;
+	std::chrono::steady_clock::time_point transaction_start;
 };
 class bulk_pull_account_client final : public std::enable_shared_from_this<nano::bulk_pull_account_client>
 {
@@ -205,6 +222,62 @@ public:
 	nano::account account;
 	uint64_t total_blocks;
 };
+/** Entries making up the chunks sent in response to a ledger_snapshot_req, an empty chunk ends the stream */
+enum class ledger_snapshot_entry : uint8_t
+{
+	end = 0x0,
+	block = 0x1,
+	account = 0x2,
+	pending = 0x3,
+	representation = 0x4
+};
+/**
+ * Imports a ledger snapshot into a ledger holding only the genesis block.
+ * Blocks are stored without signature or work validation, instead the chains, balances, supply and representative
+ * weights are checked for consistency and each anchor block has to be part of the snapshot.
+ */
+class ledger_snapshot_client final : public std::enable_shared_from_this<nano::ledger_snapshot_client>
+{
+public:
+	ledger_snapshot_client (std::shared_ptr<nano::bootstrap_client> const &, std::unordered_set<nano::block_hash> const &);
+	/** Blocks until the snapshot is imported, returns true and restores the genesis only ledger on failure */
+	bool run ();
+	/** Writes the length prefixed chunks of the whole stream to a temporary file, the import reads them back with read_chunk */
+	bool download (std::ostream &);
+	bool read_chunk (std::istream &);
+	std::future<bool> request ();
+	std::future<bool> receive_chunk ();
+	bool process_chunk (nano::transaction const &);
+	bool process_block (nano::transaction const &, nano::stream &);
+	bool process_account (nano::transaction const &, nano::stream &);
+	bool process_pending (nano::transaction const &, nano::stream &);
+	bool process_representation (nano::transaction const &, nano::stream &);
+	bool process_end (nano::stream &);
+	std::shared_ptr<nano::bootstrap_client> connection;
+	std::shared_ptr<std::vector<uint8_t>> chunk;
+	std::unordered_set<nano::block_hash> anchors;
+	bool finished{ false };
+	// Chain of the account currently being received, blocks are sent in ascending height before the account itself
+	nano::account chain_account{ 0 };
+	nano::block_hash chain_open{ 0 };
+	nano::block_hash chain_head{ 0 };
+	nano::block_hash chain_successor{ 0 };
+	uint64_t chain_height{ 0 };
+	std::shared_ptr<nano::block> chain_head_block;
+	nano::block_sideband chain_head_sideband;
+	nano::epoch chain_head_epoch{ nano::epoch::epoch_0 };
+	// Last keys appended to each table, these have to be strictly ascending
+	nano::account previous_account{ 0 };
+	nano::pending_key previous_pending{ 0, 0 };
+	nano::account previous_representative{ 0 };
+	uint64_t block_count{ 0 };
+	uint64_t account_count{ 0 };
+	uint64_t pending_count{ 0 };
+	uint64_t representation_count{ 0 };
+	nano::uint256_t supply{ 0 };
+	std::unordered_map<nano::account, nano::uint128_t> weights;
+	static size_t constexpr chunk_size_max = 1024 * 1024;
+};
 class cached_pulls final
 {
 public:
@@ -240,15 +313,19 @@ public:
 	void bootstrap ();
 	void bootstrap_lazy (nano::block_hash const &, bool = false);
 	void bootstrap_wallet (std::deque<nano::account> &);
+	void bootstrap_snapshot (nano::endpoint const &, std::vector<nano::block_hash> const &);
 	void run_bootstrap ();
 	void notify_listeners (bool);
 	void add_observer (std::function<void(bool)> const &);
 	bool in_progress ();
 	std::shared_ptr<nano::bootstrap_attempt> current_attempt ();
+	/** Queues an action on the work validation threads, which check proof of work of pulled blocks off the network threads */
+	void validate_work (std::function<void()> const &);
 	nano::pulls_cache cache;
 	void stop ();
 
 private:
+	void run_work_validation ();
 	nano::node & node;
 	std::shared_ptr<nano::bootstrap_attempt> attempt;
 	std::atomic<bool> stopped;
@@ -257,6 +334,11 @@ private:
 	std::mutex observers_mutex;
 	std::vector<std::function<void(bool)>> observers;
 	boost::thread thread;
+	std::deque<std::function<void()>> work_validation;
+	std::mutex work_validation_mutex;
+	std::condition_variable work_validation_condition;
+	/** Each pull client has at most one batch queued, so batches of different connections are validated in parallel */
+	std::vector<boost::thread> work_validation_threads;
 
 	friend std::unique_ptr<seq_con_info_component> collect_seq_con_info (bootstrap_initiator & bootstrap_initiator, const std::string & name);
 };
@@ -281,6 +363,8 @@ public:
 	bool on;
 	std::atomic<size_t> bootstrap_count{ 0 };
 	std::atomic<size_t> realtime_count{ 0 };
+	/** Set while a ledger snapshot is being served, only one is served at a time */
+	std::atomic<bool> ledger_snapshot_serving{ false };
 
 private:
 	uint16_t port;
@@ -380,6 +464,58 @@ public:
 	std::shared_ptr<std::vector<uint8_t>> receive_buffer;
 	std::shared_ptr<nano::bootstrap_server> connection;
 };
+enum class ledger_snapshot_phase
+{
+	accounts,
+	pending,
+	representation,
+	end,
+	finished
+};
+/**
+ * Streams the cemented part of the ledger, see nano::ledger_snapshot_client.
+ * The snapshot is made of the blocks up to the confirmation heights read when the request starts. Cemented blocks never
+ * change, so the read transaction is released while each chunk is written and renewed for the next one.
+ * Accounts are sent in key order, each preceded by its cemented blocks in ascending height. Account information,
+ * pending entries and representative weights are rewritten as they were at those heights.
+ */
+class ledger_snapshot_server final : public std::enable_shared_from_this<nano::ledger_snapshot_server>
+{
+public:
+	explicit ledger_snapshot_server (std::shared_ptr<nano::bootstrap_server> const &);
+	~ledger_snapshot_server ();
+	void start ();
+	void send_next ();
+	void sent_action (boost::system::error_code const &, size_t);
+	void next (nano::stream &);
+	void next_account (nano::stream &);
+	void next_pending (nano::stream &);
+	void next_representation (nano::stream &);
+	uint64_t cemented_height (nano::account const &) const;
+	bool cemented (nano::block_hash const &);
+	nano::account_info cemented_info (nano::account const &, uint64_t);
+	void collect_pending (nano::account const &);
+	std::shared_ptr<nano::bootstrap_server> connection;
+	nano::read_transaction transaction;
+	std::shared_ptr<std::vector<uint8_t>> send_buffer;
+	nano::ledger_snapshot_phase phase{ nano::ledger_snapshot_phase::accounts };
+	/** Non-zero confirmation heights of every account as of the start of the request, sorted by account */
+	std::vector<std::pair<nano::account, uint64_t>> heights;
+	size_t current_account{ 0 };
+	nano::account chain_account{ 0 };
+	nano::account_info chain_info;
+	nano::block_hash chain_next{ 0 };
+	uint64_t chain_remaining{ 0 };
+	/** Pending entries are collected one destination account at a time, in a single transaction each */
+	std::map<nano::pending_key, nano::pending_info> pending;
+	nano::account pending_start{ 0 };
+	bool pending_finished{ false };
+	std::map<nano::account, nano::uint128_t> weights;
+	uint64_t block_count{ 0 };
+	uint64_t account_count{ 0 };
+	uint64_t pending_count{ 0 };
+	static size_t constexpr chunk_size = 64 * 1024;
+};
 class frontier_req;
 class frontier_req_server final : public std::enable_shared_from_this<nano::frontier_req_server>
 {
@@ -396,6 +532,12 @@ public:
 	std::unique_ptr<nano::frontier_req> request;
 	std::shared_ptr<std::vector<uint8_t>> send_buffer;
 	size_t count;
-	std::deque<std::pair<nano::account, nano::block_hash>> accounts;
+	/**
+	 * Frontiers are read through a single transaction and cursor kept for the whole request. Once the transaction gets older than
+	 * bootstrap_read_transaction_max_age it is refreshed and the cursor repositioned after the last account read.
+	 */
+	nano::read_transaction transaction;
+	std::chrono::steady_clock::time_point transaction_start;
+	nano::store_iterator<nano::account, nano::account_info> iterator;
 };
 }
@@ -159,6 +159,11 @@ size_t nano::message_header::payload_length_bytes () const
 			// bulk_push doesn't have a payload
 			return 0;
 		}
+		case nano::message_type::ledger_snapshot_req:
+		{
+			// ledger_snapshot_req doesn't have a payload
+			return 0;
+		}
 		case nano::message_type::frontier_req:
 		{
 			return nano::frontier_req::size;
@@ -960,6 +965,32 @@ void nano::bulk_push::visit (nano::message_visitor & visitor_a) const
 	visitor_a.bulk_push (*this);
 }
 
+nano::ledger_snapshot_req::ledger_snapshot_req () :
+message (nano::message_type::ledger_snapshot_req)
+{
+}
+
+nano::ledger_snapshot_req::ledger_snapshot_req (nano::message_header const & header_a) :
+message (header_a)
+{
+}
+
+bool nano::ledger_snapshot_req::deserialize (nano::stream & stream_a)
+{
+	assert (header.type == nano::message_type::ledger_snapshot_req);
+	return false;
+}
+
+void nano::ledger_snapshot_req::serialize (nano::stream & stream_a) const
+{
+	header.serialize (stream_a);
+}
+
+void nano::ledger_snapshot_req::visit (nano::message_visitor & visitor_a) const
+{
+	visitor_a.ledger_snapshot_req (*this);
+}
+
 nano::node_id_handshake::node_id_handshake (bool & error_a, nano::stream & stream_a, nano::message_header const & header_a) :
 message (header_a),
 query (boost::none),
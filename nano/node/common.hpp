@@ -185,7 +185,8 @@ enum class message_type : uint8_t
 	frontier_req = 0x8,
 	/* deleted 0x9 */
 	node_id_handshake = 0x0a,
-	bulk_pull_account = 0x0b
+	bulk_pull_account = 0x0b,
+	ledger_snapshot_req = 0x0c
 };
 enum class bulk_pull_account_flags : uint8_t
 {
@@ -381,6 +382,18 @@ public:
 	bool deserialize (nano::stream &);
 	void visit (nano::message_visitor &) const override;
 };
+/**
+ * Requests a snapshot of the cemented ledger, see nano::ledger_snapshot_server
+ */
+class ledger_snapshot_req final : public message
+{
+public:
+	ledger_snapshot_req ();
+	explicit ledger_snapshot_req (nano::message_header const &);
+	void serialize (nano::stream &) const override;
+	bool deserialize (nano::stream &);
+	void visit (nano::message_visitor &) const override;
+};
 class node_id_handshake final : public message
 {
 public:
@@ -407,6 +420,7 @@ public:
 	virtual void bulk_push (nano::bulk_push const &) = 0;
 	virtual void frontier_req (nano::frontier_req const &) = 0;
 	virtual void node_id_handshake (nano::node_id_handshake const &) = 0;
+	virtual void ledger_snapshot_req (nano::ledger_snapshot_req const &) = 0;
 	virtual ~message_visitor ();
 };
 
@@ -3,29 +3,37 @@
 #include <nano/lib/timer.hpp>
 #include <nano/node/common.hpp>
 #include <nano/node/ipc.hpp>
+#include <nano/node/ipc_binary_handler.hpp>
 #include <nano/node/json_handler.hpp>
 #include <nano/node/node.hpp>
 
 #include <boost/array.hpp>
 #include <boost/bind.hpp>
 #include <boost/endian/conversion.hpp>
+#include <boost/optional.hpp>
 #include <boost/polymorphic_cast.hpp>
 #include <boost/property_tree/json_parser.hpp>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/thread/thread_time.hpp>
 
 #include <algorithm>
+#include <array>
 #include <chrono>
 #include <cstdio>
+#include <deque>
 #include <fstream>
 #include <future>
 #include <iostream>
+#include <mutex>
 #include <thread>
 
 using namespace boost::log;
 
 namespace
 {
+/** Pieces of a streamed response which may wait to be written before the handler is paused */
+size_t constexpr max_queued_chunks = 4;
+
 /**
  * A session represents an inbound connection over which multiple requests/reponses are transmitted.
  */
@@ -64,13 +72,13 @@ public:
 	 */
 	void async_read_exactly (void * buff_a, size_t size_a, std::chrono::seconds timeout_a, std::function<void()> callback_a)
 	{
-		timer_start (timeout_a);
+		timer_start (read_timer, timeout_a);
 		auto this_l (this->shared_from_this ());
 		boost::asio::async_read (socket,
 		boost::asio::buffer (buff_a, size_a),
 		boost::asio::transfer_exactly (size_a),
-		[this_l, callback_a](boost::system::error_code const & ec, size_t bytes_transferred_a) {
-			this_l->timer_cancel ();
+		boost::asio::bind_executor (strand, [this_l, callback_a](boost::system::error_code const & ec, size_t bytes_transferred_a) {
+			this_l->timer_cancel (this_l->read_timer);
 			if (ec == boost::asio::error::connection_aborted || ec == boost::asio::error::connection_reset)
 			{
 				if (this_l->node.config.logging.log_ipc ())
@@ -82,62 +90,226 @@ public:
 			{
 				callback_a ();
 			}
+		}));
+	}
+
+	/**
+	 * Queues \p buffer_a to be written once the responses queued before it have been written. Handlers of concurrent
+	 * requests share the socket, so writes must not overlap. \p callback_a is called on the strand when the write has completed.
+	 */
+	void queue_write (std::shared_ptr<std::vector<uint8_t>> buffer_a, std::function<void(boost::system::error_code const &)> callback_a)
+	{
+		auto this_l (this->shared_from_this ());
+		boost::asio::post (strand, [this_l, buffer_a, callback_a]() {
+			this_l->write_queue.emplace_back (buffer_a, callback_a);
+			if (this_l->write_queue.size () == 1)
+			{
+				this_l->write_queued ();
+			}
+		});
+	}
+
+	/** Writes the front of the write queue, which must be non-empty, on the strand */
+	void write_queued ()
+	{
+		auto this_l (this->shared_from_this ());
+		auto buffer_l (write_queue.front ().first);
+		timer_start (write_timer, std::chrono::seconds (config_transport.io_timeout));
+		boost::asio::async_write (socket, boost::asio::buffer (*buffer_l), boost::asio::bind_executor (strand, [this_l, buffer_l](boost::system::error_code const & error_a, size_t size_a) {
+			this_l->timer_cancel (this_l->write_timer);
+			auto callback_l (std::move (this_l->write_queue.front ().second));
+			this_l->write_queue.pop_front ();
+			if (!this_l->write_queue.empty ())
+			{
+				this_l->write_queued ();
+			}
+			if (error_a && this_l->node.config.logging.log_ipc ())
+			{
+				this_l->node.logger.always_log ("IPC: Write failed: ", error_a.message ());
+			}
+			callback_l (error_a);
+		}));
+	}
+
+	/** The pieces of one streamed response which are waiting to be written, only accessed on the strand */
+	class chunk_queue final
+	{
+	public:
+		size_t queued{ 0 };
+		/** Set while the handler waits for room in the queue */
+		std::function<void(bool)> resume;
+		bool failed{ false };
+	};
+
+	/**
+	 * Queues a piece of a streamed response which is followed by further pieces, without waiting for it to be written.
+	 * \p resume_a is called once the queue has room for the next piece, which may be straight away.
+	 */
+	void write_response_chunk (std::shared_ptr<chunk_queue> const & queue_a, std::shared_ptr<std::vector<uint8_t>> buffer_a, std::function<void(bool)> const & resume_a)
+	{
+		auto this_l (this->shared_from_this ());
+		boost::asio::post (strand, [this_l, queue_a, buffer_a, resume_a]() {
+			if (!queue_a->failed)
+			{
+				auto resume_l (++queue_a->queued < max_queued_chunks);
+				if (!resume_l)
+				{
+					queue_a->resume = resume_a;
+				}
+				this_l->queue_write (buffer_a, [queue_a](boost::system::error_code const & error_a) {
+					--queue_a->queued;
+					queue_a->failed = queue_a->failed || error_a;
+					std::function<void(bool)> resume_l;
+					resume_l.swap (queue_a->resume);
+					if (resume_l)
+					{
+						resume_l (!error_a);
+					}
+				});
+				if (resume_l)
+				{
+					resume_a (true);
+				}
+			}
+			else
+			{
+				// The client has gone, the rest of the response is not wanted
+				resume_a (false);
+			}
 		});
 	}
 
-	/** Handler for payload_encoding::json_legacy */
-	void handle_json_query (bool allow_unsafe)
+	/**
+	 * Frames \p body_a for the encoding of the request being answered: a request id if multiplexed, followed by the
+	 * payload length which has response_chunk_continued set if further pieces follow.
+	 */
+	static std::shared_ptr<std::vector<uint8_t>> response_frame (boost::optional<uint32_t> request_id_a, std::string const & body_a, bool last_a)
+	{
+		auto result (std::make_shared<std::vector<uint8_t>> ());
+		result->reserve (2 * sizeof (uint32_t) + body_a.size ());
+		auto append ([&result](uint32_t value_a) {
+			auto value_be (boost::endian::native_to_big (value_a));
+			auto bytes (reinterpret_cast<uint8_t const *> (&value_be));
+			result->insert (result->end (), bytes, bytes + sizeof (value_be));
+		});
+		if (request_id_a)
+		{
+			append (*request_id_a);
+		}
+		append (static_cast<uint32_t> (body_a.size ()) | (last_a ? 0 : nano::ipc::response_chunk_continued));
+		result->insert (result->end (), body_a.begin (), body_a.end ());
+		return result;
+	}
+
+	/**
+	 * Handler for the JSON payload encodings. The request is handled on the server's worker threads.
+	 * A multiplexed request carries \p request_id_a, its session has already gone on to read the next request.
+	 * Otherwise the next request is read once the response has been written. Only a session carrying a single
+	 * request is \p chunked, as waiting for a streamed response to be read must not hold back other requests.
+	 */
+	void handle_json_query (std::string const & body_a, bool allow_unsafe, bool chunked, boost::optional<uint32_t> request_id_a)
 	{
-		session_timer.restart ();
+		nano::timer<std::chrono::microseconds> request_timer (nano::timer_state::started);
 		auto request_id_l (std::to_string (server.id_dispenser.fetch_add (1)));
 
 		// This is called when nano::rpc_handler#process_request is done. We convert to
 		// json and write the response to the ipc socket with a length prefix.
 		auto this_l (this->shared_from_this ());
-		auto response_handler_l ([this_l, request_id_l](std::string const & body) {
-			this_l->response_body = body;
-			this_l->size_response = boost::endian::native_to_big (static_cast<uint32_t> (this_l->response_body.size ()));
-			std::vector<boost::asio::mutable_buffer> bufs = {
-				boost::asio::buffer (&this_l->size_response, sizeof (this_l->size_response)),
-				boost::asio::buffer (this_l->response_body)
-			};
-
+		auto response_handler_l ([this_l, request_id_l, request_id_a, request_timer](std::string const & body) mutable {
 			if (this_l->node.config.logging.log_ipc ())
 			{
-				this_l->node.logger.always_log (boost::str (boost::format ("IPC/RPC request %1% completed in: %2% %3%") % request_id_l % this_l->session_timer.stop ().count () % this_l->session_timer.unit ()));
+				this_l->node.logger.always_log (boost::str (boost::format ("IPC/RPC request %1% completed in: %2% %3%") % request_id_l % request_timer.stop ().count () % request_timer.unit ()));
 			}
-
-			this_l->timer_start (std::chrono::seconds (this_l->config_transport.io_timeout));
-			boost::asio::async_write (this_l->socket, bufs, [this_l](boost::system::error_code const & error_a, size_t size_a) {
-				this_l->timer_cancel ();
+			this_l->queue_write (response_frame (request_id_a, body, true), [this_l, request_id_a](boost::system::error_code const & error_a) {
 				if (!error_a)
 				{
-					this_l->read_next_request ();
+					if (!request_id_a)
+					{
+						this_l->read_next_request ();
+					}
+					else
+					{
+						this_l->multiplexed_request_completed ();
+					}
 				}
-				else if (this_l->node.config.logging.log_ipc ())
+			});
+		});
+
+		// Streamed responses are written as they are produced, the last piece completes the request like a whole response
+		nano::rpc_response_chunk response_chunk_handler_l;
+		if (chunked)
+		{
+			auto queue_l (std::make_shared<chunk_queue> ());
+			response_chunk_handler_l = [this_l, response_handler_l, request_id_a, queue_l](std::string const & body_a, bool last_a, std::function<void(bool)> const & resume_a) mutable {
+				if (last_a)
 				{
-					this_l->node.logger.always_log ("IPC: Write failed: ", error_a.message ());
+					response_handler_l (body_a);
 				}
-			});
+				else
+				{
+					this_l->write_response_chunk (queue_l, response_frame (request_id_a, body_a, false), resume_a);
+				}
+			};
+		}
+
+		node.stats.inc (nano::stat::type::ipc, nano::stat::detail::invocations);
 
-			// Do not call any member variables here (like session_timer) as it's possible that the next request may already be underway.
+		// For unsafe actions to be allowed, the unsafe encoding must be used AND the transport config must allow it
+		auto unsafe_l (allow_unsafe && config_transport.allow_unsafe);
+		boost::asio::post (server.workers_io_ctx, [this_l, body_a, response_handler_l, response_chunk_handler_l, unsafe_l]() {
+			auto & server_l (this_l->server);
+			// Note that if the rpc action is async, the shared_ptr<json_handler> lifetime will be extended by the action handler
+			auto handler (std::make_shared<nano::json_handler> (this_l->node, server_l.node_rpc_config, body_a, response_handler_l, [&server_l]() {
+				server_l.stop ();
+				server_l.node.alarm.add (std::chrono::steady_clock::now () + std::chrono::seconds (3), [& io_ctx = server_l.node.alarm.io_ctx]() {
+					io_ctx.stop ();
+				});
+			},
+			response_chunk_handler_l));
+			handler->process_request (unsafe_l);
 		});
+	}
 
+	/** Handler for payload_encoding::binary, the request is handled on the server's worker threads */
+	void handle_binary_query (std::vector<uint8_t> const & request_a)
+	{
 		node.stats.inc (nano::stat::type::ipc, nano::stat::detail::invocations);
-		auto body (std::string (reinterpret_cast<char *> (buffer.data ()), buffer.size ()));
-
-		// Note that if the rpc action is async, the shared_ptr<json_handler> lifetime will be extended by the action handler
-		auto handler (std::make_shared<nano::json_handler> (node, server.node_rpc_config, body, response_handler_l, [& server = server]() {
-			server.stop ();
-			server.node.alarm.add (std::chrono::steady_clock::now () + std::chrono::seconds (3), [& io_ctx = server.node.alarm.io_ctx]() {
-				io_ctx.stop ();
+		auto this_l (this->shared_from_this ());
+		boost::asio::post (server.workers_io_ctx, [this_l, request_a]() {
+			auto response_l (std::make_shared<std::vector<uint8_t>> (nano::ipc::binary_handler (this_l->node).process (request_a)));
+			auto size_be (boost::endian::native_to_big (static_cast<uint32_t> (response_l->size ())));
+			auto size_bytes (reinterpret_cast<uint8_t const *> (&size_be));
+			response_l->insert (response_l->begin (), size_bytes, size_bytes + sizeof (size_be));
+			this_l->queue_write (response_l, [this_l](boost::system::error_code const & error_a) {
+				if (!error_a)
+				{
+					this_l->read_next_request ();
+				}
 			});
-		}));
-		// For unsafe actions to be allowed, the unsafe encoding must be used AND the transport config must allow it
-		handler->process_request (allow_unsafe && config_transport.allow_unsafe);
+		});
+	}
+
+	/** Counts a multiplexed request as in flight, returns false if the next one is to be read once one has been answered */
+	bool multiplexed_request_started ()
+	{
+		++requests_in_flight;
+		read_deferred = requests_in_flight >= node.config.ipc_config.max_multiplexed_requests;
+		return !read_deferred;
+	}
+
+	/** Reads the next multiplexed request if reading was held back by the limit */
+	void multiplexed_request_completed ()
+	{
+		--requests_in_flight;
+		auto read_l (read_deferred);
+		read_deferred = false;
+		if (read_l)
+		{
+			read_next_request ();
+		}
 	}
 
-	/** Async request reader */
+	/** Async request reader, called on the strand or before the session's first operation */
 	void read_next_request ()
 	{
 		auto this_l = this->shared_from_this ();
@@ -152,16 +324,48 @@ public:
 					this_l->node.logger.always_log ("IPC: Invalid preamble");
 				}
 			}
-			else if (this_l->buffer[nano::ipc::preamble_offset::encoding] == static_cast<uint8_t> (nano::ipc::payload_encoding::json_legacy) || this_l->buffer[nano::ipc::preamble_offset::encoding] == static_cast<uint8_t> (nano::ipc::payload_encoding::json_unsafe))
+			else if (this_l->buffer[nano::ipc::preamble_offset::encoding] >= static_cast<uint8_t> (nano::ipc::payload_encoding::json_legacy) && this_l->buffer[nano::ipc::preamble_offset::encoding] <= static_cast<uint8_t> (nano::ipc::payload_encoding::json_chunked_unsafe))
 			{
-				auto allow_unsafe (this_l->buffer[nano::ipc::preamble_offset::encoding] == static_cast<uint8_t> (nano::ipc::payload_encoding::json_unsafe));
+				auto encoding (static_cast<nano::ipc::payload_encoding> (this_l->buffer[nano::ipc::preamble_offset::encoding]));
+				auto allow_unsafe (encoding == nano::ipc::payload_encoding::json_unsafe || encoding == nano::ipc::payload_encoding::json_chunked_unsafe);
+				auto chunked (encoding == nano::ipc::payload_encoding::json_chunked || encoding == nano::ipc::payload_encoding::json_chunked_unsafe);
 				// Length of payload
-				this_l->async_read_exactly (&this_l->buffer_size, sizeof (this_l->buffer_size), [this_l, allow_unsafe]() {
+				this_l->async_read_exactly (&this_l->buffer_size, sizeof (this_l->buffer_size), [this_l, allow_unsafe, chunked]() {
 					boost::endian::big_to_native_inplace (this_l->buffer_size);
 					this_l->buffer.resize (this_l->buffer_size);
 					// Payload (ptree compliant JSON string)
-					this_l->async_read_exactly (this_l->buffer.data (), this_l->buffer_size, [this_l, allow_unsafe]() {
-						this_l->handle_json_query (allow_unsafe);
+					this_l->async_read_exactly (this_l->buffer.data (), this_l->buffer_size, [this_l, allow_unsafe, chunked]() {
+						this_l->handle_json_query (std::string (reinterpret_cast<char *> (this_l->buffer.data ()), this_l->buffer.size ()), allow_unsafe, chunked, boost::none);
+					});
+				});
+			}
+			else if (this_l->buffer[nano::ipc::preamble_offset::encoding] == static_cast<uint8_t> (nano::ipc::payload_encoding::json_multiplexed) || this_l->buffer[nano::ipc::preamble_offset::encoding] == static_cast<uint8_t> (nano::ipc::payload_encoding::json_multiplexed_unsafe))
+			{
+				auto allow_unsafe (this_l->buffer[nano::ipc::preamble_offset::encoding] == static_cast<uint8_t> (nano::ipc::payload_encoding::json_multiplexed_unsafe));
+				// Request id and length of payload
+				this_l->async_read_exactly (this_l->request_header.data (), sizeof (this_l->request_header), [this_l, allow_unsafe]() {
+					auto request_id (boost::endian::big_to_native (this_l->request_header[0]));
+					this_l->buffer_size = boost::endian::big_to_native (this_l->request_header[1]);
+					this_l->buffer.resize (this_l->buffer_size);
+					this_l->async_read_exactly (this_l->buffer.data (), this_l->buffer_size, [this_l, allow_unsafe, request_id]() {
+						std::string body (reinterpret_cast<char *> (this_l->buffer.data ()), this_l->buffer.size ());
+						// The buffer is reused by the next request, which is read while this one is handled unless too many are in flight
+						if (this_l->multiplexed_request_started ())
+						{
+							this_l->read_next_request ();
+						}
+						this_l->handle_json_query (body, allow_unsafe, false, request_id);
+					});
+				});
+			}
+			else if (this_l->buffer[nano::ipc::preamble_offset::encoding] == static_cast<uint8_t> (nano::ipc::payload_encoding::binary))
+			{
+				// Length of payload
+				this_l->async_read_exactly (&this_l->buffer_size, sizeof (this_l->buffer_size), [this_l]() {
+					boost::endian::big_to_native_inplace (this_l->buffer_size);
+					this_l->buffer.resize (this_l->buffer_size);
+					this_l->async_read_exactly (this_l->buffer.data (), this_l->buffer_size, [this_l]() {
+						this_l->handle_binary_query (this_l->buffer);
 					});
 				});
 			}
@@ -172,11 +376,12 @@ public:
 		});
 	}
 
-	/** Shut down and close socket */
+	/** Shut down and close socket, which the read and the write timer may both do */
 	void close ()
 	{
-		socket.shutdown (boost::asio::ip::tcp::socket::shutdown_both);
-		socket.close ();
+		boost::system::error_code ec;
+		socket.shutdown (boost::asio::ip::tcp::socket::shutdown_both, ec);
+		socket.close (ec);
 	}
 
 private:
@@ -186,9 +391,6 @@ private:
 	/** Unique session id used for logging */
 	uint64_t session_id;
 
-	/** Timer for measuring the duration of ipc calls */
-	nano::timer<std::chrono::microseconds> session_timer;
-
 	/**
 	 * IO context from node, or per-transport, depending on configuration.
 	 * Certain transports may scale better if they use a separate context.
@@ -201,9 +403,15 @@ private:
 	/** Buffer sizes are read into this */
 	uint32_t buffer_size{ 0 };
 
-	/** RPC response */
-	std::string response_body;
-	uint32_t size_response{ 0 };
+	/** Request id and payload length of a multiplexed request */
+	std::array<uint32_t, 2> request_header;
+
+	/** Responses waiting for the socket, with the callback to invoke once each has been written. Only accessed on the strand */
+	std::deque<std::pair<std::shared_ptr<std::vector<uint8_t>>, std::function<void(boost::system::error_code const &)>>> write_queue;
+
+	/** Multiplexed requests read but not yet answered, reading stops at ipc_config.max_multiplexed_requests. Only accessed on the strand */
+	size_t requests_in_flight{ 0 };
+	bool read_deferred{ false };
 
 	/** Buffer used to store data received from the client */
 	std::vector<uint8_t> buffer;
@@ -297,7 +505,8 @@ private:
 
 nano::ipc::ipc_server::ipc_server (nano::node & node_a, nano::node_rpc_config const & node_rpc_config_a) :
 node (node_a),
-node_rpc_config (node_rpc_config_a)
+node_rpc_config (node_rpc_config_a),
+workers (workers_io_ctx, std::max (1u, node_a.config.ipc_config.worker_threads >= 0 ? static_cast<unsigned> (node_a.config.ipc_config.worker_threads) : node_a.config.io_threads))
 {
 	try
 	{
@@ -2,6 +2,7 @@
 
 #include <nano/lib/ipc.hpp>
 #include <nano/lib/numbers.hpp>
+#include <nano/lib/utility.hpp>
 #include <nano/node/node_rpc_config.hpp>
 
 #include <atomic>
@@ -27,7 +28,11 @@ namespace ipc
 		/** Unique counter/id shared across sessions */
 		std::atomic<uint64_t> id_dispenser{ 0 };
 
+		/** Requests are handled on these threads, leaving the transport threads to read and write */
+		boost::asio::io_context workers_io_ctx;
+
 	private:
+		nano::thread_runner workers;
 		std::unique_ptr<dsock_file_remover> file_remover;
 		std::vector<std::shared_ptr<nano::ipc::transport>> transports;
 	};
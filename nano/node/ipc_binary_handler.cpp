@@ -0,0 +1,199 @@
+#include <nano/node/ipc_binary_handler.hpp>
+#include <nano/node/node.hpp>
+#include <nano/secure/utility.hpp>
+
+nano::ipc::binary_handler::binary_handler (nano::node & node_a) :
+node (node_a)
+{
+}
+
+std::vector<uint8_t> nano::ipc::binary_handler::process (std::vector<uint8_t> const & request_a)
+{
+	std::vector<uint8_t> result;
+	std::string error;
+	{
+		nano::bufferstream request_stream (request_a.data (), request_a.size ());
+		nano::vectorstream response_stream (result);
+		nano::write (response_stream, nano::ipc::binary::status::ok);
+		nano::ipc::binary::action action (nano::ipc::binary::action::invalid);
+		nano::try_read (request_stream, action);
+		switch (action)
+		{
+			case nano::ipc::binary::action::account_info:
+				error = account_info (request_stream, response_stream);
+				break;
+			case nano::ipc::binary::action::account_history:
+				error = account_history (request_stream, response_stream);
+				break;
+			case nano::ipc::binary::action::blocks_info:
+				error = blocks_info (request_stream, response_stream);
+				break;
+			default:
+				error = "Unknown command";
+				break;
+		}
+	}
+	if (!error.empty ())
+	{
+		result.clear ();
+		nano::vectorstream response_stream (result);
+		nano::write (response_stream, nano::ipc::binary::status::error);
+		nano::ipc::binary::serialize_error (response_stream, error);
+	}
+	return result;
+}
+
+std::string nano::ipc::binary_handler::account_info (nano::stream & request_a, nano::stream & response_a)
+{
+	std::string result;
+	nano::ipc::binary::account_info_request request;
+	if (!request.deserialize (request_a))
+	{
+		auto transaction (node.store.tx_begin_read ());
+		nano::account_info info;
+		if (!node.store.account_get (transaction, request.account, info))
+		{
+			nano::ipc::binary::account_info_response response;
+			response.frontier = info.head;
+			response.open_block = info.open_block;
+			response.representative_block = info.rep_block;
+			auto block (node.store.block_get (transaction, info.rep_block));
+			assert (block != nullptr);
+			response.representative = block->representative ();
+			response.balance = info.balance;
+			response.modified = info.modified;
+			response.block_count = info.block_count;
+			response.confirmation_height = info.confirmation_height;
+			response.serialize (response_a);
+		}
+		else
+		{
+			result = std::error_code (nano::error_common::account_not_found).message ();
+		}
+	}
+	else
+	{
+		result = "Unable to parse request";
+	}
+	return result;
+}
+
+/** Walks the chain like the account_history RPC with raw output, without an account filter */
+std::string nano::ipc::binary_handler::account_history (nano::stream & request_a, nano::stream & response_a)
+{
+	std::string result;
+	nano::ipc::binary::account_history_request request;
+	if (!request.deserialize (request_a))
+	{
+		auto transaction (node.store.tx_begin_read ());
+		nano::ipc::binary::account_history_response response;
+		auto hash (request.head);
+		if (!hash.is_zero ())
+		{
+			if (node.store.block_exists (transaction, hash))
+			{
+				response.account = node.ledger.account (transaction, hash);
+			}
+			else
+			{
+				result = std::error_code (nano::error_blocks::not_found).message ();
+			}
+		}
+		else
+		{
+			response.account = request.account;
+			if (request.reverse)
+			{
+				nano::account_info info;
+				if (!node.store.account_get (transaction, request.account, info))
+				{
+					hash = info.open_block;
+				}
+				else
+				{
+					result = std::error_code (nano::error_common::account_not_found).message ();
+				}
+			}
+			else
+			{
+				hash = node.ledger.latest (transaction, request.account);
+			}
+		}
+		if (result.empty ())
+		{
+			auto count (request.count);
+			if (count > 0)
+			{
+				hash = node.ledger.block_at_distance (transaction, response.account, hash, request.offset, request.reverse);
+			}
+			nano::block_sideband sideband;
+			auto block (node.store.block_get (transaction, hash, &sideband));
+			while (block != nullptr && count > 0)
+			{
+				response.history.emplace_back ();
+				auto & entry (response.history.back ());
+				entry.hash = hash;
+				entry.height = sideband.height;
+				entry.local_timestamp = sideband.timestamp;
+				entry.amount = node.ledger.amount (transaction, hash);
+				entry.counterparty = node.ledger.block_destination (transaction, *block);
+				if (entry.counterparty.is_zero ())
+				{
+					auto source (node.ledger.block_source (transaction, *block));
+					// The link of an epoch block is not a block
+					if (!source.is_zero () && node.store.block_exists (transaction, source))
+					{
+						entry.counterparty = node.ledger.account (transaction, source);
+					}
+				}
+				entry.block = block;
+				--count;
+				hash = request.reverse ? node.store.block_successor (transaction, hash) : block->previous ();
+				block = node.store.block_get (transaction, hash, &sideband);
+			}
+			response.next = hash;
+			response.serialize (response_a);
+		}
+	}
+	else
+	{
+		result = "Unable to parse request";
+	}
+	return result;
+}
+
+std::string nano::ipc::binary_handler::blocks_info (nano::stream & request_a, nano::stream & response_a)
+{
+	std::string result;
+	nano::ipc::binary::blocks_info_request request;
+	if (!request.deserialize (request_a))
+	{
+		auto transaction (node.store.tx_begin_read ());
+		nano::ipc::binary::blocks_info_response response;
+		response.blocks.reserve (request.hashes.size ());
+		for (auto const & hash : request.hashes)
+		{
+			response.blocks.emplace_back ();
+			auto & entry (response.blocks.back ());
+			entry.hash = hash;
+			nano::block_sideband sideband;
+			entry.block = node.store.block_get (transaction, hash, &sideband);
+			entry.found = entry.block != nullptr;
+			if (entry.found)
+			{
+				entry.account = entry.block->account ().is_zero () ? sideband.account : entry.block->account ();
+				entry.amount = node.ledger.amount (transaction, hash);
+				entry.balance = node.ledger.balance (transaction, hash);
+				entry.height = sideband.height;
+				entry.local_timestamp = sideband.timestamp;
+				entry.confirmed = node.block_confirmed_or_being_confirmed (transaction, hash);
+			}
+		}
+		response.serialize (response_a);
+	}
+	else
+	{
+		result = "Unable to parse request";
+	}
+	return result;
+}
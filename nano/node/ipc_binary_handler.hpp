@@ -0,0 +1,32 @@
+#pragma once
+
+#include <nano/lib/ipc_binary.hpp>
+
+#include <string>
+#include <vector>
+
+namespace nano
+{
+class node;
+namespace ipc
+{
+	/**
+	 * Handles payload_encoding::binary requests. Fields are read from the ledger and written in their raw form, so neither
+	 * side converts hashes, accounts, amounts or blocks to and from text.
+	 */
+	class binary_handler final
+	{
+	public:
+		binary_handler (nano::node &);
+		/** Returns the response payload to the request payload \p request_a */
+		std::vector<uint8_t> process (std::vector<uint8_t> const & request_a);
+
+	private:
+		/** Each action reads its request and writes its response, returning an error message instead if it fails */
+		std::string account_info (nano::stream &, nano::stream &);
+		std::string account_history (nano::stream &, nano::stream &);
+		std::string blocks_info (nano::stream &, nano::stream &);
+		nano::node & node;
+	};
+}
+}
@@ -25,6 +25,11 @@ nano::error nano::ipc::ipc_config::serialize_json (nano::jsonconfig & json) cons
 	domain_l.put ("path", transport_domain.path);
 	domain_l.put ("io_timeout", transport_domain.io_timeout);
 	json.put_child ("local", domain_l);
+	if (worker_threads >= 0)
+	{
+		json.put ("worker_threads", worker_threads);
+	}
+	json.put ("max_multiplexed_requests", max_multiplexed_requests);
 	return json.get_error ();
 }
 
@@ -59,5 +64,15 @@ nano::error nano::ipc::ipc_config::deserialize_json (bool & upgraded_a, nano::js
 		domain_l->get<size_t> ("io_timeout", transport_domain.io_timeout);
 	}
 
+	json.get_optional<long> ("worker_threads", worker_threads, -1);
+	if (worker_threads == 0)
+	{
+		json.get_error ().set ("worker_threads must be at least 1");
+	}
+	json.get_optional<size_t> ("max_multiplexed_requests", max_multiplexed_requests);
+	if (max_multiplexed_requests == 0)
+	{
+		json.get_error ().set ("max_multiplexed_requests must be at least 1");
+	}
 	return json.get_error ();
 }
@@ -59,6 +59,10 @@ namespace ipc
 		nano::error serialize_json (nano::jsonconfig & json) const;
 		ipc_config_domain_socket transport_domain;
 		ipc_config_tcp_socket transport_tcp;
+		/** Number of threads handling requests, the node's io_threads if not set */
+		long worker_threads{ -1 };
+		/** Requests a multiplexed connection may have in flight, further requests are read once one has been answered */
+		size_t max_multiplexed_requests{ 64 };
 	};
 }
 }
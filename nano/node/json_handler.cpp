@@ -1,5 +1,7 @@
 #include <nano/lib/config.hpp>
 #include <nano/lib/json_error_response.hpp>
+#include <nano/lib/json_reader.hpp>
+#include <nano/lib/perfect_hash.hpp>
 #include <nano/lib/timer.hpp>
 #include <nano/node/common.hpp>
 #include <nano/node/ipc.hpp>
@@ -23,20 +25,24 @@
 #include <future>
 #include <iostream>
 #include <thread>
+#include <unordered_set>
 
 namespace
 {
 void construct_json (nano::seq_con_info_component * component, boost::property_tree::ptree & parent);
-using ipc_json_handler_no_arg_func_map = std::unordered_map<std::string, std::function<void(nano::json_handler *)>>;
-ipc_json_handler_no_arg_func_map create_ipc_json_handler_no_arg_func_map ();
-auto ipc_json_handler_no_arg_funcs = create_ipc_json_handler_no_arg_func_map ();
+using json_handler_action_list = std::vector<std::pair<std::string, std::function<void(nano::json_handler *)>>>;
+json_handler_action_list create_json_handler_actions ();
+std::vector<std::string> json_handler_action_names (json_handler_action_list const &);
+auto json_handler_actions = create_json_handler_actions ();
+nano::perfect_hash json_handler_action_index (json_handler_action_names (json_handler_actions));
 bool block_confirmed (nano::node & node, nano::transaction & transaction, nano::block_hash const & hash, bool include_active, bool include_only_confirmed);
 }
 
-nano::json_handler::json_handler (nano::node & node_a, nano::node_rpc_config const & node_rpc_config_a, std::string const & body_a, std::function<void(std::string const &)> const & response_a, std::function<void()> stop_callback_a) :
+nano::json_handler::json_handler (nano::node & node_a, nano::node_rpc_config const & node_rpc_config_a, std::string const & body_a, std::function<void(std::string const &)> const & response_a, std::function<void()> stop_callback_a, nano::rpc_response_chunk const & response_chunk_a) :
 body (body_a),
 node (node_a),
 response (response_a),
+response_chunk (response_chunk_a),
 stop_callback (stop_callback_a),
 node_rpc_config (node_rpc_config_a)
 {
@@ -46,78 +52,20 @@ void nano::json_handler::process_request (bool unsafe_a)
 {
 	try
 	{
-		std::stringstream istream (body);
-		boost::property_tree::read_json (istream, request);
+		nano::json_reader (body).read (request);
 		action = request.get<std::string> ("action");
-		auto no_arg_func_iter = ipc_json_handler_no_arg_funcs.find (action);
-		if (no_arg_func_iter != ipc_json_handler_no_arg_funcs.cend ())
+		unsafe = unsafe_a;
+		auto index (json_handler_action_index.find (action));
+		if (index != nano::perfect_hash::not_found)
 		{
-			// First try the map of options with no arguments
-			no_arg_func_iter->second (this);
+			if (!cached_response ())
+			{
+				json_handler_actions[index].second (this);
+			}
 		}
 		else
 		{
-			// Try the rest of the options
-			if (action == "wallet_seed")
-			{
-				if (unsafe_a || node.network_params.network.is_test_network ())
-				{
-					wallet_seed ();
-				}
-				else
-				{
-					json_error_response (response, "Unsafe RPC not allowed");
-				}
-			}
-			else if (action == "chain")
-			{
-				chain ();
-			}
-			else if (action == "successors")
-			{
-				chain (true);
-			}
-			else if (action == "history")
-			{
-				request.put ("head", request.get<std::string> ("hash"));
-				account_history ();
-			}
-			else if (action == "knano_from_raw" || action == "krai_from_raw")
-			{
-				mnano_from_raw (nano::kxrb_ratio);
-			}
-			else if (action == "knano_to_raw" || action == "krai_to_raw")
-			{
-				mnano_to_raw (nano::kxrb_ratio);
-			}
-			else if (action == "nano_from_raw" || action == "rai_from_raw")
-			{
-				mnano_from_raw (nano::xrb_ratio);
-			}
-			else if (action == "nano_to_raw" || action == "rai_to_raw")
-			{
-				mnano_to_raw (nano::xrb_ratio);
-			}
-			else if (action == "mnano_from_raw" || action == "mrai_from_raw")
-			{
-				mnano_from_raw ();
-			}
-			else if (action == "mnano_to_raw" || action == "mrai_to_raw")
-			{
-				mnano_to_raw ();
-			}
-			else if (action == "password_valid")
-			{
-				password_valid ();
-			}
-			else if (action == "wallet_locked")
-			{
-				password_valid (true);
-			}
-			else
-			{
-				json_error_response (response, "Unknown command");
-			}
+			json_error_response (response, "Unknown command");
 		}
 	}
 	catch (std::runtime_error const &)
@@ -130,6 +78,50 @@ void nano::json_handler::process_request (bool unsafe_a)
 	}
 }
 
+/**
+ * Answers the request from the response cache if it is enabled for the action. On a miss the response is redirected
+ * into the cache, streamed responses are then assembled first.
+ */
+bool nano::json_handler::cached_response ()
+{
+	auto result (false);
+	auto const & config_l (node_rpc_config.response_cache);
+	if (config_l.enable)
+	{
+		auto ttl (config_l.ttls.find (action));
+		if (ttl != config_l.ttls.end () && ttl->second.count () > 0)
+		{
+			// Read before the response is produced, a write committed meanwhile leaves the entry outdated rather than the cache stale
+			auto generation (node.store.generation ());
+			auto key (nano::json_response_cache::key (request));
+			auto existing (node.json_response_cache.get (key, generation));
+			if (existing)
+			{
+				response (*existing);
+				result = true;
+			}
+			else
+			{
+				boost::optional<uint64_t> generation_l;
+				if (!nano::json_response_cache::ledger_independent (action))
+				{
+					generation_l = generation;
+				}
+				auto response_l (response);
+				auto & cache_l (node.json_response_cache);
+				auto ttl_l (ttl->second);
+				auto max_entries_l (config_l.max_entries);
+				response = [response_l, &cache_l, key, generation_l, ttl_l, max_entries_l](std::string const & body_a) {
+					cache_l.put (key, body_a, generation_l, ttl_l, max_entries_l);
+					response_l (body_a);
+				};
+				response_chunk = nullptr;
+			}
+		}
+	}
+	return result;
+}
+
 void nano::json_handler::response_errors ()
 {
 	if (ec || response_l.empty ())
@@ -148,6 +140,78 @@ void nano::json_handler::response_errors ()
 	}
 }
 
+/**
+ * Starts a streamed response with its root object open, errors have to be settled before this is called.
+ * Members preceding the streamed entries are written to the returned writer.
+ */
+nano::json_writer & nano::json_handler::response_stream_begin ()
+{
+	auto & pieces_l (stream_pieces);
+	stream_writer = std::make_unique<nano::json_writer> ([&pieces_l](std::string const & chunk_a, bool last_a) {
+		pieces_l.emplace_back (chunk_a, last_a);
+	});
+	stream_writer->begin_object ();
+	return *stream_writer;
+}
+
+/**
+ * Produces the rest of a streamed response. \p step_a writes entries while no piece is waiting to be passed on and
+ * finishes the writer after the last entry. Each step opens its own transactions, so none is held while the consumer
+ * catches up, and picks up after the last entry the previous step wrote.
+ * Without a chunk handler the pieces are assembled and passed to response once complete.
+ */
+void nano::json_handler::response_stream (std::function<void(nano::json_writer &)> const & step_a)
+{
+	stream_step = step_a;
+	if (response_chunk)
+	{
+		response_stream_next ();
+	}
+	else
+	{
+		std::string body_l;
+		for (auto last_l (false); !last_l;)
+		{
+			while (stream_pieces.empty ())
+			{
+				stream_step (*stream_writer);
+			}
+			body_l.append (stream_pieces.front ().first);
+			last_l = stream_pieces.front ().second;
+			stream_pieces.pop_front ();
+		}
+		response (body_l);
+	}
+}
+
+/** Passes the next piece to the chunk handler, the one after is produced once the handler resumes the stream */
+void nano::json_handler::response_stream_next ()
+{
+	while (stream_pieces.empty ())
+	{
+		stream_step (*stream_writer);
+	}
+	auto piece (std::move (stream_pieces.front ()));
+	stream_pieces.pop_front ();
+	if (piece.second)
+	{
+		response_chunk (piece.first, true, [](bool) {});
+	}
+	else
+	{
+		auto this_l (shared_from_this ());
+		response_chunk (piece.first, false, [this_l](bool resume_a) {
+			// Resumed from the consumer's completion handler, production continues on a node thread instead
+			if (resume_a)
+			{
+				this_l->node.background ([this_l]() {
+					this_l->response_stream_next ();
+				});
+			}
+		});
+	}
+}
+
 std::shared_ptr<nano::wallet> nano::json_handler::wallet_impl ()
 {
 	if (!ec)
@@ -243,8 +307,7 @@ std::shared_ptr<nano::block> nano::json_handler::block_impl (bool signature_work
 	{
 		std::string block_text (request.get<std::string> ("block"));
 		boost::property_tree::ptree block_l;
-		std::stringstream block_stream (block_text);
-		boost::property_tree::read_json (block_stream, block_l);
+		nano::json_reader (block_text).read (block_l);
 		if (!signature_work_required)
 		{
 			block_l.put ("signature", "0");
@@ -1552,6 +1615,50 @@ void nano::json_handler::bootstrap_lazy ()
 	response_errors ();
 }
 
+void nano::json_handler::bootstrap_snapshot ()
+{
+	std::string address_text = request.get<std::string> ("address");
+	std::string port_text = request.get<std::string> ("port");
+	boost::system::error_code address_ec;
+	auto address (boost::asio::ip::address_v6::from_string (address_text, address_ec));
+	if (!address_ec)
+	{
+		uint16_t port;
+		if (!nano::parse_port (port_text, port))
+		{
+			std::vector<nano::block_hash> anchors;
+			auto anchors_node (request.get_child_optional ("anchors"));
+			if (anchors_node)
+			{
+				for (auto & anchor : *anchors_node)
+				{
+					nano::block_hash hash;
+					if (hash.decode_hex (anchor.second.data ()))
+					{
+						ec = nano::error_blocks::invalid_block_hash;
+						break;
+					}
+					anchors.push_back (hash);
+				}
+			}
+			if (!ec)
+			{
+				node.bootstrap_initiator.bootstrap_snapshot (nano::endpoint (address, port), anchors);
+				response_l.put ("success", "");
+			}
+		}
+		else
+		{
+			ec = nano::error_common::invalid_port;
+		}
+	}
+	else
+	{
+		ec = nano::error_common::invalid_ip_address;
+	}
+	response_errors ();
+}
+
 /*
  * @warning This is an internal/diagnostic RPC, do not rely on its interface being stable
  */
@@ -1867,18 +1974,19 @@ void nano::json_handler::delegators ()
 	{
 		boost::property_tree::ptree delegators;
 		auto transaction (node.store.tx_begin_read ());
-		for (auto i (node.store.latest_begin (transaction)), n (node.store.latest_end ()); i != n; ++i)
+		// Encoded into one buffer rather than a new string for each delegator
+		std::string delegator_text (nano::uint256_union::account_encoded_size, '\0');
+		for (auto i (node.store.delegators_begin (transaction, account)), n (node.store.delegators_end ()); i != n && i->first == account; ++i)
 		{
-			nano::account_info const & info (i->second);
-			auto block (node.store.block_get (transaction, info.rep_block));
-			assert (block != nullptr);
-			if (block->representative () == account)
-			{
-				std::string balance;
-				nano::uint128_union (info.balance).encode_dec (balance);
-				nano::account const & account (i->first);
-				delegators.put (account.to_account (), balance);
-			}
+			nano::account const & delegator (i->second);
+			nano::account_info info;
+			auto error (node.store.account_get (transaction, delegator, info));
+			(void)error;
+			assert (!error);
+			std::string balance;
+			nano::uint128_union (info.balance).encode_dec (balance);
+			delegator.encode_account (&delegator_text[0]);
+			delegators.put (delegator_text, balance);
 		}
 		response_l.add_child ("delegators", delegators);
 	}
@@ -1890,18 +1998,8 @@ void nano::json_handler::delegators_count ()
 	auto account (account_impl ());
 	if (!ec)
 	{
-		uint64_t count (0);
 		auto transaction (node.store.tx_begin_read ());
-		for (auto i (node.store.latest_begin (transaction)), n (node.store.latest_end ()); i != n; ++i)
-		{
-			nano::account_info const & info (i->second);
-			auto block (node.store.block_get (transaction, info.rep_block));
-			assert (block != nullptr);
-			if (block->representative () == account)
-			{
-				++count;
-			}
-		}
+		uint64_t count (node.store.delegators_count (transaction, account));
 		response_l.put ("count", std::to_string (count));
 	}
 	response_errors ();
@@ -1942,15 +2040,31 @@ void nano::json_handler::frontiers ()
 	auto count (count_impl ());
 	if (!ec)
 	{
-		boost::property_tree::ptree frontiers;
-		auto transaction (node.store.tx_begin_read ());
-		for (auto i (node.store.latest_begin (transaction, start)), n (node.store.latest_end ()); i != n && frontiers.size () < count; ++i)
-		{
-			frontiers.put (i->first.to_account (), i->second.head.to_string ());
-		}
-		response_l.add_child ("frontiers", frontiers);
+		response_stream_begin ().begin_object ("frontiers");
+		uint64_t written (0);
+		response_stream ([this, start, count, written](nano::json_writer & writer_a) mutable {
+			auto transaction (node.store.tx_begin_read ());
+			auto i (node.store.latest_begin (transaction, start));
+			auto n (node.store.latest_end ());
+			for (; i != n && written < count && stream_pieces.empty (); ++i, ++written)
+			{
+				writer_a.put (i->first.to_account (), i->second.head.to_string ());
+			}
+			if (i != n && written < count)
+			{
+				start = i->first;
+			}
+			else
+			{
+				writer_a.end ();
+				writer_a.finish ();
+			}
+		});
+	}
+	else
+	{
+		response_errors ();
 	}
-	response_errors ();
 }
 
 void nano::json_handler::account_count ()
@@ -2210,17 +2324,19 @@ void nano::json_handler::account_history ()
 	}
 	if (!ec)
 	{
-		boost::property_tree::ptree history;
-		response_l.put ("account", account.to_account ());
-		nano::block_sideband sideband;
-		auto block (node.store.block_get (transaction, hash, &sideband));
-		while (block != nullptr && count > 0)
+		if (count > 0)
 		{
-			if (offset > 0)
-			{
-				--offset;
-			}
-			else
+			// Skipped blocks are never filtered, so the offset is a distance in the chain
+			hash = node.ledger.block_at_distance (transaction, account, hash, offset, reverse);
+		}
+		auto & writer (response_stream_begin ());
+		writer.put ("account", account.to_account ());
+		writer.begin_array ("history");
+		response_stream ([this, account, hash, count, output_raw, reverse, accounts_to_filter](nano::json_writer & writer_a) mutable {
+			auto transaction (node.store.tx_begin_read ());
+			nano::block_sideband sideband;
+			auto block (node.store.block_get (transaction, hash, &sideband));
+			while (block != nullptr && count > 0 && stream_pieces.empty ())
 			{
 				boost::property_tree::ptree entry;
 				history_visitor visitor (*this, output_raw, transaction, entry, hash, accounts_to_filter);
@@ -2235,20 +2351,27 @@ void nano::json_handler::account_history ()
 						entry.put ("work", nano::to_string_hex (block->block_work ()));
 						entry.put ("signature", block->block_signature ().to_string ());
 					}
-					history.push_back (std::make_pair ("", entry));
+					writer_a.push_back_child (entry);
 					--count;
 				}
+				hash = reverse ? node.store.block_successor (transaction, hash) : block->previous ();
+				block = node.store.block_get (transaction, hash, &sideband);
 			}
-			hash = reverse ? node.store.block_successor (transaction, hash) : block->previous ();
-			block = node.store.block_get (transaction, hash, &sideband);
-		}
-		response_l.add_child ("history", history);
-		if (!hash.is_zero ())
-		{
-			response_l.put (reverse ? "next" : "previous", hash.to_string ());
-		}
+			if (block == nullptr || count == 0)
+			{
+				writer_a.end ();
+				if (!hash.is_zero ())
+				{
+					writer_a.put (reverse ? "next" : "previous", hash.to_string ());
+				}
+				writer_a.finish ();
+			}
+		});
+	}
+	else
+	{
+		response_errors ();
 	}
-	response_errors ();
 }
 
 void nano::json_handler::keepalive ()
@@ -2302,9 +2425,10 @@ void nano::json_handler::ledger ()
 {
 	auto count (count_optional_impl ());
 	auto threshold (threshold_optional_impl ());
+	nano::account start (0);
+	uint64_t modified_since (0);
 	if (!ec)
 	{
-		nano::account start (0);
 		boost::optional<std::string> account_text (request.get_optional<std::string> ("account"));
 		if (account_text.is_initialized ())
 		{
@@ -2313,7 +2437,6 @@ void nano::json_handler::ledger ()
 				ec = nano::error_common::bad_account_number;
 			}
 		}
-		uint64_t modified_since (0);
 		boost::optional<std::string> modified_since_text (request.get_optional<std::string> ("modified_since"));
 		if (modified_since_text.is_initialized ())
 		{
@@ -2322,110 +2445,136 @@ void nano::json_handler::ledger ()
 				ec = nano::error_rpc::invalid_timestamp;
 			}
 		}
+	}
+	if (!ec)
+	{
 		const bool sorting = request.get<bool> ("sorting", false);
 		const bool representative = request.get<bool> ("representative", false);
 		const bool weight = request.get<bool> ("weight", false);
 		const bool pending = request.get<bool> ("pending", false);
-		boost::property_tree::ptree accounts;
-		auto transaction (node.store.tx_begin_read ());
-		if (!ec && !sorting) // Simple
-		{
-			for (auto i (node.store.latest_begin (transaction, start)), n (node.store.latest_end ()); i != n && accounts.size () < count; ++i)
+		// Returns false if the account is left out as its balance with pending is below the threshold
+		// Hashes and accounts are encoded into one buffer rather than a new string for each
+		auto text (std::make_shared<std::string> (nano::uint256_union::account_encoded_size, '\0'));
+		auto entry ([this, threshold, representative, weight, pending, text](nano::transaction const & transaction_a, nano::account const & account_a, nano::account_info const & info_a, boost::property_tree::ptree & entry_a) {
+			auto put_hex ([&entry_a, &text](char const * key_a, nano::uint256_union const & value_a) {
+				text->resize (2 * value_a.bytes.size ());
+				value_a.encode_hex (&(*text)[0]);
+				entry_a.put (key_a, *text);
+			});
+			if (pending)
 			{
-				nano::account_info const & info (i->second);
-				if (info.modified >= modified_since && (pending || info.balance.number () >= threshold.number ()))
+				auto account_pending (node.ledger.account_pending (transaction_a, account_a));
+				if (info_a.balance.number () + account_pending < threshold.number ())
 				{
-					nano::account const & account (i->first);
-					boost::property_tree::ptree response_a;
-					if (pending)
+					return false;
+				}
+				entry_a.put ("pending", account_pending.convert_to<std::string> ());
+			}
+			put_hex ("frontier", info_a.head);
+			put_hex ("open_block", info_a.open_block);
+			put_hex ("representative_block", info_a.rep_block);
+			std::string balance;
+			nano::uint128_union (info_a.balance).encode_dec (balance);
+			entry_a.put ("balance", balance);
+			entry_a.put ("modified_timestamp", std::to_string (info_a.modified));
+			entry_a.put ("block_count", std::to_string (info_a.block_count));
+			if (representative)
+			{
+				auto block (node.store.block_get (transaction_a, info_a.rep_block));
+				assert (block != nullptr);
+				text->resize (nano::uint256_union::account_encoded_size);
+				block->representative ().encode_account (&(*text)[0]);
+				entry_a.put ("representative", *text);
+			}
+			if (weight)
+			{
+				auto account_weight (node.ledger.weight (transaction_a, account_a));
+				entry_a.put ("weight", account_weight.convert_to<std::string> ());
+			}
+			return true;
+		});
+		response_stream_begin ().begin_object ("accounts");
+		uint64_t written (0);
+		if (!sorting) // Simple
+		{
+			response_stream ([this, entry, start, count, threshold, modified_since, pending, written](nano::json_writer & writer_a) mutable {
+				auto transaction (node.store.tx_begin_read ());
+				auto i (node.store.latest_begin (transaction, start));
+				auto n (node.store.latest_end ());
+				std::string account_text (nano::uint256_union::account_encoded_size, '\0');
+				for (; i != n && written < count && stream_pieces.empty (); ++i)
+				{
+					nano::account_info const & info (i->second);
+					if (info.modified >= modified_since && (pending || info.balance.number () >= threshold.number ()))
 					{
-						auto account_pending (node.ledger.account_pending (transaction, account));
-						if (info.balance.number () + account_pending < threshold.number ())
+						boost::property_tree::ptree response_a;
+						if (entry (transaction, i->first, info, response_a))
 						{
-							continue;
+							i->first.encode_account (&account_text[0]);
+							writer_a.put_child (account_text, response_a);
+							++written;
 						}
-						response_a.put ("pending", account_pending.convert_to<std::string> ());
-					}
-					response_a.put ("frontier", info.head.to_string ());
-					response_a.put ("open_block", info.open_block.to_string ());
-					response_a.put ("representative_block", info.rep_block.to_string ());
-					std::string balance;
-					nano::uint128_union (info.balance).encode_dec (balance);
-					response_a.put ("balance", balance);
-					response_a.put ("modified_timestamp", std::to_string (info.modified));
-					response_a.put ("block_count", std::to_string (info.block_count));
-					if (representative)
-					{
-						auto block (node.store.block_get (transaction, info.rep_block));
-						assert (block != nullptr);
-						response_a.put ("representative", block->representative ().to_account ());
 					}
-					if (weight)
-					{
-						auto account_weight (node.ledger.weight (transaction, account));
-						response_a.put ("weight", account_weight.convert_to<std::string> ());
-					}
-					accounts.push_back (std::make_pair (account.to_account (), response_a));
 				}
-			}
+				if (i != n && written < count)
+				{
+					start = i->first;
+				}
+				else
+				{
+					writer_a.end ();
+					writer_a.finish ();
+				}
+			});
 		}
-		else if (!ec) // Sorting
+		else // Sorting
 		{
-			std::vector<std::pair<nano::uint128_union, nano::account>> ledger_l;
-			for (auto i (node.store.latest_begin (transaction, start)), n (node.store.latest_end ()); i != n; ++i)
+			auto ledger_l (std::make_shared<std::vector<std::pair<nano::uint128_union, nano::account>>> ());
 			{
-				nano::account_info const & info (i->second);
-				nano::uint128_union balance (info.balance);
-				if (info.modified >= modified_since)
+				auto transaction (node.store.tx_begin_read ());
+				for (auto i (node.store.latest_begin (transaction, start)), n (node.store.latest_end ()); i != n; ++i)
 				{
-					ledger_l.emplace_back (balance, i->first);
+					nano::account_info const & info (i->second);
+					nano::uint128_union balance (info.balance);
+					if (info.modified >= modified_since)
+					{
+						ledger_l->emplace_back (balance, i->first);
+					}
 				}
 			}
-			std::sort (ledger_l.begin (), ledger_l.end ());
-			std::reverse (ledger_l.begin (), ledger_l.end ());
-			nano::account_info info;
-			for (auto i (ledger_l.begin ()), n (ledger_l.end ()); i != n && accounts.size () < count; ++i)
-			{
-				node.store.account_get (transaction, i->second, info);
-				if (pending || info.balance.number () >= threshold.number ())
+			std::sort (ledger_l->begin (), ledger_l->end ());
+			std::reverse (ledger_l->begin (), ledger_l->end ());
+			size_t index (0);
+			response_stream ([this, entry, ledger_l, count, threshold, pending, written, index](nano::json_writer & writer_a) mutable {
+				auto transaction (node.store.tx_begin_read ());
+				nano::account_info info;
+				std::string account_text (nano::uint256_union::account_encoded_size, '\0');
+				for (; index < ledger_l->size () && written < count && stream_pieces.empty (); ++index)
 				{
-					nano::account const & account (i->second);
-					boost::property_tree::ptree response_a;
-					if (pending)
+					nano::account const & account ((*ledger_l)[index].second);
+					if (!node.store.account_get (transaction, account, info) && (pending || info.balance.number () >= threshold.number ()))
 					{
-						auto account_pending (node.ledger.account_pending (transaction, account));
-						if (info.balance.number () + account_pending < threshold.number ())
+						boost::property_tree::ptree response_a;
+						if (entry (transaction, account, info, response_a))
 						{
-							continue;
+							account.encode_account (&account_text[0]);
+							writer_a.put_child (account_text, response_a);
+							++written;
 						}
-						response_a.put ("pending", account_pending.convert_to<std::string> ());
-					}
-					response_a.put ("frontier", info.head.to_string ());
-					response_a.put ("open_block", info.open_block.to_string ());
-					response_a.put ("representative_block", info.rep_block.to_string ());
-					std::string balance;
-					(i->first).encode_dec (balance);
-					response_a.put ("balance", balance);
-					response_a.put ("modified_timestamp", std::to_string (info.modified));
-					response_a.put ("block_count", std::to_string (info.block_count));
-					if (representative)
-					{
-						auto block (node.store.block_get (transaction, info.rep_block));
-						assert (block != nullptr);
-						response_a.put ("representative", block->representative ().to_account ());
-					}
-					if (weight)
-					{
-						auto account_weight (node.ledger.weight (transaction, account));
-						response_a.put ("weight", account_weight.convert_to<std::string> ());
 					}
-					accounts.push_back (std::make_pair (account.to_account (), response_a));
 				}
-			}
+				if (index == ledger_l->size () || written == count)
+				{
+					writer_a.end ();
+					writer_a.finish ();
+				}
+			});
 		}
-		response_l.add_child ("accounts", accounts);
 	}
-	response_errors ();
+	else
+	{
+		response_errors ();
+	}
 }
 
 void nano::json_handler::mnano_from_raw (nano::uint128_t ratio)
@@ -3089,36 +3238,41 @@ void nano::json_handler::representatives ()
 	if (!ec)
 	{
 		const bool sorting = request.get<bool> ("sorting", false);
-		boost::property_tree::ptree representatives;
-		auto transaction (node.store.tx_begin_read ());
-		if (!sorting) // Simple
+		// The representation table has no seek by account, so the entries are collected up front and streamed from memory
+		auto representation (std::make_shared<std::vector<std::pair<nano::uint128_union, std::string>>> ());
 		{
-			for (auto i (node.store.representation_begin (transaction)), n (node.store.representation_end ()); i != n && representatives.size () < count; ++i)
+			auto transaction (node.store.tx_begin_read ());
+			for (auto i (node.store.representation_begin (transaction)), n (node.store.representation_end ()); i != n && (sorting || representation->size () < count); ++i)
 			{
 				nano::account const & account (i->first);
 				auto amount (node.store.representation_get (transaction, account));
-				representatives.put (account.to_account (), amount.convert_to<std::string> ());
+				representation->push_back (std::make_pair (amount, account.to_account ()));
 			}
 		}
-		else // Sorting
+		if (sorting)
 		{
-			std::vector<std::pair<nano::uint128_union, std::string>> representation;
-			for (auto i (node.store.representation_begin (transaction)), n (node.store.representation_end ()); i != n; ++i)
+			std::sort (representation->begin (), representation->end ());
+			std::reverse (representation->begin (), representation->end ());
+		}
+		response_stream_begin ().begin_object ("representatives");
+		size_t index (0);
+		response_stream ([this, representation, count, index](nano::json_writer & writer_a) mutable {
+			for (; index < representation->size () && index < count && stream_pieces.empty (); ++index)
 			{
-				nano::account const & account (i->first);
-				auto amount (node.store.representation_get (transaction, account));
-				representation.push_back (std::make_pair (amount, account.to_account ()));
+				auto const & entry ((*representation)[index]);
+				writer_a.put (entry.second, entry.first.number ().convert_to<std::string> ());
 			}
-			std::sort (representation.begin (), representation.end ());
-			std::reverse (representation.begin (), representation.end ());
-			for (auto i (representation.begin ()), n (representation.end ()); i != n && representatives.size () < count; ++i)
+			if (index == representation->size () || index == count)
 			{
-				representatives.put (i->second, (i->first).number ().convert_to<std::string> ());
+				writer_a.end ();
+				writer_a.finish ();
 			}
-		}
-		response_l.add_child ("representatives", representatives);
+		});
+	}
+	else
+	{
+		response_errors ();
 	}
-	response_errors ();
 }
 
 void nano::json_handler::representatives_online ()
@@ -3586,18 +3740,40 @@ void nano::json_handler::unchecked ()
 	auto count (count_optional_impl ());
 	if (!ec)
 	{
-		boost::property_tree::ptree unchecked;
-		auto transaction (node.store.tx_begin_read ());
-		for (auto i (node.store.unchecked_begin (transaction)), n (node.store.unchecked_end ()); i != n && unchecked.size () < count; ++i)
-		{
-			nano::unchecked_info const & info (i->second);
-			std::string contents;
-			info.block->serialize_json (contents);
-			unchecked.put (info.block->hash ().to_string (), contents);
-		}
-		response_l.add_child ("blocks", unchecked);
+		response_stream_begin ().begin_object ("blocks");
+		// A block waiting on several dependencies has an entry for each, it's listed once
+		std::unordered_set<nano::block_hash> written;
+		nano::unchecked_key start (0, 0);
+		response_stream ([this, count, written, start](nano::json_writer & writer_a) mutable {
+			auto transaction (node.store.tx_begin_read ());
+			auto i (node.store.unchecked_begin (transaction, start));
+			auto n (node.store.unchecked_end ());
+			for (; i != n && written.size () < count && stream_pieces.empty (); ++i)
+			{
+				nano::unchecked_info const & info (i->second);
+				auto hash (info.block->hash ());
+				if (written.insert (hash).second)
+				{
+					std::string contents;
+					info.block->serialize_json (contents);
+					writer_a.put (hash.to_string (), contents);
+				}
+			}
+			if (i != n && written.size () < count)
+			{
+				start = i->first;
+			}
+			else
+			{
+				writer_a.end ();
+				writer_a.finish ();
+			}
+		});
+	}
+	else
+	{
+		response_errors ();
 	}
-	response_errors ();
 }
 
 void nano::json_handler::unchecked_clear ()
@@ -3885,6 +4061,8 @@ void nano::json_handler::wallet_balances ()
 		boost::property_tree::ptree balances;
 		auto transaction (node.wallets.tx_begin_read ());
 		auto block_transaction (node.store.tx_begin_read ());
+		// Encoded into one buffer rather than a new string for each account
+		std::string account_text (nano::uint256_union::account_encoded_size, '\0');
 		for (auto i (wallet->store.begin (transaction)), n (wallet->store.end ()); i != n; ++i)
 		{
 			nano::account const & account (i->first);
@@ -3895,7 +4073,8 @@ void nano::json_handler::wallet_balances ()
 				nano::uint128_t pending = node.ledger.account_pending (block_transaction, account);
 				entry.put ("balance", balance.convert_to<std::string> ());
 				entry.put ("pending", pending.convert_to<std::string> ());
-				balances.push_back (std::make_pair (account.to_account (), entry));
+				account.encode_account (&account_text[0]);
+				balances.push_back (std::make_pair (account_text, entry));
 			}
 		}
 		response_l.add_child ("balances", balances);
@@ -4131,49 +4310,65 @@ void nano::json_handler::wallet_ledger ()
 	auto wallet (wallet_impl ());
 	if (!ec)
 	{
-		boost::property_tree::ptree accounts;
-		auto transaction (node.wallets.tx_begin_read ());
-		auto block_transaction (node.store.tx_begin_read ());
-		for (auto i (wallet->store.begin (transaction)), n (wallet->store.end ()); i != n; ++i)
-		{
-			nano::account const & account (i->first);
-			nano::account_info info;
-			if (!node.store.account_get (block_transaction, account, info))
+		response_stream_begin ().begin_object ("accounts");
+		nano::account start (nano::wallet_store::special_count);
+		response_stream ([this, wallet, start, modified_since, representative, weight, pending](nano::json_writer & writer_a) mutable {
+			auto transaction (node.wallets.tx_begin_read ());
+			auto block_transaction (node.store.tx_begin_read ());
+			auto i (wallet->store.begin (transaction, start));
+			auto n (wallet->store.end ());
+			for (; i != n && stream_pieces.empty (); ++i)
 			{
-				if (info.modified >= modified_since)
+				nano::account const & account (i->first);
+				nano::account_info info;
+				if (!node.store.account_get (block_transaction, account, info))
 				{
-					boost::property_tree::ptree entry;
-					entry.put ("frontier", info.head.to_string ());
-					entry.put ("open_block", info.open_block.to_string ());
-					entry.put ("representative_block", info.rep_block.to_string ());
-					std::string balance;
-					nano::uint128_union (info.balance).encode_dec (balance);
-					entry.put ("balance", balance);
-					entry.put ("modified_timestamp", std::to_string (info.modified));
-					entry.put ("block_count", std::to_string (info.block_count));
-					if (representative)
-					{
-						auto block (node.store.block_get (block_transaction, info.rep_block));
-						assert (block != nullptr);
-						entry.put ("representative", block->representative ().to_account ());
-					}
-					if (weight)
-					{
-						auto account_weight (node.ledger.weight (block_transaction, account));
-						entry.put ("weight", account_weight.convert_to<std::string> ());
-					}
-					if (pending)
+					if (info.modified >= modified_since)
 					{
-						auto account_pending (node.ledger.account_pending (block_transaction, account));
-						entry.put ("pending", account_pending.convert_to<std::string> ());
+						boost::property_tree::ptree entry;
+						entry.put ("frontier", info.head.to_string ());
+						entry.put ("open_block", info.open_block.to_string ());
+						entry.put ("representative_block", info.rep_block.to_string ());
+						std::string balance;
+						nano::uint128_union (info.balance).encode_dec (balance);
+						entry.put ("balance", balance);
+						entry.put ("modified_timestamp", std::to_string (info.modified));
+						entry.put ("block_count", std::to_string (info.block_count));
+						if (representative)
+						{
+							auto block (node.store.block_get (block_transaction, info.rep_block));
+							assert (block != nullptr);
+							entry.put ("representative", block->representative ().to_account ());
+						}
+						if (weight)
+						{
+							auto account_weight (node.ledger.weight (block_transaction, account));
+							entry.put ("weight", account_weight.convert_to<std::string> ());
+						}
+						if (pending)
+						{
+							auto account_pending (node.ledger.account_pending (block_transaction, account));
+							entry.put ("pending", account_pending.convert_to<std::string> ());
+						}
+						writer_a.put_child (account.to_account (), entry);
 					}
-					accounts.push_back (std::make_pair (account.to_account (), entry));
 				}
 			}
-		}
-		response_l.add_child ("accounts", accounts);
+			if (i != n)
+			{
+				start = i->first;
+			}
+			else
+			{
+				writer_a.end ();
+				writer_a.finish ();
+			}
+		});
+	}
+	else
+	{
+		response_errors ();
 	}
-	response_errors ();
 }
 
 void nano::json_handler::wallet_lock ()
@@ -4181,9 +4376,7 @@ void nano::json_handler::wallet_lock ()
 	auto wallet (wallet_impl ());
 	if (!ec)
 	{
-		nano::raw_key empty;
-		empty.data.clear ();
-		wallet->store.password.value_set (empty);
+		wallet->store.lock ();
 		response_l.put ("locked", "1");
 		node.logger.try_log ("Wallet locked");
 	}
@@ -4367,22 +4560,29 @@ void nano::json_handler::wallet_republish ()
 
 void nano::json_handler::wallet_seed ()
 {
-	auto wallet (wallet_impl ());
-	if (!ec)
+	if (unsafe || node.network_params.network.is_test_network ())
 	{
-		auto transaction (node.wallets.tx_begin_read ());
-		if (wallet->store.valid_password (transaction))
-		{
-			nano::raw_key seed;
-			wallet->store.seed (seed, transaction);
-			response_l.put ("seed", seed.data.to_string ());
-		}
-		else
+		auto wallet (wallet_impl ());
+		if (!ec)
 		{
-			ec = nano::error_common::wallet_locked;
+			auto transaction (node.wallets.tx_begin_read ());
+			if (wallet->store.valid_password (transaction))
+			{
+				nano::raw_key seed;
+				wallet->store.seed (seed, transaction);
+				response_l.put ("seed", seed.data.to_string ());
+			}
+			else
+			{
+				ec = nano::error_common::wallet_locked;
+			}
 		}
+		response_errors ();
+	}
+	else
+	{
+		json_error_response (response, "Unsafe RPC not allowed");
 	}
-	response_errors ();
 }
 
 void nano::json_handler::wallet_work_get ()
@@ -4596,123 +4796,188 @@ void construct_json (nano::seq_con_info_component * component, boost::property_t
 	parent.add_child (composite->get_name (), current);
 }
 
-// Any RPC handlers which require no arguments (excl default arguments) should go here.
+// Every RPC action is dispatched through this table, actions taking arguments or sharing a handler are bound with a lambda.
 // This is to prevent large if/else chains which compilers can have limits for (MSVC for instance has 128).
-ipc_json_handler_no_arg_func_map create_ipc_json_handler_no_arg_func_map ()
-{
-	ipc_json_handler_no_arg_func_map no_arg_funcs;
-	no_arg_funcs.emplace ("account_balance", &nano::json_handler::account_balance);
-	no_arg_funcs.emplace ("account_block_count", &nano::json_handler::account_block_count);
-	no_arg_funcs.emplace ("account_count", &nano::json_handler::account_count);
-	no_arg_funcs.emplace ("account_create", &nano::json_handler::account_create);
-	no_arg_funcs.emplace ("account_get", &nano::json_handler::account_get);
-	no_arg_funcs.emplace ("account_history", &nano::json_handler::account_history);
-	no_arg_funcs.emplace ("account_info", &nano::json_handler::account_info);
-	no_arg_funcs.emplace ("account_key", &nano::json_handler::account_key);
-	no_arg_funcs.emplace ("account_list", &nano::json_handler::account_list);
-	no_arg_funcs.emplace ("account_move", &nano::json_handler::account_move);
-	no_arg_funcs.emplace ("account_remove", &nano::json_handler::account_remove);
-	no_arg_funcs.emplace ("account_representative", &nano::json_handler::account_representative);
-	no_arg_funcs.emplace ("account_representative_set", &nano::json_handler::account_representative_set);
-	no_arg_funcs.emplace ("account_weight", &nano::json_handler::account_weight);
-	no_arg_funcs.emplace ("accounts_balances", &nano::json_handler::accounts_balances);
-	no_arg_funcs.emplace ("accounts_create", &nano::json_handler::accounts_create);
-	no_arg_funcs.emplace ("accounts_frontiers", &nano::json_handler::accounts_frontiers);
-	no_arg_funcs.emplace ("accounts_pending", &nano::json_handler::accounts_pending);
-	no_arg_funcs.emplace ("active_difficulty", &nano::json_handler::active_difficulty);
-	no_arg_funcs.emplace ("available_supply", &nano::json_handler::available_supply);
-	no_arg_funcs.emplace ("block_info", &nano::json_handler::block_info);
-	no_arg_funcs.emplace ("block", &nano::json_handler::block_info);
-	no_arg_funcs.emplace ("block_confirm", &nano::json_handler::block_confirm);
-	no_arg_funcs.emplace ("blocks", &nano::json_handler::blocks);
-	no_arg_funcs.emplace ("blocks_info", &nano::json_handler::blocks_info);
-	no_arg_funcs.emplace ("block_account", &nano::json_handler::block_account);
-	no_arg_funcs.emplace ("block_count", &nano::json_handler::block_count);
-	no_arg_funcs.emplace ("block_count_type", &nano::json_handler::block_count_type);
-	no_arg_funcs.emplace ("block_create", &nano::json_handler::block_create);
-	no_arg_funcs.emplace ("block_hash", &nano::json_handler::block_hash);
-	no_arg_funcs.emplace ("bootstrap", &nano::json_handler::bootstrap);
-	no_arg_funcs.emplace ("bootstrap_any", &nano::json_handler::bootstrap_any);
-	no_arg_funcs.emplace ("bootstrap_lazy", &nano::json_handler::bootstrap_lazy);
-	no_arg_funcs.emplace ("bootstrap_status", &nano::json_handler::bootstrap_status);
-	no_arg_funcs.emplace ("confirmation_active", &nano::json_handler::confirmation_active);
-	no_arg_funcs.emplace ("confirmation_height_currently_processing", &nano::json_handler::confirmation_height_currently_processing);
-	no_arg_funcs.emplace ("confirmation_history", &nano::json_handler::confirmation_history);
-	no_arg_funcs.emplace ("confirmation_info", &nano::json_handler::confirmation_info);
-	no_arg_funcs.emplace ("confirmation_quorum", &nano::json_handler::confirmation_quorum);
-	no_arg_funcs.emplace ("database_txn_tracker", &nano::json_handler::database_txn_tracker);
-	no_arg_funcs.emplace ("delegators", &nano::json_handler::delegators);
-	no_arg_funcs.emplace ("delegators_count", &nano::json_handler::delegators_count);
-	no_arg_funcs.emplace ("deterministic_key", &nano::json_handler::deterministic_key);
-	no_arg_funcs.emplace ("frontiers", &nano::json_handler::frontiers);
-	no_arg_funcs.emplace ("frontier_count", &nano::json_handler::account_count);
-	no_arg_funcs.emplace ("keepalive", &nano::json_handler::keepalive);
-	no_arg_funcs.emplace ("key_create", &nano::json_handler::key_create);
-	no_arg_funcs.emplace ("key_expand", &nano::json_handler::key_expand);
-	no_arg_funcs.emplace ("ledger", &nano::json_handler::ledger);
-	no_arg_funcs.emplace ("node_id", &nano::json_handler::node_id);
-	no_arg_funcs.emplace ("node_id_delete", &nano::json_handler::node_id_delete);
-	no_arg_funcs.emplace ("password_change", &nano::json_handler::password_change);
-	no_arg_funcs.emplace ("password_enter", &nano::json_handler::password_enter);
-	no_arg_funcs.emplace ("wallet_unlock", &nano::json_handler::password_enter);
-	no_arg_funcs.emplace ("payment_begin", &nano::json_handler::payment_begin);
-	no_arg_funcs.emplace ("payment_init", &nano::json_handler::payment_init);
-	no_arg_funcs.emplace ("payment_end", &nano::json_handler::payment_end);
-	no_arg_funcs.emplace ("payment_wait", &nano::json_handler::payment_wait);
-	no_arg_funcs.emplace ("peers", &nano::json_handler::peers);
-	no_arg_funcs.emplace ("pending", &nano::json_handler::pending);
-	no_arg_funcs.emplace ("pending_exists", &nano::json_handler::pending_exists);
-	no_arg_funcs.emplace ("process", &nano::json_handler::process);
-	no_arg_funcs.emplace ("receive", &nano::json_handler::receive);
-	no_arg_funcs.emplace ("receive_minimum", &nano::json_handler::receive_minimum);
-	no_arg_funcs.emplace ("receive_minimum_set", &nano::json_handler::receive_minimum_set);
-	no_arg_funcs.emplace ("representatives", &nano::json_handler::representatives);
-	no_arg_funcs.emplace ("representatives_online", &nano::json_handler::representatives_online);
-	no_arg_funcs.emplace ("republish", &nano::json_handler::republish);
-	no_arg_funcs.emplace ("search_pending", &nano::json_handler::search_pending);
-	no_arg_funcs.emplace ("search_pending_all", &nano::json_handler::search_pending_all);
-	no_arg_funcs.emplace ("send", &nano::json_handler::send);
-	no_arg_funcs.emplace ("sign", &nano::json_handler::sign);
-	no_arg_funcs.emplace ("stats", &nano::json_handler::stats);
-	no_arg_funcs.emplace ("stats_clear", &nano::json_handler::stats_clear);
-	no_arg_funcs.emplace ("stop", &nano::json_handler::stop);
-	no_arg_funcs.emplace ("unchecked", &nano::json_handler::unchecked);
-	no_arg_funcs.emplace ("unchecked_clear", &nano::json_handler::unchecked_clear);
-	no_arg_funcs.emplace ("unchecked_get", &nano::json_handler::unchecked_get);
-	no_arg_funcs.emplace ("unchecked_keys", &nano::json_handler::unchecked_keys);
-	no_arg_funcs.emplace ("unopened", &nano::json_handler::unopened);
-	no_arg_funcs.emplace ("uptime", &nano::json_handler::uptime);
-	no_arg_funcs.emplace ("validate_account_number", &nano::json_handler::validate_account_number);
-	no_arg_funcs.emplace ("version", &nano::json_handler::version);
-	no_arg_funcs.emplace ("wallet_add", &nano::json_handler::wallet_add);
-	no_arg_funcs.emplace ("wallet_add_watch", &nano::json_handler::wallet_add_watch);
-	no_arg_funcs.emplace ("wallet_balances", &nano::json_handler::wallet_balances);
-	no_arg_funcs.emplace ("wallet_change_seed", &nano::json_handler::wallet_change_seed);
-	no_arg_funcs.emplace ("wallet_contains", &nano::json_handler::wallet_contains);
-	no_arg_funcs.emplace ("wallet_create", &nano::json_handler::wallet_create);
-	no_arg_funcs.emplace ("wallet_destroy", &nano::json_handler::wallet_destroy);
-	no_arg_funcs.emplace ("wallet_export", &nano::json_handler::wallet_export);
-	no_arg_funcs.emplace ("wallet_frontiers", &nano::json_handler::wallet_frontiers);
-	no_arg_funcs.emplace ("wallet_history", &nano::json_handler::wallet_history);
-	no_arg_funcs.emplace ("wallet_info", &nano::json_handler::wallet_info);
-	no_arg_funcs.emplace ("wallet_balance_total", &nano::json_handler::wallet_info);
-	no_arg_funcs.emplace ("wallet_key_valid", &nano::json_handler::wallet_key_valid);
-	no_arg_funcs.emplace ("wallet_ledger", &nano::json_handler::wallet_ledger);
-	no_arg_funcs.emplace ("wallet_lock", &nano::json_handler::wallet_lock);
-	no_arg_funcs.emplace ("wallet_pending", &nano::json_handler::wallet_pending);
-	no_arg_funcs.emplace ("wallet_representative", &nano::json_handler::wallet_representative);
-	no_arg_funcs.emplace ("wallet_representative_set", &nano::json_handler::wallet_representative_set);
-	no_arg_funcs.emplace ("wallet_republish", &nano::json_handler::wallet_republish);
-	no_arg_funcs.emplace ("wallet_work_get", &nano::json_handler::wallet_work_get);
-	no_arg_funcs.emplace ("work_generate", &nano::json_handler::work_generate);
-	no_arg_funcs.emplace ("work_cancel", &nano::json_handler::work_cancel);
-	no_arg_funcs.emplace ("work_get", &nano::json_handler::work_get);
-	no_arg_funcs.emplace ("work_set", &nano::json_handler::work_set);
-	no_arg_funcs.emplace ("work_validate", &nano::json_handler::work_validate);
-	no_arg_funcs.emplace ("work_peer_add", &nano::json_handler::work_peer_add);
-	no_arg_funcs.emplace ("work_peers", &nano::json_handler::work_peers);
-	no_arg_funcs.emplace ("work_peers_clear", &nano::json_handler::work_peers_clear);
-	return no_arg_funcs;
+json_handler_action_list create_json_handler_actions ()
+{
+	json_handler_action_list actions;
+	actions.emplace_back ("account_balance", &nano::json_handler::account_balance);
+	actions.emplace_back ("account_block_count", &nano::json_handler::account_block_count);
+	actions.emplace_back ("account_count", &nano::json_handler::account_count);
+	actions.emplace_back ("account_create", &nano::json_handler::account_create);
+	actions.emplace_back ("account_get", &nano::json_handler::account_get);
+	actions.emplace_back ("account_history", &nano::json_handler::account_history);
+	actions.emplace_back ("account_info", &nano::json_handler::account_info);
+	actions.emplace_back ("account_key", &nano::json_handler::account_key);
+	actions.emplace_back ("account_list", &nano::json_handler::account_list);
+	actions.emplace_back ("account_move", &nano::json_handler::account_move);
+	actions.emplace_back ("account_remove", &nano::json_handler::account_remove);
+	actions.emplace_back ("account_representative", &nano::json_handler::account_representative);
+	actions.emplace_back ("account_representative_set", &nano::json_handler::account_representative_set);
+	actions.emplace_back ("account_weight", &nano::json_handler::account_weight);
+	actions.emplace_back ("accounts_balances", &nano::json_handler::accounts_balances);
+	actions.emplace_back ("accounts_create", &nano::json_handler::accounts_create);
+	actions.emplace_back ("accounts_frontiers", &nano::json_handler::accounts_frontiers);
+	actions.emplace_back ("accounts_pending", &nano::json_handler::accounts_pending);
+	actions.emplace_back ("active_difficulty", &nano::json_handler::active_difficulty);
+	actions.emplace_back ("available_supply", &nano::json_handler::available_supply);
+	actions.emplace_back ("block_info", &nano::json_handler::block_info);
+	actions.emplace_back ("block", &nano::json_handler::block_info);
+	actions.emplace_back ("block_confirm", &nano::json_handler::block_confirm);
+	actions.emplace_back ("blocks", &nano::json_handler::blocks);
+	actions.emplace_back ("blocks_info", &nano::json_handler::blocks_info);
+	actions.emplace_back ("block_account", &nano::json_handler::block_account);
+	actions.emplace_back ("block_count", &nano::json_handler::block_count);
+	actions.emplace_back ("block_count_type", &nano::json_handler::block_count_type);
+	actions.emplace_back ("block_create", &nano::json_handler::block_create);
+	actions.emplace_back ("block_hash", &nano::json_handler::block_hash);
+	actions.emplace_back ("bootstrap", &nano::json_handler::bootstrap);
+	actions.emplace_back ("bootstrap_any", &nano::json_handler::bootstrap_any);
+	actions.emplace_back ("bootstrap_lazy", &nano::json_handler::bootstrap_lazy);
+	actions.emplace_back ("bootstrap_snapshot", &nano::json_handler::bootstrap_snapshot);
+	actions.emplace_back ("bootstrap_status", &nano::json_handler::bootstrap_status);
+	actions.emplace_back ("chain", [](nano::json_handler * handler_a) {
+		handler_a->chain ();
+	});
+	actions.emplace_back ("confirmation_active", &nano::json_handler::confirmation_active);
+	actions.emplace_back ("confirmation_height_currently_processing", &nano::json_handler::confirmation_height_currently_processing);
+	actions.emplace_back ("confirmation_history", &nano::json_handler::confirmation_history);
+	actions.emplace_back ("confirmation_info", &nano::json_handler::confirmation_info);
+	actions.emplace_back ("confirmation_quorum", &nano::json_handler::confirmation_quorum);
+	actions.emplace_back ("database_txn_tracker", &nano::json_handler::database_txn_tracker);
+	actions.emplace_back ("delegators", &nano::json_handler::delegators);
+	actions.emplace_back ("delegators_count", &nano::json_handler::delegators_count);
+	actions.emplace_back ("deterministic_key", &nano::json_handler::deterministic_key);
+	actions.emplace_back ("frontiers", &nano::json_handler::frontiers);
+	actions.emplace_back ("frontier_count", &nano::json_handler::account_count);
+	actions.emplace_back ("history", [](nano::json_handler * handler_a) {
+		handler_a->request.put ("head", handler_a->request.get<std::string> ("hash"));
+		handler_a->account_history ();
+	});
+	actions.emplace_back ("keepalive", &nano::json_handler::keepalive);
+	actions.emplace_back ("key_create", &nano::json_handler::key_create);
+	actions.emplace_back ("key_expand", &nano::json_handler::key_expand);
+	actions.emplace_back ("knano_from_raw", [](nano::json_handler * handler_a) {
+		handler_a->mnano_from_raw (nano::kxrb_ratio);
+	});
+	actions.emplace_back ("knano_to_raw", [](nano::json_handler * handler_a) {
+		handler_a->mnano_to_raw (nano::kxrb_ratio);
+	});
+	actions.emplace_back ("krai_from_raw", [](nano::json_handler * handler_a) {
+		handler_a->mnano_from_raw (nano::kxrb_ratio);
+	});
+	actions.emplace_back ("krai_to_raw", [](nano::json_handler * handler_a) {
+		handler_a->mnano_to_raw (nano::kxrb_ratio);
+	});
+	actions.emplace_back ("ledger", &nano::json_handler::ledger);
+	actions.emplace_back ("mnano_from_raw", [](nano::json_handler * handler_a) {
+		handler_a->mnano_from_raw ();
+	});
+	actions.emplace_back ("mnano_to_raw", [](nano::json_handler * handler_a) {
+		handler_a->mnano_to_raw ();
+	});
+	actions.emplace_back ("mrai_from_raw", [](nano::json_handler * handler_a) {
+		handler_a->mnano_from_raw ();
+	});
+	actions.emplace_back ("mrai_to_raw", [](nano::json_handler * handler_a) {
+		handler_a->mnano_to_raw ();
+	});
+	actions.emplace_back ("nano_from_raw", [](nano::json_handler * handler_a) {
+		handler_a->mnano_from_raw (nano::xrb_ratio);
+	});
+	actions.emplace_back ("nano_to_raw", [](nano::json_handler * handler_a) {
+		handler_a->mnano_to_raw (nano::xrb_ratio);
+	});
+	actions.emplace_back ("node_id", &nano::json_handler::node_id);
+	actions.emplace_back ("node_id_delete", &nano::json_handler::node_id_delete);
+	actions.emplace_back ("password_change", &nano::json_handler::password_change);
+	actions.emplace_back ("password_enter", &nano::json_handler::password_enter);
+	actions.emplace_back ("password_valid", [](nano::json_handler * handler_a) {
+		handler_a->password_valid ();
+	});
+	actions.emplace_back ("wallet_unlock", &nano::json_handler::password_enter);
+	actions.emplace_back ("payment_begin", &nano::json_handler::payment_begin);
+	actions.emplace_back ("payment_init", &nano::json_handler::payment_init);
+	actions.emplace_back ("payment_end", &nano::json_handler::payment_end);
+	actions.emplace_back ("payment_wait", &nano::json_handler::payment_wait);
+	actions.emplace_back ("peers", &nano::json_handler::peers);
+	actions.emplace_back ("pending", &nano::json_handler::pending);
+	actions.emplace_back ("pending_exists", &nano::json_handler::pending_exists);
+	actions.emplace_back ("process", &nano::json_handler::process);
+	actions.emplace_back ("rai_from_raw", [](nano::json_handler * handler_a) {
+		handler_a->mnano_from_raw (nano::xrb_ratio);
+	});
+	actions.emplace_back ("rai_to_raw", [](nano::json_handler * handler_a) {
+		handler_a->mnano_to_raw (nano::xrb_ratio);
+	});
+	actions.emplace_back ("receive", &nano::json_handler::receive);
+	actions.emplace_back ("receive_minimum", &nano::json_handler::receive_minimum);
+	actions.emplace_back ("receive_minimum_set", &nano::json_handler::receive_minimum_set);
+	actions.emplace_back ("representatives", &nano::json_handler::representatives);
+	actions.emplace_back ("representatives_online", &nano::json_handler::representatives_online);
+	actions.emplace_back ("republish", &nano::json_handler::republish);
+	actions.emplace_back ("search_pending", &nano::json_handler::search_pending);
+	actions.emplace_back ("search_pending_all", &nano::json_handler::search_pending_all);
+	actions.emplace_back ("send", &nano::json_handler::send);
+	actions.emplace_back ("sign", &nano::json_handler::sign);
+	actions.emplace_back ("stats", &nano::json_handler::stats);
+	actions.emplace_back ("stats_clear", &nano::json_handler::stats_clear);
+	actions.emplace_back ("stop", &nano::json_handler::stop);
+	actions.emplace_back ("successors", [](nano::json_handler * handler_a) {
+		handler_a->chain (true);
+	});
+	actions.emplace_back ("unchecked", &nano::json_handler::unchecked);
+	actions.emplace_back ("unchecked_clear", &nano::json_handler::unchecked_clear);
+	actions.emplace_back ("unchecked_get", &nano::json_handler::unchecked_get);
+	actions.emplace_back ("unchecked_keys", &nano::json_handler::unchecked_keys);
+	actions.emplace_back ("unopened", &nano::json_handler::unopened);
+	actions.emplace_back ("uptime", &nano::json_handler::uptime);
+	actions.emplace_back ("validate_account_number", &nano::json_handler::validate_account_number);
+	actions.emplace_back ("version", &nano::json_handler::version);
+	actions.emplace_back ("wallet_add", &nano::json_handler::wallet_add);
+	actions.emplace_back ("wallet_add_watch", &nano::json_handler::wallet_add_watch);
+	actions.emplace_back ("wallet_balances", &nano::json_handler::wallet_balances);
+	actions.emplace_back ("wallet_change_seed", &nano::json_handler::wallet_change_seed);
+	actions.emplace_back ("wallet_contains", &nano::json_handler::wallet_contains);
+	actions.emplace_back ("wallet_create", &nano::json_handler::wallet_create);
+	actions.emplace_back ("wallet_destroy", &nano::json_handler::wallet_destroy);
+	actions.emplace_back ("wallet_export", &nano::json_handler::wallet_export);
+	actions.emplace_back ("wallet_frontiers", &nano::json_handler::wallet_frontiers);
+	actions.emplace_back ("wallet_history", &nano::json_handler::wallet_history);
+	actions.emplace_back ("wallet_info", &nano::json_handler::wallet_info);
+	actions.emplace_back ("wallet_balance_total", &nano::json_handler::wallet_info);
+	actions.emplace_back ("wallet_key_valid", &nano::json_handler::wallet_key_valid);
+	actions.emplace_back ("wallet_ledger", &nano::json_handler::wallet_ledger);
+	actions.emplace_back ("wallet_lock", &nano::json_handler::wallet_lock);
+	actions.emplace_back ("wallet_locked", [](nano::json_handler * handler_a) {
+		handler_a->password_valid (true);
+	});
+	actions.emplace_back ("wallet_pending", &nano::json_handler::wallet_pending);
+	actions.emplace_back ("wallet_representative", &nano::json_handler::wallet_representative);
+	actions.emplace_back ("wallet_representative_set", &nano::json_handler::wallet_representative_set);
+	actions.emplace_back ("wallet_republish", &nano::json_handler::wallet_republish);
+	actions.emplace_back ("wallet_seed", &nano::json_handler::wallet_seed);
+	actions.emplace_back ("wallet_work_get", &nano::json_handler::wallet_work_get);
+	actions.emplace_back ("work_generate", &nano::json_handler::work_generate);
+	actions.emplace_back ("work_cancel", &nano::json_handler::work_cancel);
+	actions.emplace_back ("work_get", &nano::json_handler::work_get);
+	actions.emplace_back ("work_set", &nano::json_handler::work_set);
+	actions.emplace_back ("work_validate", &nano::json_handler::work_validate);
+	actions.emplace_back ("work_peer_add", &nano::json_handler::work_peer_add);
+	actions.emplace_back ("work_peers", &nano::json_handler::work_peers);
+	actions.emplace_back ("work_peers_clear", &nano::json_handler::work_peers_clear);
+	return actions;
+}
+
+std::vector<std::string> json_handler_action_names (json_handler_action_list const & actions_a)
+{
+	std::vector<std::string> result;
+	result.reserve (actions_a.size ());
+	for (auto const & action : actions_a)
+	{
+		result.push_back (action.first);
+	}
+	return result;
 }
 
 /** Due to the asynchronous nature of updating confirmation heights, it can also be necessary to check active roots */
@@ -1,12 +1,16 @@
 #pragma once
 
+#include <nano/lib/json_writer.hpp>
 #include <nano/lib/numbers.hpp>
+#include <nano/lib/rpc_handler_interface.hpp>
 #include <nano/node/wallet.hpp>
 #include <nano/rpc/rpc.hpp>
 
 #include <boost/property_tree/ptree.hpp>
 
+#include <deque>
 #include <functional>
+#include <memory>
 #include <string>
 
 namespace nano
@@ -17,8 +21,12 @@ class node_rpc_config;
 class json_handler : public std::enable_shared_from_this<nano::json_handler>
 {
 public:
+	/**
+	 * If \p response_chunk is set, streamed responses are passed to it in pieces instead of to \p response as a whole.
+	 * The next piece is only produced once the consumer has resumed the stream.
+	 */
 	json_handler (
-	nano::node &, nano::node_rpc_config const &, std::string const &, std::function<void(std::string const &)> const &, std::function<void()> stop_callback = []() {});
+	nano::node &, nano::node_rpc_config const &, std::string const &, std::function<void(std::string const &)> const &, std::function<void()> stop_callback = []() {}, nano::rpc_response_chunk const & response_chunk = nullptr);
 	void process_request (bool unsafe = false);
 	void account_balance ();
 	void account_block_count ();
@@ -52,6 +60,7 @@ public:
 	void bootstrap ();
 	void bootstrap_any ();
 	void bootstrap_lazy ();
+	void bootstrap_snapshot ();
 	void bootstrap_status ();
 	void chain (bool = false);
 	void confirmation_active ();
@@ -136,7 +145,16 @@ public:
 	nano::node & node;
 	boost::property_tree::ptree request;
 	std::function<void(std::string const &)> response;
+	nano::rpc_response_chunk response_chunk;
 	void response_errors ();
+	nano::json_writer & response_stream_begin ();
+	void response_stream (std::function<void(nano::json_writer &)> const &);
+	void response_stream_next ();
+	/** Pieces produced by the stream writer which have not been passed on yet */
+	std::deque<std::pair<std::string, bool>> stream_pieces;
+	std::unique_ptr<nano::json_writer> stream_writer;
+	std::function<void(nano::json_writer &)> stream_step;
+	bool cached_response ();
 	std::error_code ec;
 	std::string action;
 	boost::property_tree::ptree response_l;
@@ -154,6 +172,8 @@ public:
 	uint64_t count_optional_impl (uint64_t = std::numeric_limits<uint64_t>::max ());
 	uint64_t offset_optional_impl (uint64_t = 0);
 	bool enable_sign_hash{ false };
+	/** Set from process_request, allows actions such as wallet_seed which expose secrets */
+	bool unsafe{ false };
 	std::function<void()> stop_callback;
 	nano::node_rpc_config const & node_rpc_config;
 };
@@ -169,13 +189,17 @@ public:
 	{
 	}
 
-	void process_request (std::string const &, std::string const & body_a, std::function<void(std::string const &)> response_a) override
+	void process_request (std::string const &, std::string const & body_a, nano::rpc_response_chunk response_a) override
 	{
-		// Note that if the rpc action is async, the shared_ptr<json_handler> lifetime will be extended by the action handler
-		auto handler (std::make_shared<nano::json_handler> (node, node_rpc_config, body_a, response_a, [this]() {
+		auto complete_response ([response_a](std::string const & response_body_a) {
+			response_a (response_body_a, true, [](bool) {});
+		});
+		auto stop_l ([this]() {
 			this->stop_callback ();
 			this->stop ();
-		}));
+		});
+		// Note that if the rpc action is async, the shared_ptr<json_handler> lifetime will be extended by the action handler
+		auto handler (std::make_shared<nano::json_handler> (node, node_rpc_config, body_a, complete_response, stop_l, response_a));
 		handler->process_request ();
 	}
 
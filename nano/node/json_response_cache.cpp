@@ -0,0 +1,123 @@
+#include <nano/lib/stats.hpp>
+#include <nano/node/json_response_cache.hpp>
+
+#include <boost/property_tree/ptree.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+/** Values and member names are length prefixed, members are sorted by name while array elements keep their order */
+void append_normalized (boost::property_tree::ptree const & tree_a, std::string & result_a)
+{
+	if (tree_a.empty ())
+	{
+		result_a.append (std::to_string (tree_a.data ().size ()));
+		result_a.push_back (':');
+		result_a.append (tree_a.data ());
+	}
+	else
+	{
+		std::vector<boost::property_tree::ptree::value_type const *> children;
+		children.reserve (tree_a.size ());
+		for (auto const & child : tree_a)
+		{
+			children.push_back (&child);
+		}
+		std::stable_sort (children.begin (), children.end (), [](auto const * lhs, auto const * rhs) {
+			return lhs->first < rhs->first;
+		});
+		result_a.push_back ('{');
+		for (auto child : children)
+		{
+			result_a.append (std::to_string (child->first.size ()));
+			result_a.push_back (':');
+			result_a.append (child->first);
+			append_normalized (child->second, result_a);
+		}
+		result_a.push_back ('}');
+	}
+}
+}
+
+nano::json_response_cache::json_response_cache (nano::stat & stats_a) :
+stats (stats_a)
+{
+}
+
+std::string nano::json_response_cache::key (boost::property_tree::ptree const & request_a)
+{
+	std::string result;
+	append_normalized (request_a, result);
+	return result;
+}
+
+bool nano::json_response_cache::ledger_independent (std::string const & action_a)
+{
+	return action_a == "active_difficulty" || action_a == "confirmation_quorum" || action_a == "representatives_online";
+}
+
+boost::optional<std::string> nano::json_response_cache::get (std::string const & key_a, uint64_t generation_a)
+{
+	boost::optional<std::string> result;
+	{
+		std::lock_guard<std::mutex> lock (mutex);
+		auto & keys (entries.get<1> ());
+		auto existing (keys.find (key_a));
+		if (existing != keys.end ())
+		{
+			if (std::chrono::steady_clock::now () < existing->expiry && (!existing->generation || *existing->generation == generation_a))
+			{
+				result = existing->response;
+			}
+			else
+			{
+				keys.erase (existing);
+			}
+		}
+	}
+	stats.inc (nano::stat::type::rpc_cache, result ? nano::stat::detail::hit : nano::stat::detail::miss);
+	return result;
+}
+
+void nano::json_response_cache::put (std::string const & key_a, std::string const & response_a, boost::optional<uint64_t> generation_a, std::chrono::milliseconds ttl_a, size_t max_entries_a)
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	auto & keys (entries.get<1> ());
+	auto existing (keys.find (key_a));
+	if (existing != keys.end ())
+	{
+		keys.erase (existing);
+	}
+	entries.push_back ({ key_a, response_a, generation_a, std::chrono::steady_clock::now () + ttl_a });
+	// Evicts the responses which were stored first
+	while (entries.size () > max_entries_a)
+	{
+		entries.pop_front ();
+	}
+}
+
+size_t nano::json_response_cache::size ()
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	return entries.size ();
+}
+
+void nano::json_response_cache::clear ()
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	entries.clear ();
+}
+
+namespace nano
+{
+std::unique_ptr<seq_con_info_component> collect_seq_con_info (json_response_cache & json_response_cache, const std::string & name)
+{
+	auto count = json_response_cache.size ();
+	auto sizeof_element = sizeof (nano::json_response_cache_entry);
+	auto composite = std::make_unique<seq_con_info_composite> (name);
+	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "entries", count, sizeof_element }));
+	return composite;
+}
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <nano/lib/utility.hpp>
+
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+#include <boost/multi_index_container.hpp>
+#include <boost/optional.hpp>
+#include <boost/property_tree/ptree_fwd.hpp>
+
+#include <chrono>
+#include <mutex>
+#include <string>
+
+namespace nano
+{
+class stat;
+
+class json_response_cache_entry final
+{
+public:
+	std::string key;
+	std::string response;
+	/** Store generation the response was produced at, not checked for responses independent of the ledger */
+	boost::optional<uint64_t> generation;
+	std::chrono::steady_clock::time_point expiry;
+};
+
+/**
+ * Responses to read-only RPC actions keyed by their normalized request. A response is served until its time to live
+ * runs out or, for actions reading the ledger, until anything is written to the store.
+ */
+class json_response_cache final
+{
+public:
+	explicit json_response_cache (nano::stat &);
+	/** Returns a key which is equal for requests that only differ in formatting and member order */
+	static std::string key (boost::property_tree::ptree const &);
+	/** Whether responses of \p action_a change without a write to the store, so they are only limited by their time to live */
+	static bool ledger_independent (std::string const & action_a);
+	boost::optional<std::string> get (std::string const & key_a, uint64_t generation_a);
+	/** \p generation_a has to be read before the response is produced, so writes which raced the request invalidate it */
+	void put (std::string const & key_a, std::string const & response_a, boost::optional<uint64_t> generation_a, std::chrono::milliseconds ttl_a, size_t max_entries_a);
+	size_t size ();
+	void clear ();
+
+private:
+	// clang-format off
+	boost::multi_index_container<nano::json_response_cache_entry,
+	boost::multi_index::indexed_by<
+		boost::multi_index::sequenced<>,
+		boost::multi_index::hashed_unique<boost::multi_index::member<nano::json_response_cache_entry, std::string, &nano::json_response_cache_entry::key>>>>
+	entries;
+	// clang-format on
+	std::mutex mutex;
+	nano::stat & stats;
+};
+
+std::unique_ptr<seq_con_info_component> collect_seq_con_info (json_response_cache & json_response_cache, const std::string & name);
+}
@@ -502,6 +502,86 @@ nano::store_iterator<nano::account, nano::uint128_union> nano::mdb_store::repres
 	return result;
 }
 
+void nano::mdb_store::delegator_put (nano::transaction const & transaction_a, nano::account const & representative_a, nano::account const & delegator_a)
+{
+	auto status (mdb_put (env.tx (transaction_a), delegators, nano::mdb_val (representative_a), nano::mdb_val (delegator_a), MDB_NODUPDATA));
+	release_assert (status == 0 || status == MDB_KEYEXIST);
+}
+
+void nano::mdb_store::delegator_del (nano::transaction const & transaction_a, nano::account const & representative_a, nano::account const & delegator_a)
+{
+	auto status (mdb_del (env.tx (transaction_a), delegators, nano::mdb_val (representative_a), nano::mdb_val (delegator_a)));
+	release_assert (status == 0 || status == MDB_NOTFOUND);
+}
+
+nano::store_iterator<nano::account, nano::account> nano::mdb_store::delegators_begin (nano::transaction const & transaction_a, nano::account const & representative_a)
+{
+	nano::store_iterator<nano::account, nano::account> result (std::make_unique<nano::mdb_iterator<nano::account, nano::account>> (transaction_a, delegators, nano::mdb_val (representative_a)));
+	return result;
+}
+
+nano::store_iterator<nano::account, nano::account> nano::mdb_store::delegators_end ()
+{
+	nano::store_iterator<nano::account, nano::account> result (nullptr);
+	return result;
+}
+
+size_t nano::mdb_store::delegators_count (nano::transaction const & transaction_a, nano::account const & representative_a)
+{
+	size_t result (0);
+	MDB_cursor * cursor;
+	auto status (mdb_cursor_open (env.tx (transaction_a), delegators, &cursor));
+	release_assert (status == 0);
+	nano::mdb_val key (representative_a);
+	nano::mdb_val value;
+	auto status2 (mdb_cursor_get (cursor, key, value, MDB_SET));
+	release_assert (status2 == 0 || status2 == MDB_NOTFOUND);
+	if (status2 == 0)
+	{
+		auto status3 (mdb_cursor_count (cursor, &result));
+		release_assert (status3 == 0);
+	}
+	mdb_cursor_close (cursor);
+	return result;
+}
+
+void nano::mdb_store::account_height_put (nano::transaction const & transaction_a, nano::account_height_key const & key_a, nano::block_hash const & hash_a)
+{
+	auto status (mdb_put (env.tx (transaction_a), account_heights, nano::mdb_val (key_a), nano::mdb_val (hash_a), 0));
+	release_assert (status == 0);
+}
+
+void nano::mdb_store::account_height_del (nano::transaction const & transaction_a, nano::account_height_key const & key_a)
+{
+	auto status (mdb_del (env.tx (transaction_a), account_heights, nano::mdb_val (key_a), nullptr));
+	release_assert (status == 0 || status == MDB_NOTFOUND);
+}
+
+nano::block_hash nano::mdb_store::block_at_height (nano::transaction const & transaction_a, nano::account const & account_a, uint64_t height_a) const
+{
+	nano::mdb_val value;
+	auto status (mdb_get (env.tx (transaction_a), account_heights, nano::mdb_val (nano::account_height_key (account_a, height_a)), value));
+	release_assert (status == 0 || status == MDB_NOTFOUND);
+	nano::block_hash result (0);
+	if (status == 0)
+	{
+		result = nano::uint256_union (value);
+	}
+	return result;
+}
+
+nano::store_iterator<nano::account_height_key, nano::block_hash> nano::mdb_store::account_heights_begin (nano::transaction const & transaction_a, nano::account_height_key const & key_a)
+{
+	nano::store_iterator<nano::account_height_key, nano::block_hash> result (std::make_unique<nano::mdb_iterator<nano::account_height_key, nano::block_hash>> (transaction_a, account_heights, nano::mdb_val (key_a)));
+	return result;
+}
+
+nano::store_iterator<nano::account_height_key, nano::block_hash> nano::mdb_store::account_heights_end ()
+{
+	nano::store_iterator<nano::account_height_key, nano::block_hash> result (nullptr);
+	return result;
+}
+
 nano::store_iterator<nano::unchecked_key, nano::unchecked_info> nano::mdb_store::unchecked_begin (nano::transaction const & transaction_a)
 {
 	nano::store_iterator<nano::unchecked_key, nano::unchecked_info> result (std::make_unique<nano::mdb_iterator<nano::unchecked_key, nano::unchecked_info>> (transaction_a, unchecked));
@@ -582,7 +662,18 @@ void nano::mdb_store::serialize_mdb_tracker (boost::property_tree::ptree & json,
 
 nano::write_transaction nano::mdb_store::tx_begin_write ()
 {
-	return env.tx_begin_write (create_txn_callbacks ());
+	auto callbacks (create_txn_callbacks ());
+	// Called once the transaction has been committed, so readers which see the new generation also see the writes
+	callbacks.txn_end = [txn_end = callbacks.txn_end, &generation_m = generation_m](const nano::transaction_impl * transaction_impl) {
+		txn_end (transaction_impl);
+		++generation_m;
+	};
+	return env.tx_begin_write (callbacks);
+}
+
+uint64_t nano::mdb_store::generation () const
+{
+	return generation_m;
 }
 
 nano::read_transaction nano::mdb_store::tx_begin_read ()
@@ -620,7 +711,10 @@ void nano::mdb_store::open_databases (bool & error_a, nano::transaction const &
 	error_a |= mdb_dbi_open (env.tx (transaction_a), "state_v1", flags, &state_blocks_v1) != 0;
 	error_a |= mdb_dbi_open (env.tx (transaction_a), "pending", flags, &pending_v0) != 0;
 	error_a |= mdb_dbi_open (env.tx (transaction_a), "pending_v1", flags, &pending_v1) != 0;
+	error_a |= mdb_dbi_open (env.tx (transaction_a), "pending_totals", flags, &pending_totals) != 0;
 	error_a |= mdb_dbi_open (env.tx (transaction_a), "representation", flags, &representation) != 0;
+	error_a |= mdb_dbi_open (env.tx (transaction_a), "delegators", flags | MDB_DUPSORT | MDB_DUPFIXED, &delegators) != 0;
+	error_a |= mdb_dbi_open (env.tx (transaction_a), "account_heights", flags, &account_heights) != 0;
 	error_a |= mdb_dbi_open (env.tx (transaction_a), "unchecked", flags, &unchecked) != 0;
 	error_a |= mdb_dbi_open (env.tx (transaction_a), "vote", flags, &vote) != 0;
 	error_a |= mdb_dbi_open (env.tx (transaction_a), "online_weight", flags, &online_weight) != 0;
@@ -743,6 +837,12 @@ bool nano::mdb_store::do_upgrades (nano::write_transaction & transaction_a, size
 		case 13:
 			upgrade_v13_to_v14 (transaction_a);
 		case 14:
+			upgrade_v14_to_v15 (transaction_a);
+		case 15:
+			upgrade_v15_to_v16 (transaction_a, batch_size);
+		case 16:
+			upgrade_v16_to_v17 (transaction_a);
+		case 17:
 			break;
 		default:
 			logger.always_log (boost::str (boost::format ("The version of the ledger (%1%) is too high for this node") % version_l));
@@ -1042,6 +1142,97 @@ void nano::mdb_store::upgrade_v13_to_v14 (nano::transaction const & transaction_
 	release_assert (!error || error == MDB_NOTFOUND);
 }
 
+void nano::mdb_store::upgrade_v14_to_v15 (nano::transaction const & transaction_a)
+{
+	// Populate the delegator index from the representative of every account
+	version_put (transaction_a, 15);
+	for (auto i (latest_begin (transaction_a)), n (latest_end ()); i != n; ++i)
+	{
+		auto rep_block (block_get (transaction_a, i->second.rep_block));
+		if (rep_block != nullptr)
+		{
+			delegator_put (transaction_a, rep_block->representative (), i->first);
+		}
+	}
+	logger.always_log ("Completed delegator index upgrade");
+}
+
+void nano::mdb_store::upgrade_v15_to_v16 (nano::write_transaction & transaction_a, size_t const batch_size)
+{
+	// Populate the account height index by walking every account chain from its open block
+	size_t cost (0);
+	nano::account account (0);
+	auto const & not_an_account (network_params.random.not_an_account);
+	while (account != not_an_account)
+	{
+		nano::account first (0);
+		nano::account_info second;
+		{
+			auto current (latest_begin (transaction_a, account));
+			if (current != latest_end ())
+			{
+				first = current->first;
+				second = current->second;
+			}
+		}
+		if (!first.is_zero ())
+		{
+			auto hash (second.open_block);
+			uint64_t height (1);
+			while (!hash.is_zero ())
+			{
+				if (cost >= batch_size)
+				{
+					logger.always_log (boost::str (boost::format ("Upgrading account height index for account %1%... height %2%") % first.to_account ().substr (0, 24) % std::to_string (height)));
+					transaction_a.commit ();
+					std::this_thread::yield ();
+					transaction_a.renew ();
+					cost = 0;
+				}
+				account_height_put (transaction_a, nano::account_height_key (first, height), hash);
+				hash = block_successor (transaction_a, hash);
+				++height;
+				++cost;
+			}
+			account = first.number () + 1;
+		}
+		else
+		{
+			account = not_an_account;
+		}
+	}
+	logger.always_log ("Completed account height index upgrade");
+	version_put (transaction_a, 16);
+}
+
+void nano::mdb_store::upgrade_v16_to_v17 (nano::transaction const & transaction_a)
+{
+	// Sum the pending entries of every account, both pending tables are merged in key order so entries of an account are adjacent
+	version_put (transaction_a, 17);
+	auto status (mdb_drop (env.tx (transaction_a), pending_totals, 0));
+	release_assert (status == 0);
+	nano::account account (0);
+	nano::pending_total total;
+	for (auto i (pending_begin (transaction_a)), n (pending_end ()); i != n; ++i)
+	{
+		nano::pending_key const & key (i->first);
+		nano::pending_info const & info (i->second);
+		if (key.account != account && total.count > 0)
+		{
+			pending_total_put (transaction_a, account, total);
+			total = nano::pending_total ();
+		}
+		account = key.account;
+		total.amount = total.amount.number () + info.amount.number ();
+		++total.count;
+	}
+	if (total.count > 0)
+	{
+		pending_total_put (transaction_a, account, total);
+	}
+	logger.always_log ("Completed pending totals upgrade");
+}
+
 void nano::mdb_store::clear (MDB_dbi db_a)
 {
 	auto transaction (tx_begin_write ());
@@ -1229,6 +1420,7 @@ std::shared_ptr<nano::block> nano::mdb_store::block_random (nano::transaction co
 
 void nano::mdb_store::block_del (nano::transaction const & transaction_a, nano::block_hash const & hash_a)
 {
+	account_height_unindex (transaction_a, hash_a);
 	auto status (mdb_del (env.tx (transaction_a), state_blocks_v1, nano::mdb_val (hash_a), nullptr));
 	release_assert (status == 0 || status == MDB_NOTFOUND);
 	if (status != 0)
@@ -1444,19 +1636,70 @@ void nano::mdb_store::account_put (nano::transaction const & transaction_a, nano
 
 void nano::mdb_store::pending_put (nano::transaction const & transaction_a, nano::pending_key const & key_a, nano::pending_info const & pending_a)
 {
+	nano::pending_info existing;
+	// An entry in the other pending table stays and remains counted
+	if (!pending_get (transaction_a, key_a, existing) && existing.epoch == pending_a.epoch)
+	{
+		pending_total_subtract (transaction_a, key_a.account, existing.amount);
+	}
 	auto status (mdb_put (env.tx (transaction_a), get_pending_db (pending_a.epoch), nano::mdb_val (key_a), nano::mdb_val (pending_a), 0));
 	release_assert (status == 0);
+	pending_total_add (transaction_a, key_a.account, pending_a.amount);
 }
 
 void nano::mdb_store::pending_del (nano::transaction const & transaction_a, nano::pending_key const & key_a)
 {
-	auto status1 (mdb_del (env.tx (transaction_a), pending_v1, mdb_val (key_a), nullptr));
-	if (status1 != 0)
+	nano::pending_info existing;
+	auto error (pending_get (transaction_a, key_a, existing));
+	release_assert (!error);
+	auto status (mdb_del (env.tx (transaction_a), get_pending_db (existing.epoch), mdb_val (key_a), nullptr));
+	release_assert (status == 0);
+	pending_total_subtract (transaction_a, key_a.account, existing.amount);
+}
+
+nano::pending_total nano::mdb_store::pending_total_get (nano::transaction const & transaction_a, nano::account const & account_a)
+{
+	nano::mdb_val value;
+	auto status (mdb_get (env.tx (transaction_a), pending_totals, nano::mdb_val (account_a), value));
+	release_assert (status == 0 || status == MDB_NOTFOUND);
+	nano::pending_total result;
+	if (status == 0)
 	{
-		release_assert (status1 == MDB_NOTFOUND);
-		auto status2 (mdb_del (env.tx (transaction_a), pending_v0, mdb_val (key_a), nullptr));
-		release_assert (status2 == 0);
+		result = nano::pending_total (value);
+	}
+	return result;
+}
+
+/** Accounts without pending entries have no row */
+void nano::mdb_store::pending_total_put (nano::transaction const & transaction_a, nano::account const & account_a, nano::pending_total const & total_a)
+{
+	if (total_a.count > 0)
+	{
+		auto status (mdb_put (env.tx (transaction_a), pending_totals, nano::mdb_val (account_a), nano::mdb_val (total_a), 0));
+		release_assert (status == 0);
 	}
+	else
+	{
+		auto status (mdb_del (env.tx (transaction_a), pending_totals, nano::mdb_val (account_a), nullptr));
+		release_assert (status == 0 || status == MDB_NOTFOUND);
+	}
+}
+
+void nano::mdb_store::pending_total_add (nano::transaction const & transaction_a, nano::account const & account_a, nano::amount const & amount_a)
+{
+	auto total (pending_total_get (transaction_a, account_a));
+	total.amount = total.amount.number () + amount_a.number ();
+	++total.count;
+	pending_total_put (transaction_a, account_a, total);
+}
+
+void nano::mdb_store::pending_total_subtract (nano::transaction const & transaction_a, nano::account const & account_a, nano::amount const & amount_a)
+{
+	auto total (pending_total_get (transaction_a, account_a));
+	release_assert (total.count > 0 && total.amount.number () >= amount_a.number ());
+	total.amount = total.amount.number () - amount_a.number ();
+	--total.count;
+	pending_total_put (transaction_a, account_a, total);
 }
 
 bool nano::mdb_store::pending_get (nano::transaction const & transaction_a, nano::pending_key const & key_a, nano::pending_info & pending_a)
@@ -1593,6 +1836,35 @@ void nano::mdb_store::representation_put (nano::transaction const & transaction_
 	release_assert (status == 0);
 }
 
+void nano::mdb_store::ledger_clear (nano::transaction const & transaction_a)
+{
+	for (auto table : { frontiers, accounts_v0, accounts_v1, send_blocks, receive_blocks, open_blocks, change_blocks, state_blocks_v0, state_blocks_v1, pending_v0, pending_v1, pending_totals, representation, delegators, account_heights })
+	{
+		auto status (mdb_drop (env.tx (transaction_a), table, 0));
+		release_assert (status == 0);
+	}
+}
+
+void nano::mdb_store::account_append (nano::transaction const & transaction_a, nano::account const & account_a, nano::account_info const & info_a)
+{
+	auto status (mdb_put (env.tx (transaction_a), get_account_db (info_a.epoch), nano::mdb_val (account_a), nano::mdb_val (info_a), MDB_APPEND));
+	release_assert (status == 0);
+}
+
+void nano::mdb_store::pending_append (nano::transaction const & transaction_a, nano::pending_key const & key_a, nano::pending_info const & pending_a)
+{
+	auto status (mdb_put (env.tx (transaction_a), get_pending_db (pending_a.epoch), nano::mdb_val (key_a), nano::mdb_val (pending_a), MDB_APPEND));
+	release_assert (status == 0);
+	pending_total_add (transaction_a, key_a.account, pending_a.amount);
+}
+
+void nano::mdb_store::representation_append (nano::transaction const & transaction_a, nano::account const & account_a, nano::uint128_t const & representation_a)
+{
+	nano::uint128_union rep (representation_a);
+	auto status (mdb_put (env.tx (transaction_a), representation, nano::mdb_val (account_a), nano::mdb_val (rep), MDB_APPEND));
+	release_assert (status == 0);
+}
+
 void nano::mdb_store::unchecked_clear (nano::transaction const & transaction_a)
 {
 	auto status (mdb_drop (env.tx (transaction_a), unchecked, 0));
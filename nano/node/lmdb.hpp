@@ -12,6 +12,7 @@
 #include <boost/filesystem.hpp>
 #include <boost/optional.hpp>
 
+#include <atomic>
 #include <thread>
 
 #include <lmdb/libraries/liblmdb/lmdb.h>
@@ -138,6 +139,7 @@ public:
 	mdb_store (bool &, nano::logger_mt &, boost::filesystem::path const &, nano::txn_tracking_config const & txn_tracking_config_a = nano::txn_tracking_config{}, std::chrono::milliseconds block_processor_batch_max_time_a = std::chrono::milliseconds (5000), int lmdb_max_dbs = 128, bool drop_unchecked = false, size_t batch_size = 512);
 	nano::write_transaction tx_begin_write () override;
 	nano::read_transaction tx_begin_read () override;
+	uint64_t generation () const override;
 
 	std::shared_ptr<nano::block> block_random (nano::transaction const &) override;
 	void block_del (nano::transaction const &, nano::block_hash const &) override;
@@ -174,6 +176,7 @@ public:
 	nano::store_iterator<nano::pending_key, nano::pending_info> pending_begin (nano::transaction const &, nano::pending_key const &) override;
 	nano::store_iterator<nano::pending_key, nano::pending_info> pending_begin (nano::transaction const &) override;
 	nano::store_iterator<nano::pending_key, nano::pending_info> pending_end () override;
+	nano::pending_total pending_total_get (nano::transaction const &, nano::account const &) override;
 
 	bool block_info_get (nano::transaction const &, nano::block_hash const &, nano::block_info &) const override;
 	nano::epoch block_version (nano::transaction const &, nano::block_hash const &) override;
@@ -183,6 +186,18 @@ public:
 	nano::store_iterator<nano::account, nano::uint128_union> representation_begin (nano::transaction const &) override;
 	nano::store_iterator<nano::account, nano::uint128_union> representation_end () override;
 
+	void delegator_put (nano::transaction const &, nano::account const &, nano::account const &) override;
+	void delegator_del (nano::transaction const &, nano::account const &, nano::account const &) override;
+	nano::store_iterator<nano::account, nano::account> delegators_begin (nano::transaction const &, nano::account const &) override;
+	nano::store_iterator<nano::account, nano::account> delegators_end () override;
+	size_t delegators_count (nano::transaction const &, nano::account const &) override;
+
+	void account_height_put (nano::transaction const &, nano::account_height_key const &, nano::block_hash const &) override;
+	void account_height_del (nano::transaction const &, nano::account_height_key const &) override;
+	nano::block_hash block_at_height (nano::transaction const &, nano::account const &, uint64_t) const override;
+	nano::store_iterator<nano::account_height_key, nano::block_hash> account_heights_begin (nano::transaction const &, nano::account_height_key const &) override;
+	nano::store_iterator<nano::account_height_key, nano::block_hash> account_heights_end () override;
+
 	void unchecked_clear (nano::transaction const &) override;
 	void unchecked_put (nano::transaction const &, nano::unchecked_key const &, nano::unchecked_info const &) override;
 	void unchecked_del (nano::transaction const &, nano::unchecked_key const &) override;
@@ -216,6 +231,11 @@ public:
 	nano::store_iterator<nano::endpoint_key, nano::no_value> peers_begin (nano::transaction const & transaction_a) override;
 	nano::store_iterator<nano::endpoint_key, nano::no_value> peers_end () override;
 
+	void ledger_clear (nano::transaction const &) override;
+	void account_append (nano::transaction const &, nano::account const &, nano::account_info const &) override;
+	void pending_append (nano::transaction const &, nano::pending_key const &, nano::pending_info const &) override;
+	void representation_append (nano::transaction const &, nano::account const &, nano::uint128_t const &) override;
+
 	MDB_dbi get_account_db (nano::epoch epoch_a) const;
 	void serialize_mdb_tracker (boost::property_tree::ptree &, std::chrono::milliseconds, std::chrono::milliseconds) override;
 
@@ -289,6 +309,12 @@ public:
 	 */
 	MDB_dbi pending_v1{ 0 };
 
+	/**
+	 * Sum and number of the pending entries of each account across pending_v0 and pending_v1.
+	 * nano::account -> nano::amount, uint64_t
+	 */
+	MDB_dbi pending_totals{ 0 };
+
 	/**
 	 * Maps block hash to account and balance.
 	 * block_hash -> nano::account, nano::amount
@@ -301,6 +327,18 @@ public:
 	 */
 	MDB_dbi representation{ 0 };
 
+	/**
+	 * Accounts delegating to each representative, sorted duplicates per representative.
+	 * nano::account (representative) -> nano::account (delegator)
+	 */
+	MDB_dbi delegators{ 0 };
+
+	/**
+	 * Blocks of each account by height.
+	 * nano::account_height_key -> nano::block_hash
+	 */
+	MDB_dbi account_heights{ 0 };
+
 	/**
 	 * Unchecked bootstrap blocks info.
 	 * nano::block_hash -> nano::unchecked_info
@@ -352,12 +390,19 @@ private:
 	void upgrade_v11_to_v12 (nano::transaction const &);
 	void upgrade_v12_to_v13 (nano::write_transaction &, size_t);
 	void upgrade_v13_to_v14 (nano::transaction const &);
+	void upgrade_v14_to_v15 (nano::transaction const &);
+	void upgrade_v15_to_v16 (nano::write_transaction &, size_t);
+	void upgrade_v16_to_v17 (nano::transaction const &);
 	MDB_dbi get_pending_db (nano::epoch epoch_a) const;
+	void pending_total_put (nano::transaction const &, nano::account const &, nano::pending_total const &);
+	void pending_total_add (nano::transaction const &, nano::account const &, nano::amount const &);
+	void pending_total_subtract (nano::transaction const &, nano::account const &, nano::amount const &);
 	void open_databases (bool &, nano::transaction const &, unsigned);
 	nano::mdb_txn_tracker mdb_txn_tracker;
 	nano::mdb_txn_callbacks create_txn_callbacks ();
 	bool txn_tracking_enabled;
-	static int constexpr version{ 14 };
+	std::atomic<uint64_t> generation_m{ 0 };
+	static int constexpr version{ 17 };
 
 	size_t count (nano::transaction const &, MDB_dbi) const;
 	size_t count (nano::transaction const &, std::initializer_list<MDB_dbi>) const;
@@ -5,6 +5,7 @@
 #include <sstream>
 
 nano::network::network (nano::node & node_a, uint16_t port_a) :
+syn_cookies (node_a.checker),
 buffer_container (node_a.stats, nano::network::buffer_size, 4096), // 2Mb receive buffer
 resolver (node_a.io_ctx),
 node (node_a),
@@ -555,6 +556,10 @@ public:
 	{
 		node.stats.inc (nano::stat::type::message, nano::stat::detail::node_id_handshake, nano::stat::dir::in);
 	}
+	void ledger_snapshot_req (nano::ledger_snapshot_req const &) override
+	{
+		assert (false);
+	}
 	nano::node & node;
 	std::shared_ptr<nano::transport::channel> channel;
 };
@@ -959,25 +964,44 @@ boost::optional<nano::uint256_union> nano::syn_cookies::assign (nano::endpoint c
 	return result;
 }
 
+nano::syn_cookies::syn_cookies (nano::signature_checker & checker_a) :
+checker (checker_a)
+{
+}
+
 bool nano::syn_cookies::validate (nano::endpoint const & endpoint_a, nano::account const & node_id, nano::signature const & sig)
 {
 	auto ip_addr (endpoint_a.address ());
 	assert (ip_addr.is_v6 ());
-	std::lock_guard<std::mutex> lock (syn_cookie_mutex);
-	auto result (true);
-	auto cookie_it (cookies.find (endpoint_a));
-	if (cookie_it != cookies.end () && !nano::validate_message (node_id, cookie_it->second.cookie, sig))
+	boost::optional<nano::uint256_union> cookie;
 	{
-		result = false;
-		cookies.erase (cookie_it);
-		unsigned & ip_cookies = cookies_per_ip[ip_addr];
-		if (ip_cookies > 0)
+		std::lock_guard<std::mutex> lock (syn_cookie_mutex);
+		auto cookie_it (cookies.find (endpoint_a));
+		if (cookie_it != cookies.end ())
 		{
-			--ip_cookies;
+			cookie = cookie_it->second.cookie;
 		}
-		else
+	}
+	auto result (true);
+	// Handshakes arriving together are verified as one batch, so the signature is checked without holding the mutex
+	if (cookie && !checker.validate_message (node_id, cookie->bytes.data (), cookie->bytes.size (), sig))
+	{
+		std::lock_guard<std::mutex> lock (syn_cookie_mutex);
+		auto cookie_it (cookies.find (endpoint_a));
+		// A cookie is accepted once, it may have been used or purged meanwhile
+		if (cookie_it != cookies.end () && cookie_it->second.cookie == *cookie)
 		{
-			assert (false && "More SYN cookies deleted than created for IP");
+			result = false;
+			cookies.erase (cookie_it);
+			unsigned & ip_cookies = cookies_per_ip[ip_addr];
+			if (ip_cookies > 0)
+			{
+				--ip_cookies;
+			}
+			else
+			{
+				assert (false && "More SYN cookies deleted than created for IP");
+			}
 		}
 	}
 	return result;
@@ -2,6 +2,7 @@
 
 #include <nano/boost/asio.hpp>
 #include <nano/node/common.hpp>
+#include <nano/node/signatures.hpp>
 #include <nano/node/transport/tcp.hpp>
 #include <nano/node/transport/udp.hpp>
 
@@ -87,12 +88,13 @@ private:
 class syn_cookies final
 {
 public:
+	explicit syn_cookies (nano::signature_checker &);
 	void purge (std::chrono::steady_clock::time_point const &);
 	// Returns boost::none if the IP is rate capped on syn cookie requests,
 	// or if the endpoint already has a syn cookie query
 	boost::optional<nano::uint256_union> assign (nano::endpoint const &);
 	// Returns false if valid, true if invalid (true on error convention)
-	// Also removes the syn cookie from the store if valid
+	// Also removes the syn cookie from the store if valid. The signature is verified through the checker without holding the mutex
 	bool validate (nano::endpoint const &, nano::account const &, nano::signature const &);
 	std::unique_ptr<seq_con_info_component> collect_seq_con_info (std::string const &);
 
@@ -103,6 +105,7 @@ private:
 		nano::uint256_union cookie;
 		std::chrono::steady_clock::time_point created_at;
 	};
+	nano::signature_checker & checker;
 	mutable std::mutex syn_cookie_mutex;
 	std::unordered_map<nano::endpoint, syn_cookie_info> cookies;
 	std::unordered_map<boost::asio::ip::address, unsigned> cookies_per_ip;
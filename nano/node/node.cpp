@@ -162,7 +162,7 @@ std::unique_ptr<seq_con_info_component> collect_seq_con_info (rep_crawler & rep_
 
 std::unique_ptr<seq_con_info_component> collect_seq_con_info (block_processor & block_processor, const std::string & name)
 {
-	size_t state_blocks_count = 0;
+	size_t unverified_blocks_count = 0;
 	size_t blocks_count = 0;
 	size_t blocks_hashes_count = 0;
 	size_t forced_count = 0;
@@ -170,7 +170,7 @@ std::unique_ptr<seq_con_info_component> collect_seq_con_info (block_processor &
 
 	{
 		std::lock_guard<std::mutex> guard (block_processor.mutex);
-		state_blocks_count = block_processor.state_blocks.size ();
+		unverified_blocks_count = block_processor.unverified_blocks.size ();
 		blocks_count = block_processor.blocks.size ();
 		blocks_hashes_count = block_processor.blocks_hashes.size ();
 		forced_count = block_processor.forced.size ();
@@ -178,7 +178,7 @@ std::unique_ptr<seq_con_info_component> collect_seq_con_info (block_processor &
 	}
 
 	auto composite = std::make_unique<seq_con_info_composite> (name);
-	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "state_blocks", state_blocks_count, sizeof (decltype (block_processor.state_blocks)::value_type) }));
+	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "unverified_blocks", unverified_blocks_count, sizeof (decltype (block_processor.unverified_blocks)::value_type) }));
 	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "blocks", blocks_count, sizeof (decltype (block_processor.blocks)::value_type) }));
 	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "blocks_hashes", blocks_hashes_count, sizeof (decltype (block_processor.blocks_hashes)::value_type) }));
 	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "forced", forced_count, sizeof (decltype (block_processor.forced)::value_type) }));
@@ -207,6 +207,7 @@ store (*store_impl),
 wallets_store_impl (std::make_unique<nano::mdb_wallets_store> (init_a.wallets_store_init, application_path_a / "wallets.ldb", config_a.lmdb_max_dbs)),
 wallets_store (*wallets_store_impl),
 gap_cache (*this),
+json_response_cache (stats),
 ledger (store, stats, config.epoch_block_link, config.epoch_block_signer),
 checker (config.signature_checker_threads),
 network (*this, config.peering_port),
@@ -651,6 +652,7 @@ std::unique_ptr<seq_con_info_component> collect_seq_con_info (node & node, const
 	composite->add_component (collect_seq_con_info (node.alarm, "alarm"));
 	composite->add_component (collect_seq_con_info (node.work, "work"));
 	composite->add_component (collect_seq_con_info (node.gap_cache, "gap_cache"));
+	composite->add_component (collect_seq_con_info (node.json_response_cache, "json_response_cache"));
 	composite->add_component (collect_seq_con_info (node.ledger, "ledger"));
 	composite->add_component (collect_seq_con_info (node.active, "active"));
 	composite->add_component (collect_seq_con_info (node.bootstrap_initiator, "bootstrap_initiator"));
@@ -1002,18 +1004,19 @@ public:
 class distributed_work : public std::enable_shared_from_this<distributed_work>
 {
 public:
-	distributed_work (std::shared_ptr<nano::node> const & node_a, nano::block_hash const & root_a, std::function<void(uint64_t)> callback_a, uint64_t difficulty_a) :
-	distributed_work (1, node_a, root_a, callback_a, difficulty_a)
+	distributed_work (std::shared_ptr<nano::node> const & node_a, nano::block_hash const & root_a, std::function<void(uint64_t)> callback_a, uint64_t difficulty_a, nano::work_priority priority_a) :
+	distributed_work (1, node_a, root_a, callback_a, difficulty_a, priority_a)
 	{
 		assert (node_a != nullptr);
 	}
-	distributed_work (unsigned int backoff_a, std::shared_ptr<nano::node> const & node_a, nano::block_hash const & root_a, std::function<void(uint64_t)> callback_a, uint64_t difficulty_a) :
+	distributed_work (unsigned int backoff_a, std::shared_ptr<nano::node> const & node_a, nano::block_hash const & root_a, std::function<void(uint64_t)> callback_a, uint64_t difficulty_a, nano::work_priority priority_a) :
 	callback (callback_a),
 	backoff (backoff_a),
 	node (node_a),
 	root (root_a),
 	need_resolve (node_a->config.work_peers),
-	difficulty (difficulty_a)
+	difficulty (difficulty_a),
+	priority (priority_a)
 	{
 		assert (node_a != nullptr);
 		completed.clear ();
@@ -1222,7 +1225,7 @@ public:
 					node->work.generate (root, [callback_l](boost::optional<uint64_t> const & work_a) {
 						callback_l (work_a.value ());
 					},
-					difficulty);
+					difficulty, priority);
 					// clang-format on
 				}
 				else
@@ -1237,10 +1240,10 @@ public:
 					std::weak_ptr<nano::node> node_w (node);
 					auto next_backoff (std::min (backoff * 2, (unsigned int)60 * 5));
 					// clang-format off
-					node->alarm.add (now + std::chrono::seconds (backoff), [ node_w, root_l, callback_l, next_backoff, difficulty = difficulty ] {
+					node->alarm.add (now + std::chrono::seconds (backoff), [ node_w, root_l, callback_l, next_backoff, difficulty = difficulty, priority = priority ] {
 						if (auto node_l = node_w.lock ())
 						{
-							auto work_generation (std::make_shared<distributed_work> (next_backoff, node_l, root_l, callback_l, difficulty));
+							auto work_generation (std::make_shared<distributed_work> (next_backoff, node_l, root_l, callback_l, difficulty, priority));
 							work_generation->start ();
 						}
 					});
@@ -1264,6 +1267,7 @@ public:
 	std::vector<std::pair<std::string, uint16_t>> need_resolve;
 	std::atomic_flag completed;
 	uint64_t difficulty;
+	nano::work_priority priority;
 };
 }
 
@@ -1272,9 +1276,9 @@ void nano::node::work_generate_blocking (nano::block & block_a)
 	work_generate_blocking (block_a, network_params.network.publish_threshold);
 }
 
-void nano::node::work_generate_blocking (nano::block & block_a, uint64_t difficulty_a)
+void nano::node::work_generate_blocking (nano::block & block_a, uint64_t difficulty_a, nano::work_priority priority_a)
 {
-	block_a.block_work_set (work_generate_blocking (block_a.root (), difficulty_a));
+	block_a.block_work_set (work_generate_blocking (block_a.root (), difficulty_a, priority_a));
 }
 
 void nano::node::work_generate (nano::uint256_union const & hash_a, std::function<void(uint64_t)> callback_a)
@@ -1282,9 +1286,24 @@ void nano::node::work_generate (nano::uint256_union const & hash_a, std::functio
 	work_generate (hash_a, callback_a, network_params.network.publish_threshold);
 }
 
-void nano::node::work_generate (nano::uint256_union const & hash_a, std::function<void(uint64_t)> callback_a, uint64_t difficulty_a)
+void nano::node::work_generate (nano::uint256_union const & hash_a, std::function<void(uint64_t)> callback_a, uint64_t difficulty_a, nano::work_priority priority_a)
 {
-	auto work_generation (std::make_shared<distributed_work> (shared (), hash_a, callback_a, difficulty_a));
+	auto callback_l (callback_a);
+	if (config.logging.work_generation_time ())
+	{
+		auto begin (std::chrono::steady_clock::now ());
+		auto expected (work.expected_duration (difficulty_a));
+		std::weak_ptr<nano::node> node_w (shared ());
+		callback_l = [callback_a, node_w, hash_a, difficulty_a, begin, expected](uint64_t work_a) {
+			if (auto node_l = node_w.lock ())
+			{
+				auto actual (std::chrono::duration_cast<std::chrono::milliseconds> (std::chrono::steady_clock::now () - begin));
+				node_l->logger.try_log (boost::str (boost::format ("Work generation for %1% with a difficulty of %2% took %3% ms, expected %4% ms") % hash_a.to_string () % nano::to_string_hex (difficulty_a) % actual.count () % expected.count ()));
+			}
+			callback_a (work_a);
+		};
+	}
+	auto work_generation (std::make_shared<distributed_work> (shared (), hash_a, callback_l, difficulty_a, priority_a));
 	work_generation->start ();
 }
 
@@ -1293,7 +1312,7 @@ uint64_t nano::node::work_generate_blocking (nano::uint256_union const & block_a
 	return work_generate_blocking (block_a, network_params.network.publish_threshold);
 }
 
-uint64_t nano::node::work_generate_blocking (nano::uint256_union const & hash_a, uint64_t difficulty_a)
+uint64_t nano::node::work_generate_blocking (nano::uint256_union const & hash_a, uint64_t difficulty_a, nano::work_priority priority_a)
 {
 	std::promise<uint64_t> promise;
 	std::future<uint64_t> future = promise.get_future ();
@@ -1301,7 +1320,7 @@ uint64_t nano::node::work_generate_blocking (nano::uint256_union const & hash_a,
 	work_generate (hash_a, [&promise](uint64_t work_a) {
 		promise.set_value (work_a);
 	},
-	difficulty_a);
+	difficulty_a, priority_a);
 	// clang-format on
 	return future.get ();
 }
@@ -1604,9 +1623,14 @@ bool nano::node::validate_block_by_previous (nano::transaction const & transacti
 			}
 		}
 	}
-	if (!result && (account.is_zero () || nano::validate_message (account, block_a->hash (), block_a->block_signature ())))
+	if (!result)
 	{
-		result = true;
+		// Elections publish with the active transactions mutex held, so the signature is verified with those collected so far rather than waiting for more
+		auto hash (block_a->hash ());
+		if (account.is_zero () || checker.validate_message (account, hash.bytes.data (), hash.bytes.size (), block_a->block_signature (), false))
+		{
+			result = true;
+		}
 	}
 	return result;
 }
@@ -9,6 +9,7 @@
 #include <nano/node/confirmation_height_processor.hpp>
 #include <nano/node/election.hpp>
 #include <nano/node/gap_cache.hpp>
+#include <nano/node/json_response_cache.hpp>
 #include <nano/node/logging.hpp>
 #include <nano/node/network.hpp>
 #include <nano/node/node_observers.hpp>
@@ -144,11 +145,11 @@ public:
 	void bootstrap_wallet ();
 	void unchecked_cleanup ();
 	int price (nano::uint128_t const &, int);
-	void work_generate_blocking (nano::block &, uint64_t);
+	void work_generate_blocking (nano::block &, uint64_t, nano::work_priority = nano::work_priority::normal);
 	void work_generate_blocking (nano::block &);
-	uint64_t work_generate_blocking (nano::uint256_union const &, uint64_t);
+	uint64_t work_generate_blocking (nano::uint256_union const &, uint64_t, nano::work_priority = nano::work_priority::normal);
 	uint64_t work_generate_blocking (nano::uint256_union const &);
-	void work_generate (nano::uint256_union const &, std::function<void(uint64_t)>, uint64_t);
+	void work_generate (nano::uint256_union const &, std::function<void(uint64_t)>, uint64_t, nano::work_priority = nano::work_priority::normal);
 	void work_generate (nano::uint256_union const &, std::function<void(uint64_t)>);
 	void add_initial_peers ();
 	void block_confirm (std::shared_ptr<nano::block>);
@@ -176,6 +177,7 @@ public:
 	std::unique_ptr<nano::wallets_store> wallets_store_impl;
 	nano::wallets_store & wallets_store;
 	nano::gap_cache gap_cache;
+	nano::json_response_cache json_response_cache;
 	nano::ledger ledger;
 	nano::signature_checker checker;
 	nano::network network;
@@ -4,6 +4,20 @@
 #include <nano/lib/rpcconfig.hpp>
 #include <nano/node/node_rpc_config.hpp>
 
+nano::rpc_response_cache_config::rpc_response_cache_config ()
+{
+	// Responses to these are also discarded once anything is written to the ledger
+	for (auto action : { "account_balance", "account_block_count", "account_info", "account_representative", "account_weight", "accounts_balances", "accounts_frontiers", "available_supply", "block_account", "block_count", "block_info", "blocks", "blocks_info", "delegators", "delegators_count", "frontier_count", "representatives" })
+	{
+		ttls[action] = std::chrono::seconds (5);
+	}
+	// Node state which is not in the ledger, these are only limited by the time they are kept
+	for (auto action : { "active_difficulty", "confirmation_quorum", "representatives_online" })
+	{
+		ttls[action] = std::chrono::seconds (1);
+	}
+}
+
 nano::error nano::node_rpc_config::serialize_json (nano::jsonconfig & json) const
 {
 	json.put ("version", json_version ());
@@ -14,6 +28,17 @@ nano::error nano::node_rpc_config::serialize_json (nano::jsonconfig & json) cons
 	child_process_l.put ("enable", child_process.enable);
 	child_process_l.put ("rpc_path", child_process.rpc_path);
 	json.put_child ("child_process", child_process_l);
+
+	nano::jsonconfig response_cache_l;
+	response_cache_l.put ("enable", response_cache.enable);
+	response_cache_l.put ("max_entries", response_cache.max_entries);
+	nano::jsonconfig ttls_l;
+	for (auto const & ttl : response_cache.ttls)
+	{
+		ttls_l.put (ttl.first, ttl.second.count ());
+	}
+	response_cache_l.put_child ("ttls", ttls_l);
+	json.put_child ("response_cache", response_cache_l);
 	return json.get_error ();
 }
 
@@ -68,6 +93,24 @@ nano::error nano::node_rpc_config::deserialize_json (bool & upgraded_a, nano::js
 		child_process_l->get_optional<std::string> ("rpc_path", child_process.rpc_path);
 	}
 
+	auto response_cache_l (json.get_optional_child ("response_cache"));
+	if (response_cache_l)
+	{
+		response_cache_l->get_optional<bool> ("enable", response_cache.enable);
+		response_cache_l->get_optional<size_t> ("max_entries", response_cache.max_entries);
+		auto ttls_l (response_cache_l->get_optional_child ("ttls"));
+		if (ttls_l)
+		{
+			// Only the known read-only actions can be configured
+			for (auto & ttl : response_cache.ttls)
+			{
+				auto milliseconds (static_cast<uint64_t> (ttl.second.count ()));
+				ttls_l->get_optional<uint64_t> (ttl.first, milliseconds);
+				ttl.second = std::chrono::milliseconds (milliseconds);
+			}
+		}
+	}
+
 	return json.get_error ();
 }
 
@@ -4,7 +4,9 @@
 
 #include <boost/filesystem.hpp>
 
+#include <chrono>
 #include <string>
+#include <unordered_map>
 
 namespace nano
 {
@@ -15,6 +17,17 @@ public:
 	std::string rpc_path{ get_default_rpc_filepath () };
 };
 
+/** Caching of responses to read-only actions, see nano::json_response_cache */
+class rpc_response_cache_config final
+{
+public:
+	rpc_response_cache_config ();
+	bool enable{ false };
+	size_t max_entries{ 4096 };
+	/** The actions which may be cached and how long their responses are kept, zero disables caching of an action */
+	std::unordered_map<std::string, std::chrono::milliseconds> ttls;
+};
+
 class node_rpc_config final
 {
 public:
@@ -23,6 +36,7 @@ public:
 	bool enable_sign_hash{ false };
 	uint64_t max_work_generate_difficulty{ 0xffffffffc0000000 };
 	nano::rpc_child_process_config child_process;
+	nano::rpc_response_cache_config response_cache;
 	static unsigned json_version ()
 	{
 		return 1;
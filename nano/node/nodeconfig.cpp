@@ -104,6 +104,8 @@ nano::error nano::node_config::serialize_json (nano::jsonconfig & json) const
 	json.put ("work_threads", work_threads);
 	json.put (signature_checker_threads_key, signature_checker_threads);
 	json.put ("enable_voting", enable_voting);
+	json.put ("ledger_snapshot_server", ledger_snapshot_server);
+	json.put ("bootstrap_work_validation_threads", bootstrap_work_validation_threads);
 	json.put ("bootstrap_connections", bootstrap_connections);
 	json.put ("bootstrap_connections_max", bootstrap_connections_max);
 	json.put ("callback_address", callback_address);
@@ -122,6 +124,8 @@ nano::error nano::node_config::serialize_json (nano::jsonconfig & json) const
 	json.put ("external_port", external_port);
 	json.put ("tcp_incoming_connections_max", tcp_incoming_connections_max);
 	json.put ("use_memory_pools", use_memory_pools);
+	json.put ("wallet_key_cache", wallet_key_cache);
+	json.put ("wallet_action_threads", wallet_action_threads);
 	nano::jsonconfig websocket_l;
 	websocket_config.serialize_json (websocket_l);
 	json.put_child ("websocket", websocket_l);
@@ -256,6 +260,10 @@ bool nano::node_config::upgrade_json (unsigned version_a, nano::jsonconfig & jso
 			json.put ("active_elections_size", active_elections_size);
 			json.put ("bandwidth_limit", bandwidth_limit);
 			json.put ("conf_height_processor_batch_min_time", conf_height_processor_batch_min_time.count ());
+			json.put ("wallet_key_cache", wallet_key_cache);
+			json.put ("wallet_action_threads", wallet_action_threads);
+			json.put ("ledger_snapshot_server", ledger_snapshot_server);
+			json.put ("bootstrap_work_validation_threads", bootstrap_work_validation_threads);
 		}
 		case 17:
 			break;
@@ -389,6 +397,7 @@ nano::error nano::node_config::deserialize_json (bool & upgraded_a, nano::jsonco
 		json.get<unsigned> ("io_threads", io_threads);
 		json.get<unsigned> ("work_threads", work_threads);
 		json.get<unsigned> ("network_threads", network_threads);
+		json.get<unsigned> ("bootstrap_work_validation_threads", bootstrap_work_validation_threads);
 		json.get<unsigned> ("bootstrap_connections", bootstrap_connections);
 		json.get<unsigned> ("bootstrap_connections_max", bootstrap_connections_max);
 		json.get<std::string> ("callback_address", callback_address);
@@ -396,6 +405,7 @@ nano::error nano::node_config::deserialize_json (bool & upgraded_a, nano::jsonco
 		json.get<std::string> ("callback_target", callback_target);
 		json.get<int> ("lmdb_max_dbs", lmdb_max_dbs);
 		json.get<bool> ("enable_voting", enable_voting);
+		json.get<bool> ("ledger_snapshot_server", ledger_snapshot_server);
 		json.get<bool> ("allow_local_peers", allow_local_peers);
 		json.get<unsigned> (signature_checker_threads_key, signature_checker_threads);
 		json.get<boost::asio::ip::address_v6> ("external_address", external_address);
@@ -406,6 +416,8 @@ nano::error nano::node_config::deserialize_json (bool & upgraded_a, nano::jsonco
 		json.get (pow_sleep_interval_key, pow_sleep_interval_l);
 		pow_sleep_interval = std::chrono::nanoseconds (pow_sleep_interval_l);
 		json.get<bool> ("use_memory_pools", use_memory_pools);
+		json.get<bool> ("wallet_key_cache", wallet_key_cache);
+		json.get<unsigned> ("wallet_action_threads", wallet_action_threads);
 		json.get<size_t> ("confirmation_history_size", confirmation_history_size);
 		json.get<size_t> ("active_elections_size", active_elections_size);
 		json.get<size_t> ("bandwidth_limit", bandwidth_limit);
@@ -428,6 +440,10 @@ nano::error nano::node_config::deserialize_json (bool & upgraded_a, nano::jsonco
 		{
 			json.get_error ().set ("io_threads must be non-zero");
 		}
+		if (bootstrap_work_validation_threads == 0)
+		{
+			json.get_error ().set ("bootstrap_work_validation_threads must be non-zero");
+		}
 		if (active_elections_size <= 250 && !network.is_test_network ())
 		{
 			json.get_error ().set ("active_elections_size must be grater than 250");
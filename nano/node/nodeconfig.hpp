@@ -42,11 +42,19 @@ public:
 	nano::amount online_weight_minimum{ 60000 * nano::Gxrb_ratio };
 	unsigned online_weight_quorum{ 50 };
 	unsigned password_fanout{ 1024 };
+	/** Keep decrypted wallet keys in locked memory while wallets are unlocked */
+	bool wallet_key_cache{ false };
 	unsigned io_threads{ std::max<unsigned> (4, boost::thread::hardware_concurrency ()) };
 	unsigned network_threads{ std::max<unsigned> (4, boost::thread::hardware_concurrency ()) };
 	unsigned work_threads{ std::max<unsigned> (4, boost::thread::hardware_concurrency ()) };
+	/** Threads running wallet actions, actions of different accounts run concurrently */
+	unsigned wallet_action_threads{ std::max<unsigned> (4, boost::thread::hardware_concurrency ()) };
 	unsigned signature_checker_threads{ (boost::thread::hardware_concurrency () != 0) ? boost::thread::hardware_concurrency () - 1 : 0 }; /* The calling thread does checks as well so remove it from the number of threads used */
 	bool enable_voting{ false };
+	/** Answer ledger snapshot requests from bootstrap peers, one at a time */
+	bool ledger_snapshot_server{ false };
+	/** Threads validating work and processing blocks of bootstrap pulls, shared by all pull connections */
+	unsigned bootstrap_work_validation_threads{ std::max<unsigned> (1, std::min<unsigned> (4, boost::thread::hardware_concurrency ())) };
 	unsigned bootstrap_connections{ 4 };
 	unsigned bootstrap_connections_max{ 64 };
 	nano::websocket::config websocket_config;
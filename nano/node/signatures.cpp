@@ -1,14 +1,24 @@
 #include <nano/lib/numbers.hpp>
 #include <nano/node/signatures.hpp>
 
+#include <algorithm>
+
+constexpr size_t nano::signature_checker::batch_size;
+constexpr size_t nano::signature_checker::min_chunk_size;
+constexpr size_t nano::signature_checker::collect_size;
+constexpr std::chrono::milliseconds nano::signature_checker::collect_delay;
+
 nano::signature_checker::signature_checker (unsigned num_threads) :
-thread_pool (num_threads),
-single_threaded (num_threads == 0),
 num_threads (num_threads)
 {
-	if (!single_threaded)
+	boost::thread::attributes attrs;
+	nano::thread_attributes::set (attrs);
+	for (auto i (0u); i < num_threads; ++i)
 	{
-		set_thread_names (num_threads);
+		threads.push_back (boost::thread (attrs, [this]() {
+			nano::thread_role::set (nano::thread_role::name::signature_checking);
+			run ();
+		}));
 	}
 }
 
@@ -17,152 +27,219 @@ nano::signature_checker::~signature_checker ()
 	stop ();
 }
 
-void nano::signature_checker::verify (nano::signature_check_set & check_a)
+void nano::signature_checker::verify (nano::signature_check_set & check_a, nano::signature_check_priority priority_a)
 {
+	std::unique_lock<std::mutex> lock (mutex);
+	// Don't process anything else if we have stopped
+	if (!stopped && check_a.size != 0)
 	{
-		// Don't process anything else if we have stopped
-		std::lock_guard<std::mutex> guard (mutex);
-		if (stopped)
+		task task_l (check_a, priority_a);
+		++tasks_active;
+		if (num_threads != 0)
 		{
-			return;
+			tasks.push_back (&task_l);
+			producer_condition.notify_all ();
 		}
+		std::vector<chunk> chunks;
+		while (task_l.next < check_a.size)
+		{
+			chunks.clear ();
+			claim (task_l, chunks);
+			lock.unlock ();
+			verify_chunks (chunks);
+			lock.lock ();
+			finish (chunks);
+		}
+		// Wait for the threads verifying the last chunks of this set
+		done_condition.wait (lock, [&task_l]() { return task_l.in_progress == 0; });
+		--tasks_active;
+		done_condition.notify_all ();
 	}
+}
 
-	if (check_a.size < multithreaded_cutoff || single_threaded)
+bool nano::signature_checker::validate_message (nano::public_key const & public_key_a, uint8_t const * message_a, size_t size_a, nano::signature const & signature_a, bool wait_a)
+{
+	std::unique_lock<std::mutex> lock (collect_mutex);
+	auto first (collecting == nullptr);
+	if (first)
 	{
-		// Not dealing with many so just use the calling thread for checking signatures
-		auto result = verify_batch (check_a, 0, check_a.size);
-		release_assert (result);
-		return;
+		collecting = std::make_shared<collection> ();
 	}
-
-	// Split up the tasks equally over the calling thread and the thread pool.
-	// Any overflow on the modulus of the batch_size is given to the calling thread, so the thread pool
-	// only ever operates on batch_size sizes.
-	size_t overflow_size = check_a.size % batch_size;
-	size_t num_full_batches = check_a.size / batch_size;
-
-	auto total_threads_to_split_over = num_threads + 1;
-	auto num_base_batches_each = num_full_batches / total_threads_to_split_over;
-	auto num_full_overflow_batches = num_full_batches % total_threads_to_split_over;
-
-	auto size_calling_thread = (num_base_batches_each * batch_size) + overflow_size;
-	auto num_full_batches_thread = (num_base_batches_each * num_threads);
-	if (num_full_overflow_batches > 0)
+	auto collection_l (collecting);
+	// The pointers stay valid as every caller waits for the collection to be verified
+	auto index (collection_l->messages.size ());
+	collection_l->messages.push_back (message_a);
+	collection_l->lengths.push_back (size_a);
+	collection_l->pub_keys.push_back (public_key_a.bytes.data ());
+	collection_l->signatures.push_back (signature_a.bytes.data ());
+	if (!wait_a || collection_l->messages.size () >= collect_size)
 	{
-		size_calling_thread += batch_size;
-		auto remaining = num_full_overflow_batches - 1;
-		num_full_batches_thread += remaining;
+		collecting = nullptr;
+		collection_l->closed = true;
+		collect_condition.notify_all ();
 	}
-
-	release_assert (check_a.size == (num_full_batches_thread * batch_size + size_calling_thread));
-
-	std::promise<void> promise;
-	std::future<void> future = promise.get_future ();
-
-	// Verify a number of signature batches over the thread pool (does not block)
-	verify_async (check_a, num_full_batches_thread, promise);
-
-	// Verify the rest on the calling thread, this operates on the signatures at the end of the check set
-	auto result = verify_batch (check_a, check_a.size - size_calling_thread, size_calling_thread);
-	release_assert (result);
-
-	// Blocks until all the work is done
-	future.wait ();
+	if (first)
+	{
+		collect_condition.wait_for (lock, collect_delay, [&collection_l]() { return collection_l->closed; });
+		if (collecting == collection_l)
+		{
+			collecting = nullptr;
+			collection_l->closed = true;
+		}
+		lock.unlock ();
+		collection_l->verifications.resize (collection_l->messages.size (), 0);
+		nano::signature_check_set check (collection_l->messages.size (), collection_l->messages.data (), collection_l->lengths.data (), collection_l->pub_keys.data (), collection_l->signatures.data (), collection_l->verifications.data ());
+		verify (check);
+		lock.lock ();
+		collection_l->done = true;
+		collect_condition.notify_all ();
+	}
+	else
+	{
+		collect_condition.wait (lock, [&collection_l]() { return collection_l->done; });
+	}
+	return collection_l->verifications[index] != 1;
 }
 
 void nano::signature_checker::stop ()
 {
-	std::lock_guard<std::mutex> guard (mutex);
-	if (!stopped)
 	{
+		std::lock_guard<std::mutex> guard (mutex);
 		stopped = true;
-		thread_pool.join ();
+	}
+	producer_condition.notify_all ();
+	for (auto & thread : threads)
+	{
+		if (thread.joinable ())
+		{
+			thread.join ();
+		}
 	}
 }
 
 void nano::signature_checker::flush ()
 {
-	std::lock_guard<std::mutex> guard (mutex);
-	while (!stopped && tasks_remaining != 0)
-		;
+	std::unique_lock<std::mutex> lock (mutex);
+	done_condition.wait (lock, [this]() { return tasks_active == 0; });
 }
 
-bool nano::signature_checker::verify_batch (const nano::signature_check_set & check_a, size_t start_index, size_t size)
+size_t nano::signature_checker::chunk_size (task const & task_a) const
 {
-	/* Returns false if there are at least 1 invalid signature */
-	auto code (nano::validate_message_batch (check_a.messages + start_index, check_a.message_lengths + start_index, check_a.pub_keys + start_index, check_a.signatures + start_index, size, check_a.verifications + start_index));
-	(void)code;
-
-	return std::all_of (check_a.verifications + start_index, check_a.verifications + start_index + size, [](int verification) { return verification == 0 || verification == 1; });
+	auto remaining (task_a.check.size - task_a.next);
+	// Claim a share of what remains so every participant keeps working until the set is done
+	auto result (remaining / (2 * (num_threads + 1)));
+	result = std::max (min_chunk_size, std::min (batch_size, result));
+	return std::min (remaining, result);
 }
 
-/* This operates on a number of signatures of size (num_batches * batch_size) from the beginning of the check_a pointers.
- * Caller should check the value of the promise which indicateswhen the work has been completed.
- */
-void nano::signature_checker::verify_async (nano::signature_check_set & check_a, size_t num_batches, std::promise<void> & promise)
+void nano::signature_checker::claim (task & task_a, std::vector<chunk> & chunks_a)
 {
-	auto task = std::make_shared<Task> (check_a, num_batches);
-	++tasks_remaining;
-
-	for (size_t batch = 0; batch < num_batches; ++batch)
+	assert (!mutex.try_lock ());
+	auto size (chunk_size (task_a));
+	chunks_a.push_back ({ &task_a, task_a.next, size });
+	task_a.next += size;
+	task_a.in_progress += size;
+	if (task_a.next == task_a.check.size)
 	{
-		auto size = batch_size;
-		auto start_index = batch * batch_size;
-
-		boost::asio::post (thread_pool, [this, task, size, start_index, &promise] {
-			auto result = this->verify_batch (task->check, start_index, size);
-			release_assert (result);
+		auto existing (std::find (tasks.begin (), tasks.end (), &task_a));
+		if (existing != tasks.end ())
+		{
+			tasks.erase (existing);
+		}
+	}
+}
 
-			if (--task->pending == 0)
+void nano::signature_checker::claim_batch (std::vector<chunk> & chunks_a)
+{
+	assert (!mutex.try_lock ());
+	size_t claimed (0);
+	for (auto priority : { nano::signature_check_priority::high, nano::signature_check_priority::normal })
+	{
+		for (auto task_l : tasks)
+		{
+			if (claimed < batch_size && task_l->priority == priority)
 			{
-				--tasks_remaining;
-				promise.set_value ();
+				auto size (std::min (chunk_size (*task_l), batch_size - claimed));
+				chunks_a.push_back ({ task_l, task_l->next, size });
+				task_l->next += size;
+				task_l->in_progress += size;
+				claimed += size;
 			}
-		});
+		}
 	}
+	tasks.erase (std::remove_if (tasks.begin (), tasks.end (), [](task * task_a) { return task_a->next == task_a->check.size; }), tasks.end ());
 }
 
-// Set the names of all the threads in the thread pool for easier identification
-void nano::signature_checker::set_thread_names (unsigned num_threads)
+void nano::signature_checker::finish (std::vector<chunk> const & chunks_a)
 {
-	auto ready = false;
-	auto pending = num_threads;
-	std::condition_variable cv;
-	std::vector<std::promise<void>> promises (num_threads);
-	std::vector<std::future<void>> futures;
-	futures.reserve (num_threads);
-	std::transform (promises.begin (), promises.end (), std::back_inserter (futures), [](auto & promise) {
-		return promise.get_future ();
-	});
+	assert (!mutex.try_lock ());
+	auto done (false);
+	for (auto & chunk_l : chunks_a)
+	{
+		chunk_l.owner->in_progress -= chunk_l.size;
+		done = done || chunk_l.owner->in_progress == 0;
+	}
+	if (done)
+	{
+		done_condition.notify_all ();
+	}
+}
 
-	for (auto i = 0u; i < num_threads; ++i)
+void nano::signature_checker::verify_chunks (std::vector<chunk> const & chunks_a)
+{
+	if (chunks_a.size () == 1)
 	{
-		// clang-format off
-		boost::asio::post (thread_pool, [&cv, &ready, &pending, &mutex = mutex, &promise = promises[i]]() {
-			std::unique_lock<std::mutex> lk (mutex);
-			nano::thread_role::set (nano::thread_role::name::signature_checking);
-			if (--pending == 0)
-			{
-				// All threads have been reached
-				ready = true;
-				lk.unlock ();
-				cv.notify_all ();
-			}
-			else
-			{
-				// We need to wait until the other threads are finished
-				cv.wait (lk, [&ready]() { return ready; });
-			}
-			promise.set_value ();
-		});
-		// clang-format on
+		auto & check (chunks_a.front ().owner->check);
+		auto start (chunks_a.front ().start);
+		auto size (chunks_a.front ().size);
+		nano::validate_message_batch (check.messages + start, check.message_lengths + start, check.pub_keys + start, check.signatures + start, size, check.verifications + start);
+		release_assert (std::all_of (check.verifications + start, check.verifications + start + size, [](int verification) { return verification == 0 || verification == 1; }));
 	}
+	else
+	{
+		// Gather chunks of several sets into one batch and scatter the results back
+		std::vector<unsigned char const *> messages;
+		std::vector<size_t> lengths;
+		std::vector<unsigned char const *> pub_keys;
+		std::vector<unsigned char const *> signatures;
+		for (auto & chunk_l : chunks_a)
+		{
+			auto & check (chunk_l.owner->check);
+			messages.insert (messages.end (), check.messages + chunk_l.start, check.messages + chunk_l.start + chunk_l.size);
+			lengths.insert (lengths.end (), check.message_lengths + chunk_l.start, check.message_lengths + chunk_l.start + chunk_l.size);
+			pub_keys.insert (pub_keys.end (), check.pub_keys + chunk_l.start, check.pub_keys + chunk_l.start + chunk_l.size);
+			signatures.insert (signatures.end (), check.signatures + chunk_l.start, check.signatures + chunk_l.start + chunk_l.size);
+		}
+		std::vector<int> verifications (messages.size (), 0);
+		nano::validate_message_batch (messages.data (), lengths.data (), pub_keys.data (), signatures.data (), messages.size (), verifications.data ());
+		release_assert (std::all_of (verifications.begin (), verifications.end (), [](int verification) { return verification == 0 || verification == 1; }));
+		auto result (verifications.begin ());
+		for (auto & chunk_l : chunks_a)
+		{
+			std::copy (result, result + chunk_l.size, chunk_l.owner->check.verifications + chunk_l.start);
+			result += chunk_l.size;
+		}
+	}
+}
 
-	// Wait until all threads have finished
-	for (auto & future : futures)
+void nano::signature_checker::run ()
+{
+	std::vector<chunk> chunks;
+	std::unique_lock<std::mutex> lock (mutex);
+	while (!stopped)
 	{
-		future.wait ();
+		if (!tasks.empty ())
+		{
+			chunks.clear ();
+			claim_batch (chunks);
+			lock.unlock ();
+			verify_chunks (chunks);
+			lock.lock ();
+			finish (chunks);
+		}
+		else
+		{
+			producer_condition.wait (lock);
+		}
 	}
-	assert (pending == 0);
 }
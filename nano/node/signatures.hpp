@@ -1,11 +1,16 @@
 #pragma once
 
-#include <nano/boost/asio.hpp>
+#include <nano/lib/numbers.hpp>
 #include <nano/lib/utility.hpp>
 
-#include <atomic>
-#include <future>
+#include <boost/thread/thread.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 namespace nano
 {
@@ -25,42 +30,98 @@ public:
 	int * verifications;
 };
 
-/** Multi-threaded signature checker */
+/** Order in which verification threads take work from concurrent callers */
+enum class signature_check_priority : uint8_t
+{
+	/** Votes, elections wait on them */
+	high,
+	/** Blocks and everything else */
+	normal
+};
+
+/**
+ * Multi-threaded signature checker
+ * Each set passed to verify is queued as a task and threads claim chunks from whichever tasks have signatures left, highest priority first.
+ * A thread takes one chunk from each task in turn until its batch is full, so small sets from several callers are verified together.
+ * Chunks shrink as a task nears completion so threads finish a set at about the same time. The calling thread verifies chunks of its own set.
+ */
 class signature_checker final
 {
 public:
 	signature_checker (unsigned num_threads);
 	~signature_checker ();
-	void verify (signature_check_set &);
+	void verify (signature_check_set &, nano::signature_check_priority = nano::signature_check_priority::normal);
+	/**
+	 * Verifies a single signature, returning true if it is invalid as nano::validate_message does. Signatures of concurrent callers
+	 * are collected into one set, which is verified once collect_size are waiting or collect_delay after the first arrived.
+	 * Unless \p wait_a, the signatures collected so far are verified straight away, for callers holding locks others wait on.
+	 */
+	bool validate_message (nano::public_key const &, uint8_t const *, size_t, nano::signature const &, bool wait_a = true);
 	void stop ();
 	void flush ();
+	/** Maximum number of signatures in one batch verification */
+	static constexpr size_t batch_size = 256;
+	/** Smallest chunk claimed from a task, unless fewer signatures remain */
+	static constexpr size_t min_chunk_size = 32;
+	/** Single signatures collected before they are verified together */
+	static constexpr size_t collect_size = 64;
+	/** Longest a single signature waits for others to be collected with it */
+	static constexpr std::chrono::milliseconds collect_delay{ 1 };
 
 private:
-	struct Task final
+	/** Single signatures verified as one set, the callers wait until done */
+	class collection final
 	{
-		Task (nano::signature_check_set & check, size_t pending) :
-		check (check), pending (pending)
-		{
-		}
-		~Task ()
+	public:
+		std::vector<unsigned char const *> messages;
+		std::vector<size_t> lengths;
+		std::vector<unsigned char const *> pub_keys;
+		std::vector<unsigned char const *> signatures;
+		std::vector<int> verifications;
+		/** Set once no further signatures are added */
+		bool closed{ false };
+		bool done{ false };
+	};
+	class task final
+	{
+	public:
+		task (nano::signature_check_set & check_a, nano::signature_check_priority priority_a) :
+		check (check_a), priority (priority_a)
 		{
-			release_assert (pending == 0);
 		}
 		nano::signature_check_set & check;
-		std::atomic<size_t> pending;
+		nano::signature_check_priority priority;
+		/** Index of the first unclaimed signature */
+		size_t next{ 0 };
+		/** Signatures claimed but not yet verified */
+		size_t in_progress{ 0 };
 	};
-
-	bool verify_batch (const nano::signature_check_set & check_a, size_t index, size_t size);
-	void verify_async (nano::signature_check_set & check_a, size_t num_batches, std::promise<void> & promise);
-	void set_thread_names (unsigned num_threads);
-	boost::asio::thread_pool thread_pool;
-	std::atomic<int> tasks_remaining{ 0 };
-	/** minimum signature_check_set size eligible to be multithreaded */
-	static constexpr size_t multithreaded_cutoff = 513;
-	static constexpr size_t batch_size = 256;
-	const bool single_threaded;
+	class chunk final
+	{
+	public:
+		nano::signature_checker::task * owner;
+		size_t start;
+		size_t size;
+	};
+	size_t chunk_size (task const &) const;
+	void claim (task &, std::vector<chunk> &);
+	void claim_batch (std::vector<chunk> &);
+	void finish (std::vector<chunk> const &);
+	void verify_chunks (std::vector<chunk> const &);
+	void run ();
+	/** Tasks with unclaimed signatures, in arrival order */
+	std::deque<task *> tasks;
+	/** Tasks whose verify call has not returned yet */
+	size_t tasks_active{ 0 };
+	std::vector<boost::thread> threads;
 	unsigned num_threads;
 	std::mutex mutex;
+	std::condition_variable producer_condition;
+	std::condition_variable done_condition;
 	bool stopped{ false };
+	/** Collection accepting signatures, the caller which created it verifies it */
+	std::shared_ptr<collection> collecting;
+	std::mutex collect_mutex;
+	std::condition_variable collect_condition;
 };
 }
@@ -45,6 +45,10 @@ public:
 	{
 		result = nano::stat::detail::node_id_handshake;
 	}
+	void ledger_snapshot_req (nano::ledger_snapshot_req const & message_a) override
+	{
+		result = nano::stat::detail::ledger_snapshot;
+	}
 	nano::stat::detail result;
 };
 }
@@ -410,6 +410,10 @@ public:
 	{
 		assert (false);
 	}
+	void ledger_snapshot_req (nano::ledger_snapshot_req const &) override
+	{
+		assert (false);
+	}
 	void node_id_handshake (nano::node_id_handshake const & message_a) override
 	{
 		if (node.config.logging.network_node_id_handshake_logging ())
@@ -175,7 +175,7 @@ void nano::vote_processor::verify_votes (std::deque<std::pair<std::shared_ptr<na
 		signatures.push_back (vote.first->signature.bytes.data ());
 	}
 	nano::signature_check_set check = { size, messages.data (), lengths.data (), pub_keys.data (), signatures.data (), verifications.data () };
-	node.checker.verify (check);
+	node.checker.verify (check, nano::signature_check_priority::high);
 	std::remove_reference_t<decltype (votes_a)> result;
 	auto i (0);
 	for (auto & vote : votes_a)
@@ -195,7 +195,13 @@ nano::vote_code nano::vote_processor::vote_blocking (nano::transaction const & t
 {
 	assert (!node.active.mutex.try_lock ());
 	auto result (nano::vote_code::invalid);
-	if (validated || !vote_a->validate ())
+	if (!validated)
+	{
+		// Called with the active transactions mutex held, so the signature is verified with those collected so far rather than waiting for more
+		auto hash (vote_a->hash ());
+		validated = !node.checker.validate_message (vote_a->account, hash.bytes.data (), hash.bytes.size (), vote_a->signature, false);
+	}
+	if (validated)
 	{
 		auto max_vote (node.store.vote_max (transaction_a, vote_a));
 		result = nano::vote_code::replay;
@@ -1,4 +1,5 @@
 #include <nano/crypto_lib/random_pool.hpp>
+#include <nano/lib/memory.hpp>
 #include <nano/lib/utility.hpp>
 #include <nano/node/node.hpp>
 #include <nano/node/wallet.hpp>
@@ -33,6 +34,18 @@ void nano::wallet_store::wallet_key (nano::raw_key & prv_a, nano::transaction co
 	prv_a.decrypt (wallet_l.data, password_l, salt (transaction_a).owords[0]);
 }
 
+void nano::wallet_store::lock ()
+{
+	std::lock_guard<std::recursive_mutex> lock (mutex);
+	if (key_cache != nullptr)
+	{
+		key_cache->clear ();
+	}
+	nano::raw_key empty;
+	empty.data.clear ();
+	password.value_set (empty);
+}
+
 void nano::wallet_store::seed (nano::raw_key & prv_a, nano::transaction const & transaction_a)
 {
 	nano::wallet_value value (entry_get_raw (transaction_a, nano::wallet_store::seed_special));
@@ -146,6 +159,11 @@ bool nano::wallet_store::attempt_password (nano::transaction const & transaction
 	bool result = false;
 	{
 		std::lock_guard<std::recursive_mutex> lock (mutex);
+		if (key_cache != nullptr)
+		{
+			// Keys cached under the previous password must not outlive it
+			key_cache->clear ();
+		}
 		nano::raw_key password_l;
 		derive_key (password_l, transaction_a, password_a);
 		password.value_set (password_l);
@@ -241,6 +259,110 @@ void nano::fan::value_set (nano::raw_key const & value_a)
 	*(values[0]) ^= value_a.data;
 }
 
+nano::wallet_key_cache::~wallet_key_cache ()
+{
+	release ();
+}
+
+bool nano::wallet_key_cache::get (nano::public_key const & pub_a, nano::raw_key & prv_a)
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	auto existing (index.find (pub_a));
+	auto result (existing == index.end ());
+	if (!result)
+	{
+		prv_a.data = keys[existing->second];
+	}
+	return result;
+}
+
+void nano::wallet_key_cache::put (nano::public_key const & pub_a, nano::raw_key const & prv_a, uint64_t generation_a)
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	// The zero key marks empty slots of the index
+	if (generation_a == generation_m && !pub_a.is_zero ())
+	{
+		auto existing (index.find (pub_a));
+		if (existing != index.end ())
+		{
+			keys[existing->second] = prv_a.data;
+		}
+		else
+		{
+			if (accounts.size () == capacity)
+			{
+				auto capacity_l (std::max<size_t> (128, capacity * 2));
+				auto keys_l (static_cast<nano::uint256_union *> (nano::locked_allocate (capacity_l * sizeof (nano::uint256_union))));
+				if (keys_l != nullptr)
+				{
+					std::copy (keys, keys + accounts.size (), keys_l);
+					nano::locked_free (keys, capacity * sizeof (nano::uint256_union));
+					keys = keys_l;
+					capacity = capacity_l;
+				}
+			}
+			// Without memory the key isn't cached and is decrypted on each fetch
+			if (accounts.size () < capacity)
+			{
+				index[pub_a] = accounts.size ();
+				keys[accounts.size ()] = prv_a.data;
+				accounts.push_back (pub_a);
+			}
+		}
+	}
+}
+
+void nano::wallet_key_cache::erase (nano::public_key const & pub_a)
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	// A key decrypted before the erase, which may not have been put yet, must not be cached after it
+	++generation_m;
+	auto existing (index.find (pub_a));
+	if (existing != index.end ())
+	{
+		auto position (existing->second);
+		index.erase (pub_a);
+		auto last (accounts.size () - 1);
+		if (position != last)
+		{
+			// Move the last key into the hole
+			keys[position] = keys[last];
+			accounts[position] = accounts[last];
+			index[accounts[position]] = position;
+		}
+		keys[last].clear ();
+		accounts.pop_back ();
+	}
+}
+
+void nano::wallet_key_cache::clear ()
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	++generation_m;
+	release ();
+}
+
+uint64_t nano::wallet_key_cache::generation ()
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	return generation_m;
+}
+
+size_t nano::wallet_key_cache::size ()
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	return accounts.size ();
+}
+
+void nano::wallet_key_cache::release ()
+{
+	nano::locked_free (keys, capacity * sizeof (nano::uint256_union));
+	keys = nullptr;
+	capacity = 0;
+	accounts.clear ();
+	index.clear ();
+}
+
 // Wallet version number
 nano::uint256_union const nano::wallet_store::version_special (0);
 // Random number used to salt private key encryption
@@ -417,6 +539,10 @@ void nano::wallet_store::insert_watch (nano::transaction const & transaction_a,
 
 void nano::wallet_store::erase (nano::transaction const & transaction_a, nano::public_key const & pub)
 {
+	if (key_cache != nullptr)
+	{
+		key_cache->erase (pub);
+	}
 	auto status (mdb_del (tx (transaction_a), handle, nano::mdb_val (pub), nullptr));
 	(void)status;
 	assert (status == 0);
@@ -470,6 +596,23 @@ nano::key_type nano::wallet_store::key_type (nano::wallet_value const & value_a)
 }
 
 bool nano::wallet_store::fetch (nano::transaction const & transaction_a, nano::public_key const & pub, nano::raw_key & prv)
+{
+	// Only keys fetched with a valid password are cached and the cache is cleared when the wallet is locked
+	auto result (key_cache == nullptr || key_cache->get (pub, prv));
+	if (result)
+	{
+		// Read before validating the password so a lock racing with this fetch discards its key
+		auto generation (key_cache != nullptr ? key_cache->generation () : 0);
+		result = fetch_uncached (transaction_a, pub, prv);
+		if (!result && key_cache != nullptr)
+		{
+			key_cache->put (pub, prv, generation);
+		}
+	}
+	return result;
+}
+
+bool nano::wallet_store::fetch_uncached (nano::transaction const & transaction_a, nano::public_key const & pub, nano::raw_key & prv)
 {
 	auto result (false);
 	if (valid_password (transaction_a))
@@ -747,6 +890,10 @@ lock_observer ([](bool, bool) {}),
 store (init_a, wallets_a.kdf, transaction_a, wallets_a.node.config.random_representative (), wallets_a.node.config.password_fanout, wallet_a),
 wallets (wallets_a)
 {
+	if (wallets_a.node.config.wallet_key_cache)
+	{
+		store.key_cache = std::make_unique<nano::wallet_key_cache> ();
+	}
 }
 
 nano::wallet::wallet (bool & init_a, nano::transaction & transaction_a, nano::wallets & wallets_a, std::string const & wallet_a, std::string const & json) :
@@ -754,6 +901,10 @@ lock_observer ([](bool, bool) {}),
 store (init_a, wallets_a.kdf, transaction_a, wallets_a.node.config.random_representative (), wallets_a.node.config.password_fanout, wallet_a, json),
 wallets (wallets_a)
 {
+	if (wallets_a.node.config.wallet_key_cache)
+	{
+		store.key_cache = std::make_unique<nano::wallet_key_cache> ();
+	}
 }
 
 void nano::wallet::enter_initial_password ()
@@ -805,7 +956,7 @@ nano::public_key nano::wallet::deterministic_insert (nano::transaction const & t
 		key = store.deterministic_insert (transaction_a);
 		if (generate_work_a)
 		{
-			work_ensure (key, key);
+			work_ensure (key);
 		}
 		auto block_transaction (wallets.node.store.tx_begin_read ());
 		if (wallets.node.ledger.weight (block_transaction, key) >= wallets.node.config.vote_minimum.number ())
@@ -827,7 +978,7 @@ nano::public_key nano::wallet::deterministic_insert (uint32_t const index, bool
 		key = store.deterministic_insert (transaction, index);
 		if (generate_work_a)
 		{
-			work_ensure (key, key);
+			work_ensure (key);
 		}
 	}
 	return key;
@@ -849,7 +1000,7 @@ nano::public_key nano::wallet::insert_adhoc (nano::transaction const & transacti
 		auto block_transaction (wallets.node.store.tx_begin_read ());
 		if (generate_work_a)
 		{
-			work_ensure (key, wallets.node.ledger.latest_root (block_transaction, key));
+			work_ensure (key);
 		}
 		if (wallets.node.ledger.weight (block_transaction, key) >= wallets.node.config.vote_minimum.number ())
 		{
@@ -911,6 +1062,10 @@ void nano::wallet::serialize (std::string & json_a)
 
 void nano::wallet_store::destroy (nano::transaction const & transaction_a)
 {
+	if (key_cache != nullptr)
+	{
+		key_cache->clear ();
+	}
 	auto status (mdb_drop (tx (transaction_a), handle, 1));
 	(void)status;
 	assert (status == 0);
@@ -919,6 +1074,7 @@ void nano::wallet_store::destroy (nano::transaction const & transaction_a)
 
 std::shared_ptr<nano::block> nano::wallet::receive_action (nano::block const & send_a, nano::account const & representative_a, nano::uint128_union const & amount_a, uint64_t work_a, bool generate_work_a)
 {
+	auto cached_work (work_a == 0);
 	nano::account account;
 	auto hash (send_a.hash ());
 	std::shared_ptr<nano::block> block;
@@ -974,17 +1130,22 @@ std::shared_ptr<nano::block> nano::wallet::receive_action (nano::block const & s
 	}
 	if (block != nullptr)
 	{
-		if (nano::work_validate (*block))
+		auto invalid_work (nano::work_validate (*block));
+		if (cached_work)
+		{
+			wallets.node.stats.inc (nano::stat::type::work_cache, invalid_work ? nano::stat::detail::miss : nano::stat::detail::hit);
+		}
+		if (invalid_work)
 		{
 			wallets.node.logger.try_log (boost::str (boost::format ("Cached or provided work for block %1% account %2% is invalid, regenerating") % block->hash ().to_string () % account.to_account ()));
-			wallets.node.work_generate_blocking (*block, wallets.node.active.active_difficulty ());
+			wallets.node.work_generate_blocking (*block, wallets.node.active.active_difficulty (), nano::work_priority::high);
 		}
 		wallets.watcher.add (block);
 		wallets.node.process_active (block);
 		wallets.node.block_processor.flush ();
 		if (generate_work_a)
 		{
-			work_ensure (account, block->hash ());
+			work_ensure (account);
 		}
 	}
 	return block;
@@ -992,6 +1153,7 @@ std::shared_ptr<nano::block> nano::wallet::receive_action (nano::block const & s
 
 std::shared_ptr<nano::block> nano::wallet::change_action (nano::account const & source_a, nano::account const & representative_a, uint64_t work_a, bool generate_work_a)
 {
+	auto cached_work (work_a == 0);
 	std::shared_ptr<nano::block> block;
 	{
 		auto transaction (wallets.tx_begin_read ());
@@ -1019,17 +1181,22 @@ std::shared_ptr<nano::block> nano::wallet::change_action (nano::account const &
 	}
 	if (block != nullptr)
 	{
-		if (nano::work_validate (*block))
+		auto invalid_work (nano::work_validate (*block));
+		if (cached_work)
+		{
+			wallets.node.stats.inc (nano::stat::type::work_cache, invalid_work ? nano::stat::detail::miss : nano::stat::detail::hit);
+		}
+		if (invalid_work)
 		{
 			wallets.node.logger.try_log (boost::str (boost::format ("Cached or provided work for block %1% account %2% is invalid, regenerating") % block->hash ().to_string () % source_a.to_account ()));
-			wallets.node.work_generate_blocking (*block, wallets.node.active.active_difficulty ());
+			wallets.node.work_generate_blocking (*block, wallets.node.active.active_difficulty (), nano::work_priority::high);
 		}
 		wallets.watcher.add (block);
 		wallets.node.process_active (block);
 		wallets.node.block_processor.flush ();
 		if (generate_work_a)
 		{
-			work_ensure (source_a, block->hash ());
+			work_ensure (source_a);
 		}
 	}
 	return block;
@@ -1037,6 +1204,8 @@ std::shared_ptr<nano::block> nano::wallet::change_action (nano::account const &
 
 std::shared_ptr<nano::block> nano::wallet::send_action (nano::account const & source_a, nano::account const & account_a, nano::uint128_t const & amount_a, uint64_t work_a, bool generate_work_a, boost::optional<std::string> id_a)
 {
+	// Without provided work the block uses the work cached for the account
+	auto cached_work (work_a == 0);
 	boost::optional<nano::mdb_val> id_mdb_val;
 	if (id_a)
 	{
@@ -1129,17 +1298,22 @@ std::shared_ptr<nano::block> nano::wallet::send_action (nano::account const & so
 
 	if (!error && block != nullptr && !cached_block)
 	{
-		if (nano::work_validate (*block))
+		auto invalid_work (nano::work_validate (*block));
+		if (cached_work)
+		{
+			wallets.node.stats.inc (nano::stat::type::work_cache, invalid_work ? nano::stat::detail::miss : nano::stat::detail::hit);
+		}
+		if (invalid_work)
 		{
 			wallets.node.logger.try_log (boost::str (boost::format ("Cached or provided work for block %1% account %2% is invalid, regenerating") % block->hash ().to_string () % account_a.to_account ()));
-			wallets.node.work_generate_blocking (*block, wallets.node.active.active_difficulty ());
+			wallets.node.work_generate_blocking (*block, wallets.node.active.active_difficulty (), nano::work_priority::high);
 		}
 		wallets.watcher.add (block);
 		wallets.node.process_active (block);
 		wallets.node.block_processor.flush ();
 		if (generate_work_a)
 		{
-			work_ensure (source_a, block->hash ());
+			work_ensure (source_a);
 		}
 	}
 	return block;
@@ -1164,7 +1338,8 @@ void nano::wallet::change_async (nano::account const & source_a, nano::account c
 	wallets.node.wallets.queue_wallet_action (nano::wallets::high_priority, this_l, [this_l, source_a, representative_a, action_a, work_a, generate_work_a](nano::wallet & wallet_a) {
 		auto block (wallet_a.change_action (source_a, representative_a, work_a, generate_work_a));
 		action_a (block);
-	});
+	},
+	source_a);
 }
 
 bool nano::wallet::receive_sync (std::shared_ptr<nano::block> block_a, nano::account const & representative_a, nano::uint128_t const & amount_a)
@@ -1183,10 +1358,13 @@ bool nano::wallet::receive_sync (std::shared_ptr<nano::block> block_a, nano::acc
 void nano::wallet::receive_async (std::shared_ptr<nano::block> block_a, nano::account const & representative_a, nano::uint128_t const & amount_a, std::function<void(std::shared_ptr<nano::block>)> const & action_a, uint64_t work_a, bool generate_work_a)
 {
 	auto this_l (shared_from_this ());
+	// The receiving account is the destination of legacy send blocks and the link of state blocks
+	auto account (block_a->type () == nano::block_type::send ? static_cast<nano::send_block const &> (*block_a).hashables.destination : block_a->link ());
 	wallets.node.wallets.queue_wallet_action (amount_a, this_l, [this_l, block_a, representative_a, amount_a, action_a, work_a, generate_work_a](nano::wallet & wallet_a) {
 		auto block (wallet_a.receive_action (*block_a, representative_a, amount_a, work_a, generate_work_a));
 		action_a (block);
-	});
+	},
+	account);
 }
 
 nano::block_hash nano::wallet::send_sync (nano::account const & source_a, nano::account const & account_a, nano::uint128_t const & amount_a)
@@ -1208,7 +1386,8 @@ void nano::wallet::send_async (nano::account const & source_a, nano::account con
 	wallets.node.wallets.queue_wallet_action (nano::wallets::high_priority, this_l, [this_l, source_a, account_a, amount_a, action_a, work_a, generate_work_a, id_a](nano::wallet & wallet_a) {
 		auto block (wallet_a.send_action (source_a, account_a, amount_a, work_a, generate_work_a, id_a));
 		action_a (block);
-	});
+	},
+	source_a);
 }
 
 // Update work for account if latest root is root_a
@@ -1228,11 +1407,9 @@ void nano::wallet::work_update (nano::transaction const & transaction_a, nano::a
 	}
 }
 
-void nano::wallet::work_ensure (nano::account const & account_a, nano::block_hash const & hash_a)
+void nano::wallet::work_ensure (nano::account const & account_a)
 {
-	wallets.node.wallets.queue_wallet_action (nano::wallets::generate_priority, shared_from_this (), [account_a, hash_a](nano::wallet & wallet_a) {
-		wallet_a.work_cache_blocking (account_a, hash_a);
-	});
+	wallets.precache.add (shared_from_this (), account_a);
 }
 
 bool nano::wallet::search_pending ()
@@ -1468,7 +1645,7 @@ void nano::work_watcher::run ()
 				std::error_code ec;
 				builder.from (*i.second);
 				lock.unlock ();
-				builder.work (node.work_generate_blocking (root, node.active.active_difficulty ()));
+				builder.work (node.work_generate_blocking (root, node.active.active_difficulty (), nano::work_priority::low));
 				std::shared_ptr<state_block> block (builder.build (ec));
 				if (!ec)
 				{
@@ -1538,25 +1715,179 @@ bool nano::work_watcher::is_watched (nano::qualified_root const & root_a)
 	return exists != blocks.end ();
 }
 
+nano::work_precache::work_precache (nano::node & node_a) :
+node (node_a),
+thread ([this]() {
+	nano::thread_role::set (nano::thread_role::name::work_precache);
+	run ();
+})
+{
+}
+
+nano::work_precache::~work_precache ()
+{
+	stop ();
+}
+
+void nano::work_precache::stop ()
+{
+	std::unique_lock<std::mutex> lock (mutex);
+	accounts.clear ();
+	stopped = true;
+	condition.notify_all ();
+	lock.unlock ();
+	if (thread.joinable ())
+	{
+		thread.join ();
+	}
+}
+
+void nano::work_precache::run ()
+{
+	std::unique_lock<std::mutex> lock (mutex);
+	while (!stopped)
+	{
+		std::vector<std::pair<std::shared_ptr<nano::wallet>, nano::account>> hot;
+		auto cutoff (std::chrono::steady_clock::now () - hot_cutoff);
+		for (auto i (accounts.begin ()), n (accounts.end ()); i != n;)
+		{
+			auto wallet (i->second.wallet.lock ());
+			if (wallet == nullptr || i->second.last_use < cutoff)
+			{
+				i = accounts.erase (i);
+			}
+			else
+			{
+				if (i->second.generating.is_zero ())
+				{
+					hot.emplace_back (wallet, i->first);
+				}
+				++i;
+			}
+		}
+		lock.unlock ();
+		for (auto & i : hot)
+		{
+			refresh (i.first, i.second);
+		}
+		lock.lock ();
+		if (!stopped)
+		{
+			// Frontier changes are signalled by add, difficulty changes are picked up by polling
+			condition.wait_for (lock, std::chrono::seconds (1));
+		}
+	}
+}
+
+void nano::work_precache::refresh (std::shared_ptr<nano::wallet> wallet_a, nano::account const & account_a)
+{
+	auto difficulty (node.active.active_difficulty ());
+	auto valid (true);
+	nano::block_hash root (0);
+	{
+		auto transaction (wallet_a->wallets.tx_begin_read ());
+		// Watch-only accounts can't sign
+		if (wallet_a->live () && !wallet_a->store.entry_get_raw (transaction, account_a).key.is_zero ())
+		{
+			auto block_transaction (node.store.tx_begin_read ());
+			root = node.ledger.latest_root (block_transaction, account_a);
+			uint64_t work (0);
+			valid = !wallet_a->store.work_get (transaction, account_a, work) && nano::work_value (root, work) >= difficulty;
+		}
+	}
+	if (!valid)
+	{
+		{
+			std::lock_guard<std::mutex> lock (mutex);
+			auto existing (accounts.find (account_a));
+			valid = stopped || existing == accounts.end () || !existing->second.generating.is_zero ();
+			if (!valid)
+			{
+				existing->second.generating = root;
+			}
+		}
+		if (!valid)
+		{
+			std::weak_ptr<nano::wallet> wallet_w (wallet_a);
+			// Speculative, so it yields to work for blocks which are being created or published
+			// clang-format off
+			node.work_generate (root, [this, wallet_w, account_a, root](uint64_t work_a) {
+				if (auto wallet_l = wallet_w.lock ())
+				{
+					auto transaction (wallet_l->wallets.tx_begin_write ());
+					if (wallet_l->live () && wallet_l->store.exists (transaction, account_a))
+					{
+						// Discarded if the frontier moved on while generating, the next pass regenerates
+						wallet_l->work_update (transaction, account_a, root, work_a);
+					}
+				}
+				node.stats.inc (nano::stat::type::work_cache, nano::stat::detail::refresh);
+				std::lock_guard<std::mutex> lock (mutex);
+				auto existing (accounts.find (account_a));
+				if (existing != accounts.end () && existing->second.generating == root)
+				{
+					existing->second.generating.clear ();
+				}
+			},
+			difficulty, nano::work_priority::low);
+			// clang-format on
+		}
+	}
+}
+
+void nano::work_precache::add (std::shared_ptr<nano::wallet> wallet_a, nano::account const & account_a)
+{
+	{
+		std::lock_guard<std::mutex> lock (mutex);
+		if (!stopped)
+		{
+			auto & entry (accounts[account_a]);
+			entry.wallet = wallet_a;
+			entry.last_use = std::chrono::steady_clock::now ();
+		}
+	}
+	condition.notify_all ();
+}
+
+size_t nano::work_precache::size ()
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	return accounts.size ();
+}
+
 void nano::wallets::do_wallet_actions ()
 {
 	std::unique_lock<std::mutex> action_lock (action_mutex);
+	nano::account account;
+	std::shared_ptr<nano::wallet> wallet;
+	nano::wallet_action_queue::action_type current;
 	while (!stopped)
 	{
-		if (!actions.empty ())
+		if (!actions.pop (account, wallet, current))
 		{
-			auto first (actions.begin ());
-			auto wallet (first->second.first);
-			auto current (std::move (first->second.second));
-			actions.erase (first);
 			if (wallet->live ())
 			{
+				// The observer sees the executor busy from the first running action until the last one finishes
+				auto first (actions_active++ == 0);
 				action_lock.unlock ();
-				observer (true);
+				if (first)
+				{
+					observer (true);
+				}
 				current (*wallet);
-				observer (false);
 				action_lock.lock ();
+				if (--actions_active == 0)
+				{
+					action_lock.unlock ();
+					observer (false);
+					action_lock.lock ();
+				}
 			}
+			wallet = nullptr;
+			current = nullptr;
+			actions.done (account);
+			// The account's next action can run
+			condition.notify_one ();
 		}
 		else
 		{
@@ -1565,17 +1896,96 @@ void nano::wallets::do_wallet_actions ()
 	}
 }
 
+void nano::wallet_action_queue::push (nano::uint128_t const & priority_a, nano::account const & account_a, std::shared_ptr<nano::wallet> wallet_a, action_type const & action_a)
+{
+	auto & entry (accounts[account_a]);
+	if (!entry.running && !entry.queue.empty ())
+	{
+		ready.erase (entry.ready_position);
+	}
+	entry.queue.insert (std::make_pair (priority_a, std::make_pair (wallet_a, action_a)));
+	++count;
+	if (!entry.running)
+	{
+		make_ready (account_a, entry);
+	}
+}
+
+bool nano::wallet_action_queue::pop (nano::account & account_a, std::shared_ptr<nano::wallet> & wallet_a, action_type & action_a)
+{
+	auto result (ready.empty ());
+	if (!result)
+	{
+		account_a = ready.begin ()->second;
+		ready.erase (ready.begin ());
+		auto & entry (accounts[account_a]);
+		assert (!entry.running && !entry.queue.empty ());
+		auto first (entry.queue.begin ());
+		wallet_a = std::move (first->second.first);
+		action_a = std::move (first->second.second);
+		entry.queue.erase (first);
+		entry.running = true;
+		--count;
+	}
+	return result;
+}
+
+void nano::wallet_action_queue::done (nano::account const & account_a)
+{
+	auto existing (accounts.find (account_a));
+	// The queue may have been cleared while the action was running
+	if (existing != accounts.end () && existing->second.running)
+	{
+		existing->second.running = false;
+		if (existing->second.queue.empty ())
+		{
+			accounts.erase (existing);
+		}
+		else
+		{
+			make_ready (account_a, existing->second);
+		}
+	}
+}
+
+void nano::wallet_action_queue::make_ready (nano::account const & account_a, account_actions & entry_a)
+{
+	assert (!entry_a.running && !entry_a.queue.empty ());
+	entry_a.ready_position = ready.insert (std::make_pair (entry_a.queue.begin ()->first, account_a));
+}
+
+bool nano::wallet_action_queue::empty () const
+{
+	return count == 0;
+}
+
+size_t nano::wallet_action_queue::size () const
+{
+	return count;
+}
+
+void nano::wallet_action_queue::clear ()
+{
+	accounts.clear ();
+	ready.clear ();
+	count = 0;
+}
+
 nano::wallets::wallets (bool error_a, nano::node & node_a) :
 observer ([](bool) {}),
 node (node_a),
 env (boost::polymorphic_downcast<nano::mdb_wallets_store *> (node_a.wallets_store_impl.get ())->environment),
 stopped (false),
 watcher (node_a),
-thread ([this]() {
-	nano::thread_role::set (nano::thread_role::name::wallet_actions);
-	do_wallet_actions ();
-})
+precache (node_a)
 {
+	for (auto i (0u), n (std::max (1u, node_a.config.wallet_action_threads)); i < n; ++i)
+	{
+		threads.push_back (boost::thread ([this]() {
+			nano::thread_role::set (nano::thread_role::name::wallet_actions);
+			do_wallet_actions ();
+		}));
+	}
 	std::unique_lock<std::mutex> lock (mutex);
 	if (!error_a)
 	{
@@ -1731,13 +2141,13 @@ void nano::wallets::reload ()
 	}
 }
 
-void nano::wallets::queue_wallet_action (nano::uint128_t const & amount_a, std::shared_ptr<nano::wallet> wallet_a, std::function<void(nano::wallet &)> const & action_a)
+void nano::wallets::queue_wallet_action (nano::uint128_t const & amount_a, std::shared_ptr<nano::wallet> wallet_a, std::function<void(nano::wallet &)> const & action_a, nano::account const & account_a)
 {
 	{
 		std::lock_guard<std::mutex> action_lock (action_mutex);
-		actions.insert (std::make_pair (amount_a, std::make_pair (wallet_a, std::move (action_a))));
+		actions.push (amount_a, account_a, wallet_a, action_a);
 	}
-	condition.notify_all ();
+	condition.notify_one ();
 }
 
 void nano::wallets::foreach_representative (nano::transaction const & transaction_a, std::function<void(nano::public_key const & pub_a, nano::raw_key const & prv_a)> const & action_a)
@@ -1801,11 +2211,15 @@ void nano::wallets::stop ()
 		actions.clear ();
 	}
 	condition.notify_all ();
-	if (thread.joinable ())
+	for (auto & thread : threads)
 	{
-		thread.join ();
+		if (thread.joinable ())
+		{
+			thread.join ();
+		}
 	}
 	watcher.stop ();
+	precache.stop ();
 }
 
 nano::write_transaction nano::wallets::tx_begin_write ()
@@ -1935,7 +2349,7 @@ void nano::wallets::move_table (std::string const & name_a, MDB_txn * tx_source,
 	assert (!error6);
 }
 
-nano::uint128_t const nano::wallets::generate_priority = std::numeric_limits<nano::uint128_t>::max ();
+std::chrono::minutes constexpr nano::work_precache::hot_cutoff;
 nano::uint128_t const nano::wallets::high_priority = std::numeric_limits<nano::uint128_t>::max () - 1;
 
 nano::store_iterator<nano::uint256_union, nano::wallet_value> nano::wallet_store::begin (nano::transaction const & transaction_a)
@@ -1991,9 +2405,21 @@ std::unique_ptr<seq_con_info_component> collect_seq_con_info (wallets & wallets,
 {
 	size_t items_count = 0;
 	size_t actions_count = 0;
+	size_t cached_keys_count = 0;
 	{
 		std::lock_guard<std::mutex> guard (wallets.mutex);
 		items_count = wallets.items.size ();
+		for (auto & item : wallets.items)
+		{
+			if (item.second->store.key_cache != nullptr)
+			{
+				cached_keys_count += item.second->store.key_cache->size ();
+			}
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> action_lock (wallets.action_mutex);
 		actions_count = wallets.actions.size ();
 	}
 
@@ -2002,6 +2428,8 @@ std::unique_ptr<seq_con_info_component> collect_seq_con_info (wallets & wallets,
 	auto sizeof_actions_element = sizeof (decltype (wallets.actions)::value_type);
 	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "items", items_count, sizeof_item_element }));
 	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "actions_count", actions_count, sizeof_actions_element }));
+	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "cached_keys", cached_keys_count, sizeof (nano::uint256_union) }));
+	composite->add_component (std::make_unique<seq_con_info_leaf> (seq_con_info{ "precache_accounts", wallets.precache.size (), sizeof (decltype (wallets.precache.accounts)::value_type) }));
 	return composite;
 }
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <nano/lib/config.hpp>
+#include <nano/lib/flat_hash.hpp>
 #include <nano/node/lmdb.hpp>
 #include <nano/node/openclwork.hpp>
 #include <nano/secure/blockstore.hpp>
@@ -35,6 +36,34 @@ public:
 	void phs (nano::raw_key &, std::string const &, nano::uint256_union const &);
 	std::mutex mutex;
 };
+/**
+ * Decrypted private keys of a wallet, letting signing skip password validation, key decryption and public key derivation.
+ * Keys are stored densely in pages from nano::locked_allocate, which are zeroed when released. The wallet clears the cache whenever it is locked.
+ */
+class wallet_key_cache final
+{
+public:
+	~wallet_key_cache ();
+	/** Copies the key of `pub_a` to `prv_a`, returns true if it isn't cached */
+	bool get (nano::public_key const & pub_a, nano::raw_key & prv_a);
+	/** Caches a key decrypted while `generation_a` was current, keys decrypted before an erase or clear are discarded */
+	void put (nano::public_key const & pub_a, nano::raw_key const & prv_a, uint64_t generation_a);
+	void erase (nano::public_key const &);
+	void clear ();
+	/** Incremented by each erase and clear */
+	uint64_t generation ();
+	size_t size ();
+
+private:
+	void release ();
+	std::mutex mutex;
+	uint64_t generation_m{ 0 };
+	/** Locked storage for `capacity` keys, the key of accounts[i] is keys[i] */
+	nano::uint256_union * keys{ nullptr };
+	size_t capacity{ 0 };
+	std::vector<nano::public_key> accounts;
+	nano::flat_hash_map<nano::public_key, size_t> index;
+};
 enum class key_type
 {
 	not_a_type,
@@ -53,6 +82,8 @@ public:
 	bool rekey (nano::transaction const &, std::string const &);
 	bool valid_password (nano::transaction const &);
 	bool attempt_password (nano::transaction const &, std::string const &);
+	/** Forgets the password and any cached keys */
+	void lock ();
 	void wallet_key (nano::raw_key &, nano::transaction const &);
 	void seed (nano::raw_key &, nano::transaction const &);
 	void seed_set (nano::transaction const &, nano::raw_key const &);
@@ -91,8 +122,11 @@ public:
 	void upgrade_v1_v2 (nano::transaction const &);
 	void upgrade_v2_v3 (nano::transaction const &);
 	void upgrade_v3_v4 (nano::transaction const &);
+	/** Setting the password directly bypasses the key cache, use lock () to lock the wallet */
 	nano::fan password;
 	nano::fan wallet_key_mem;
+	/** Only created when the node enables wallet_key_cache */
+	std::unique_ptr<nano::wallet_key_cache> key_cache;
 	static unsigned const version_1 = 1;
 	static unsigned const version_2 = 2;
 	static unsigned const version_3 = 3;
@@ -114,6 +148,7 @@ public:
 
 private:
 	MDB_txn * tx (nano::transaction const &) const;
+	bool fetch_uncached (nano::transaction const &, nano::public_key const &, nano::raw_key &);
 };
 // A wallet is a set of account keys encrypted by a common encryption key
 class wallet final : public std::enable_shared_from_this<nano::wallet>
@@ -145,7 +180,8 @@ public:
 	void work_apply (nano::account const &, std::function<void(uint64_t)>);
 	void work_cache_blocking (nano::account const &, nano::block_hash const &);
 	void work_update (nano::transaction const &, nano::account const &, nano::block_hash const &, uint64_t);
-	void work_ensure (nano::account const &, nano::block_hash const &);
+	/** Keeps work for the account's frontier cached, see work_precache */
+	void work_ensure (nano::account const &);
 	bool search_pending ();
 	void init_free_accounts (nano::transaction const &);
 	uint32_t deterministic_check (nano::transaction const & transaction_a, uint32_t index);
@@ -179,6 +215,74 @@ public:
 	std::unordered_map<nano::qualified_root, std::shared_ptr<nano::state_block>> blocks;
 	std::thread thread;
 };
+/**
+ * Keeps the cached work of recently used wallet accounts valid for their frontier at the active difficulty, so signing rarely waits on work generation.
+ * Work is regenerated in the background whenever an account's frontier advances or the active difficulty rises above its cached work.
+ */
+class work_precache final
+{
+public:
+	work_precache (nano::node &);
+	~work_precache ();
+	void stop ();
+	void run ();
+	/** Keeps the account's work ready until it's unused for hot_cutoff */
+	void add (std::shared_ptr<nano::wallet>, nano::account const &);
+	size_t size ();
+	class entry final
+	{
+	public:
+		std::weak_ptr<nano::wallet> wallet;
+		std::chrono::steady_clock::time_point last_use;
+		/** Root of the work being generated, zero when idle */
+		nano::block_hash generating{ 0 };
+	};
+	std::mutex mutex;
+	nano::node & node;
+	std::condition_variable condition;
+	bool stopped{ false };
+	std::unordered_map<nano::account, entry> accounts;
+	static std::chrono::minutes constexpr hot_cutoff = std::chrono::minutes (60);
+	std::thread thread;
+
+private:
+	void refresh (std::shared_ptr<nano::wallet>, nano::account const &);
+};
+/**
+ * Wallet actions queued by the account whose chain they extend.
+ * Actions of different accounts may run concurrently, those of one account run one at a time in priority order.
+ * Not synchronized, wallets guards it with action_mutex.
+ */
+class wallet_action_queue final
+{
+public:
+	using action_type = std::function<void(nano::wallet &)>;
+	using value_type = std::pair<std::shared_ptr<nano::wallet>, action_type>;
+	void push (nano::uint128_t const &, nano::account const &, std::shared_ptr<nano::wallet>, action_type const &);
+	/** Takes the highest priority action among accounts with no running action and marks its account running. Returns true if there is none */
+	bool pop (nano::account &, std::shared_ptr<nano::wallet> &, action_type &);
+	/** Called when the action popped for an account finished so its next action can run */
+	void done (nano::account const &);
+	bool empty () const;
+	size_t size () const;
+	void clear ();
+
+private:
+	using ready_container = std::multimap<nano::uint128_t, nano::account, std::greater<nano::uint128_t>>;
+	class account_actions final
+	{
+	public:
+		std::multimap<nano::uint128_t, value_type, std::greater<nano::uint128_t>> queue;
+		bool running{ false };
+		/** Entry of the head action in ready, valid while the queue is not empty and no action is running */
+		ready_container::iterator ready_position;
+	};
+	void make_ready (nano::account const &, account_actions &);
+	std::unordered_map<nano::account, account_actions> accounts;
+	/** Head action priority of each account that can run */
+	ready_container ready;
+	size_t count{ 0 };
+};
 /**
  * The wallets set is all the wallets a node controls.
  * A node may contain multiple wallets independently encrypted and operated.
@@ -196,7 +300,8 @@ public:
 	void reload ();
 	void do_work_regeneration ();
 	void do_wallet_actions ();
-	void queue_wallet_action (nano::uint128_t const &, std::shared_ptr<nano::wallet>, std::function<void(nano::wallet &)> const &);
+	/** Queues an action extending the chain of the given account */
+	void queue_wallet_action (nano::uint128_t const &, std::shared_ptr<nano::wallet>, std::function<void(nano::wallet &)> const &, nano::account const &);
 	void foreach_representative (nano::transaction const &, std::function<void(nano::public_key const &, nano::raw_key const &)> const &);
 	bool exists (nano::transaction const &, nano::public_key const &);
 	void stop ();
@@ -208,7 +313,9 @@ public:
 	nano::network_params network_params;
 	std::function<void(bool)> observer;
 	std::unordered_map<nano::uint256_union, std::shared_ptr<nano::wallet>> items;
-	std::multimap<nano::uint128_t, std::pair<std::shared_ptr<nano::wallet>, std::function<void(nano::wallet &)>>, std::greater<nano::uint128_t>> actions;
+	nano::wallet_action_queue actions;
+	/** Number of action threads running an action */
+	unsigned actions_active{ 0 };
 	std::mutex mutex;
 	std::mutex action_mutex;
 	std::condition_variable condition;
@@ -219,8 +326,8 @@ public:
 	nano::mdb_env & env;
 	std::atomic<bool> stopped;
 	nano::work_watcher watcher;
-	boost::thread thread;
-	static nano::uint128_t const generate_priority;
+	nano::work_precache precache;
+	std::vector<boost::thread> threads;
 	static nano::uint128_t const high_priority;
 	std::atomic<uint64_t> reps_count{ 0 };
 
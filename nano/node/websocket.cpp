@@ -176,6 +176,10 @@ nano::websocket::session::~session ()
 		std::unique_lock<std::mutex> lk (subscriptions_mutex);
 		for (auto & subscription : subscriptions)
 		{
+			if (subscription.first == nano::websocket::topic::confirmation)
+			{
+				ws_listener.unindex_confirmation_subscription (this, dynamic_cast<nano::websocket::confirmation_options *> (subscription.second.get ()));
+			}
 			ws_listener.decrease_subscriber_count (subscription.first);
 		}
 	}
@@ -214,32 +218,60 @@ void nano::websocket::session::close ()
 	// clang-format on
 }
 
-void nano::websocket::session::write (nano::websocket::message message_a)
+void nano::websocket::session::write (nano::websocket::message const & message_a)
 {
-	// clang-format off
-	std::unique_lock<std::mutex> lk (subscriptions_mutex);
-	auto subscription (subscriptions.find (message_a.topic));
-	if (message_a.topic == nano::websocket::topic::ack || (subscription != subscriptions.end () && !subscription->second->should_filter (message_a)))
+	if (should_write (message_a))
 	{
-		lk.unlock ();
-		auto this_l (shared_from_this ());
-		boost::asio::post (strand,
-		[message_a, this_l]() {
+		write (message_a.to_string ());
+	}
+}
+
+bool nano::websocket::session::should_write (nano::websocket::message const & message_a)
+{
+	std::lock_guard<std::mutex> lk (subscriptions_mutex);
+	auto subscription (subscriptions.find (message_a.topic));
+	return message_a.topic == nano::websocket::topic::ack || (subscription != subscriptions.end () && !subscription->second->should_filter (message_a));
+}
+
+void nano::websocket::session::write (std::shared_ptr<std::string const> payload_a)
+{
+	auto this_l (shared_from_this ());
+	// clang-format off
+	boost::asio::post (strand,
+	[payload_a, this_l]() {
+		auto & node_l (this_l->ws_listener.get_node ());
+		auto max_queued (node_l.config.websocket_config.max_queued_messages);
+		if (max_queued == 0 || this_l->send_queue.size () < max_queued)
+		{
 			bool write_in_progress = !this_l->send_queue.empty ();
-			this_l->send_queue.emplace_back (message_a);
+			this_l->send_queue.emplace_back (payload_a);
 			if (!write_in_progress)
 			{
 				this_l->write_queued_messages ();
 			}
-		});
-	}
+		}
+		else if (node_l.config.websocket_config.disconnect_slow_consumers)
+		{
+			if (this_l->ws.next_layer ().is_open ())
+			{
+				node_l.stats.inc (nano::stat::type::websocket, nano::stat::detail::slow_consumer_disconnect);
+				node_l.logger.try_log ("Websocket: disconnecting slow consumer");
+				// Closing the socket cancels the pending write, which a websocket close would have to wait for
+				boost::system::error_code ec_ignore;
+				this_l->ws.next_layer ().close (ec_ignore);
+			}
+		}
+		else
+		{
+			node_l.stats.inc (nano::stat::type::websocket, nano::stat::detail::message_drop, nano::stat::dir::out);
+		}
+	});
 	// clang-format on
 }
 
 void nano::websocket::session::write_queued_messages ()
 {
-	auto msg (send_queue.front ());
-	auto msg_str (msg.to_string ());
+	auto msg_str (send_queue.front ());
 	auto this_l (shared_from_this ());
 
 	// clang-format off
@@ -254,6 +286,11 @@ void nano::websocket::session::write_queued_messages ()
 				this_l->write_queued_messages ();
 			}
 		}
+		else
+		{
+			// Nothing more can be written, do not hold on to the queued messages
+			this_l->send_queue.clear ();
+		}
 	}));
 	// clang-format on
 }
@@ -394,20 +431,33 @@ void nano::websocket::session::handle_message (boost::property_tree::ptree const
 		auto existing (subscriptions.find (topic_l));
 		if (existing != subscriptions.end ())
 		{
+			if (topic_l == nano::websocket::topic::confirmation)
+			{
+				ws_listener.unindex_confirmation_subscription (this, dynamic_cast<nano::websocket::confirmation_options *> (existing->second.get ()));
+			}
 			existing->second = std::move (options_l);
 			ws_listener.get_node ().logger.always_log ("Websocket: updated subscription to topic: ", from_topic (topic_l));
 		}
 		else
 		{
-			subscriptions.insert (std::make_pair (topic_l, std::move (options_l)));
+			existing = subscriptions.insert (std::make_pair (topic_l, std::move (options_l))).first;
 			ws_listener.get_node ().logger.always_log ("Websocket: new subscription to topic: ", from_topic (topic_l));
 			ws_listener.increase_subscriber_count (topic_l);
 		}
+		if (topic_l == nano::websocket::topic::confirmation)
+		{
+			ws_listener.index_confirmation_subscription (shared_from_this (), dynamic_cast<nano::websocket::confirmation_options *> (existing->second.get ()));
+		}
 		action_succeeded = true;
 	}
 	else if (action == "unsubscribe" && topic_l != nano::websocket::topic::invalid)
 	{
 		std::lock_guard<std::mutex> lk (subscriptions_mutex);
+		auto existing (subscriptions.find (topic_l));
+		if (existing != subscriptions.end () && topic_l == nano::websocket::topic::confirmation)
+		{
+			ws_listener.unindex_confirmation_subscription (this, dynamic_cast<nano::websocket::confirmation_options *> (existing->second.get ()));
+		}
 		if (subscriptions.erase (topic_l))
 		{
 			ws_listener.get_node ().logger.always_log ("Websocket: removed subscription to topic: ", from_topic (topic_l));
@@ -501,50 +551,180 @@ void nano::websocket::listener::broadcast_confirmation (std::shared_ptr<nano::bl
 {
 	nano::websocket::message_builder builder;
 
-	std::lock_guard<std::mutex> lk (sessions_mutex);
+	// Each variant is built and rendered at most once, then shared by every session it is written to
 	boost::optional<nano::websocket::message> msg_with_block;
 	boost::optional<nano::websocket::message> msg_without_block;
-	for (auto & weak_session : sessions)
+	std::shared_ptr<std::string const> payload_with_block;
+	std::shared_ptr<std::string const> payload_without_block;
+	boost::optional<nano::account> destination;
+	if (block_a->type () == nano::block_type::state)
 	{
-		auto session_ptr (weak_session.lock ());
-		if (session_ptr)
+		destination = block_a->link ();
+	}
+	for (auto & session_ptr : confirmation_candidates (account_a, destination))
+	{
+		boost::optional<bool> include_block;
 		{
+			std::lock_guard<std::mutex> lk (session_ptr->subscriptions_mutex);
 			auto subscription (session_ptr->subscriptions.find (nano::websocket::topic::confirmation));
 			if (subscription != session_ptr->subscriptions.end ())
 			{
 				auto conf_options (dynamic_cast<nano::websocket::confirmation_options *> (subscription->second.get ()));
-				auto include_block (conf_options == nullptr ? true : conf_options->get_include_block ());
-
-				if (include_block && !msg_with_block)
-				{
-					msg_with_block = builder.block_confirmed (block_a, account_a, amount_a, subtype, include_block, election_status_type_a);
-				}
-				else if (!include_block && !msg_without_block)
-				{
-					msg_without_block = builder.block_confirmed (block_a, account_a, amount_a, subtype, include_block, election_status_type_a);
-				}
-				else
+				include_block = conf_options == nullptr ? true : conf_options->get_include_block ();
+			}
+		}
+		if (include_block)
+		{
+			auto & msg (*include_block ? msg_with_block : msg_without_block);
+			auto & payload (*include_block ? payload_with_block : payload_without_block);
+			if (!msg)
+			{
+				msg = builder.block_confirmed (block_a, account_a, amount_a, subtype, *include_block, election_status_type_a);
+			}
+			if (session_ptr->should_write (*msg))
+			{
+				if (!payload)
 				{
-					assert (false);
+					payload = msg->to_string ();
 				}
+				session_ptr->write (payload);
+			}
+		}
+	}
+}
 
-				session_ptr->write (include_block ? msg_with_block.get () : msg_without_block.get ());
+void nano::websocket::listener::broadcast (nano::websocket::message const & message_a)
+{
+	std::shared_ptr<std::string const> payload;
+	for (auto & session_ptr : sessions_snapshot ())
+	{
+		if (session_ptr->should_write (message_a))
+		{
+			if (!payload)
+			{
+				payload = message_a.to_string ();
 			}
+			session_ptr->write (payload);
 		}
 	}
 }
 
-void nano::websocket::listener::broadcast (nano::websocket::message message_a)
+std::vector<std::shared_ptr<nano::websocket::session>> nano::websocket::listener::sessions_snapshot ()
 {
+	std::vector<std::shared_ptr<nano::websocket::session>> result;
 	std::lock_guard<std::mutex> lk (sessions_mutex);
+	result.reserve (sessions.size ());
 	for (auto & weak_session : sessions)
 	{
 		auto session_ptr (weak_session.lock ());
 		if (session_ptr)
 		{
-			session_ptr->write (message_a);
+			result.push_back (session_ptr);
+		}
+	}
+	return result;
+}
+
+void nano::websocket::listener::index_confirmation_subscription (std::shared_ptr<nano::websocket::session> const & session_a, nano::websocket::confirmation_options const * options_a)
+{
+	std::lock_guard<std::mutex> lk (confirmation_index_mutex);
+	if (options_a == nullptr || !options_a->get_has_account_filtering_options ())
+	{
+		confirmation_subscribers_all.push_back (session_a);
+	}
+	else
+	{
+		if (options_a->get_all_local_accounts ())
+		{
+			confirmation_subscribers_local.push_back (session_a);
+		}
+		for (auto & account_text : options_a->get_accounts ())
+		{
+			nano::account account;
+			auto error (account.decode_account (account_text));
+			(void)error;
+			assert (!error);
+			confirmation_subscribers_by_account.emplace (account, session_a);
+		}
+	}
+}
+
+void nano::websocket::listener::unindex_confirmation_subscription (nano::websocket::session const * session_a, nano::websocket::confirmation_options const * options_a)
+{
+	// A session being destroyed can no longer be locked, its entries are removed along with any other expired ones
+	auto matches ([session_a](std::weak_ptr<nano::websocket::session> const & entry_a) {
+		auto session_l (entry_a.lock ());
+		return session_l == nullptr || session_l.get () == session_a;
+	});
+	std::lock_guard<std::mutex> lk (confirmation_index_mutex);
+	if (options_a == nullptr || !options_a->get_has_account_filtering_options ())
+	{
+		confirmation_subscribers_all.erase (std::remove_if (confirmation_subscribers_all.begin (), confirmation_subscribers_all.end (), matches), confirmation_subscribers_all.end ());
+	}
+	else
+	{
+		if (options_a->get_all_local_accounts ())
+		{
+			confirmation_subscribers_local.erase (std::remove_if (confirmation_subscribers_local.begin (), confirmation_subscribers_local.end (), matches), confirmation_subscribers_local.end ());
+		}
+		for (auto & account_text : options_a->get_accounts ())
+		{
+			nano::account account;
+			account.decode_account (account_text);
+			auto range (confirmation_subscribers_by_account.equal_range (account));
+			for (auto i (range.first); i != range.second;)
+			{
+				i = matches (i->second) ? confirmation_subscribers_by_account.erase (i) : std::next (i);
+			}
+		}
+	}
+}
+
+std::vector<std::shared_ptr<nano::websocket::session>> nano::websocket::listener::confirmation_candidates (nano::account const & account_a, boost::optional<nano::account> const & destination_a)
+{
+	std::vector<std::shared_ptr<nano::websocket::session>> result;
+	std::unordered_set<nano::websocket::session *> added;
+	auto add ([&result, &added](std::weak_ptr<nano::websocket::session> const & entry_a) {
+		auto session_l (entry_a.lock ());
+		if (session_l != nullptr && added.insert (session_l.get ()).second)
+		{
+			result.push_back (session_l);
+		}
+	});
+	std::vector<std::weak_ptr<nano::websocket::session>> local_l;
+	{
+		std::lock_guard<std::mutex> lk (confirmation_index_mutex);
+		for (auto & entry : confirmation_subscribers_all)
+		{
+			add (entry);
+		}
+		// Account filters only apply to blocks with a destination, as in confirmation_options::should_filter
+		if (destination_a)
+		{
+			local_l = confirmation_subscribers_local;
+			for (auto & account : { account_a, *destination_a })
+			{
+				auto range (confirmation_subscribers_by_account.equal_range (account));
+				for (auto i (range.first); i != range.second; ++i)
+				{
+					add (i->second);
+				}
+			}
+		}
+	}
+	// The wallets are read without holding the index, which subscribing sessions wait on
+	if (!local_l.empty ())
+	{
+		auto transaction_l (node.wallets.tx_begin_read ());
+		if (node.wallets.exists (transaction_l, account_a) || node.wallets.exists (transaction_l, *destination_a))
+		{
+			for (auto & entry : local_l)
+			{
+				add (entry);
+			}
 		}
 	}
+	return result;
 }
 
 void nano::websocket::listener::increase_subscriber_count (nano::websocket::topic const & topic_a)
@@ -578,9 +758,15 @@ nano::websocket::message nano::websocket::message_builder::block_confirmed (std:
 
 	// Block confirmation properties
 	boost::property_tree::ptree message_node_l;
-	message_node_l.add ("account", account_a.to_account ());
+	// The account and the hash are encoded into one buffer
+	std::string text (nano::uint256_union::account_encoded_size, '\0');
+	account_a.encode_account (&text[0]);
+	message_node_l.add ("account", text);
 	message_node_l.add ("amount", amount_a.to_string_dec ());
-	message_node_l.add ("hash", block_a->hash ().to_string ());
+	auto hash (block_a->hash ());
+	text.resize (2 * hash.bytes.size ());
+	hash.encode_hex (&text[0]);
+	message_node_l.add ("hash", text);
 
 	std::string confirmation_type = "unknown";
 	switch (election_status_type_a)
@@ -653,10 +839,10 @@ void nano::websocket::message_builder::set_common_fields (nano::websocket::messa
 	message_a.contents.add ("time", std::to_string (milli_since_epoch));
 }
 
-std::shared_ptr<std::string> nano::websocket::message::to_string () const
+std::shared_ptr<std::string const> nano::websocket::message::to_string () const
 {
 	std::ostringstream ostream;
 	boost::property_tree::write_json (ostream, contents);
 	ostream.flush ();
-	return std::make_shared<std::string> (ostream.str ());
+	return std::make_shared<std::string const> (ostream.str ());
 }
@@ -5,6 +5,7 @@
 #include <nano/lib/blocks.hpp>
 #include <nano/lib/numbers.hpp>
 
+#include <boost/optional.hpp>
 #include <boost/property_tree/json_parser.hpp>
 
 #include <algorithm>
@@ -69,7 +70,7 @@ namespace websocket
 		{
 		}
 
-		std::shared_ptr<std::string> to_string () const;
+		std::shared_ptr<std::string const> to_string () const;
 		nano::websocket::topic topic;
 		boost::property_tree::ptree contents;
 	};
@@ -133,6 +134,22 @@ namespace websocket
 			return include_block;
 		}
 
+		/** Returns whether confirmations are filtered by account at all */
+		bool get_has_account_filtering_options () const
+		{
+			return has_account_filtering_options;
+		}
+
+		bool get_all_local_accounts () const
+		{
+			return all_local_accounts;
+		}
+
+		std::unordered_set<std::string> const & get_accounts () const
+		{
+			return accounts;
+		}
+
 		static constexpr const uint8_t type_active_quorum = 1;
 		static constexpr const uint8_t type_active_confirmation_height = 2;
 		static constexpr const uint8_t type_inactive = 4;
@@ -191,7 +208,16 @@ namespace websocket
 		void read ();
 
 		/** Enqueue \p message_a for writing to the websockets */
-		void write (nano::websocket::message message_a);
+		void write (nano::websocket::message const & message_a);
+
+		/** Returns whether \p message_a is an ack or matches a subscription of this session */
+		bool should_write (nano::websocket::message const & message_a);
+
+		/**
+		 * Enqueue an already rendered message. Broadcasts render a message once and share the payload between sessions.
+		 * If the session has max_queued_messages waiting, the payload is dropped or the session disconnected.
+		 */
+		void write (std::shared_ptr<std::string const> payload_a);
 
 	private:
 		/** The owning listener */
@@ -203,7 +229,7 @@ namespace websocket
 		/** All websocket operations that are thread unsafe must go through a strand. */
 		boost::asio::strand<boost::asio::io_context::executor_type> strand;
 		/** Outgoing messages. The send queue is protected by accessing it only through the strand */
-		std::deque<message> send_queue;
+		std::deque<std::shared_ptr<std::string const>> send_queue;
 
 		/** Hash functor for topic enums */
 		struct topic_hash
@@ -244,7 +270,7 @@ namespace websocket
 		void broadcast_confirmation (std::shared_ptr<nano::block> block_a, nano::account const & account_a, nano::amount const & amount_a, std::string subtype, nano::election_status_type election_status_type_a);
 
 		/** Broadcast \p message to all session subscribing to the message topic. */
-		void broadcast (nano::websocket::message message_a);
+		void broadcast (nano::websocket::message const & message_a);
 
 		nano::node & get_node () const
 		{
@@ -280,6 +306,28 @@ namespace websocket
 		std::mutex sessions_mutex;
 		std::vector<std::weak_ptr<session>> sessions;
 		std::array<std::atomic<std::size_t>, number_topics> topic_subscriber_count{};
+
+		/** Live sessions, copied so that messages are written without holding sessions_mutex */
+		std::vector<std::shared_ptr<session>> sessions_snapshot ();
+
+		/**
+		 * Adds a confirmation subscription to the index, \p options_a is null if the subscription has default options.
+		 * Called with the session's subscriptions_mutex held.
+		 */
+		void index_confirmation_subscription (std::shared_ptr<session> const & session_a, nano::websocket::confirmation_options const * options_a);
+		/** Removes a confirmation subscription indexed with \p options_a from the index */
+		void unindex_confirmation_subscription (session const * session_a, nano::websocket::confirmation_options const * options_a);
+		/** Sessions which may want the confirmation of a block of \p account_a, possibly sending to \p destination_a */
+		std::vector<std::shared_ptr<session>> confirmation_candidates (nano::account const & account_a, boost::optional<nano::account> const & destination_a);
+
+		/**
+		 * Confirmation subscribers, indexed so that a confirmation only visits sessions which can be interested in it.
+		 * Sessions filtering on accounts are found by account, the others are subscribed to every account or to the local ones.
+		 */
+		std::mutex confirmation_index_mutex;
+		std::unordered_multimap<nano::account, std::weak_ptr<session>> confirmation_subscribers_by_account;
+		std::vector<std::weak_ptr<session>> confirmation_subscribers_all;
+		std::vector<std::weak_ptr<session>> confirmation_subscribers_local;
 		std::atomic<bool> stopped{ false };
 	};
 }
@@ -11,6 +11,8 @@ nano::error nano::websocket::config::serialize_json (nano::jsonconfig & json) co
 	json.put ("enable", enabled);
 	json.put ("address", address.to_string ());
 	json.put ("port", port);
+	json.put ("max_queued_messages", max_queued_messages);
+	json.put ("disconnect_slow_consumers", disconnect_slow_consumers);
 	return json.get_error ();
 }
 
@@ -19,5 +21,7 @@ nano::error nano::websocket::config::deserialize_json (nano::jsonconfig & json)
 	json.get<bool> ("enable", enabled);
 	json.get_required<boost::asio::ip::address_v6> ("address", address);
 	json.get<uint16_t> ("port", port);
+	json.get<size_t> ("max_queued_messages", max_queued_messages);
+	json.get<bool> ("disconnect_slow_consumers", disconnect_slow_consumers);
 	return json.get_error ();
 }
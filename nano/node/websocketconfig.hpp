@@ -20,6 +20,10 @@ namespace websocket
 		bool enabled{ false };
 		uint16_t port;
 		boost::asio::ip::address_v6 address{ boost::asio::ip::address_v6::loopback () };
+		/** Messages a session may have waiting to be written before further messages are dropped, 0 for no limit */
+		size_t max_queued_messages{ 1024 };
+		/** Disconnect a session that reaches max_queued_messages instead of dropping messages */
+		bool disconnect_slow_consumers{ false };
 	};
 }
 }
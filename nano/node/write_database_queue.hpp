@@ -12,7 +12,8 @@ namespace nano
 enum class writer
 {
 	confirmation_height,
-	process_batch
+	process_batch,
+	ledger_snapshot
 };
 
 class write_guard final
@@ -1618,9 +1618,7 @@ wallet (wallet_a)
 		if (this->wallet.wallet_m->store.valid_password (transaction))
 		{
 			// lock wallet
-			nano::raw_key empty;
-			empty.data.clear ();
-			this->wallet.wallet_m->store.password.value_set (empty);
+			this->wallet.wallet_m->store.lock ();
 			update_locked (true, true);
 			lock_toggle->setText ("Unlock");
 			this->wallet.node.logger.try_log ("Wallet locked");
@@ -9,9 +9,18 @@
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/format.hpp>
 
+namespace
+{
+/** Pieces of a chunked response which may wait to be written before the producer is paused */
+size_t constexpr max_queued_chunks = 4;
+/** A client which does not accept a piece within this time is disconnected */
+std::chrono::seconds constexpr chunk_write_timeout (15);
+}
+
 nano::rpc_connection::rpc_connection (nano::rpc_config const & rpc_config, boost::asio::io_context & io_ctx, nano::logger_mt & logger, nano::rpc_handler_interface & rpc_handler_interface) :
 socket (io_ctx),
 strand (io_ctx.get_executor ()),
+chunk_timer (io_ctx),
 io_ctx (io_ctx),
 logger (logger),
 rpc_config (rpc_config),
@@ -52,6 +61,118 @@ void nano::rpc_connection::write_result (std::string body, unsigned version, boo
 	}
 }
 
+void nano::rpc_connection::write_chunk (std::string const & body_a, bool last_a, unsigned version_a, std::function<void(bool)> const & resume_a)
+{
+	auto this_l (shared_from_this ());
+	boost::asio::post (strand, [this_l, body_a, last_a, version_a, resume_a]() {
+		if (!this_l->chunked && last_a)
+		{
+			// Complete in one piece, sent with a Content-Length
+			this_l->write_result (body_a, version_a);
+			boost::beast::http::async_write (this_l->socket, this_l->res, boost::asio::bind_executor (this_l->strand, [this_l](boost::system::error_code const & ec, size_t bytes_transferred) {
+				this_l->write_completion_handler (this_l);
+			}));
+		}
+		else if (!this_l->chunks_failed)
+		{
+			std::ostringstream piece;
+			if (!this_l->chunked)
+			{
+				this_l->chunked = true;
+				auto already_responded (this_l->responded.test_and_set ());
+				(void)already_responded;
+				assert (!already_responded);
+				this_l->prepare_head (version_a);
+				boost::beast::http::response<boost::beast::http::empty_body> head (this_l->res.base ());
+				head.chunked (true);
+				piece << head.base ();
+			}
+			if (!body_a.empty ())
+			{
+				piece << std::hex << body_a.size () << "\r\n"
+				      << body_a << "\r\n";
+			}
+			if (last_a)
+			{
+				piece << "0\r\n\r\n";
+				this_l->chunks_complete = true;
+			}
+			this_l->chunks.push_back (piece.str ());
+			if (!last_a)
+			{
+				// The producer is paused while the queue is full and resumed as pieces are written
+				if (this_l->chunks.size () < max_queued_chunks)
+				{
+					resume_a (true);
+				}
+				else
+				{
+					this_l->chunk_resume = resume_a;
+				}
+			}
+			if (!this_l->chunk_writing)
+			{
+				this_l->write_next_chunk ();
+			}
+		}
+		else if (!last_a)
+		{
+			// The client has gone, the rest of the response is not wanted
+			resume_a (false);
+		}
+	});
+}
+
+/** Writes the front of the chunk queue, one write is in progress at a time */
+void nano::rpc_connection::write_next_chunk ()
+{
+	auto this_l (shared_from_this ());
+	chunk_writing = true;
+	chunk_timer.expires_after (chunk_write_timeout);
+	chunk_timer.async_wait (boost::asio::bind_executor (strand, [this_l](boost::system::error_code const & ec) {
+		// A write completed after the timer fired has restarted it
+		if (!ec && this_l->chunk_writing && this_l->chunk_timer.expiry () <= std::chrono::steady_clock::now ())
+		{
+			boost::system::error_code ignored;
+			this_l->socket.close (ignored);
+		}
+	}));
+	boost::asio::async_write (socket, boost::asio::buffer (chunks.front ()), boost::asio::bind_executor (strand, [this_l](boost::system::error_code const & ec, size_t bytes_transferred) {
+		this_l->chunk_writing = false;
+		this_l->chunk_timer.cancel ();
+		this_l->chunks.pop_front ();
+		std::function<void(bool)> resume_l;
+		if (!ec)
+		{
+			if (this_l->chunks.size () < max_queued_chunks)
+			{
+				resume_l.swap (this_l->chunk_resume);
+			}
+			if (!this_l->chunks.empty ())
+			{
+				this_l->write_next_chunk ();
+			}
+			else if (this_l->chunks_complete)
+			{
+				this_l->write_completion_handler (this_l);
+			}
+		}
+		else
+		{
+			this_l->logger.always_log ("RPC write error: ", ec.message ());
+			this_l->chunks_failed = true;
+			this_l->chunks.clear ();
+			resume_l.swap (this_l->chunk_resume);
+			boost::system::error_code ignored;
+			this_l->socket.close (ignored);
+		}
+		if (resume_l)
+		{
+			resume_l (!ec);
+		}
+	}));
+}
+
 void nano::rpc_connection::read ()
 {
 	auto this_l (shared_from_this ());
@@ -101,16 +222,17 @@ void nano::rpc_connection::parse_request (std::shared_ptr<boost::beast::http::re
 				std::stringstream ss;
 				ss << std::hex << std::showbase << reinterpret_cast<uintptr_t> (this_l.get ());
 				auto request_id = ss.str ();
-				auto response_handler ([this_l, version, start, request_id](std::string const & tree_a) {
-					auto body = tree_a;
-					this_l->write_result (body, version);
-					boost::beast::http::async_write (this_l->socket, this_l->res, boost::asio::bind_executor (this_l->strand, [this_l](boost::system::error_code const & ec, size_t bytes_transferred) {
-						this_l->write_completion_handler (this_l);
-					}));
-
-					std::stringstream ss;
-					ss << "RPC request " << request_id << " completed in: " << std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::steady_clock::now () - start).count () << " microseconds";
-					this_l->logger.always_log (ss.str ().c_str ());
+				auto response_handler ([this_l, version, start, request_id](std::string const & body_a, bool last_a, std::function<void(bool)> const & resume_a) {
+					this_l->write_chunk (body_a, last_a, version, resume_a);
+					if (last_a)
+					{
+						std::stringstream ss;
+						ss << "RPC request " << request_id << " completed in: " << std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::steady_clock::now () - start).count () << " microseconds";
+						this_l->logger.always_log (ss.str ().c_str ());
+					}
+				});
+				auto complete_response ([response_handler](std::string const & body_a) {
+					response_handler (body_a, true, [](bool) {});
 				});
 				auto method = req.method ();
 				switch (method)
@@ -132,7 +254,7 @@ void nano::rpc_connection::parse_request (std::shared_ptr<boost::beast::http::re
 					}
 					default:
 					{
-						json_error_response (response_handler, "Can only POST requests");
+						json_error_response (complete_response, "Can only POST requests");
 						break;
 					}
 				}
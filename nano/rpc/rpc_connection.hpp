@@ -6,6 +6,7 @@
 #include <boost/beast.hpp>
 
 #include <atomic>
+#include <deque>
 
 /* Boost v1.70 introduced breaking changes; the conditional compilation allows 1.6x to be supported as well. */
 #if BOOST_VERSION < 107000
@@ -29,6 +30,12 @@ public:
 	virtual void write_completion_handler (std::shared_ptr<nano::rpc_connection> rpc_connection);
 	void prepare_head (unsigned version, boost::beast::http::status status = boost::beast::http::status::ok);
 	void write_result (std::string body, unsigned version, boost::beast::http::status status = boost::beast::http::status::ok);
+	/**
+	 * Writes a piece of the response, a response which arrives in several pieces is sent with chunked transfer encoding.
+	 * Pieces are queued and written asynchronously, \p resume is called once the queue has room for the next one.
+	 */
+	void write_chunk (std::string const & body, bool last, unsigned version, std::function<void(bool)> const & resume);
+	void write_next_chunk ();
 	void parse_request (std::shared_ptr<boost::beast::http::request_parser<boost::beast::http::empty_body>> header_parser);
 
 	void read ();
@@ -38,6 +45,15 @@ public:
 	boost::beast::http::response<boost::beast::http::string_body> res;
 	boost::asio::strand<boost::asio::io_context::executor_type> strand;
 	std::atomic_flag responded;
+	bool chunked{ false };
+	/** Framed pieces of a chunked response waiting to be written, the chunk state is only accessed on the strand */
+	std::deque<std::string> chunks;
+	/** Set while the producer waits for room in the chunk queue */
+	std::function<void(bool)> chunk_resume;
+	bool chunk_writing{ false };
+	bool chunks_complete{ false };
+	bool chunks_failed{ false };
+	boost::asio::steady_timer chunk_timer;
 	boost::asio::io_context & io_ctx;
 	nano::logger_mt & logger;
 	nano::rpc_config const & rpc_config;
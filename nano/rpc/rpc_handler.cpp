@@ -1,5 +1,6 @@
 #include <nano/lib/errors.hpp>
 #include <nano/lib/json_error_response.hpp>
+#include <nano/lib/json_reader.hpp>
 #include <nano/lib/logger_mt.hpp>
 #include <nano/lib/rpc_handler_interface.hpp>
 #include <nano/lib/rpcconfig.hpp>
@@ -17,10 +18,13 @@ std::unordered_set<std::string> rpc_control_impl_set = create_rpc_control_impls
 std::string filter_request (boost::property_tree::ptree tree_a);
 }
 
-nano::rpc_handler::rpc_handler (nano::rpc_config const & rpc_config, std::string const & body_a, std::string const & request_id_a, std::function<void(std::string const &)> const & response_a, nano::rpc_handler_interface & rpc_handler_interface_a, nano::logger_mt & logger) :
+nano::rpc_handler::rpc_handler (nano::rpc_config const & rpc_config, std::string const & body_a, std::string const & request_id_a, nano::rpc_response_chunk const & response_a, nano::rpc_handler_interface & rpc_handler_interface_a, nano::logger_mt & logger) :
 body (body_a),
 request_id (request_id_a),
-response (response_a),
+response_chunk (response_a),
+response ([response_a](std::string const & response_body_a) {
+	response_a (response_body_a, true, [](bool) {});
+}),
 rpc_config (rpc_config),
 rpc_handler_interface (rpc_handler_interface_a),
 logger (logger)
@@ -52,11 +56,7 @@ void nano::rpc_handler::process_request ()
 		else
 		{
 			boost::property_tree::ptree request;
-			{
-				std::stringstream ss;
-				ss << body;
-				boost::property_tree::read_json (ss, request);
-			}
+			nano::json_reader (body).read (request);
 
 			auto action = request.get<std::string> ("action");
 			// Creating same string via stringstream as using it directly is generating a TSAN warning
@@ -108,7 +108,7 @@ void nano::rpc_handler::process_request ()
 
 			if (!error)
 			{
-				rpc_handler_interface.process_request (action, body, this->response);
+				rpc_handler_interface.process_request (action, body, this->response_chunk);
 			}
 		}
 	}
@@ -134,6 +134,7 @@ std::unordered_set<std::string> create_rpc_control_impls ()
 	set.emplace ("accounts_create");
 	set.emplace ("block_create");
 	set.emplace ("bootstrap_lazy");
+	set.emplace ("bootstrap_snapshot");
 	set.emplace ("confirmation_height_currently_processing");
 	set.emplace ("database_txn_tracker");
 	set.emplace ("keepalive");
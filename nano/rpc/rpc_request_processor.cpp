@@ -1,178 +1,445 @@
 #include <nano/lib/json_error_response.hpp>
 #include <nano/rpc/rpc_request_processor.hpp>
 
-nano::rpc_request_processor::rpc_request_processor (boost::asio::io_context & io_ctx, nano::rpc_config & rpc_config) :
-ipc_address (rpc_config.address.to_string ()),
-ipc_port (rpc_config.rpc_process.ipc_port),
-thread ([this]() {
-	nano::thread_role::set (nano::thread_role::name::rpc_request_processor);
-	this->run ();
-})
-{
-	std::lock_guard<std::mutex> lk (this->request_mutex);
-	this->connections.reserve (rpc_config.rpc_process.num_ipc_connections);
-	for (auto i = 0u; i < rpc_config.rpc_process.num_ipc_connections; ++i)
-	{
-		connections.push_back (std::make_shared<nano::ipc_connection> (nano::ipc::ipc_client (io_ctx), false));
-		auto connection = this->connections.back ();
-		// clang-format off
-		connection->client.async_connect (ipc_address, ipc_port, [ connection, &connections_mutex = this->connections_mutex ](nano::error err) {
-			// Even if there is an error this needs to be set so that another attempt can be made to connect with the ipc connection
-			std::lock_guard<std::mutex> lk (connections_mutex);
-			connection->is_available = true;
-		});
-		// clang-format on
-	}
+namespace
+{
+std::string const connect_error ("There is a problem connecting to the node. Make sure ipc->tcp is enabled in node config and ports match");
+
+/** Actions whose response the node streams in pieces, these are sent over their own ipc_stream */
+std::unordered_set<std::string> create_streamed_actions ()
+{
+	std::unordered_set<std::string> set;
+	set.emplace ("account_history");
+	set.emplace ("frontiers");
+	set.emplace ("ledger");
+	set.emplace ("representatives");
+	set.emplace ("unchecked");
+	set.emplace ("wallet_ledger");
+	return set;
 }
+std::unordered_set<std::string> const streamed_actions = create_streamed_actions ();
 
-nano::rpc_request_processor::~rpc_request_processor ()
+void error_response (nano::rpc_request & rpc_request_a, std::string const & message_a)
 {
-	stop ();
+	nano::json_error_response ([&rpc_request_a](std::string const & body_a) {
+		rpc_request_a.response (body_a, true, [](bool) {});
+	},
+	message_a);
+}
 }
 
-void nano::rpc_request_processor::stop ()
+nano::ipc_connection::ipc_connection (boost::asio::io_context & io_ctx_a, std::string const & address_a, uint16_t port_a) :
+strand (io_ctx_a.get_executor ()),
+client (io_ctx_a, strand),
+address (address_a),
+port (port_a),
+read_buffer (std::make_shared<std::vector<uint8_t>> ())
 {
-	{
-		std::lock_guard<std::mutex> lock (request_mutex);
-		stopped = true;
-	}
-	condition.notify_one ();
-	if (thread.joinable ())
-	{
-		thread.join ();
-	}
 }
 
-void nano::rpc_request_processor::add (std::shared_ptr<rpc_request> request)
+void nano::ipc_connection::connect ()
 {
+	auto this_l (shared_from_this ());
+	boost::asio::post (strand, [this_l]() {
+		if (this_l->state == connection_state::disconnected)
+		{
+			this_l->state = connection_state::connecting;
+			this_l->client.async_connect (this_l->address, this_l->port, [this_l](nano::error err) {
+				if (this_l->state == connection_state::connecting)
+				{
+					if (!err)
+					{
+						this_l->state = connection_state::connected;
+						this_l->write_next ();
+						if (!this_l->requests.empty () && !this_l->reading)
+						{
+							this_l->read_next ();
+						}
+					}
+					else
+					{
+						this_l->state = connection_state::disconnected;
+						this_l->writes.clear ();
+						for (auto & request : this_l->requests)
+						{
+							error_response (*request.second.request, connect_error);
+						}
+						this_l->outstanding -= this_l->requests.size ();
+						this_l->requests.clear ();
+					}
+				}
+			});
+		}
+	});
+}
+
+void nano::ipc_connection::send (std::shared_ptr<nano::rpc_request> rpc_request_a)
+{
+	++outstanding;
+	auto this_l (shared_from_this ());
+	boost::asio::post (strand, [this_l, rpc_request_a]() {
+		if (this_l->state != connection_state::closed)
+		{
+			auto id (this_l->next_id++);
+			auto & pending_l (this_l->requests[id]);
+			pending_l.request = rpc_request_a;
+			pending_l.frame = nano::ipc::prepare_request (nano::ipc::payload_encoding::json_multiplexed, rpc_request_a->body, id);
+			this_l->writes.push_back (id);
+			if (this_l->state == connection_state::connected)
+			{
+				this_l->write_next ();
+				if (!this_l->reading)
+				{
+					this_l->read_next ();
+				}
+			}
+			else
+			{
+				this_l->reconnect_when_idle ();
+			}
+		}
+		else
+		{
+			--this_l->outstanding;
+			error_response (*rpc_request_a, "RPC is stopping");
+		}
+	});
+}
+
+void nano::ipc_connection::close ()
+{
+	auto this_l (shared_from_this ());
+	boost::asio::post (strand, [this_l]() {
+		this_l->state = connection_state::closed;
+		this_l->client.close ();
+	});
+}
+
+/** Writes the next queued request, one write is in progress at a time */
+void nano::ipc_connection::write_next ()
+{
+	if (!writing && !writes.empty () && state == connection_state::connected)
 	{
-		std::lock_guard<std::mutex> lk (request_mutex);
-		requests.push_back (request);
+		auto id (writes.front ());
+		writes.pop_front ();
+		auto existing (requests.find (id));
+		assert (existing != requests.end ());
+		writing = true;
+		auto this_l (shared_from_this ());
+		client.async_write (existing->second.frame, [this_l](nano::error err_a, size_t size_a) {
+			this_l->writing = false;
+			if (!err_a && size_a != 0 && this_l->state == connection_state::connected)
+			{
+				this_l->write_next ();
+			}
+			else
+			{
+				this_l->failed ("Cannot write to the node");
+			}
+		});
 	}
-	condition.notify_one ();
 }
 
-void nano::rpc_request_processor::read_payload (std::shared_ptr<nano::ipc_connection> connection, std::shared_ptr<std::vector<uint8_t>> res, std::shared_ptr<nano::rpc_request> rpc_request)
+/** Reads the request id and header of the next response piece, reading continues while requests are outstanding */
+void nano::ipc_connection::read_next ()
+{
+	reading = true;
+	auto this_l (shared_from_this ());
+	client.async_read (read_buffer, 2 * sizeof (uint32_t), [this_l](nano::error err_a, size_t size_a) {
+		if (!err_a && size_a == 2 * sizeof (uint32_t) && this_l->state == connection_state::connected)
+		{
+			auto words (reinterpret_cast<uint32_t const *> (this_l->read_buffer->data ()));
+			this_l->read_payload (boost::endian::big_to_native (words[0]), boost::endian::big_to_native (words[1]));
+		}
+		else
+		{
+			this_l->reading = false;
+			this_l->failed ("Connection to node has failed");
+		}
+	});
+}
+
+/**
+ * Reads the payload of a response piece. The node answers multiplexed requests in one piece, as streamed responses are
+ * requested over an ipc_stream, so a piece is passed on without waiting for the consumer and reading continues.
+ */
+void nano::ipc_connection::read_payload (uint32_t id_a, uint32_t header_a)
 {
-	uint32_t payload_size_l = boost::endian::big_to_native (*reinterpret_cast<uint32_t *> (res->data ()));
-	res->resize (payload_size_l);
-	// Read JSON payload
-	connection->client.async_read (res, payload_size_l, [this, connection, res, rpc_request](nano::error err_read_a, size_t size_read_a) {
-		// We need 2 sequential reads to get both the header and payload, so only allow other writes
-		// when they have both been read.
-		make_available (*connection);
-		if (!err_read_a && size_read_a != 0)
+	auto last_l ((header_a & nano::ipc::response_chunk_continued) == 0);
+	uint32_t payload_size_l (header_a & ~nano::ipc::response_chunk_continued);
+	auto this_l (shared_from_this ());
+	client.async_read (read_buffer, payload_size_l, [this_l, id_a, last_l, payload_size_l](nano::error err_a, size_t size_a) {
+		if (!err_a && size_a == payload_size_l && this_l->state == connection_state::connected)
 		{
-			rpc_request->response (std::string (res->begin (), res->end ()));
-			if (rpc_request->action == "stop")
+			auto existing (this_l->requests.find (id_a));
+			if (existing != this_l->requests.end ())
 			{
-				this->stop_callback ();
+				existing->second.responded = true;
+				existing->second.request->response (std::string (this_l->read_buffer->begin (), this_l->read_buffer->end ()), last_l, [](bool) {});
+				if (last_l)
+				{
+					this_l->requests.erase (existing);
+					--this_l->outstanding;
+				}
 			}
+			this_l->resume_reading ();
 		}
 		else
 		{
-			json_error_response (rpc_request->response, "Failed to read payload");
+			this_l->reading = false;
+			this_l->failed ("Failed to read payload");
 		}
 	});
 }
 
-void nano::rpc_request_processor::make_available (nano::ipc_connection & connection)
+/** Reads the next response piece while requests are outstanding */
+void nano::ipc_connection::resume_reading ()
 {
-	std::lock_guard<std::mutex> lk (connections_mutex);
-	connection.is_available = true; // Allow people to use it now
+	if (!requests.empty () && state == connection_state::connected)
+	{
+		read_next ();
+	}
+	else
+	{
+		reading = false;
+		reconnect_when_idle ();
+	}
 }
 
-// Connection does not exist or has been closed, try to connect to it again and then resend IPC request
-void nano::rpc_request_processor::try_reconnect_and_execute_request (std::shared_ptr<nano::ipc_connection> connection, std::shared_ptr<std::vector<uint8_t>> req, std::shared_ptr<std::vector<uint8_t>> res, std::shared_ptr<nano::rpc_request> rpc_request)
+/**
+ * Closes the connection after an IO error. Requests which have had no response yet are resent once over a new connection,
+ * as the node may have closed an idle connection, the others are answered with \p message_a.
+ */
+void nano::ipc_connection::failed (std::string const & message_a)
 {
-	connection->client.async_connect (ipc_address, ipc_port, [this, connection, req, res, rpc_request](nano::error err) {
-		if (!err)
+	if (state == connection_state::connected)
+	{
+		state = connection_state::disconnected;
+		client.close ();
+		writes.clear ();
+		for (auto i (requests.begin ()), n (requests.end ()); i != n;)
 		{
-			connection->client.async_write (req, [this, connection, res, rpc_request](nano::error err_a, size_t size_a) {
-				if (size_a != 0 && !err_a)
+			if (!i->second.responded && !i->second.resent)
+			{
+				i->second.resent = true;
+				writes.push_back (i->first);
+				++i;
+			}
+			else
+			{
+				error_response (*i->second.request, message_a);
+				--outstanding;
+				i = requests.erase (i);
+			}
+		}
+	}
+	reconnect_when_idle ();
+}
+
+/** A new connection replaces the socket, which is only done once no operation on the old one is pending */
+void nano::ipc_connection::reconnect_when_idle ()
+{
+	if (state == connection_state::disconnected && !reading && !writing && !requests.empty ())
+	{
+		connect ();
+	}
+}
+
+nano::ipc_stream::ipc_stream (boost::asio::io_context & io_ctx_a, std::shared_ptr<nano::rpc_request> request_a) :
+strand (io_ctx_a.get_executor ()),
+client (io_ctx_a, strand),
+request (request_a),
+read_buffer (std::make_shared<std::vector<uint8_t>> ())
+{
+}
+
+void nano::ipc_stream::start (std::string const & address_a, uint16_t port_a)
+{
+	auto this_l (shared_from_this ());
+	boost::asio::post (strand, [this_l, address_a, port_a]() {
+		if (!this_l->done)
+		{
+			this_l->client.async_connect (address_a, port_a, [this_l](nano::error err_a) {
+				if (!err_a && !this_l->done)
 				{
-					// Read length
-					connection->client.async_read (res, sizeof (uint32_t), [this, connection, res, rpc_request](nano::error err_read_a, size_t size_read_a) {
-						if (size_read_a != 0 && !err_read_a)
+					this_l->client.async_write (nano::ipc::prepare_request (nano::ipc::payload_encoding::json_chunked, this_l->request->body), [this_l](nano::error err_a, size_t size_a) {
+						if (!err_a && size_a != 0)
 						{
-							this->read_payload (connection, res, rpc_request);
+							this_l->read_next ();
 						}
 						else
 						{
-							json_error_response (rpc_request->response, "Connection to node has failed");
-							make_available (*connection);
+							this_l->failed ("Cannot write to the node");
 						}
 					});
 				}
 				else
 				{
-					json_error_response (rpc_request->response, "Cannot write to the node");
-					make_available (*connection);
+					this_l->failed (connect_error);
 				}
 			});
 		}
+	});
+}
+
+void nano::ipc_stream::close ()
+{
+	auto this_l (shared_from_this ());
+	boost::asio::post (strand, [this_l]() {
+		this_l->failed ("RPC is stopping");
+	});
+}
+
+/** Reads the header of the next response piece */
+void nano::ipc_stream::read_next ()
+{
+	auto this_l (shared_from_this ());
+	client.async_read (read_buffer, sizeof (uint32_t), [this_l](nano::error err_a, size_t size_a) {
+		if (!err_a && size_a == sizeof (uint32_t) && !this_l->done)
+		{
+			this_l->read_payload (boost::endian::big_to_native (*reinterpret_cast<uint32_t const *> (this_l->read_buffer->data ())));
+		}
+		else
+		{
+			this_l->failed ("Connection to node has failed");
+		}
+	});
+}
+
+/** Reads a response piece and passes it on, the next piece is read once the consumer has taken this one */
+void nano::ipc_stream::read_payload (uint32_t header_a)
+{
+	auto last_l ((header_a & nano::ipc::response_chunk_continued) == 0);
+	uint32_t payload_size_l (header_a & ~nano::ipc::response_chunk_continued);
+	auto this_l (shared_from_this ());
+	client.async_read (read_buffer, payload_size_l, [this_l, last_l, payload_size_l](nano::error err_a, size_t size_a) {
+		if (!err_a && size_a == payload_size_l && !this_l->done)
+		{
+			if (!last_l)
+			{
+				this_l->request->response (std::string (this_l->read_buffer->begin (), this_l->read_buffer->end ()), false, [this_l](bool resume_a) {
+					boost::asio::post (this_l->strand, [this_l, resume_a]() {
+						if (resume_a && !this_l->done)
+						{
+							this_l->read_next ();
+						}
+						else
+						{
+							// The consumer has gone, closing the connection stops the node producing the rest
+							this_l->done = true;
+							this_l->client.close ();
+						}
+					});
+				});
+			}
+			else
+			{
+				this_l->done = true;
+				this_l->request->response (std::string (this_l->read_buffer->begin (), this_l->read_buffer->end ()), true, [](bool) {});
+				this_l->client.close ();
+			}
+		}
 		else
 		{
-			json_error_response (rpc_request->response, "There is a problem connecting to the node. Make sure ipc->tcp is enabled in node config and ports match");
-			make_available (*connection);
+			this_l->failed ("Failed to read payload");
 		}
 	});
 }
 
-void nano::rpc_request_processor::run ()
+/** Ends the response with \p message_a unless it has been completed */
+void nano::ipc_stream::failed (std::string const & message_a)
+{
+	if (!done)
+	{
+		done = true;
+		client.close ();
+		error_response (*request, message_a);
+	}
+}
+
+nano::rpc_request_processor::rpc_request_processor (boost::asio::io_context & io_ctx, nano::rpc_config & rpc_config) :
+io_ctx (io_ctx),
+address (rpc_config.address.to_string ()),
+port (rpc_config.rpc_process.ipc_port)
 {
-	// This should be a conditioned wait
-	std::unique_lock<std::mutex> lk (request_mutex);
-	while (!stopped)
+	connections.reserve (rpc_config.rpc_process.num_ipc_connections);
+	for (auto i = 0u; i < rpc_config.rpc_process.num_ipc_connections; ++i)
 	{
-		if (!requests.empty ())
+		connections.push_back (std::make_shared<nano::ipc_connection> (io_ctx, address, port));
+		connections.back ()->connect ();
+	}
+}
+
+nano::rpc_request_processor::~rpc_request_processor ()
+{
+	stop ();
+}
+
+void nano::rpc_request_processor::stop ()
+{
+	for (auto & connection : connections)
+	{
+		connection->close ();
+	}
+	std::lock_guard<std::mutex> lock (streams_mutex);
+	stopped = true;
+	for (auto & stream : streams)
+	{
+		if (auto stream_l = stream.lock ())
 		{
-			lk.unlock ();
-			std::unique_lock<std::mutex> conditions_lk (connections_mutex);
-			// Find the first free ipc_client
-			auto it = std::find_if (connections.begin (), connections.end (), [](auto connection) -> bool {
-				return connection->is_available;
-			});
+			stream_l->close ();
+		}
+	}
+	streams.clear ();
+}
 
-			if (it != connections.cend ())
+void nano::rpc_request_processor::add (std::shared_ptr<rpc_request> request)
+{
+	if (request->action == "stop")
+	{
+		auto response_l (request->response);
+		request->response = [this, response_l](std::string const & body_a, bool last_a, std::function<void(bool)> const & resume_a) {
+			response_l (body_a, last_a, resume_a);
+			if (last_a)
 			{
-				// Successfully found one
-				lk.lock ();
-				auto rpc_request = requests.front ();
-				requests.pop_front ();
-				lk.unlock ();
-				auto connection = *it;
-				connection->is_available = false; // Make sure no one else can take it
-				conditions_lk.unlock ();
-				auto req (nano::ipc::prepare_request (nano::ipc::payload_encoding::json_legacy, rpc_request->body));
-				auto res (std::make_shared<std::vector<uint8_t>> ());
-
-				// Have we tried to connect yet?
-				connection->client.async_write (req, [this, connection, req, res, rpc_request](nano::error err_a, size_t size_a) {
-					if (!err_a)
-					{
-						connection->client.async_read (res, sizeof (uint32_t), [this, connection, req, res, rpc_request](nano::error err_read_a, size_t size_read_a) {
-							if (size_read_a != 0 && !err_read_a)
-							{
-								this->read_payload (connection, res, rpc_request);
-							}
-							else
-							{
-								this->try_reconnect_and_execute_request (connection, req, res, rpc_request);
-							}
-						});
-					}
-					else
-					{
-						try_reconnect_and_execute_request (connection, req, res, rpc_request);
-					}
-				});
+				this->stop_callback ();
 			}
-			lk.lock ();
+		};
+	}
+	if (streamed_actions.find (request->action) != streamed_actions.end ())
+	{
+		// Each streamed response has a connection to itself, so that waiting for its consumer holds back no other request
+		auto stream (std::make_shared<nano::ipc_stream> (io_ctx, request));
+		{
+			std::lock_guard<std::mutex> lock (streams_mutex);
+			if (!stopped)
+			{
+				streams.erase (std::remove_if (streams.begin (), streams.end (), [](auto const & stream_a) {
+					return stream_a.expired ();
+				}),
+				streams.end ());
+				streams.push_back (stream);
+			}
+			else
+			{
+				stream = nullptr;
+			}
+		}
+		if (stream != nullptr)
+		{
+			stream->start (address, port);
 		}
 		else
 		{
-			condition.wait (lk);
+			error_response (*request, "RPC is stopping");
 		}
 	}
+	else
+	{
+		// Requests share connections, so pick the one with the least outstanding
+		auto connection (*std::min_element (connections.begin (), connections.end (), [](auto const & lhs, auto const & rhs) {
+			return lhs->outstanding < rhs->outstanding;
+		}));
+		connection->send (request);
+	}
 }
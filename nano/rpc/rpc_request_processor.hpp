@@ -11,29 +11,105 @@
 #include <boost/endian/conversion.hpp>
 #include <boost/property_tree/json_parser.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
 namespace nano
 {
-struct ipc_connection
+struct rpc_request
 {
-	ipc_connection (nano::ipc::ipc_client && client_a, bool is_available_a) :
-	client (std::move (client_a)), is_available (is_available_a)
+	rpc_request (const std::string & action_a, const std::string & body_a, nano::rpc_response_chunk response_a) :
+	action (action_a), body (body_a), response (response_a)
 	{
 	}
 
-	nano::ipc::ipc_client client;
-	bool is_available{ false };
+	std::string action;
+	std::string body;
+	/** Receives the response as it is read from the node, the last piece is flagged */
+	nano::rpc_response_chunk response;
 };
 
-struct rpc_request
+/**
+ * IPC connection to the node carrying any number of requests at once. Requests are tagged with an id and the node
+ * answers them in the order they complete, so a slow request does not hold up the ones sent after it.
+ * The connection state is only accessed on the strand.
+ */
+class ipc_connection final : public std::enable_shared_from_this<nano::ipc_connection>
 {
-	rpc_request (const std::string & action_a, const std::string & body_a, std::function<void(std::string const &)> response_a) :
-	action (action_a), body (body_a), response (response_a)
+public:
+	ipc_connection (boost::asio::io_context &, std::string const &, uint16_t);
+	void connect ();
+	/** Sends the request over this connection, reconnecting first if the connection has failed */
+	void send (std::shared_ptr<nano::rpc_request>);
+	void close ();
+	/** Number of requests sent over this connection which have not completed, used to spread requests across connections */
+	std::atomic<size_t> outstanding{ 0 };
+
+private:
+	class pending final
 	{
-	}
+	public:
+		std::shared_ptr<nano::rpc_request> request;
+		std::shared_ptr<std::vector<uint8_t>> frame;
+		/** Set once part of the response has been passed on, after which the request cannot be resent */
+		bool responded{ false };
+		bool resent{ false };
+	};
+	enum class connection_state
+	{
+		disconnected,
+		connecting,
+		connected,
+		closed
+	};
+	void write_next ();
+	void read_next ();
+	void read_payload (uint32_t, uint32_t);
+	void resume_reading ();
+	void failed (std::string const &);
+	void reconnect_when_idle ();
+	boost::asio::strand<boost::asio::io_context::executor_type> strand;
+	/** Runs its completion handlers on the strand */
+	nano::ipc::ipc_client client;
+	std::string const address;
+	uint16_t const port;
+	connection_state state{ connection_state::disconnected };
+	uint32_t next_id{ 0 };
+	std::unordered_map<uint32_t, pending> requests;
+	/** Ids of the requests waiting to be written */
+	std::deque<uint32_t> writes;
+	bool writing{ false };
+	bool reading{ false };
+	std::shared_ptr<std::vector<uint8_t>> read_buffer;
+};
 
-	std::string action;
-	std::string body;
-	std::function<void(std::string const &)> response;
+/**
+ * IPC connection to the node carrying a single request whose response is streamed. A piece is read once the consumer has
+ * taken the one before, so a slow HTTP client holds back its own response and not the requests of others.
+ * The state is only accessed on the strand.
+ */
+class ipc_stream final : public std::enable_shared_from_this<nano::ipc_stream>
+{
+public:
+	ipc_stream (boost::asio::io_context &, std::shared_ptr<nano::rpc_request>);
+	void start (std::string const &, uint16_t);
+	void close ();
+
+private:
+	void read_next ();
+	void read_payload (uint32_t);
+	void failed (std::string const &);
+	boost::asio::strand<boost::asio::io_context::executor_type> strand;
+	/** Runs its completion handlers on the strand */
+	nano::ipc::ipc_client client;
+	std::shared_ptr<nano::rpc_request> request;
+	std::shared_ptr<std::vector<uint8_t>> read_buffer;
+	/** Set once the response has been completed, by the node or with an error */
+	bool done{ false };
 };
 
 class rpc_request_processor
@@ -46,20 +122,14 @@ public:
 	std::function<void()> stop_callback;
 
 private:
-	void run ();
-	void read_payload (std::shared_ptr<nano::ipc_connection> connection, std::shared_ptr<std::vector<uint8_t>> res, std::shared_ptr<nano::rpc_request> rpc_request);
-	void try_reconnect_and_execute_request (std::shared_ptr<nano::ipc_connection> connection, std::shared_ptr<std::vector<uint8_t>> req, std::shared_ptr<std::vector<uint8_t>> res, std::shared_ptr<nano::rpc_request> rpc_request);
-	void make_available (nano::ipc_connection & connection);
-
+	boost::asio::io_context & io_ctx;
+	std::string const address;
+	uint16_t const port;
 	std::vector<std::shared_ptr<nano::ipc_connection>> connections;
-	std::mutex request_mutex;
-	std::mutex connections_mutex;
+	/** Streams in progress, closed when stopping */
+	std::vector<std::weak_ptr<nano::ipc_stream>> streams;
 	bool stopped{ false };
-	std::deque<std::shared_ptr<nano::rpc_request>> requests;
-	std::condition_variable condition;
-	const std::string ipc_address;
-	const uint16_t ipc_port;
-	std::thread thread;
+	std::mutex streams_mutex;
 };
 
 class ipc_rpc_processor final : public nano::rpc_handler_interface
@@ -70,7 +140,7 @@ public:
 	{
 	}
 
-	void process_request (std::string const & action_a, std::string const & body_a, std::function<void(std::string const &)> response_a) override
+	void process_request (std::string const & action_a, std::string const & body_a, nano::rpc_response_chunk response_a) override
 	{
 		rpc_request_processor.add (std::make_shared<nano::rpc_request> (action_a, body_a, response_a));
 	}
@@ -2754,6 +2754,69 @@ TEST (rpc, block_count)
 	}
 }
 
+TEST (rpc, response_cache)
+{
+	nano::system system (24000, 1);
+	auto & node1 (*system.nodes[0]);
+	enable_ipc_transport_tcp (node1.config.ipc_config.transport_tcp);
+	nano::node_rpc_config node_rpc_config;
+	node_rpc_config.response_cache.enable = true;
+	nano::ipc::ipc_server ipc_server (node1, node_rpc_config);
+	nano::rpc_config rpc_config (true);
+	nano::ipc_rpc_processor ipc_rpc_processor (system.io_ctx, rpc_config);
+	nano::rpc rpc (system.io_ctx, rpc_config, ipc_rpc_processor);
+	rpc.start ();
+	boost::property_tree::ptree request1;
+	request1.put ("action", "block_count");
+	request1.put ("include_cemented", "true");
+	boost::property_tree::ptree request2;
+	request2.put ("include_cemented", "true");
+	request2.put ("action", "block_count");
+	// Member order does not matter
+	ASSERT_EQ (nano::json_response_cache::key (request1), nano::json_response_cache::key (request2));
+	{
+		test_response response1 (request1, rpc.config.port, system.io_ctx);
+		system.deadline_set (5s);
+		while (response1.status == 0)
+		{
+			ASSERT_NO_ERROR (system.poll ());
+		}
+		ASSERT_EQ (200, response1.status);
+		ASSERT_EQ ("1", response1.json.get<std::string> ("count"));
+		ASSERT_EQ (1, node1.stats.count (nano::stat::type::rpc_cache, nano::stat::detail::miss));
+		ASSERT_EQ (0, node1.stats.count (nano::stat::type::rpc_cache, nano::stat::detail::hit));
+	}
+	{
+		test_response response2 (request2, rpc.config.port, system.io_ctx);
+		system.deadline_set (5s);
+		while (response2.status == 0)
+		{
+			ASSERT_NO_ERROR (system.poll ());
+		}
+		ASSERT_EQ (200, response2.status);
+		ASSERT_EQ ("1", response2.json.get<std::string> ("count"));
+		ASSERT_EQ (1, node1.stats.count (nano::stat::type::rpc_cache, nano::stat::detail::miss));
+		ASSERT_EQ (1, node1.stats.count (nano::stat::type::rpc_cache, nano::stat::detail::hit));
+	}
+	// Writing to the ledger invalidates the response
+	nano::keypair key;
+	nano::genesis genesis;
+	nano::send_block send (genesis.hash (), key.pub, nano::genesis_amount - 1, nano::test_genesis_key.prv, nano::test_genesis_key.pub, system.work.generate (genesis.hash ()));
+	ASSERT_EQ (nano::process_result::progress, node1.process (send).code);
+	{
+		test_response response3 (request1, rpc.config.port, system.io_ctx);
+		system.deadline_set (5s);
+		while (response3.status == 0)
+		{
+			ASSERT_NO_ERROR (system.poll ());
+		}
+		ASSERT_EQ (200, response3.status);
+		ASSERT_EQ ("2", response3.json.get<std::string> ("count"));
+		ASSERT_EQ (2, node1.stats.count (nano::stat::type::rpc_cache, nano::stat::detail::miss));
+		ASSERT_EQ (1, node1.stats.count (nano::stat::type::rpc_cache, nano::stat::detail::hit));
+	}
+}
+
 TEST (rpc, frontier_count)
 {
 	nano::system system (24000, 1);
@@ -6642,3 +6705,97 @@ TEST (rpc_config, migrate)
 
 	ASSERT_EQ (rpc_config.port, 11111);
 }
+
+namespace
+{
+/**
+ * Stands in for the node at the other end of an ipc_connection. A multiplexed request is read from each of \p connections_a
+ * connections in turn. The request on the last connection is answered with \p answer_a if set, the others are closed unanswered.
+ */
+void ipc_node (boost::asio::io_context & io_ctx_a, boost::asio::ip::tcp::acceptor & acceptor_a, unsigned connections_a, boost::optional<std::string> const & answer_a, std::vector<std::string> & requests_a)
+{
+	for (auto i (0u); i < connections_a; ++i)
+	{
+		boost::asio::ip::tcp::socket socket (io_ctx_a);
+		acceptor_a.accept (socket);
+		// Preamble, request id and payload length
+		std::array<uint32_t, 3> header;
+		boost::asio::read (socket, boost::asio::buffer (header));
+		std::string body (boost::endian::big_to_native (header[2]), '\0');
+		boost::asio::read (socket, boost::asio::buffer (&body[0], body.size ()));
+		requests_a.push_back (body);
+		if (answer_a && i + 1 == connections_a)
+		{
+			std::array<uint32_t, 2> response_header{ { header[1], boost::endian::native_to_big (static_cast<uint32_t> (answer_a->size ())) } };
+			boost::asio::write (socket, boost::asio::buffer (response_header));
+			boost::asio::write (socket, boost::asio::buffer (*answer_a));
+		}
+	}
+}
+}
+
+TEST (rpc, ipc_connection_resend)
+{
+	nano::system system;
+	boost::asio::io_context node_io_ctx;
+	boost::asio::ip::tcp::acceptor acceptor (node_io_ctx, boost::asio::ip::tcp::endpoint (boost::asio::ip::address_v6::loopback (), 24078));
+	std::vector<std::string> requests;
+	// The first connection is closed after the request has been read, as the node does with an idle connection
+	std::string answer (R"({"count": "1"})");
+	std::thread node_thread ([&node_io_ctx, &acceptor, &answer, &requests]() {
+		ipc_node (node_io_ctx, acceptor, 2, answer, requests);
+	});
+	auto connection (std::make_shared<nano::ipc_connection> (system.io_ctx, "::1", 24078));
+	connection->connect ();
+	std::string response;
+	std::atomic<bool> done{ false };
+	connection->send (std::make_shared<nano::rpc_request> ("block_count", R"({"action": "block_count"})", [&response, &done](std::string const & body_a, bool last_a, std::function<void(bool)> const &) {
+		response += body_a;
+		done = last_a;
+	}));
+	system.deadline_set (5s);
+	while (!done)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	node_thread.join ();
+	// Resent unchanged over a new connection
+	ASSERT_EQ (2, requests.size ());
+	ASSERT_EQ (requests[0], requests[1]);
+	ASSERT_EQ (answer, response);
+	ASSERT_EQ (0, connection->outstanding);
+	connection->close ();
+}
+
+TEST (rpc, ipc_connection_resend_once)
+{
+	nano::system system;
+	boost::asio::io_context node_io_ctx;
+	boost::asio::ip::tcp::acceptor acceptor (node_io_ctx, boost::asio::ip::tcp::endpoint (boost::asio::ip::address_v6::loopback (), 24078));
+	std::vector<std::string> requests;
+	std::thread node_thread ([&node_io_ctx, &acceptor, &requests]() {
+		ipc_node (node_io_ctx, acceptor, 2, boost::none, requests);
+	});
+	auto connection (std::make_shared<nano::ipc_connection> (system.io_ctx, "::1", 24078));
+	connection->connect ();
+	std::string response;
+	std::atomic<bool> done{ false };
+	connection->send (std::make_shared<nano::rpc_request> ("block_count", R"({"action": "block_count"})", [&response, &done](std::string const & body_a, bool last_a, std::function<void(bool)> const &) {
+		response += body_a;
+		done = last_a;
+	}));
+	system.deadline_set (5s);
+	while (!done)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	node_thread.join ();
+	// A request is resent once, failing again answers it with an error
+	ASSERT_EQ (2, requests.size ());
+	boost::property_tree::ptree response_tree;
+	std::stringstream ss (response);
+	boost::property_tree::read_json (ss, response_tree);
+	ASSERT_TRUE (response_tree.get_optional<std::string> ("error").is_initialized ());
+	ASSERT_EQ (0, connection->outstanding);
+	connection->close ();
+}
@@ -79,6 +79,12 @@ public:
 		static_assert (std::is_standard_layout<nano::pending_info>::value, "Standard layout is required");
 	}
 
+	db_val (nano::pending_total const & val_a) :
+	db_val (sizeof (val_a), const_cast<nano::pending_total *> (&val_a))
+	{
+		static_assert (std::is_standard_layout<nano::pending_total>::value, "Standard layout is required");
+	}
+
 	db_val (nano::pending_key const & val_a) :
 	db_val (sizeof (val_a), const_cast<nano::pending_key *> (&val_a))
 	{
@@ -107,6 +113,12 @@ public:
 		static_assert (std::is_standard_layout<nano::endpoint_key>::value, "Standard layout is required");
 	}
 
+	db_val (nano::account_height_key const & val_a) :
+	db_val (sizeof (val_a), const_cast<nano::account_height_key *> (&val_a))
+	{
+		static_assert (std::is_standard_layout<nano::account_height_key>::value, "Standard layout is required");
+	}
+
 	db_val (std::shared_ptr<nano::block> const & val_a) :
 	buffer (std::make_shared<std::vector<uint8_t>> ())
 	{
@@ -163,6 +175,15 @@ public:
 		return result;
 	}
 
+	explicit operator nano::pending_total () const
+	{
+		nano::pending_total result;
+		assert (size () == sizeof (result));
+		static_assert (sizeof (nano::pending_total::amount) + sizeof (nano::pending_total::count) == sizeof (result), "Packed class");
+		std::copy (reinterpret_cast<uint8_t const *> (data ()), reinterpret_cast<uint8_t const *> (data ()) + sizeof (result), reinterpret_cast<uint8_t *> (&result));
+		return result;
+	}
+
 	explicit operator nano::pending_key () const
 	{
 		nano::pending_key result;
@@ -215,6 +236,14 @@ public:
 		return result;
 	}
 
+	explicit operator nano::account_height_key () const
+	{
+		nano::account_height_key result;
+		assert (size () == sizeof (result));
+		std::copy (reinterpret_cast<uint8_t const *> (data ()), reinterpret_cast<uint8_t const *> (data ()) + sizeof (result), reinterpret_cast<uint8_t *> (&result));
+		return result;
+	}
+
 	explicit operator nano::no_value () const
 	{
 		return no_value::dummy;
@@ -598,6 +627,8 @@ public:
 	virtual nano::store_iterator<nano::pending_key, nano::pending_info> pending_begin (nano::transaction const &, nano::pending_key const &) = 0;
 	virtual nano::store_iterator<nano::pending_key, nano::pending_info> pending_begin (nano::transaction const &) = 0;
 	virtual nano::store_iterator<nano::pending_key, nano::pending_info> pending_end () = 0;
+	/** Sum and number of the pending entries of an account, maintained by the pending put, append and delete functions */
+	virtual nano::pending_total pending_total_get (nano::transaction const &, nano::account const &) = 0;
 
 	virtual bool block_info_get (nano::transaction const &, nano::block_hash const &, nano::block_info &) const = 0;
 	virtual nano::uint128_t block_balance (nano::transaction const &, nano::block_hash const &) = 0;
@@ -610,6 +641,14 @@ public:
 	virtual nano::store_iterator<nano::account, nano::uint128_union> representation_begin (nano::transaction const &) = 0;
 	virtual nano::store_iterator<nano::account, nano::uint128_union> representation_end () = 0;
 
+	/** Secondary index of the accounts delegating to each representative, maintained alongside account_info.rep_block */
+	virtual void delegator_put (nano::transaction const &, nano::account const &, nano::account const &) = 0;
+	virtual void delegator_del (nano::transaction const &, nano::account const &, nano::account const &) = 0;
+	/** Iterates (representative, delegator) pairs starting at the first delegator of the representative, callers stop once the key changes */
+	virtual nano::store_iterator<nano::account, nano::account> delegators_begin (nano::transaction const &, nano::account const &) = 0;
+	virtual nano::store_iterator<nano::account, nano::account> delegators_end () = 0;
+	virtual size_t delegators_count (nano::transaction const &, nano::account const &) = 0;
+
 	virtual void unchecked_clear (nano::transaction const &) = 0;
 	virtual void unchecked_put (nano::transaction const &, nano::unchecked_key const &, nano::unchecked_info const &) = 0;
 	virtual void unchecked_put (nano::transaction const &, nano::block_hash const &, std::shared_ptr<nano::block> const &) = 0;
@@ -652,7 +691,27 @@ public:
 	virtual nano::store_iterator<nano::endpoint_key, nano::no_value> peers_end () = 0;
 
 	virtual uint64_t block_account_height (nano::transaction const & transaction_a, nano::block_hash const & hash_a) const = 0;
+
+	/** Secondary index of the blocks of each account by height, maintained by block_import and block_del */
+	virtual void account_height_put (nano::transaction const &, nano::account_height_key const &, nano::block_hash const &) = 0;
+	virtual void account_height_del (nano::transaction const &, nano::account_height_key const &) = 0;
+	/** Returns the block of \p account_a at \p height_a, zero if the chain is shorter */
+	virtual nano::block_hash block_at_height (nano::transaction const &, nano::account const & account_a, uint64_t height_a) const = 0;
+	/** Iterates the blocks of accounts in ascending height starting at the key, callers stop once the account changes */
+	virtual nano::store_iterator<nano::account_height_key, nano::block_hash> account_heights_begin (nano::transaction const &, nano::account_height_key const &) = 0;
+	virtual nano::store_iterator<nano::account_height_key, nano::block_hash> account_heights_end () = 0;
+
+	/** Empties the block, account, pending, representation, delegator and frontier tables and their indexes ahead of importing a ledger snapshot */
+	virtual void ledger_clear (nano::transaction const &) = 0;
+	/** Stores a block with an already complete sideband, unlike block_put the predecessor is not modified */
+	virtual void block_import (nano::transaction const &, nano::block_hash const &, nano::block const &, nano::block_sideband const &, nano::epoch = nano::epoch::epoch_0) = 0;
+	/** Bulk loading variants of the put functions, keys must be supplied in ascending order and be greater than any already stored */
+	virtual void account_append (nano::transaction const &, nano::account const &, nano::account_info const &) = 0;
+	virtual void pending_append (nano::transaction const &, nano::pending_key const &, nano::pending_info const &) = 0;
+	virtual void representation_append (nano::transaction const &, nano::account const &, nano::uint128_t const &) = 0;
 	virtual void serialize_mdb_tracker (boost::property_tree::ptree &, std::chrono::milliseconds, std::chrono::milliseconds) = 0;
+	/** Incremented after every committed write transaction, an unchanged value means nothing was written in between */
+	virtual uint64_t generation () const = 0;
 
 	/** Start read-write transaction */
 	virtual nano::write_transaction tx_begin_write () = 0;
@@ -689,6 +748,7 @@ public:
 		block_put (transaction_a, hash_l, *genesis_a.open, sideband);
 		account_put (transaction_a, network_params.ledger.genesis_account, { hash_l, genesis_a.open->hash (), genesis_a.open->hash (), std::numeric_limits<nano::uint128_t>::max (), nano::seconds_since_epoch (), 1, 1, nano::epoch::epoch_0 });
 		representation_put (transaction_a, network_params.ledger.genesis_account, std::numeric_limits<nano::uint128_t>::max ());
+		delegator_put (transaction_a, network_params.ledger.genesis_account, network_params.ledger.genesis_account);
 		frontier_put (transaction_a, hash_l, network_params.ledger.genesis_account);
 	}
 
@@ -752,8 +812,16 @@ public:
 
 	void block_put (nano::transaction const & transaction_a, nano::block_hash const & hash_a, nano::block const & block_a, nano::block_sideband const & sideband_a, nano::epoch epoch_a = nano::epoch::epoch_0) override
 	{
-		assert (block_a.type () == sideband_a.type);
 		assert (sideband_a.successor.is_zero () || block_exists (transaction_a, sideband_a.successor));
+		block_import (transaction_a, hash_a, block_a, sideband_a, epoch_a);
+		nano::block_predecessor_set<Val> predecessor (transaction_a, *this);
+		block_a.visit (predecessor);
+		assert (block_a.previous ().is_zero () || block_successor (transaction_a, block_a.previous ()) == hash_a);
+	}
+
+	void block_import (nano::transaction const & transaction_a, nano::block_hash const & hash_a, nano::block const & block_a, nano::block_sideband const & sideband_a, nano::epoch epoch_a = nano::epoch::epoch_0) override
+	{
+		assert (block_a.type () == sideband_a.type);
 		std::vector<uint8_t> vector;
 		{
 			nano::vectorstream stream (vector);
@@ -761,18 +829,42 @@ public:
 			sideband_a.serialize (stream);
 		}
 		block_raw_put (transaction_a, vector, block_a.type (), epoch_a, hash_a);
-		nano::block_predecessor_set<Val> predecessor (transaction_a, *this);
-		block_a.visit (predecessor);
-		assert (block_a.previous ().is_zero () || block_successor (transaction_a, block_a.previous ()) == hash_a);
+		// A zero height is not known yet, these entries are indexed once the sideband is upgraded
+		if (sideband_a.height != 0)
+		{
+			auto account (block_a.account ().is_zero () ? sideband_a.account : block_a.account ());
+			account_height_put (transaction_a, nano::account_height_key (account, sideband_a.height), hash_a);
+		}
 	}
 
-	// Converts a block hash to a block height
+	// Converts a block hash to a block height, read straight from the sideband without deserializing the block
 	uint64_t block_account_height (nano::transaction const & transaction_a, nano::block_hash const & hash_a) const override
 	{
-		nano::block_sideband sideband;
-		auto block = block_get (transaction_a, hash_a, &sideband);
-		assert (block != nullptr);
-		return sideband.height;
+		uint64_t result (0);
+		nano::block_type type;
+		auto value (block_raw_get (transaction_a, hash_a, type));
+		assert (value.size () != 0);
+		if (entry_has_sideband (value.size (), type))
+		{
+			if (type == nano::block_type::open)
+			{
+				result = 1;
+			}
+			else
+			{
+				auto offset (value.size () - nano::block_sideband::size (type) + sizeof (nano::block_hash));
+				if (type != nano::block_type::state)
+				{
+					offset += sizeof (nano::account);
+				}
+				nano::bufferstream stream (reinterpret_cast<uint8_t const *> (value.data ()) + offset, sizeof (result));
+				auto error (nano::try_read (stream, result));
+				(void)error;
+				assert (!error);
+				boost::endian::big_to_native_inplace (result);
+			}
+		}
+		return result;
 	}
 
 	std::shared_ptr<nano::block> block_get (nano::transaction const & transaction_a, nano::block_hash const & hash_a, nano::block_sideband * sideband_a = nullptr) const override
@@ -992,6 +1084,29 @@ protected:
 		return entry_size_a == nano::block::size (type_a) + nano::block_sideband::size (type_a);
 	}
 
+	/** Removes the height index entry of a block which is about to be deleted */
+	void account_height_unindex (nano::transaction const & transaction_a, nano::block_hash const & hash_a)
+	{
+		nano::block_type type;
+		auto value (block_raw_get (transaction_a, hash_a, type));
+		if (entry_has_sideband (value.size (), type))
+		{
+			nano::bufferstream stream (reinterpret_cast<uint8_t const *> (value.data ()), value.size ());
+			auto block (nano::deserialize_block (stream, type));
+			assert (block != nullptr);
+			nano::block_sideband sideband;
+			sideband.type = type;
+			auto error (sideband.deserialize (stream));
+			(void)error;
+			assert (!error);
+			auto account (block->account ().is_zero () ? sideband.account : block->account ());
+			if (sideband.height != 0 && block_at_height (transaction_a, account, sideband.height) == hash_a)
+			{
+				account_height_del (transaction_a, nano::account_height_key (account, sideband.height));
+			}
+		}
+	}
+
 	nano::db_val<Val> block_raw_get (nano::transaction const & transaction_a, nano::block_hash const & hash_a, nano::block_type & type_a) const
 	{
 		nano::db_val<Val> result;
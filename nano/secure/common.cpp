@@ -186,6 +186,17 @@ epoch (epoch_a)
 {
 }
 
+void nano::account_info::serialize (nano::stream & stream_a) const
+{
+	nano::write (stream_a, head.bytes);
+	nano::write (stream_a, rep_block.bytes);
+	nano::write (stream_a, open_block.bytes);
+	nano::write (stream_a, balance.bytes);
+	nano::write (stream_a, modified);
+	nano::write (stream_a, block_count);
+	nano::write (stream_a, confirmation_height);
+}
+
 bool nano::account_info::deserialize (nano::stream & stream_a)
 {
 	auto error (false);
@@ -241,6 +252,12 @@ epoch (epoch_a)
 {
 }
 
+void nano::pending_info::serialize (nano::stream & stream_a) const
+{
+	nano::write (stream_a, source.bytes);
+	nano::write (stream_a, amount.bytes);
+}
+
 bool nano::pending_info::deserialize (nano::stream & stream_a)
 {
 	auto error (false);
@@ -262,12 +279,29 @@ bool nano::pending_info::operator== (nano::pending_info const & other_a) const
 	return source == other_a.source && amount == other_a.amount && epoch == other_a.epoch;
 }
 
+nano::pending_total::pending_total (nano::amount const & amount_a, uint64_t count_a) :
+amount (amount_a),
+count (count_a)
+{
+}
+
+bool nano::pending_total::operator== (nano::pending_total const & other_a) const
+{
+	return amount == other_a.amount && count == other_a.count;
+}
+
 nano::pending_key::pending_key (nano::account const & account_a, nano::block_hash const & hash_a) :
 account (account_a),
 hash (hash_a)
 {
 }
 
+void nano::pending_key::serialize (nano::stream & stream_a) const
+{
+	nano::write (stream_a, account.bytes);
+	nano::write (stream_a, hash.bytes);
+}
+
 bool nano::pending_key::deserialize (nano::stream & stream_a)
 {
 	auto error (false);
@@ -289,6 +323,11 @@ bool nano::pending_key::operator== (nano::pending_key const & other_a) const
 	return account == other_a.account && hash == other_a.hash;
 }
 
+bool nano::pending_key::operator< (nano::pending_key const & other_a) const
+{
+	return account == other_a.account ? hash < other_a.hash : account < other_a.account;
+}
+
 nano::block_hash nano::pending_key::key () const
 {
 	return account;
@@ -346,6 +385,22 @@ uint16_t nano::endpoint_key::port () const
 	return boost::endian::big_to_native (network_port);
 }
 
+nano::account_height_key::account_height_key (nano::account const & account_a, uint64_t height_a) :
+account_m (account_a),
+height_m (boost::endian::native_to_big (height_a))
+{
+}
+
+nano::account const & nano::account_height_key::account () const
+{
+	return account_m;
+}
+
+uint64_t nano::account_height_key::height () const
+{
+	return boost::endian::big_to_native (height_m);
+}
+
 nano::block_info::block_info (nano::account const & account_a, nano::amount const & balance_a) :
 account (account_a),
 balance (balance_a)
@@ -681,47 +736,13 @@ std::shared_ptr<nano::vote> nano::vote_uniquer::unique (std::shared_ptr<nano::vo
 		{
 			result->blocks.front () = uniquer.unique (boost::get<std::shared_ptr<nano::block>> (result->blocks.front ()));
 		}
-		nano::uint256_union key (vote_a->full_hash ());
-		std::lock_guard<std::mutex> lock (mutex);
-		auto & existing (votes[key]);
-		if (auto block_l = existing.lock ())
-		{
-			result = block_l;
-		}
-		else
-		{
-			existing = vote_a;
-		}
-
-		release_assert (std::numeric_limits<CryptoPP::word32>::max () > votes.size ());
-		for (auto i (0); i < cleanup_count && !votes.empty (); ++i)
-		{
-			auto random_offset = nano::random_pool::generate_word32 (0, static_cast<CryptoPP::word32> (votes.size () - 1));
-
-			auto existing (std::next (votes.begin (), random_offset));
-			if (existing == votes.end ())
-			{
-				existing = votes.begin ();
-			}
-			if (existing != votes.end ())
-			{
-				if (auto block_l = existing->second.lock ())
-				{
-					// Still live
-				}
-				else
-				{
-					votes.erase (existing);
-				}
-			}
-		}
+		result = votes.unique (vote_a->full_hash (), vote_a);
 	}
 	return result;
 }
 
 size_t nano::vote_uniquer::size ()
 {
-	std::lock_guard<std::mutex> lock (mutex);
 	return votes.size ();
 }
 
@@ -85,6 +85,7 @@ class account_info final
 public:
 	account_info () = default;
 	account_info (nano::block_hash const &, nano::block_hash const &, nano::block_hash const &, nano::amount const &, uint64_t, uint64_t, uint64_t, epoch);
+	void serialize (nano::stream &) const;
 	bool deserialize (nano::stream &);
 	bool operator== (nano::account_info const &) const;
 	bool operator!= (nano::account_info const &) const;
@@ -108,19 +109,35 @@ class pending_info final
 public:
 	pending_info () = default;
 	pending_info (nano::account const &, nano::amount const &, epoch);
+	void serialize (nano::stream &) const;
 	bool deserialize (nano::stream &);
 	bool operator== (nano::pending_info const &) const;
 	nano::account source{ 0 };
 	nano::amount amount{ 0 };
 	nano::epoch epoch{ nano::epoch::epoch_0 };
 };
+/**
+ * Sum and number of the uncollected sends to an account
+ */
+class pending_total final
+{
+public:
+	pending_total () = default;
+	pending_total (nano::amount const &, uint64_t);
+	bool operator== (nano::pending_total const &) const;
+	nano::amount amount{ 0 };
+	uint64_t count{ 0 };
+};
 class pending_key final
 {
 public:
 	pending_key () = default;
 	pending_key (nano::account const &, nano::block_hash const &);
+	void serialize (nano::stream &) const;
 	bool deserialize (nano::stream &);
 	bool operator== (nano::pending_key const &) const;
+	/** Orders keys the same way they are sorted in the pending tables */
+	bool operator< (nano::pending_key const &) const;
 	nano::block_hash key () const;
 	nano::account account{ 0 };
 	nano::block_hash hash{ 0 };
@@ -153,6 +170,23 @@ private:
 	uint16_t network_port{ 0 };
 };
 
+/**
+ * Key of the account height index, sorts the blocks of each account by height
+ */
+class account_height_key final
+{
+public:
+	account_height_key () = default;
+	account_height_key (nano::account const &, uint64_t);
+	nano::account const & account () const;
+	uint64_t height () const;
+
+private:
+	nano::account account_m{ 0 };
+	// Stored in big endian so keys are ordered by height
+	uint64_t height_m{ 0 };
+};
+
 enum class no_value
 {
 	dummy
@@ -253,7 +287,7 @@ public:
 class vote_uniquer final
 {
 public:
-	using value_type = std::pair<const nano::uint256_union, std::weak_ptr<nano::vote>>;
+	using value_type = nano::sharded_uniquer<nano::vote>::value_type;
 
 	vote_uniquer (nano::block_uniquer &);
 	std::shared_ptr<nano::vote> unique (std::shared_ptr<nano::vote>);
@@ -261,9 +295,7 @@ public:
 
 private:
 	nano::block_uniquer & uniquer;
-	std::mutex mutex;
-	std::unordered_map<std::remove_const_t<value_type::first_type>, value_type::second_type> votes;
-	static unsigned constexpr cleanup_count = 2;
+	nano::sharded_uniquer<nano::vote> votes;
 };
 
 std::unique_ptr<seq_con_info_component> collect_seq_con_info (vote_uniquer & vote_uniquer, const std::string & name);
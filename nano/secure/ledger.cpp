@@ -89,8 +89,8 @@ public:
 		auto balance (ledger.balance (transaction, block_a.hashables.previous));
 		ledger.store.representation_add (transaction, representative, balance);
 		ledger.store.representation_add (transaction, hash, 0 - balance);
-		ledger.store.block_del (transaction, hash);
 		ledger.change_latest (transaction, account, block_a.hashables.previous, representative, info.balance, info.block_count - 1);
+		ledger.store.block_del (transaction, hash);
 		ledger.store.frontier_del (transaction, hash);
 		ledger.store.frontier_put (transaction, block_a.hashables.previous, account);
 		ledger.store.block_successor_clear (transaction, block_a.hashables.previous);
@@ -698,19 +698,7 @@ nano::uint128_t nano::ledger::account_balance (nano::transaction const & transac
 
 nano::uint128_t nano::ledger::account_pending (nano::transaction const & transaction_a, nano::account const & account_a)
 {
-	nano::uint128_t result (0);
-	nano::account end (account_a.number () + 1);
-	for (auto i (store.pending_v0_begin (transaction_a, nano::pending_key (account_a, 0))), n (store.pending_v0_begin (transaction_a, nano::pending_key (end, 0))); i != n; ++i)
-	{
-		nano::pending_info const & info (i->second);
-		result += info.amount.number ();
-	}
-	for (auto i (store.pending_v1_begin (transaction_a, nano::pending_key (account_a, 0))), n (store.pending_v1_begin (transaction_a, nano::pending_key (end, 0))); i != n; ++i)
-	{
-		nano::pending_info const & info (i->second);
-		result += info.amount.number ();
-	}
-	return result;
+	return store.pending_total_get (transaction_a, account_a).amount.number ();
 }
 
 nano::process_return nano::ledger::process (nano::transaction const & transaction_a, nano::block const & block_a, nano::signature_verification verification)
@@ -905,6 +893,44 @@ nano::block_hash nano::ledger::latest (nano::transaction const & transaction_a,
 	return latest_error ? 0 : info.head;
 }
 
+nano::block_hash nano::ledger::block_at_distance (nano::transaction const & transaction_a, nano::account const & account_a, nano::block_hash const & hash_a, uint64_t distance_a, bool forward_a)
+{
+	nano::block_hash result (hash_a);
+	if (distance_a > 0 && !hash_a.is_zero ())
+	{
+		auto height (store.block_account_height (transaction_a, hash_a));
+		if (height != 0)
+		{
+			if (forward_a ? distance_a <= std::numeric_limits<uint64_t>::max () - height : distance_a < height)
+			{
+				result = store.block_at_height (transaction_a, account_a, forward_a ? height + distance_a : height - distance_a);
+			}
+			else
+			{
+				result.clear ();
+			}
+		}
+		else
+		{
+			// Blocks without a height are not indexed, walk the chain instead
+			for (; distance_a > 0 && !result.is_zero (); --distance_a)
+			{
+				if (forward_a)
+				{
+					result = store.block_successor (transaction_a, result);
+				}
+				else
+				{
+					auto block (store.block_get (transaction_a, result));
+					assert (block != nullptr);
+					result = block->previous ();
+				}
+			}
+		}
+	}
+	return result;
+}
+
 // Return latest root for account, account number of there are no blocks for this account.
 nano::block_hash nano::ledger::latest_root (nano::transaction const & transaction_a, nano::account const & account_a)
 {
@@ -995,6 +1021,25 @@ void nano::ledger::change_latest (nano::transaction const & transaction_a, nano:
 		assert (store.block_get (transaction_a, hash_a)->previous ().is_zero ());
 		info.open_block = hash_a;
 	}
+	// The rep blocks must still be stored, so rollbacks delete their block after calling this
+	auto old_rep_block (exists ? info.rep_block : nano::block_hash (0));
+	auto new_rep_block (hash_a.is_zero () ? nano::block_hash (0) : rep_block_a);
+	if (old_rep_block != new_rep_block)
+	{
+		auto old_representative (old_rep_block.is_zero () ? nano::account (0) : store.block_get (transaction_a, old_rep_block)->representative ());
+		auto new_representative (new_rep_block.is_zero () ? nano::account (0) : store.block_get (transaction_a, new_rep_block)->representative ());
+		if (old_representative != new_representative)
+		{
+			if (!old_representative.is_zero ())
+			{
+				store.delegator_del (transaction_a, old_representative, account_a);
+			}
+			if (!new_representative.is_zero ())
+			{
+				store.delegator_put (transaction_a, new_representative, account_a);
+			}
+		}
+	}
 	if (!hash_a.is_zero ())
 	{
 		info.head = hash_a;
@@ -31,6 +31,8 @@ public:
 	bool block_not_confirmed_or_not_exists (nano::block const & block_a) const;
 	nano::block_hash latest (nano::transaction const &, nano::account const &);
 	nano::block_hash latest_root (nano::transaction const &, nano::account const &);
+	/** Returns the block \p distance_a blocks before \p hash_a in the chain of \p account_a, or after it if \p forward_a, zero past either end */
+	nano::block_hash block_at_distance (nano::transaction const &, nano::account const &, nano::block_hash const &, uint64_t, bool);
 	nano::block_hash representative (nano::transaction const &, nano::block_hash const &);
 	nano::block_hash representative_calculated (nano::transaction const &, nano::block_hash const &);
 	bool block_exists (nano::block_hash const &);
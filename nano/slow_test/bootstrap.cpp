@@ -0,0 +1,234 @@
+#include <nano/core_test/testutil.hpp>
+#include <nano/node/testing.hpp>
+#include <nano/node/transport/udp.hpp>
+
+#include <gtest/gtest.h>
+
+#include <boost/property_tree/json_parser.hpp>
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#ifdef __APPLE__
+#include <mach/mach.h>
+#elif !defined(_WIN32)
+#include <unistd.h>
+#endif
+
+using namespace std::chrono_literals;
+
+namespace
+{
+size_t env_size (char const * name_a, size_t default_a)
+{
+	auto value (std::getenv (name_a));
+	return value != nullptr ? std::stoull (value) : default_a;
+}
+
+/**
+ * Shape of the synthetic ledger, each value can be overridden through the environment:
+ * NANO_BOOTSTRAP_BENCHMARK_ACCOUNTS, NANO_BOOTSTRAP_BENCHMARK_CHAIN_LENGTH and NANO_BOOTSTRAP_BENCHMARK_PENDING
+ */
+class bootstrap_benchmark_shape final
+{
+public:
+	bootstrap_benchmark_shape () :
+	accounts (env_size ("NANO_BOOTSTRAP_BENCHMARK_ACCOUNTS", 1000)),
+	chain_length (env_size ("NANO_BOOTSTRAP_BENCHMARK_CHAIN_LENGTH", 10)),
+	pending (env_size ("NANO_BOOTSTRAP_BENCHMARK_PENDING", 1000))
+	{
+	}
+	/** Accounts opened from genesis sends */
+	size_t accounts;
+	/** Blocks in each of those accounts, including the open block */
+	size_t chain_length;
+	/** Genesis sends to accounts which are never opened */
+	size_t pending;
+};
+
+/** Current resident set size of the whole process, zero where it can't be read */
+uint64_t resident_memory_kb ()
+{
+	uint64_t result (0);
+#ifdef __APPLE__
+	mach_task_basic_info info;
+	mach_msg_type_number_t count (MACH_TASK_BASIC_INFO_COUNT);
+	if (task_info (mach_task_self (), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t> (&info), &count) == KERN_SUCCESS)
+	{
+		result = info.resident_size / 1024;
+	}
+#elif !defined(_WIN32)
+	// Second field is the number of resident pages
+	std::ifstream statm ("/proc/self/statm");
+	uint64_t size (0);
+	uint64_t resident (0);
+	if (statm >> size >> resident)
+	{
+		result = resident * sysconf (_SC_PAGESIZE) / 1024;
+	}
+#endif
+	return result;
+}
+
+void generate_ledger (nano::node & node_a, bootstrap_benchmark_shape const & shape_a, std::vector<nano::block_hash> & frontiers_a)
+{
+	auto genesis_head (node_a.latest (nano::test_genesis_key.pub));
+	nano::uint128_t balance (nano::genesis_amount);
+	auto transaction (node_a.store.tx_begin_write ());
+	for (size_t i (0); i < shape_a.accounts; ++i)
+	{
+		nano::keypair key;
+		balance -= nano::Gxrb_ratio;
+		nano::state_block send (nano::test_genesis_key.pub, genesis_head, nano::test_genesis_key.pub, balance, key.pub, nano::test_genesis_key.prv, nano::test_genesis_key.pub, node_a.work.generate (genesis_head));
+		ASSERT_EQ (nano::process_result::progress, node_a.ledger.process (transaction, send).code);
+		genesis_head = send.hash ();
+		nano::state_block open (key.pub, 0, key.pub, nano::Gxrb_ratio, send.hash (), key.prv, key.pub, node_a.work.generate (key.pub));
+		ASSERT_EQ (nano::process_result::progress, node_a.ledger.process (transaction, open).code);
+		auto head (open.hash ());
+		for (size_t j (1); j < shape_a.chain_length; ++j)
+		{
+			// Alternate the representative to extend the chain without moving funds
+			nano::state_block change (key.pub, head, (j % 2) ? nano::test_genesis_key.pub : key.pub, nano::Gxrb_ratio, 0, key.prv, key.pub, node_a.work.generate (head));
+			ASSERT_EQ (nano::process_result::progress, node_a.ledger.process (transaction, change).code);
+			head = change.hash ();
+		}
+		frontiers_a.push_back (head);
+	}
+	for (size_t i (0); i < shape_a.pending; ++i)
+	{
+		nano::keypair key;
+		balance -= 1;
+		nano::state_block send (nano::test_genesis_key.pub, genesis_head, nano::test_genesis_key.pub, balance, key.pub, nano::test_genesis_key.prv, nano::test_genesis_key.pub, node_a.work.generate (genesis_head));
+		ASSERT_EQ (nano::process_result::progress, node_a.ledger.process (transaction, send).code);
+		genesis_head = send.hash ();
+	}
+	frontiers_a.push_back (genesis_head);
+}
+
+uint64_t elapsed_ms (std::chrono::steady_clock::time_point const & begin_a, std::chrono::steady_clock::time_point const & end_a)
+{
+	return std::chrono::duration_cast<std::chrono::milliseconds> (end_a - begin_a).count ();
+}
+
+/**
+ * Bootstraps a second node over loopback from a node holding the synthetic ledger and reports the results as a single line of JSON.
+ * The line is printed and, if NANO_BOOTSTRAP_BENCHMARK_OUTPUT is set, appended to that file so results can be tracked over time.
+ */
+void run_bootstrap_benchmark (nano::bootstrap_mode mode_a, unsigned work_validation_threads_a = nano::node_config ().bootstrap_work_validation_threads)
+{
+	nano::system system (24000, 1);
+	auto node0 (system.nodes[0]);
+	bootstrap_benchmark_shape shape;
+	std::vector<nano::block_hash> frontiers;
+	auto generate_begin (std::chrono::steady_clock::now ());
+	generate_ledger (*node0, shape, frontiers);
+	ASSERT_FALSE (::testing::Test::HasFatalFailure ());
+	auto generate_end (std::chrono::steady_clock::now ());
+	size_t block_count (node0->store.block_count (node0->store.tx_begin_read ()).sum ());
+
+	// Lazy bootstrap accepts only 1024 start blocks (32k with legacy bootstrap disabled), disable legacy for the lazy run so no frontiers are dropped
+	nano::node_flags flags;
+	flags.disable_legacy_bootstrap = mode_a != nano::bootstrap_mode::legacy;
+	ASSERT_TRUE (!flags.disable_legacy_bootstrap || frontiers.size () <= 32 * 1024);
+	// Memory is reported relative to this baseline so it covers only the node being bootstrapped, not node0 or earlier runs
+	auto memory_baseline (resident_memory_kb ());
+	nano::node_init init1;
+	nano::node_config config1 (24001, system.logging);
+	config1.bootstrap_work_validation_threads = work_validation_threads_a;
+	auto node1 (std::make_shared<nano::node> (init1, system.io_ctx, nano::unique_path (), system.alarm, config1, system.work, flags));
+	auto begin (std::chrono::steady_clock::now ());
+	if (mode_a == nano::bootstrap_mode::legacy)
+	{
+		node1->bootstrap_initiator.bootstrap (node0->network.endpoint ());
+	}
+	else
+	{
+		node1->network.udp_channels.insert (node0->network.endpoint (), nano::protocol_version);
+		for (auto const & frontier : frontiers)
+		{
+			node1->bootstrap_initiator.bootstrap_lazy (frontier);
+		}
+	}
+	auto first_block (begin);
+	auto complete (begin);
+	auto next_sample (begin);
+	size_t unchecked_peak (0);
+	uint64_t memory_peak (0);
+	size_t received (1);
+	system.deadline_set (std::chrono::seconds (60 + block_count / 100));
+	while (received < block_count)
+	{
+		ASSERT_NO_ERROR (system.poll ());
+		auto now (std::chrono::steady_clock::now ());
+		if (now >= next_sample)
+		{
+			auto transaction (node1->store.tx_begin_read ());
+			unchecked_peak = std::max (unchecked_peak, node1->store.unchecked_count (transaction));
+			memory_peak = std::max (memory_peak, resident_memory_kb ());
+			auto received_l (node1->store.block_count (transaction).sum ());
+			if (received == 1 && received_l > 1)
+			{
+				first_block = now;
+			}
+			received = received_l;
+			complete = now;
+			next_sample = now + 100ms;
+		}
+	}
+	while (node1->bootstrap_initiator.in_progress ())
+	{
+		ASSERT_NO_ERROR (system.poll ());
+	}
+	auto finished (std::chrono::steady_clock::now ());
+
+	boost::property_tree::ptree result;
+	result.put ("benchmark", "bootstrap");
+	result.put ("mode", mode_a == nano::bootstrap_mode::legacy ? "legacy" : "lazy");
+	result.put ("timestamp", nano::seconds_since_epoch ());
+	result.put ("accounts", shape.accounts);
+	result.put ("chain_length", shape.chain_length);
+	result.put ("pending", shape.pending);
+	result.put ("work_validation_threads", work_validation_threads_a);
+	result.put ("blocks", block_count);
+	result.put ("blocks_per_second", (block_count - 1) * 1000 / std::max<uint64_t> (elapsed_ms (begin, complete), 1));
+	// Sampled along with the other counters, so short lived spikes between samples are missed
+	result.put ("memory_growth_peak_kb", memory_peak > memory_baseline ? memory_peak - memory_baseline : 0);
+	result.put ("unchecked_peak", unchecked_peak);
+	boost::property_tree::ptree phases;
+	phases.put ("generate_ms", elapsed_ms (generate_begin, generate_end));
+	phases.put ("first_block_ms", elapsed_ms (begin, first_block));
+	phases.put ("ledger_complete_ms", elapsed_ms (begin, complete));
+	phases.put ("attempt_finished_ms", elapsed_ms (begin, finished));
+	result.add_child ("phases", phases);
+	std::stringstream output;
+	boost::property_tree::write_json (output, result, false);
+	std::cout << output.str ();
+	auto path (std::getenv ("NANO_BOOTSTRAP_BENCHMARK_OUTPUT"));
+	if (path != nullptr)
+	{
+		std::ofstream file (path, std::ios::app);
+		file << output.str ();
+	}
+	node1->stop ();
+}
+}
+
+TEST (bootstrap_benchmark, legacy)
+{
+	run_bootstrap_benchmark (nano::bootstrap_mode::legacy);
+}
+
+TEST (bootstrap_benchmark, lazy)
+{
+	run_bootstrap_benchmark (nano::bootstrap_mode::lazy);
+}
+
+/**
+ * Legacy bootstrap with a single work validation thread, which is how pulled blocks were validated before the pool.
+ * Compare its blocks_per_second with bootstrap_benchmark.legacy, which uses the default pool size.
+ */
+TEST (bootstrap_benchmark, legacy_single_work_validation_thread)
+{
+	run_bootstrap_benchmark (nano::bootstrap_mode::legacy, 1);
+}
@@ -739,3 +739,207 @@ TEST (confirmation_height, prioritize_frontiers_overwrite)
 	ASSERT_NE (node->active.priority_cementable_frontiers.find (key.pub), node->active.priority_cementable_frontiers.end ());
 }
 }
+
+// Reports the cost of block_processor::process_one for blocks arriving with an empty hash cache, alongside the cost of each hash () call it no longer recomputes
+TEST (block_processor, process_one_benchmark)
+{
+	nano::system system (24000, 1);
+	auto & node (*system.nodes[0]);
+	size_t const count (10000);
+	std::vector<std::vector<uint8_t>> serialized;
+	serialized.reserve (count);
+	auto latest (node.latest (nano::test_genesis_key.pub));
+	nano::uint128_t balance (nano::genesis_amount);
+	for (size_t i (0); i < count; ++i)
+	{
+		nano::keypair key;
+		balance -= 1;
+		nano::state_block send (nano::test_genesis_key.pub, latest, nano::test_genesis_key.pub, balance, key.pub, nano::test_genesis_key.prv, nano::test_genesis_key.pub, system.work.generate (latest));
+		latest = send.hash ();
+		serialized.emplace_back ();
+		nano::vectorstream stream (serialized.back ());
+		send.serialize (stream);
+	}
+	std::vector<std::shared_ptr<nano::block>> blocks;
+	blocks.reserve (count);
+	for (auto const & bytes : serialized)
+	{
+		nano::bufferstream stream (bytes.data (), bytes.size ());
+		blocks.push_back (nano::deserialize_block (stream, nano::block_type::state));
+		ASSERT_NE (nullptr, blocks.back ());
+	}
+	auto begin (std::chrono::steady_clock::now ());
+	{
+		auto transaction (node.store.tx_begin_write ());
+		for (auto const & block : blocks)
+		{
+			ASSERT_EQ (nano::process_result::progress, node.block_processor.process_one (transaction, block).code);
+		}
+	}
+	auto process_ns (std::chrono::duration_cast<std::chrono::nanoseconds> (std::chrono::steady_clock::now () - begin).count ());
+	auto & block (*blocks.back ());
+	nano::block_hash hash;
+	begin = std::chrono::steady_clock::now ();
+	for (size_t i (0); i < count; ++i)
+	{
+		block.refresh ();
+		hash = block.hash ();
+	}
+	auto uncached_ns (std::chrono::duration_cast<std::chrono::nanoseconds> (std::chrono::steady_clock::now () - begin).count ());
+	begin = std::chrono::steady_clock::now ();
+	for (size_t i (0); i < count; ++i)
+	{
+		hash = block.hash ();
+	}
+	auto cached_ns (std::chrono::duration_cast<std::chrono::nanoseconds> (std::chrono::steady_clock::now () - begin).count ());
+	ASSERT_EQ (latest, hash);
+	std::cout << boost::str (boost::format ("{\"benchmark\": \"process_one\", \"blocks\": %1%, \"process_one_ns\": %2%, \"hash_uncached_ns\": %3%, \"hash_cached_ns\": %4%}\n") % count % (process_ns / count) % (uncached_ns / count) % (cached_ns / count));
+}
+
+namespace
+{
+/** Signature check set over messages, keys and signatures it owns */
+class owned_check_set final
+{
+public:
+	void add (nano::uint256_union const & message_a, nano::account const & account_a, nano::signature const & signature_a)
+	{
+		hashes.push_back (message_a);
+		accounts.push_back (account_a);
+		signatures.push_back (signature_a);
+	}
+	nano::signature_check_set & set ()
+	{
+		auto size (hashes.size ());
+		messages.clear ();
+		pub_keys.clear ();
+		signature_pointers.clear ();
+		for (size_t i (0); i < size; ++i)
+		{
+			messages.push_back (hashes[i].bytes.data ());
+			pub_keys.push_back (accounts[i].bytes.data ());
+			signature_pointers.push_back (signatures[i].bytes.data ());
+		}
+		lengths.assign (size, sizeof (nano::uint256_union));
+		verifications.assign (size, 0);
+		check = std::make_unique<nano::signature_check_set> (size, messages.data (), lengths.data (), pub_keys.data (), signature_pointers.data (), verifications.data ());
+		return *check;
+	}
+	bool all_valid () const
+	{
+		return std::all_of (verifications.begin (), verifications.end (), [](int verification_a) { return verification_a == 1; });
+	}
+	std::vector<nano::uint256_union> hashes;
+	std::vector<nano::account> accounts;
+	std::vector<nano::signature> signatures;
+	std::vector<unsigned char const *> messages;
+	std::vector<size_t> lengths;
+	std::vector<unsigned char const *> pub_keys;
+	std::vector<unsigned char const *> signature_pointers;
+	std::vector<int> verifications;
+	std::unique_ptr<nano::signature_check_set> check;
+};
+}
+
+/*
+ * Verifies large block sets and small vote sets from two threads at once, as the block and vote processors do.
+ * Reports overall throughput and the latency of the vote sets.
+ */
+TEST (signature_checker, mixed_load_benchmark)
+{
+	nano::node_config config;
+	nano::signature_checker checker (config.signature_checker_threads);
+	nano::keypair key;
+	size_t const block_sets (8);
+	size_t const block_set_size (4096);
+	std::vector<owned_check_set> blocks (block_sets);
+	for (auto & set : blocks)
+	{
+		for (size_t i (0); i < block_set_size; ++i)
+		{
+			nano::state_block block (key.pub, i, key.pub, i, i, key.prv, key.pub, 0);
+			set.add (block.hash (), key.pub, block.signature);
+		}
+	}
+	size_t const vote_sets (400);
+	std::vector<owned_check_set> votes (vote_sets);
+	size_t vote_count (0);
+	for (size_t i (0); i < vote_sets; ++i)
+	{
+		// Vote processor batches vary with network traffic
+		for (size_t j (0), n (1 + (i * 37) % 64); j < n; ++j)
+		{
+			nano::vote vote (key.pub, key.prv, i * 64 + j, std::vector<nano::block_hash>{ nano::block_hash (i * 64 + j) });
+			votes[i].add (vote.hash (), key.pub, vote.signature);
+			++vote_count;
+		}
+	}
+	auto begin (std::chrono::steady_clock::now ());
+	std::thread block_thread ([&checker, &blocks]() {
+		for (auto & set : blocks)
+		{
+			checker.verify (set.set ());
+		}
+	});
+	std::vector<uint64_t> latencies_us;
+	for (auto & set : votes)
+	{
+		auto vote_begin (std::chrono::steady_clock::now ());
+		checker.verify (set.set (), nano::signature_check_priority::high);
+		latencies_us.push_back (std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::steady_clock::now () - vote_begin).count ());
+	}
+	block_thread.join ();
+	auto total_us (std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::steady_clock::now () - begin).count ());
+	for (auto & set : blocks)
+	{
+		ASSERT_TRUE (set.all_valid ());
+	}
+	for (auto & set : votes)
+	{
+		ASSERT_TRUE (set.all_valid ());
+	}
+	std::sort (latencies_us.begin (), latencies_us.end ());
+	auto signatures (block_sets * block_set_size + vote_count);
+	std::cout << boost::str (boost::format ("{\"benchmark\": \"signature_checker_mixed\", \"threads\": %1%, \"signatures\": %2%, \"signatures_per_s\": %3%, \"vote_latency_p50_us\": %4%, \"vote_latency_p99_us\": %5%, \"vote_latency_max_us\": %6%}\n") % config.signature_checker_threads % signatures % (signatures * 1000000 / std::max<uint64_t> (1, total_us)) % latencies_us[latencies_us.size () / 2] % latencies_us[latencies_us.size () * 99 / 100] % latencies_us.back ());
+}
+
+TEST (uint256_union, codec_benchmark)
+{
+	size_t const count (100000);
+	nano::keypair key;
+	std::array<char, nano::uint256_union::account_encoded_size> account;
+	std::array<char, 64> hex;
+	size_t checksum (0);
+	auto begin (std::chrono::steady_clock::now ());
+	for (size_t i (0); i < count; ++i)
+	{
+		key.pub.qwords[0] = i;
+		key.pub.encode_account (account.data ());
+		checksum += account[64];
+	}
+	auto account_encode_ns (std::chrono::duration_cast<std::chrono::nanoseconds> (std::chrono::steady_clock::now () - begin).count ());
+	begin = std::chrono::steady_clock::now ();
+	nano::uint256_union output;
+	for (size_t i (0); i < count; ++i)
+	{
+		checksum += output.decode_account (account.data (), account.size ());
+	}
+	auto account_decode_ns (std::chrono::duration_cast<std::chrono::nanoseconds> (std::chrono::steady_clock::now () - begin).count ());
+	ASSERT_EQ (key.pub, output);
+	begin = std::chrono::steady_clock::now ();
+	for (size_t i (0); i < count; ++i)
+	{
+		key.pub.qwords[0] = i;
+		key.pub.encode_hex (hex.data ());
+		checksum += hex[63];
+	}
+	auto hex_encode_ns (std::chrono::duration_cast<std::chrono::nanoseconds> (std::chrono::steady_clock::now () - begin).count ());
+	begin = std::chrono::steady_clock::now ();
+	for (size_t i (0); i < count; ++i)
+	{
+		checksum += output.decode_hex (hex.data (), hex.size ());
+	}
+	auto hex_decode_ns (std::chrono::duration_cast<std::chrono::nanoseconds> (std::chrono::steady_clock::now () - begin).count ());
+	ASSERT_EQ (key.pub, output);
+	std::cout << boost::str (boost::format ("{\"benchmark\": \"uint256_union_codec\", \"account_encode_ns\": %1%, \"account_decode_ns\": %2%, \"hex_encode_ns\": %3%, \"hex_decode_ns\": %4%, \"checksum\": %5%}\n") % (account_encode_ns / count) % (account_decode_ns / count) % (hex_encode_ns / count) % (hex_decode_ns / count) % checksum);
+}